@@ -0,0 +1,327 @@
+#!/bin/sh
+
+# slbt-bench.sh: generate synthetic libtool trees, then measure the
+# overhead of slibtool's compile, link, install, uninstall, ar, and clean
+# modes, using a stand-in toolchain (slbt-bench-tool) in place of
+# the real compiler, archiver, name mangler, and installer.
+# this file is covered by COPYING.SLIBTOOL.
+
+set -eu
+
+usage()
+{
+cat << EOF >&2
+
+Usage:
+  -h            show this HELP message
+  -s  SLIBTOOL  slibtool binary to measure
+  -t  TOOL      stand-in toolchain (slbt-bench-tool)
+  -r  RUNNER    measurement utility (slbt-bench-run)
+  -w  WORKDIR   scratch directory (removed and re-created)
+  -l  NLIBS     number of libraries                   [16]
+  -m  NOBJS     number of objects per library          [16]
+  -c  NCONV     length of the convenience library chain [8]
+  -d  NDLOPEN   number of -dlpreopen libraries         [8]
+  -p  NPREFIX   libraries in the large uninstall prefix [2000]
+  -n  NREPEAT   repetitions of the slibtool-ar runs      [8]
+  -j  NJOBS     slibtool-ar -Wjobs count                [4]
+  -a  ARGCS     argument counts of the link rss sweep
+                ["1000 5000 10000 20000"]
+
+EOF
+exit 1
+}
+
+
+# one
+slibtool=
+tool=
+runner=
+workdir=
+nlibs=16
+nobjs=16
+nconv=8
+ndlopen=8
+nprefix=2000
+nrepeat=8
+njobs=4
+argcs="1000 5000 10000 20000"
+
+
+while getopts "hs:t:r:w:l:m:c:d:p:n:j:a:" opt; do
+	case $opt in
+	h)
+		usage
+		;;
+	s)
+		slibtool="$OPTARG"
+		;;
+	t)
+		tool="$OPTARG"
+		;;
+	r)
+		runner="$OPTARG"
+		;;
+	w)
+		workdir="$OPTARG"
+		;;
+	l)
+		nlibs="$OPTARG"
+		;;
+	m)
+		nobjs="$OPTARG"
+		;;
+	c)
+		nconv="$OPTARG"
+		;;
+	d)
+		ndlopen="$OPTARG"
+		;;
+	p)
+		nprefix="$OPTARG"
+		;;
+	n)
+		nrepeat="$OPTARG"
+		;;
+	j)
+		njobs="$OPTARG"
+		;;
+	a)
+		argcs="$OPTARG"
+		;;
+	\?)
+		printf 'Invalid option: -%s' "$OPTARG" >&2
+		usage
+		;;
+	esac
+done
+
+
+# two
+if [ -z "$slibtool" ] || [ -z "$tool" ] || [ -z "$runner" ] || [ -z "$workdir" ]; then
+	usage
+fi
+
+if [ "$ndlopen" -gt "$nlibs" ]; then
+	ndlopen="$nlibs"
+fi
+
+abspath()
+{
+	case "$1" in
+		/*) printf '%s' "$1" ;;
+		*)  printf '%s/%s' "$(pwd -P)" "$1" ;;
+	esac
+}
+
+slibtool=$(abspath "$slibtool")
+tool=$(abspath "$tool")
+runner=$(abspath "$runner")
+
+rm -rf -- "$workdir"
+mkdir -p -- "$workdir"
+cd -- "$workdir"
+
+workdir=$(pwd -P)
+prefix="$workdir/prefix"
+bigprefix="$workdir/bigprefix"
+
+mkdir bin cmds tree prefix prefix/lib prefix/bin bigprefix bigprefix/lib
+
+
+# three: stand-in toolchain, including the <machine>- prefixed names
+machine=$("$slibtool" --dumpmachine)
+
+for name in cc ar nm install "$machine-ar" "$machine-nm"; do
+	ln -s "$tool" "bin/$name"
+done
+
+ln -s "$slibtool" bin/slibtool
+ln -s "$slibtool" bin/slibtool-ar
+
+PATH="$workdir/bin:$PATH"
+export PATH
+
+slbt="$workdir/bin/slibtool"
+slbtar="$workdir/bin/slibtool-ar"
+
+
+# four: sources and command files
+libname()
+{
+	printf 'l%03d' "$1"
+}
+
+: > cmds/compile
+: > cmds/link
+: > cmds/install
+: > cmds/uninstall
+: > cmds/ar-serial
+: > cmds/ar-jobs
+
+cleanlist=
+
+mkdir tree/conv tree/prog
+
+arlist=
+lib=1
+
+while [ $lib -le $nlibs ]; do
+	name=$(libname $lib)
+	mkdir "tree/$name"
+
+	objs=
+	obj=1
+
+	while [ $obj -le $nobjs ]; do
+		src=$(printf 'tree/%s/%s_o%03d' "$name" "$name" $obj)
+		printf 'int %s_o%03d(void) { return %d; }\n' "$name" $obj $obj > "$src.c"
+		printf '%s --mode=compile cc -c -o %s.lo %s.c\n' "$slbt" "$src" "$src" >> cmds/compile
+		objs="$objs $src.lo"
+		cleanlist="$cleanlist $src.lo"
+		obj=$((obj + 1))
+	done
+
+	# deep .la graph: every library depends on its predecessor
+	deps=
+
+	if [ $lib -gt 1 ]; then
+		prev=$(libname $((lib - 1)))
+		deps="tree/$prev/lib$prev.la"
+	fi
+
+	printf '%s --mode=link cc -o tree/%s/lib%s.la -rpath %s/lib -version-info 1:0:0%s %s\n' \
+		"$slbt" "$name" "$name" "$prefix" "$objs" "$deps" >> cmds/link
+
+	printf '%s --mode=install install -c tree/%s/lib%s.la %s/lib/lib%s.la\n' \
+		"$slbt" "$name" "$name" "$prefix" "$name" >> cmds/install
+
+	printf '%s --mode=uninstall rm -f %s/lib/lib%s.la\n' \
+		"$slbt" "$prefix" "$name" >> cmds/uninstall
+
+	arlist="$arlist tree/$name/.libs/lib$name.a"
+	cleanlist="$cleanlist tree/$name/lib$name.la"
+	lib=$((lib + 1))
+done
+
+# convenience library chain, ending in an installable library
+conv=1
+
+while [ $conv -le $nconv ]; do
+	src=$(printf 'tree/conv/c%03d' $conv)
+	printf 'int c%03d(void) { return %d; }\n' $conv $conv > "$src.c"
+	printf '%s --mode=compile cc -c -o %s.lo %s.c\n' "$slbt" "$src" "$src" >> cmds/compile
+	cleanlist=$(printf '%s %s.lo tree/conv/libc%03d.la' "$cleanlist" "$src" $conv)
+
+	deps=
+
+	if [ $conv -gt 1 ]; then
+		deps=$(printf ' tree/conv/libc%03d.la' $((conv - 1)))
+	fi
+
+	printf '%s --mode=link cc -o tree/conv/libc%03d.la %s.lo%s\n' \
+		"$slbt" $conv "$src" "$deps" >> cmds/link
+
+	conv=$((conv + 1))
+done
+
+printf '%s --mode=link cc -o tree/conv/libconv.la -rpath %s/lib -version-info 1:0:0 tree/conv/libc%03d.la\n' \
+	"$slbt" "$prefix" $nconv >> cmds/link
+
+printf '%s --mode=install install -c tree/conv/libconv.la %s/lib/libconv.la\n' \
+	"$slbt" "$prefix" >> cmds/install
+
+printf '%s --mode=uninstall rm -f %s/lib/libconv.la\n' \
+	"$slbt" "$prefix" >> cmds/uninstall
+
+# program: the last library of the chain, and a -dlpreopen set
+printf 'int main(void) { return 0; }\n' > tree/prog/main.c
+printf '%s --mode=compile cc -c -o tree/prog/main.lo tree/prog/main.c\n' "$slbt" >> cmds/compile
+
+dlopen=
+lib=1
+
+while [ $lib -le $ndlopen ]; do
+	name=$(libname $lib)
+	dlopen="$dlopen -dlpreopen tree/$name/lib$name.la"
+	lib=$((lib + 1))
+done
+
+name=$(libname $nlibs)
+
+printf '%s --mode=link cc -o tree/prog/prog tree/prog/main.lo tree/%s/lib%s.la%s\n' \
+	"$slbt" "$name" "$name" "$dlopen" >> cmds/link
+
+printf '%s --mode=install install -c tree/prog/prog %s/bin/prog\n' \
+	"$slbt" "$prefix" >> cmds/install
+
+printf '%s --mode=uninstall rm -f %s/bin/prog\n' \
+	"$slbt" "$prefix" >> cmds/uninstall
+
+# slibtool-ar: symbol listing of all archives, serially and concurrently
+rep=1
+
+while [ $rep -le $nrepeat ]; do
+	printf '%s -Wprint=symbols -Wyaml%s\n' "$slbtar" "$arlist" >> cmds/ar-serial
+	printf '%s -Wprint=symbols -Wyaml -Wjobs=%d%s\n' "$slbtar" $njobs "$arlist" >> cmds/ar-jobs
+	rep=$((rep + 1))
+done
+
+# clean: all objects, libraries, and the program, in a single invocation
+printf '%s --mode=clean rm -f%s tree/conv/libconv.la tree/prog/main.lo tree/prog/prog\n' \
+	"$slbt" "$cleanlist" > cmds/clean
+
+# large prefix: five files per library, removed by a single invocation
+printf '%s --mode=uninstall rm -f' "$slbt" > cmds/uninstall-prefix
+
+lib=1
+
+while [ $lib -le $nprefix ]; do
+	name=$(printf 'libx%05d' $lib)
+	printf '# %s.la\n' "$name" > "bigprefix/lib/$name.la"
+	printf '!<arch>\n' > "bigprefix/lib/$name.a"
+	printf 'so\n' > "bigprefix/lib/$name.so.1.0.0"
+	ln -s "$name.so.1.0.0" "bigprefix/lib/$name.so.1"
+	ln -s "$name.so.1.0.0" "bigprefix/lib/$name.so"
+	printf ' %s/lib/%s.la' "$bigprefix" "$name" >> cmds/uninstall-prefix
+	lib=$((lib + 1))
+done
+
+printf '\n' >> cmds/uninstall-prefix
+
+# link rss sweep: a single program link line of the given length
+for argc in $argcs; do
+	printf '%s --mode=link cc -o tree/prog/sweep' "$slbt" > "cmds/argc-$argc"
+
+	obj=1
+
+	while [ $obj -le $argc ]; do
+		printf ' tree/prog/s%05d.o' $obj
+		obj=$((obj + 1))
+	done >> "cmds/argc-$argc"
+
+	printf '\n' >> "cmds/argc-$argc"
+done
+
+
+# five: measure
+printf '%-20s %6s %9s %8s %8s %9s %9s %9s %8s %10s\n' \
+	mode cmds wall user sys 'rss(KiB)' syscr syscw ctxsw 'units/s'
+
+"$runner" compile          cmds/compile
+"$runner" link             cmds/link
+"$runner" install          cmds/install
+"$runner" uninstall        cmds/uninstall
+"$runner" uninstall-prefix cmds/uninstall-prefix "$((nprefix * 5))"
+"$runner" ar               cmds/ar-serial        "$((nlibs * nrepeat))"
+"$runner" ar-jobs          cmds/ar-jobs          "$((nlibs * nrepeat))"
+
+for argc in $argcs; do
+	"$runner" "link-argc-$argc" "cmds/argc-$argc" "$argc"
+done
+
+"$runner" clean            cmds/clean            "$((nlibs * (nobjs + 1) + nconv * 2 + 3))"
+
+
+# all done
+exit 0
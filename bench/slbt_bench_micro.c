@@ -0,0 +1,566 @@
+/*******************************************************************/
+/*  slibtool: a strong libtool implementation, written in C        */
+/*  Copyright (C) 2016--2024  SysDeer Technologies, LLC            */
+/*  Released under the Standard MIT License; see COPYING.SLIBTOOL. */
+/*******************************************************************/
+
+/*****************************************************************/
+/* slbt-bench-micro: time individual library functions on inputs */
+/* that are generated in a scratch directory, and report ns/op   */
+/* (along with allocations and allocated bytes per op, provided  */
+/* that the allocator was wrapped at link time) in JSON format.  */
+/*                                                               */
+/* the format is stable: one object per benchmark, keys in fixed */
+/* order, benchmark names and parameters unchanged across        */
+/* releases; new benchmarks are appended, and a change of the    */
+/* meaning of an existing field increments "version".           */
+/*****************************************************************/
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <slibtool/slibtool.h>
+#include "slibtool_ar_impl.h"
+
+#define BENCH_FORMAT_VERSION	1
+#define BENCH_LINK_ARGC		50000
+#define BENCH_SCRIPT_LINES	10000
+#define BENCH_MERGE_ARCHIVES	16
+#define BENCH_MERGE_MEMBERS	1000
+#define BENCH_DLSYMS_ARCHIVES	4
+
+/* allocation accounting: -Wl,--wrap=malloc, etc. */
+#ifdef SLBT_BENCH_MALLOC_WRAP
+
+static size_t bench_nallocs;
+static size_t bench_nbytes;
+
+void * __real_malloc(size_t);
+void * __real_calloc(size_t, size_t);
+void * __real_realloc(void *, size_t);
+char * __real_strdup(const char *);
+char * __real_strndup(const char *, size_t);
+
+void * __wrap_malloc(size_t);
+void * __wrap_calloc(size_t, size_t);
+void * __wrap_realloc(void *, size_t);
+char * __wrap_strdup(const char *);
+char * __wrap_strndup(const char *, size_t);
+
+void * __wrap_malloc(size_t size)
+{
+	bench_nallocs++;
+	bench_nbytes += size;
+	return __real_malloc(size);
+}
+
+void * __wrap_calloc(size_t nmemb, size_t size)
+{
+	bench_nallocs++;
+	bench_nbytes += nmemb * size;
+	return __real_calloc(nmemb,size);
+}
+
+void * __wrap_realloc(void * ptr, size_t size)
+{
+	bench_nallocs++;
+	bench_nbytes += size;
+	return __real_realloc(ptr,size);
+}
+
+char * __wrap_strdup(const char * s)
+{
+	bench_nallocs++;
+	bench_nbytes += strlen(s) + 1;
+	return __real_strdup(s);
+}
+
+char * __wrap_strndup(const char * s, size_t n)
+{
+	bench_nallocs++;
+	bench_nbytes += strnlen(s,n) + 1;
+	return __real_strndup(s,n);
+}
+
+#define BENCH_FALLOCS	1
+
+#else
+
+static size_t bench_nallocs;
+static size_t bench_nbytes;
+
+#define BENCH_FALLOCS	0
+
+#endif
+
+struct bench_ctx {
+	struct slbt_driver_ctx *	dctx;
+	char **				argv;
+	const char *			path;
+	struct slbt_archive_ctx *	actx;
+	struct slbt_archive_ctx *	arctxv[BENCH_MERGE_ARCHIVES + 1];
+};
+
+typedef int bench_op(struct bench_ctx *);
+
+static const char * bench_program;
+static double       bench_mintime;
+static int          bench_first = 1;
+
+static void bench_die(const char * msg, const char * arg)
+{
+	fprintf(stderr,"%s: %s%s%s\n",bench_program,msg,arg ? ": " : "",arg ? arg : "");
+	exit(2);
+}
+
+static double bench_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* run the op in doubling batches until a batch lasts bench_mintime */
+static void bench_measure(
+	const char *		name,
+	long			param,
+	bench_op *		op,
+	struct bench_ctx *	ctx)
+{
+	size_t	idx;
+	size_t	niters;
+	size_t	nallocs;
+	size_t	nbytes;
+	double	start;
+	double	elapsed;
+
+	/* warm-up: lazily computed state, shared probe results */
+	if (op(ctx) < 0)
+		bench_die("benchmark failed",name);
+
+	for (niters=1; ; niters*=2) {
+		nallocs = bench_nallocs;
+		nbytes  = bench_nbytes;
+		start   = bench_now();
+
+		for (idx=0; idx<niters; idx++)
+			if (op(ctx) < 0)
+				bench_die("benchmark failed",name);
+
+		elapsed = bench_now() - start;
+		nallocs = bench_nallocs - nallocs;
+		nbytes  = bench_nbytes  - nbytes;
+
+		if (elapsed >= bench_mintime)
+			break;
+	}
+
+	printf("%s\n    {\"name\": \"%s\", \"param\": %ld, \"iterations\": %zu, "
+		"\"ns_per_op\": %.1f, ",
+		bench_first ? "" : ",",
+		name,param,niters,elapsed * 1e9 / niters);
+
+	if (BENCH_FALLOCS)
+		printf("\"allocs_per_op\": %.1f, \"bytes_per_op\": %.1f}",
+			(double)nallocs / niters,
+			(double)nbytes / niters);
+	else
+		printf("\"allocs_per_op\": null, \"bytes_per_op\": null}");
+
+	bench_first = 0;
+	fflush(stdout);
+}
+
+
+/* inputs */
+static void bench_write_file(const char * path, const void * data, size_t size)
+{
+	int		fd;
+	ssize_t		nwritten;
+	const char *	ch;
+
+	if ((fd = open(path,O_WRONLY|O_CREAT|O_TRUNC,0644)) < 0)
+		bench_die("cannot create",path);
+
+	for (ch=data; size; ch+=nwritten, size-=nwritten)
+		if ((nwritten = write(fd,ch,size)) < 0)
+			bench_die("cannot write",path);
+
+	close(fd);
+}
+
+static char * bench_be32(char * ch, size_t val)
+{
+	*ch++ = (val >> 24) & 0xff;
+	*ch++ = (val >> 16) & 0xff;
+	*ch++ = (val >>  8) & 0xff;
+	*ch++ = (val >>  0) & 0xff;
+
+	return ch;
+}
+
+/* an archive of stand-in objects (see slbt_bench_tool.c), each */
+/* defining a text and a data symbol, along with its armap      */
+static void bench_create_archive(const char * path, const char * prefix, size_t nmembers)
+{
+	size_t	idx;
+	size_t	symlen;
+	size_t	mapsize;
+	size_t	objsize;
+	size_t	offset;
+	size_t	size;
+	char *	base;
+	char *	ch;
+	char	sym[64];
+	char	obj[160];
+	char	hdr[128];
+
+	objsize = snprintf(obj,sizeof(obj),
+		"!<slbt-bench-object>\nT %s%07zu\nD %s%07zu_data\n",
+		prefix,(size_t)0,prefix,(size_t)0);
+
+	symlen  = 2 * (strlen(prefix) + 7 + 1) + 5;
+	mapsize = 4 + 8 * nmembers + symlen * nmembers;
+	mapsize += mapsize & 1;
+	size    = 8 + 60 + mapsize + nmembers * (60 + objsize + (objsize & 1));
+
+	if (!(base = malloc(size + 1)))
+		bench_die("out of memory",0);
+
+	ch = base;
+	memcpy(ch,"!<arch>\n",8);
+	ch += 8;
+
+	snprintf(hdr,sizeof(hdr),"%-16s%-12s%-6s%-6s%-8s%-10zu`\n","/","0","0","0","0",mapsize);
+	memcpy(ch,hdr,60);
+	ch += 60;
+
+	ch     = bench_be32(ch,2 * nmembers);
+	offset = 8 + 60 + mapsize;
+
+	for (idx=0; idx<nmembers; idx++) {
+		ch = bench_be32(ch,offset);
+		ch = bench_be32(ch,offset);
+		offset += 60 + objsize + (objsize & 1);
+	}
+
+	for (idx=0; idx<nmembers; idx++) {
+		ch += sprintf(ch,"%s%07zu",prefix,idx) + 1;
+		ch += sprintf(ch,"%s%07zu_data",prefix,idx) + 1;
+	}
+
+	if ((ch - base) & 1)
+		*ch++ = 0;
+
+	for (idx=0; idx<nmembers; idx++) {
+		snprintf(sym,sizeof(sym),"m%07zu.o/",idx);
+		snprintf(hdr,sizeof(hdr),"%-16s%-12s%-6s%-6s%-8s%-10zu`\n",sym,"0","0","0","644",objsize);
+		memcpy(ch,hdr,60);
+		ch += 60;
+
+		ch += sprintf(ch,
+			"!<slbt-bench-object>\nT %s%07zu\nD %s%07zu_data\n",
+			prefix,idx,prefix,idx);
+
+		if (objsize & 1)
+			*ch++ = '\n';
+	}
+
+	bench_write_file(path,base,ch - base);
+	free(base);
+}
+
+/* a libtool script of the given number of lines */
+static void bench_create_script(const char * path, size_t nlines)
+{
+	size_t	idx;
+	size_t	size;
+	char *	base;
+	char *	ch;
+
+	if (!(base = malloc(nlines * 80)))
+		bench_die("out of memory",0);
+
+	for (ch=base, idx=0; idx<nlines; idx++) {
+		switch (idx % 4) {
+			case 0:
+				ch += sprintf(ch,"# section %zu: configuration of the libtool script\n",idx);
+				break;
+
+			case 1:
+				ch += sprintf(ch,"variable_%zu=\"value of variable %zu\"\n",idx,idx);
+				break;
+
+			case 2:
+				ch += sprintf(ch,"\n");
+				break;
+
+			case 3:
+				ch += sprintf(ch,"test -z \"$variable_%zu\" || echo $variable_%zu\n",idx-2,idx-2);
+				break;
+		}
+	}
+
+	size = ch - base;
+	bench_write_file(path,base,size);
+	free(base);
+}
+
+
+/* ops */
+static int bench_op_driver_ctx(struct bench_ctx * ctx)
+{
+	struct slbt_driver_ctx * dctx;
+
+	if (slbt_lib_get_driver_ctx(ctx->argv,0,SLBT_DRIVER_VERBOSITY_ERRORS,0,&dctx) < 0)
+		return -1;
+
+	slbt_lib_free_driver_ctx(dctx);
+
+	return 0;
+}
+
+static int bench_op_txtfile_ctx(struct bench_ctx * ctx)
+{
+	struct slbt_txtfile_ctx * tctx;
+
+	if (slbt_lib_get_txtfile_ctx(ctx->dctx,ctx->path,&tctx) < 0)
+		return -1;
+
+	slbt_lib_free_txtfile_ctx(tctx);
+
+	return 0;
+}
+
+static int bench_op_archive_meta(struct bench_ctx * ctx)
+{
+	struct slbt_archive_meta * meta;
+
+	if (slbt_ar_get_archive_meta(ctx->dctx,ctx->actx->map,&meta) < 0)
+		return -1;
+
+	slbt_ar_free_archive_meta(meta);
+
+	return 0;
+}
+
+static int bench_op_merge_archives(struct bench_ctx * ctx)
+{
+	struct slbt_archive_ctx * arctx;
+
+	if (slbt_ar_merge_archives(ctx->arctxv,&arctx) < 0)
+		return -1;
+
+	slbt_ar_free_archive_ctx(arctx);
+
+	return 0;
+}
+
+static int bench_op_mapstrv(struct bench_ctx * ctx)
+{
+	struct slbt_archive_meta_impl * mctx;
+
+	mctx = slbt_archive_meta_ictx(ctx->actx->meta);
+
+	free(mctx->mapstrv);
+	mctx->mapstrv = 0;
+
+	return slbt_update_mapstrv(ctx->dctx,mctx);
+}
+
+static int bench_op_mapfile(struct bench_ctx * ctx)
+{
+	return slbt_ar_create_mapfile(ctx->actx->meta,ctx->path,0644);
+}
+
+static int bench_op_dlsyms(struct bench_ctx * ctx)
+{
+	return slbt_ar_create_dlsyms(ctx->arctxv,"bench",ctx->path,0644);
+}
+
+
+/* driver */
+static void bench_get_archive_ctx(struct bench_ctx * ctx, const char * path, struct slbt_archive_ctx ** actx)
+{
+	if (slbt_ar_get_archive_ctx(ctx->dctx,path,actx) < 0) {
+		slbt_output_error_vector(ctx->dctx);
+		bench_die("could not open archive",path);
+	}
+}
+
+int main(int argc, char ** argv)
+{
+	size_t				idx;
+	size_t				nmembers;
+	long				mintime;
+	struct bench_ctx		ctx;
+	struct slbt_driver_ctx *	dctx;
+	const struct slbt_source_version * ver;
+	char *				dargv[8];
+	char **				largv;
+	char				nmarg[PATH_MAX + 16];
+	char				path[PATH_MAX];
+	char				prefix[32];
+	char				tool[PATH_MAX];
+	char				(*largbuf)[32];
+
+	static const size_t		metasizes[] = {1000,10000,100000,0};
+
+	bench_program = argv[0];
+
+	if ((argc < 3) || (argc > 4)) {
+		fprintf(stderr,"usage: %s <workdir> <slbt-bench-tool> [<min-time-ms>]\n",argv[0]);
+		return 2;
+	}
+
+	mintime       = (argc == 4) ? strtol(argv[3],0,10) : 200;
+	bench_mintime = mintime / 1e3;
+
+	/* scratch directory, stand-in nm */
+	if (!realpath(argv[2],tool))
+		bench_die("cannot resolve",argv[2]);
+
+	mkdir(argv[1],0755);
+
+	if (chdir(argv[1]) < 0)
+		bench_die("cannot enter",argv[1]);
+
+	unlink("nm");
+
+	if (symlink(tool,"nm") < 0)
+		bench_die("cannot create symlink","nm");
+
+	if (!getcwd(path,sizeof(path)))
+		bench_die("getcwd failed",0);
+
+	snprintf(nmarg,sizeof(nmarg),"--nm=%s/nm",path);
+
+	/* driver context for the archive benchmarks */
+	dargv[0] = "slibtool";
+	dargv[1] = nmarg;
+	dargv[2] = "--mode=link";
+	dargv[3] = "cc";
+	dargv[4] = "-o";
+	dargv[5] = "bench";
+	dargv[6] = 0;
+
+	if (slbt_lib_get_driver_ctx(dargv,0,SLBT_DRIVER_VERBOSITY_ERRORS,0,&dctx) < 0)
+		bench_die("could not create a driver context",0);
+
+	memset(&ctx,0,sizeof(ctx));
+	ctx.dctx = dctx;
+
+	/* header */
+	ver = slbt_api_source_version();
+
+	printf("{\n  \"format\": \"slibtool-bench-micro\",\n  \"version\": %d,\n"
+		"  \"slibtool\": {\"major\": %d, \"minor\": %d, \"revision\": %d, \"commit\": \"%s\"},\n"
+		"  \"min_time_ms\": %ld,\n  \"allocs\": %s,\n  \"benchmarks\": [",
+		BENCH_FORMAT_VERSION,
+		ver->major,ver->minor,ver->revision,ver->commit,
+		mintime,BENCH_FALLOCS ? "true" : "false");
+
+	/* argv parsing: a compile line, and a long link line */
+	ctx.argv = (char *[]){
+		"slibtool","--mode=compile","--tag=CC","cc",
+		"-DHAVE_CONFIG_H","-I.","-I..","-Iinclude",
+		"-O2","-g","-Wall","-MT","foo.lo","-MD","-MP","-MF",".deps/foo.Tpo",
+		"-c","-o","foo.lo","foo.c",0};
+
+	for (idx=0; ctx.argv[idx]; idx++)
+		continue;
+
+	bench_measure("driver_ctx_compile",idx,bench_op_driver_ctx,&ctx);
+
+	if (!(largv = calloc(BENCH_LINK_ARGC + 8,sizeof(char *))))
+		bench_die("out of memory",0);
+
+	if (!(largbuf = calloc(BENCH_LINK_ARGC,sizeof(*largbuf))))
+		bench_die("out of memory",0);
+
+	largv[0] = "slibtool";
+	largv[1] = "--mode=link";
+	largv[2] = "cc";
+	largv[3] = "-o";
+	largv[4] = "prog";
+
+	for (idx=0; idx<BENCH_LINK_ARGC; idx++) {
+		switch (idx % 5) {
+			case 0: sprintf(largbuf[idx],"-Wl,--defsym=sym%zu=0",idx); break;
+			case 1: sprintf(largbuf[idx],"-L/opt/lib%zu",idx); break;
+			case 2: sprintf(largbuf[idx],"-lfoo%zu",idx); break;
+			case 3: sprintf(largbuf[idx],"-Wc,-O%zu",idx % 3); break;
+			case 4: sprintf(largbuf[idx],"x%zu.o",idx); break;
+		}
+
+		largv[5 + idx] = largbuf[idx];
+	}
+
+	ctx.argv = largv;
+	bench_measure("driver_ctx_link",BENCH_LINK_ARGC,bench_op_driver_ctx,&ctx);
+
+	free(largbuf);
+	free(largv);
+
+	/* libtool script */
+	bench_create_script("libtool",BENCH_SCRIPT_LINES);
+
+	ctx.path = "libtool";
+	bench_measure("txtfile_ctx",BENCH_SCRIPT_LINES,bench_op_txtfile_ctx,&ctx);
+
+	/* archive meta, armap sort, mapfile */
+	for (idx=0; (nmembers = metasizes[idx]); idx++) {
+		snprintf(path,sizeof(path),"meta%zu.a",nmembers);
+		bench_create_archive(path,"meta_sym",nmembers);
+		bench_get_archive_ctx(&ctx,path,&ctx.actx);
+
+		bench_measure("archive_meta",nmembers,bench_op_archive_meta,&ctx);
+		bench_measure("update_mapstrv",nmembers,bench_op_mapstrv,&ctx);
+
+		ctx.path = "bench.map";
+		bench_measure("create_mapfile",nmembers,bench_op_mapfile,&ctx);
+
+		slbt_ar_free_archive_ctx(ctx.actx);
+		ctx.actx = 0;
+	}
+
+	/* merge, dlsyms */
+	for (idx=0; idx<BENCH_MERGE_ARCHIVES; idx++) {
+		snprintf(path,sizeof(path),"merge%02zu.a",idx);
+		snprintf(prefix,sizeof(prefix),"merge%02zu_sym",idx);
+		bench_create_archive(path,prefix,BENCH_MERGE_MEMBERS);
+		bench_get_archive_ctx(&ctx,path,&ctx.arctxv[idx]);
+	}
+
+	bench_measure("merge_archives",
+		BENCH_MERGE_ARCHIVES * BENCH_MERGE_MEMBERS,
+		bench_op_merge_archives,&ctx);
+
+	for (idx=BENCH_DLSYMS_ARCHIVES; idx<BENCH_MERGE_ARCHIVES; idx++) {
+		slbt_ar_free_archive_ctx(ctx.arctxv[idx]);
+		ctx.arctxv[idx] = 0;
+	}
+
+	ctx.path = "bench.dlsyms.c";
+	bench_measure("create_dlsyms",
+		BENCH_DLSYMS_ARCHIVES * BENCH_MERGE_MEMBERS,
+		bench_op_dlsyms,&ctx);
+
+	for (idx=0; idx<BENCH_DLSYMS_ARCHIVES; idx++)
+		slbt_ar_free_archive_ctx(ctx.arctxv[idx]);
+
+	printf("\n  ]\n}\n");
+
+	slbt_lib_free_driver_ctx(dctx);
+
+	return 0;
+}
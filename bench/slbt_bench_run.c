@@ -0,0 +1,209 @@
+/*******************************************************************/
+/*  slibtool: a strong libtool implementation, written in C        */
+/*  Copyright (C) 2016--2024  SysDeer Technologies, LLC            */
+/*  Released under the Standard MIT License; see COPYING.SLIBTOOL. */
+/*******************************************************************/
+
+/*****************************************************************/
+/* slbt-bench-run: run the commands listed in a file (one per    */
+/* line, arguments separated by blanks), one after the other,    */
+/* and report the wall time, cpu time, peak rss, read and write  */
+/* system calls, and context switches of the lot. figures cover  */
+/* each command along with the processes that it had spawned.    */
+/*****************************************************************/
+
+#define _DEFAULT_SOURCE
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+struct bench_stats {
+	size_t			ncmds;
+	double			wall;
+	double			utime;
+	double			stime;
+	long			maxrss;
+	long			ctxsw;
+	unsigned long long	syscr;
+	unsigned long long	syscw;
+	int			fio;
+};
+
+static double bench_tv(const struct timeval * tv)
+{
+	return tv->tv_sec + tv->tv_usec / 1e6;
+}
+
+static double bench_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* /proc/<pid>/io of a child that has exited but was not yet reaped */
+static int bench_read_io(pid_t pid, unsigned long long * syscr, unsigned long long * syscw)
+{
+	FILE *			f;
+	char			path[64];
+	char			line[128];
+	unsigned long long	val;
+	int			nfound;
+
+	snprintf(path,sizeof(path),"/proc/%d/io",(int)pid);
+
+	if (!(f = fopen(path,"r")))
+		return -1;
+
+	for (nfound=0; fgets(line,sizeof(line),f); ) {
+		if (sscanf(line,"syscr: %llu",&val) == 1) {
+			*syscr += val;
+			nfound++;
+		} else if (sscanf(line,"syscw: %llu",&val) == 1) {
+			*syscw += val;
+			nfound++;
+		}
+	}
+
+	fclose(f);
+
+	return (nfound == 2) ? 0 : -1;
+}
+
+static int bench_run_cmd(char ** argv, int fdnull, struct bench_stats * stats)
+{
+	pid_t		pid;
+	int		status;
+	siginfo_t	info;
+	struct rusage	ru;
+
+	if ((pid = fork()) < 0)
+		return -1;
+
+	if (pid == 0) {
+		dup2(fdnull,1);
+		execvp(argv[0],argv);
+		_exit(127);
+	}
+
+	/* io accounting must be read before the child is reaped */
+	while (waitid(P_PID,pid,&info,WEXITED|WNOWAIT) < 0)
+		if (errno != EINTR)
+			return -1;
+
+	if (bench_read_io(pid,&stats->syscr,&stats->syscw) < 0)
+		stats->fio = 0;
+
+	while (wait4(pid,&status,0,&ru) < 0)
+		if (errno != EINTR)
+			return -1;
+
+	stats->ncmds++;
+	stats->utime += bench_tv(&ru.ru_utime);
+	stats->stime += bench_tv(&ru.ru_stime);
+	stats->ctxsw += ru.ru_nvcsw + ru.ru_nivcsw;
+
+	if (ru.ru_maxrss > stats->maxrss)
+		stats->maxrss = ru.ru_maxrss;
+
+	if (!WIFEXITED(status) || WEXITSTATUS(status))
+		return 1;
+
+	return 0;
+}
+
+int main(int argc, char ** argv)
+{
+	FILE *			f;
+	char *			line;
+	char *			ch;
+	char **			cargv;
+	size_t			nargs;
+	size_t			linecap;
+	ssize_t			len;
+	size_t			nunits;
+	int			fdnull;
+	int			ret;
+	double			start;
+	struct bench_stats	stats;
+
+	if ((argc < 3) || (argc > 4)) {
+		fprintf(stderr,"usage: %s <label> <cmdfile> [<units>]\n",argv[0]);
+		return 2;
+	}
+
+	if (!(f = fopen(argv[2],"r"))) {
+		fprintf(stderr,"%s: cannot open %s\n",argv[0],argv[2]);
+		return 2;
+	}
+
+	if ((fdnull = open("/dev/null",O_WRONLY)) < 0)
+		return 2;
+
+	memset(&stats,0,sizeof(stats));
+	stats.fio = 1;
+
+	line    = 0;
+	linecap = 0;
+	cargv   = 0;
+	start   = bench_now();
+
+	while ((len = getline(&line,&linecap,f)) >= 0) {
+		if ((len > 0) && (line[len-1] == '\n'))
+			line[--len] = 0;
+
+		if (!line[0] || (line[0] == '#'))
+			continue;
+
+		/* blank-separated arguments, no quoting */
+		if (!(cargv = realloc(cargv,(len / 2 + 2) * sizeof(char *))))
+			return 2;
+
+		for (nargs=0, ch=strtok(line," \t"); ch; ch=strtok(0," \t"))
+			cargv[nargs++] = ch;
+
+		cargv[nargs] = 0;
+
+		if ((ret = bench_run_cmd(cargv,fdnull,&stats))) {
+			fprintf(stderr,"%s: [%s] command %s: %s ...\n",
+				argv[0],argv[1],
+				(ret < 0) ? "could not be run" : "failed",
+				cargv[0]);
+			return 1;
+		}
+	}
+
+	stats.wall = bench_now() - start;
+	nunits     = (argc == 4) ? strtoul(argv[3],0,10) : stats.ncmds;
+
+	printf("%-20s %6zu %9.3f %8.3f %8.3f %9ld ",
+		argv[1],stats.ncmds,stats.wall,
+		stats.utime,stats.stime,stats.maxrss);
+
+	if (stats.fio)
+		printf("%9llu %9llu ",stats.syscr,stats.syscw);
+	else
+		printf("%9s %9s ","-","-");
+
+	printf("%8ld %10.1f\n",stats.ctxsw,
+		stats.wall ? nunits / stats.wall : 0.0);
+
+	free(line);
+	free(cargv);
+	fclose(f);
+	close(fdnull);
+
+	return 0;
+}
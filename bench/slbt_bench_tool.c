@@ -0,0 +1,559 @@
+/*******************************************************************/
+/*  slibtool: a strong libtool implementation, written in C        */
+/*  Copyright (C) 2016--2024  SysDeer Technologies, LLC            */
+/*  Released under the Standard MIT License; see COPYING.SLIBTOOL. */
+/*******************************************************************/
+
+/*****************************************************************/
+/* slbt-bench-tool: a stand-in toolchain for the bench target.   */
+/* invoked as cc, ar, nm, or install (by way of symlinks), the   */
+/* tool performs the minimal work needed for its output to be    */
+/* plausible to slibtool: objects are text files that list their */
+/* global symbols, archives are real ar(1) archives with an      */
+/* armap, and nm -P -A reports the symbols of archive members.   */
+/*****************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#define BENCH_OBJ_MAGIC		"!<slbt-bench-object>\n"
+#define BENCH_BIN_MAGIC		"!<slbt-bench-binary>\n"
+#define BENCH_AR_MAGIC		"!<arch>\n"
+#define BENCH_AR_HDR_SIZE	(60)
+
+struct bench_buf {
+	char *		data;
+	size_t		size;
+	size_t		cap;
+};
+
+struct bench_member {
+	const char *	name;
+	char *		data;
+	size_t		size;
+	size_t		offset;
+	size_t		lnameoff;
+};
+
+static const char * bench_program;
+
+static void bench_die(const char * fmt, const char * arg)
+{
+	fprintf(stderr,"%s: ",bench_program);
+	fprintf(stderr,fmt,arg);
+	fprintf(stderr,"\n");
+	exit(2);
+}
+
+static void bench_buf_add(struct bench_buf * buf, const void * data, size_t size)
+{
+	char * ndata;
+
+	if (buf->size + size > buf->cap) {
+		buf->cap = buf->cap ? 2 * buf->cap : 4096;
+
+		while (buf->size + size > buf->cap)
+			buf->cap *= 2;
+
+		if (!(ndata = realloc(buf->data,buf->cap)))
+			bench_die("%s","out of memory");
+
+		buf->data = ndata;
+	}
+
+	memcpy(&buf->data[buf->size],data,size);
+	buf->size += size;
+}
+
+static char * bench_read_file(const char * path, size_t * size)
+{
+	int		fd;
+	ssize_t		nread;
+	struct stat	st;
+	char *		data;
+	size_t		pos;
+
+	if ((fd = open(path,O_RDONLY)) < 0)
+		bench_die("cannot open %s",path);
+
+	if (fstat(fd,&st) < 0)
+		bench_die("cannot stat %s",path);
+
+	if (!(data = malloc(st.st_size + 1)))
+		bench_die("%s","out of memory");
+
+	for (pos=0; pos<(size_t)st.st_size; pos+=nread)
+		if ((nread = read(fd,&data[pos],st.st_size - pos)) <= 0)
+			bench_die("cannot read %s",path);
+
+	close(fd);
+
+	data[st.st_size] = 0;
+	*size = st.st_size;
+
+	return data;
+}
+
+static void bench_write_file(const char * path, const void * data, size_t size, mode_t mode)
+{
+	int		fd;
+	ssize_t		nwritten;
+	const char *	ch;
+
+	unlink(path);
+
+	if ((fd = open(path,O_WRONLY|O_CREAT|O_TRUNC,mode)) < 0)
+		bench_die("cannot create %s",path);
+
+	for (ch=data; size; ch+=nwritten, size-=nwritten)
+		if ((nwritten = write(fd,ch,size)) < 0)
+			bench_die("cannot write %s",path);
+
+	close(fd);
+}
+
+static const char * bench_basename(const char * path)
+{
+	const char * slash;
+	return (slash = strrchr(path,'/')) ? &slash[1] : path;
+}
+
+/* cc: -c <src> -o <obj> compiles, anything else links */
+static int bench_cc(char ** argv)
+{
+	char **		parg;
+	const char *	src;
+	const char *	out;
+	const char *	base;
+	char *		data;
+	char *		ch;
+	size_t		size;
+	int		fcompile;
+	struct bench_buf buf = {0,0,0};
+	char		sym[256];
+
+	for (src=0, out=0, fcompile=0, parg=&argv[1]; *parg; parg++) {
+		if (!strcmp(*parg,"-c")) {
+			fcompile = 1;
+
+		} else if (!strcmp(*parg,"-o") && parg[1]) {
+			out = *++parg;
+
+		} else if (!strncmp(*parg,"-o",2)) {
+			out = &(*parg)[2];
+
+		} else if ((*parg)[0] != '-') {
+			size = strlen(*parg);
+
+			if ((size > 2) && !strcmp(&(*parg)[size-2],".c"))
+				src = *parg;
+		}
+	}
+
+	/* link: the output merely needs to exist */
+	if (!fcompile) {
+		out = out ? out : "a.out";
+		bench_write_file(out,BENCH_BIN_MAGIC,sizeof(BENCH_BIN_MAGIC)-1,0755);
+		return 0;
+	}
+
+	if (!src)
+		bench_die("%s","no source file");
+
+	/* compile: one text and one data symbol named after the source */
+	data = bench_read_file(src,&size);
+	free(data);
+
+	base = bench_basename(src);
+
+	if ((size = strlen(base) - 2) >= sizeof(sym) - 8)
+		bench_die("%s: source name too long",src);
+
+	memcpy(sym,base,size);
+	sym[size] = 0;
+
+	for (ch=sym; *ch; ch++)
+		if (!((*ch >= 'a') && (*ch <= 'z'))
+				&& !((*ch >= 'A') && (*ch <= 'Z'))
+				&& !((*ch >= '0') && (*ch <= '9')))
+			*ch = '_';
+
+	bench_buf_add(&buf,BENCH_OBJ_MAGIC,sizeof(BENCH_OBJ_MAGIC)-1);
+	bench_buf_add(&buf,"T ",2);
+	bench_buf_add(&buf,sym,size);
+	bench_buf_add(&buf,"\nD ",3);
+	bench_buf_add(&buf,sym,size);
+	bench_buf_add(&buf,"_data\n",6);
+
+	if (!out) {
+		if (!(ch = strdup(base)))
+			bench_die("%s","out of memory");
+
+		ch[strlen(ch)-1] = 'o';
+		out = ch;
+	}
+
+	bench_write_file(out,buf.data,buf.size,0644);
+
+	return 0;
+}
+
+static void bench_ar_header(struct bench_buf * buf, const char * name, size_t size)
+{
+	char hdr[128];
+
+	snprintf(hdr,sizeof(hdr),"%-16s%-12s%-6s%-6s%-8s%-10zu`\n",
+		name,"0","0","0","644",size);
+
+	bench_buf_add(buf,hdr,BENCH_AR_HDR_SIZE);
+}
+
+static void bench_be32(struct bench_buf * buf, size_t val)
+{
+	unsigned char be[4];
+
+	be[0] = (val >> 24) & 0xff;
+	be[1] = (val >> 16) & 0xff;
+	be[2] = (val >>  8) & 0xff;
+	be[3] = (val >>  0) & 0xff;
+
+	bench_buf_add(buf,be,4);
+}
+
+/* walk the symbol lines of a stand-in object */
+static const char * bench_obj_next(const char * ch, const char * cap, char * type, size_t * len)
+{
+	const char * eol;
+
+	for (; ch < cap; ch = &eol[1]) {
+		if (!(eol = memchr(ch,'\n',cap - ch)))
+			return 0;
+
+		if ((eol - ch > 2) && (ch[1] == ' ')) {
+			*type = ch[0];
+			*len  = eol - ch - 2;
+			return &ch[2];
+		}
+	}
+
+	return 0;
+}
+
+/* ar -crs[T] <archive> <member>...: the archive is always rewritten */
+static int bench_ar(char ** argv)
+{
+	int			idx;
+	int			nmembers;
+	const char *		arname;
+	const char *		sym;
+	const char *		cap;
+	char			type;
+	size_t			len;
+	size_t			nsyms;
+	size_t			symlen;
+	size_t			offset;
+	struct bench_member *	members;
+	struct bench_member *	m;
+	struct bench_buf	lnames = {0,0,0};
+	struct bench_buf	ar     = {0,0,0};
+	char			name[32];
+
+	if (!argv[1] || !argv[2])
+		bench_die("%s","missing arguments");
+
+	/* ar -t (probe) */
+	if (strchr(argv[1],'t'))
+		return 0;
+
+	arname   = argv[2];
+	nmembers = 0;
+
+	while (argv[3 + nmembers])
+		nmembers++;
+
+	if (!(members = calloc(nmembers + 1,sizeof(*members))))
+		bench_die("%s","out of memory");
+
+	/* members, symbol count, long names */
+	for (nsyms=0, symlen=0, idx=0; idx<nmembers; idx++) {
+		m = &members[idx];
+		m->name = bench_basename(argv[3 + idx]);
+		m->data = bench_read_file(argv[3 + idx],&m->size);
+
+		cap = &m->data[m->size];
+		sym = m->data;
+
+		while ((sym = bench_obj_next(sym,cap,&type,&len))) {
+			nsyms++;
+			symlen += len + 1;
+			sym    += len;
+		}
+
+		if (strlen(m->name) > 15) {
+			m->lnameoff = lnames.size;
+			bench_buf_add(&lnames,m->name,strlen(m->name));
+			bench_buf_add(&lnames,"/\n",2);
+		}
+	}
+
+	if (lnames.size & 1)
+		bench_buf_add(&lnames,"\n",1);
+
+	/* member offsets */
+	offset  = sizeof(BENCH_AR_MAGIC) - 1;
+	offset += BENCH_AR_HDR_SIZE + 4 + 4*nsyms + symlen + (symlen & 1);
+	offset += lnames.size ? BENCH_AR_HDR_SIZE + lnames.size : 0;
+
+	for (idx=0; idx<nmembers; idx++) {
+		members[idx].offset = offset;
+		offset += BENCH_AR_HDR_SIZE + members[idx].size + (members[idx].size & 1);
+	}
+
+	/* armap */
+	bench_buf_add(&ar,BENCH_AR_MAGIC,sizeof(BENCH_AR_MAGIC)-1);
+	bench_ar_header(&ar,"/",4 + 4*nsyms + symlen + (symlen & 1));
+	bench_be32(&ar,nsyms);
+
+	for (idx=0; idx<nmembers; idx++) {
+		m   = &members[idx];
+		cap = &m->data[m->size];
+		sym = m->data;
+
+		while ((sym = bench_obj_next(sym,cap,&type,&len))) {
+			bench_be32(&ar,m->offset);
+			sym += len;
+		}
+	}
+
+	for (idx=0; idx<nmembers; idx++) {
+		m   = &members[idx];
+		cap = &m->data[m->size];
+		sym = m->data;
+
+		while ((sym = bench_obj_next(sym,cap,&type,&len))) {
+			bench_buf_add(&ar,sym,len);
+			bench_buf_add(&ar,"",1);
+			sym += len;
+		}
+	}
+
+	if (symlen & 1)
+		bench_buf_add(&ar,"",1);
+
+	/* long names */
+	if (lnames.size) {
+		bench_ar_header(&ar,"//",lnames.size);
+		bench_buf_add(&ar,lnames.data,lnames.size);
+	}
+
+	/* members */
+	for (idx=0; idx<nmembers; idx++) {
+		m = &members[idx];
+
+		if (strlen(m->name) > 15)
+			snprintf(name,sizeof(name),"/%zu",m->lnameoff);
+		else
+			snprintf(name,sizeof(name),"%s/",m->name);
+
+		bench_ar_header(&ar,name,m->size);
+		bench_buf_add(&ar,m->data,m->size);
+
+		if (m->size & 1)
+			bench_buf_add(&ar,"\n",1);
+	}
+
+	bench_write_file(arname,ar.data,ar.size,0644);
+
+	return 0;
+}
+
+static void bench_nm_object(
+	const char *	arname,
+	const char *	objname,
+	size_t		objlen,
+	const char *	data,
+	size_t		size)
+{
+	const char *	sym;
+	char		type;
+	size_t		len;
+
+	for (sym=data; (sym = bench_obj_next(sym,&data[size],&type,&len)); sym+=len) {
+		if (arname)
+			printf("%s[%.*s]: %.*s %c 0 0\n",
+				arname,(int)objlen,objname,(int)len,sym,type);
+		else
+			printf("%.*s: %.*s %c 0 0\n",
+				(int)objlen,objname,(int)len,sym,type);
+	}
+}
+
+/* nm -P -A [-g] <file>...: symbols of objects and archive members */
+static int bench_nm(char ** argv)
+{
+	char **		parg;
+	char *		data;
+	char *		ch;
+	char *		cap;
+	char *		lnames;
+	const char *	name;
+	size_t		namelen;
+	size_t		size;
+	size_t		msize;
+
+	for (parg=&argv[1]; *parg; parg++) {
+		if ((*parg)[0] == '-')
+			continue;
+
+		data = bench_read_file(*parg,&size);
+
+		if (strncmp(data,BENCH_AR_MAGIC,sizeof(BENCH_AR_MAGIC)-1)) {
+			bench_nm_object(0,*parg,strlen(*parg),data,size);
+			free(data);
+			continue;
+		}
+
+		ch     = &data[sizeof(BENCH_AR_MAGIC)-1];
+		cap    = &data[size];
+		lnames = 0;
+
+		for (; ch + BENCH_AR_HDR_SIZE <= cap; ch += BENCH_AR_HDR_SIZE + msize + (msize & 1)) {
+			msize = strtoul(&ch[48],0,10);
+
+			if (!strncmp(ch,"/ ",2))
+				continue;
+
+			if (!strncmp(ch,"// ",3)) {
+				lnames = &ch[BENCH_AR_HDR_SIZE];
+				continue;
+			}
+
+			if ((ch[0] == '/') && lnames) {
+				name = &lnames[strtoul(&ch[1],0,10)];
+				namelen = strchr(name,'/') - name;
+			} else {
+				name = ch;
+				namelen = strchr(name,'/') - name;
+			}
+
+			bench_nm_object(*parg,name,namelen,&ch[BENCH_AR_HDR_SIZE],msize);
+		}
+
+		free(data);
+	}
+
+	return 0;
+}
+
+static void bench_mkdir_p(char * path)
+{
+	char * ch;
+
+	for (ch=&path[1]; *ch; ch++) {
+		if (*ch == '/') {
+			*ch = 0;
+			mkdir(path,0755);
+			*ch = '/';
+		}
+	}
+
+	if (mkdir(path,0755) && (errno != EEXIST))
+		bench_die("cannot create directory %s",path);
+}
+
+/* install [-c] [-m mode] [-d] <src>... <dst> */
+static int bench_install(char ** argv)
+{
+	char **		parg;
+	char **		srcv;
+	char *		data;
+	char *		dst;
+	size_t		size;
+	int		nsrc;
+	int		fdir;
+	mode_t		mode;
+	struct stat	st;
+	char		path[4096];
+
+	mode = 0755;
+	fdir = 0;
+
+	for (parg=&argv[1]; *parg && ((*parg)[0] == '-'); parg++) {
+		if (!strcmp(*parg,"-d"))
+			fdir = 1;
+		else if (!strcmp(*parg,"-m") && parg[1])
+			mode = strtoul(*++parg,0,8);
+		else if ((!strcmp(*parg,"-o") || !strcmp(*parg,"-g")) && parg[1])
+			parg++;
+	}
+
+	if (fdir) {
+		for (; *parg; parg++)
+			bench_mkdir_p(*parg);
+
+		return 0;
+	}
+
+	for (srcv=parg, nsrc=0; parg[1]; parg++)
+		nsrc++;
+
+	if (!nsrc)
+		bench_die("%s","missing arguments");
+
+	dst  = *parg;
+	fdir = !stat(dst,&st) && S_ISDIR(st.st_mode);
+
+	for (; nsrc; nsrc--, srcv++) {
+		data = bench_read_file(*srcv,&size);
+
+		if (fdir)
+			snprintf(path,sizeof(path),"%s/%s",dst,bench_basename(*srcv));
+		else
+			snprintf(path,sizeof(path),"%s",dst);
+
+		bench_write_file(path,data,size,mode);
+		free(data);
+	}
+
+	return 0;
+}
+
+int main(int argc, char ** argv)
+{
+	const char * base;
+	const char * dash;
+
+	(void)argc;
+
+	bench_program = argv[0];
+	base = bench_basename(argv[0]);
+
+	/* <machine>-ar, <machine>-nm */
+	if ((dash = strrchr(base,'-')))
+		base = &dash[1];
+
+	if (!strcmp(base,"cc"))
+		return bench_cc(argv);
+
+	else if (!strcmp(base,"ar"))
+		return bench_ar(argv);
+
+	else if (!strcmp(base,"nm"))
+		return bench_nm(argv);
+
+	else if (!strcmp(base,"install"))
+		return bench_install(argv);
+
+	bench_die("%s: unknown tool name",base);
+
+	return 2;
+}
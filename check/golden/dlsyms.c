@@ -0,0 +1,951 @@
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Data Symbols: Common Section (libl01.expsyms.a) */
+extern char l01a_x_bss[];
+extern char l01a_x_common[];
+extern char l01b_x_bss[];
+extern char l01b_x_common[];
+extern char l01c_x_bss[];
+extern char l01c_x_common[];
+
+/* Data Symbols: Initialized Data (libl01.expsyms.a) */
+extern char l01a_x_data[];
+extern char l01a_x_ptr[];
+extern char l01b_x_data[];
+extern char l01b_x_ptr[];
+extern char l01c_x_data[];
+extern char l01c_x_ptr[];
+
+/* Data Symbols: Read-Only Section (libl01.expsyms.a) */
+extern char l01a_x_rodata[];
+extern char l01b_x_rodata[];
+extern char l01c_x_rodata[];
+
+/* Data Symbols: Weak Symbols (libl01.expsyms.a) */
+extern char l01a_x_weak[];
+extern char l01a_x_weakobj[];
+extern char l01b_x_weak[];
+extern char l01b_x_weakobj[];
+extern char l01c_x_weak[];
+extern char l01c_x_weakobj[];
+
+/* Text Section: Public Interfaces (libl01.expsyms.a) */
+extern int l01a_x_text();
+extern int l01b_x_text();
+extern int l01c_x_text();
+
+/* Data Symbols: Common Section (libl02.expsyms.a) */
+extern char l02a_xx_bss[];
+extern char l02a_xx_common[];
+extern char l02b_xx_bss[];
+extern char l02b_xx_common[];
+extern char l02c_xx_bss[];
+extern char l02c_xx_common[];
+
+/* Data Symbols: Initialized Data (libl02.expsyms.a) */
+extern char l02a_xx_data[];
+extern char l02a_xx_ptr[];
+extern char l02b_xx_data[];
+extern char l02b_xx_ptr[];
+extern char l02c_xx_data[];
+extern char l02c_xx_ptr[];
+
+/* Data Symbols: Read-Only Section (libl02.expsyms.a) */
+extern char l02a_xx_rodata[];
+extern char l02b_xx_rodata[];
+extern char l02c_xx_rodata[];
+
+/* Data Symbols: Weak Symbols (libl02.expsyms.a) */
+extern char l02a_xx_weak[];
+extern char l02a_xx_weakobj[];
+extern char l02b_xx_weak[];
+extern char l02b_xx_weakobj[];
+extern char l02c_xx_weak[];
+extern char l02c_xx_weakobj[];
+
+/* Text Section: Public Interfaces (libl02.expsyms.a) */
+extern int l02a_xx_text();
+extern int l02b_xx_text();
+extern int l02c_xx_text();
+
+/* Data Symbols: Common Section (libl03.expsyms.a) */
+extern char l03a_xxx_bss[];
+extern char l03a_xxx_common[];
+extern char l03b_xxx_bss[];
+extern char l03b_xxx_common[];
+extern char l03c_xxx_bss[];
+extern char l03c_xxx_common[];
+
+/* Data Symbols: Initialized Data (libl03.expsyms.a) */
+extern char l03a_xxx_data[];
+extern char l03a_xxx_ptr[];
+extern char l03b_xxx_data[];
+extern char l03b_xxx_ptr[];
+extern char l03c_xxx_data[];
+extern char l03c_xxx_ptr[];
+
+/* Data Symbols: Read-Only Section (libl03.expsyms.a) */
+extern char l03a_xxx_rodata[];
+extern char l03b_xxx_rodata[];
+extern char l03c_xxx_rodata[];
+
+/* Data Symbols: Weak Symbols (libl03.expsyms.a) */
+extern char l03a_xxx_weak[];
+extern char l03a_xxx_weakobj[];
+extern char l03b_xxx_weak[];
+extern char l03b_xxx_weakobj[];
+extern char l03c_xxx_weak[];
+extern char l03c_xxx_weakobj[];
+
+/* Text Section: Public Interfaces (libl03.expsyms.a) */
+extern int l03a_xxx_text();
+extern int l03b_xxx_text();
+extern int l03c_xxx_text();
+
+/* Data Symbols: Common Section (libl04.expsyms.a) */
+extern char l04a_xxxx_bss[];
+extern char l04a_xxxx_common[];
+extern char l04b_xxxx_bss[];
+extern char l04b_xxxx_common[];
+extern char l04c_xxxx_bss[];
+extern char l04c_xxxx_common[];
+
+/* Data Symbols: Initialized Data (libl04.expsyms.a) */
+extern char l04a_xxxx_data[];
+extern char l04a_xxxx_ptr[];
+extern char l04b_xxxx_data[];
+extern char l04b_xxxx_ptr[];
+extern char l04c_xxxx_data[];
+extern char l04c_xxxx_ptr[];
+
+/* Data Symbols: Read-Only Section (libl04.expsyms.a) */
+extern char l04a_xxxx_rodata[];
+extern char l04b_xxxx_rodata[];
+extern char l04c_xxxx_rodata[];
+
+/* Data Symbols: Weak Symbols (libl04.expsyms.a) */
+extern char l04a_xxxx_weak[];
+extern char l04a_xxxx_weakobj[];
+extern char l04b_xxxx_weak[];
+extern char l04b_xxxx_weakobj[];
+extern char l04c_xxxx_weak[];
+extern char l04c_xxxx_weakobj[];
+
+/* Text Section: Public Interfaces (libl04.expsyms.a) */
+extern int l04a_xxxx_text();
+extern int l04b_xxxx_text();
+extern int l04c_xxxx_text();
+
+/* Data Symbols: Common Section (libl05.expsyms.a) */
+extern char l05a_xxxxx_bss[];
+extern char l05a_xxxxx_common[];
+extern char l05b_xxxxx_bss[];
+extern char l05b_xxxxx_common[];
+extern char l05c_xxxxx_bss[];
+extern char l05c_xxxxx_common[];
+
+/* Data Symbols: Initialized Data (libl05.expsyms.a) */
+extern char l05a_xxxxx_data[];
+extern char l05a_xxxxx_ptr[];
+extern char l05b_xxxxx_data[];
+extern char l05b_xxxxx_ptr[];
+extern char l05c_xxxxx_data[];
+extern char l05c_xxxxx_ptr[];
+
+/* Data Symbols: Read-Only Section (libl05.expsyms.a) */
+extern char l05a_xxxxx_rodata[];
+extern char l05b_xxxxx_rodata[];
+extern char l05c_xxxxx_rodata[];
+
+/* Data Symbols: Weak Symbols (libl05.expsyms.a) */
+extern char l05a_xxxxx_weak[];
+extern char l05a_xxxxx_weakobj[];
+extern char l05b_xxxxx_weak[];
+extern char l05b_xxxxx_weakobj[];
+extern char l05c_xxxxx_weak[];
+extern char l05c_xxxxx_weakobj[];
+
+/* Text Section: Public Interfaces (libl05.expsyms.a) */
+extern int l05a_xxxxx_text();
+extern int l05b_xxxxx_text();
+extern int l05c_xxxxx_text();
+
+/* Data Symbols: Common Section (libl06.expsyms.a) */
+extern char l06a_xxxxxx_bss[];
+extern char l06a_xxxxxx_common[];
+extern char l06b_xxxxxx_bss[];
+extern char l06b_xxxxxx_common[];
+extern char l06c_xxxxxx_bss[];
+extern char l06c_xxxxxx_common[];
+
+/* Data Symbols: Initialized Data (libl06.expsyms.a) */
+extern char l06a_xxxxxx_data[];
+extern char l06a_xxxxxx_ptr[];
+extern char l06b_xxxxxx_data[];
+extern char l06b_xxxxxx_ptr[];
+extern char l06c_xxxxxx_data[];
+extern char l06c_xxxxxx_ptr[];
+
+/* Data Symbols: Read-Only Section (libl06.expsyms.a) */
+extern char l06a_xxxxxx_rodata[];
+extern char l06b_xxxxxx_rodata[];
+extern char l06c_xxxxxx_rodata[];
+
+/* Data Symbols: Weak Symbols (libl06.expsyms.a) */
+extern char l06a_xxxxxx_weak[];
+extern char l06a_xxxxxx_weakobj[];
+extern char l06b_xxxxxx_weak[];
+extern char l06b_xxxxxx_weakobj[];
+extern char l06c_xxxxxx_weak[];
+extern char l06c_xxxxxx_weakobj[];
+
+/* Text Section: Public Interfaces (libl06.expsyms.a) */
+extern int l06a_xxxxxx_text();
+extern int l06b_xxxxxx_text();
+extern int l06c_xxxxxx_text();
+
+/* Data Symbols: Common Section (libl07.expsyms.a) */
+extern char l07a_xxxxxxx_bss[];
+extern char l07a_xxxxxxx_common[];
+extern char l07b_xxxxxxx_bss[];
+extern char l07b_xxxxxxx_common[];
+extern char l07c_xxxxxxx_bss[];
+extern char l07c_xxxxxxx_common[];
+
+/* Data Symbols: Initialized Data (libl07.expsyms.a) */
+extern char l07a_xxxxxxx_data[];
+extern char l07a_xxxxxxx_ptr[];
+extern char l07b_xxxxxxx_data[];
+extern char l07b_xxxxxxx_ptr[];
+extern char l07c_xxxxxxx_data[];
+extern char l07c_xxxxxxx_ptr[];
+
+/* Data Symbols: Read-Only Section (libl07.expsyms.a) */
+extern char l07a_xxxxxxx_rodata[];
+extern char l07b_xxxxxxx_rodata[];
+extern char l07c_xxxxxxx_rodata[];
+
+/* Data Symbols: Weak Symbols (libl07.expsyms.a) */
+extern char l07a_xxxxxxx_weak[];
+extern char l07a_xxxxxxx_weakobj[];
+extern char l07b_xxxxxxx_weak[];
+extern char l07b_xxxxxxx_weakobj[];
+extern char l07c_xxxxxxx_weak[];
+extern char l07c_xxxxxxx_weakobj[];
+
+/* Text Section: Public Interfaces (libl07.expsyms.a) */
+extern int l07a_xxxxxxx_text();
+extern int l07b_xxxxxxx_text();
+extern int l07c_xxxxxxx_text();
+
+/* Data Symbols: Common Section (libl08.expsyms.a) */
+extern char l08a_xxxxxxxx_bss[];
+extern char l08a_xxxxxxxx_common[];
+extern char l08b_xxxxxxxx_bss[];
+extern char l08b_xxxxxxxx_common[];
+extern char l08c_xxxxxxxx_bss[];
+extern char l08c_xxxxxxxx_common[];
+
+/* Data Symbols: Initialized Data (libl08.expsyms.a) */
+extern char l08a_xxxxxxxx_data[];
+extern char l08a_xxxxxxxx_ptr[];
+extern char l08b_xxxxxxxx_data[];
+extern char l08b_xxxxxxxx_ptr[];
+extern char l08c_xxxxxxxx_data[];
+extern char l08c_xxxxxxxx_ptr[];
+
+/* Data Symbols: Read-Only Section (libl08.expsyms.a) */
+extern char l08a_xxxxxxxx_rodata[];
+extern char l08b_xxxxxxxx_rodata[];
+extern char l08c_xxxxxxxx_rodata[];
+
+/* Data Symbols: Weak Symbols (libl08.expsyms.a) */
+extern char l08a_xxxxxxxx_weak[];
+extern char l08a_xxxxxxxx_weakobj[];
+extern char l08b_xxxxxxxx_weak[];
+extern char l08b_xxxxxxxx_weakobj[];
+extern char l08c_xxxxxxxx_weak[];
+extern char l08c_xxxxxxxx_weakobj[];
+
+/* Text Section: Public Interfaces (libl08.expsyms.a) */
+extern int l08a_xxxxxxxx_text();
+extern int l08b_xxxxxxxx_text();
+extern int l08c_xxxxxxxx_text();
+
+/* Data Symbols: Common Section (libl09.expsyms.a) */
+extern char l09a_xxxxxxxxx_bss[];
+extern char l09a_xxxxxxxxx_common[];
+extern char l09b_xxxxxxxxx_bss[];
+extern char l09b_xxxxxxxxx_common[];
+extern char l09c_xxxxxxxxx_bss[];
+extern char l09c_xxxxxxxxx_common[];
+
+/* Data Symbols: Initialized Data (libl09.expsyms.a) */
+extern char l09a_xxxxxxxxx_data[];
+extern char l09a_xxxxxxxxx_ptr[];
+extern char l09b_xxxxxxxxx_data[];
+extern char l09b_xxxxxxxxx_ptr[];
+extern char l09c_xxxxxxxxx_data[];
+extern char l09c_xxxxxxxxx_ptr[];
+
+/* Data Symbols: Read-Only Section (libl09.expsyms.a) */
+extern char l09a_xxxxxxxxx_rodata[];
+extern char l09b_xxxxxxxxx_rodata[];
+extern char l09c_xxxxxxxxx_rodata[];
+
+/* Data Symbols: Weak Symbols (libl09.expsyms.a) */
+extern char l09a_xxxxxxxxx_weak[];
+extern char l09a_xxxxxxxxx_weakobj[];
+extern char l09b_xxxxxxxxx_weak[];
+extern char l09b_xxxxxxxxx_weakobj[];
+extern char l09c_xxxxxxxxx_weak[];
+extern char l09c_xxxxxxxxx_weakobj[];
+
+/* Text Section: Public Interfaces (libl09.expsyms.a) */
+extern int l09a_xxxxxxxxx_text();
+extern int l09b_xxxxxxxxx_text();
+extern int l09c_xxxxxxxxx_text();
+
+/* Data Symbols: Common Section (libl10.expsyms.a) */
+extern char l10a_xxxxxxxxxx_bss[];
+extern char l10a_xxxxxxxxxx_common[];
+extern char l10b_xxxxxxxxxx_bss[];
+extern char l10b_xxxxxxxxxx_common[];
+extern char l10c_xxxxxxxxxx_bss[];
+extern char l10c_xxxxxxxxxx_common[];
+
+/* Data Symbols: Initialized Data (libl10.expsyms.a) */
+extern char l10a_xxxxxxxxxx_data[];
+extern char l10a_xxxxxxxxxx_ptr[];
+extern char l10b_xxxxxxxxxx_data[];
+extern char l10b_xxxxxxxxxx_ptr[];
+extern char l10c_xxxxxxxxxx_data[];
+extern char l10c_xxxxxxxxxx_ptr[];
+
+/* Data Symbols: Read-Only Section (libl10.expsyms.a) */
+extern char l10a_xxxxxxxxxx_rodata[];
+extern char l10b_xxxxxxxxxx_rodata[];
+extern char l10c_xxxxxxxxxx_rodata[];
+
+/* Data Symbols: Weak Symbols (libl10.expsyms.a) */
+extern char l10a_xxxxxxxxxx_weak[];
+extern char l10a_xxxxxxxxxx_weakobj[];
+extern char l10b_xxxxxxxxxx_weak[];
+extern char l10b_xxxxxxxxxx_weakobj[];
+extern char l10c_xxxxxxxxxx_weak[];
+extern char l10c_xxxxxxxxxx_weakobj[];
+
+/* Text Section: Public Interfaces (libl10.expsyms.a) */
+extern int l10a_xxxxxxxxxx_text();
+extern int l10b_xxxxxxxxxx_text();
+extern int l10c_xxxxxxxxxx_text();
+
+/* Data Symbols: Common Section (libl11.expsyms.a) */
+extern char l11a_xxxxxxxxxxx_bss[];
+extern char l11a_xxxxxxxxxxx_common[];
+extern char l11b_xxxxxxxxxxx_bss[];
+extern char l11b_xxxxxxxxxxx_common[];
+extern char l11c_xxxxxxxxxxx_bss[];
+extern char l11c_xxxxxxxxxxx_common[];
+
+/* Data Symbols: Initialized Data (libl11.expsyms.a) */
+extern char l11a_xxxxxxxxxxx_data[];
+extern char l11a_xxxxxxxxxxx_ptr[];
+extern char l11b_xxxxxxxxxxx_data[];
+extern char l11b_xxxxxxxxxxx_ptr[];
+extern char l11c_xxxxxxxxxxx_data[];
+extern char l11c_xxxxxxxxxxx_ptr[];
+
+/* Data Symbols: Read-Only Section (libl11.expsyms.a) */
+extern char l11a_xxxxxxxxxxx_rodata[];
+extern char l11b_xxxxxxxxxxx_rodata[];
+extern char l11c_xxxxxxxxxxx_rodata[];
+
+/* Data Symbols: Weak Symbols (libl11.expsyms.a) */
+extern char l11a_xxxxxxxxxxx_weak[];
+extern char l11a_xxxxxxxxxxx_weakobj[];
+extern char l11b_xxxxxxxxxxx_weak[];
+extern char l11b_xxxxxxxxxxx_weakobj[];
+extern char l11c_xxxxxxxxxxx_weak[];
+extern char l11c_xxxxxxxxxxx_weakobj[];
+
+/* Text Section: Public Interfaces (libl11.expsyms.a) */
+extern int l11a_xxxxxxxxxxx_text();
+extern int l11b_xxxxxxxxxxx_text();
+extern int l11c_xxxxxxxxxxx_text();
+
+/* Data Symbols: Common Section (libl12.expsyms.a) */
+extern char l12a_xxxxxxxxxxxx_bss[];
+extern char l12a_xxxxxxxxxxxx_common[];
+extern char l12b_xxxxxxxxxxxx_bss[];
+extern char l12b_xxxxxxxxxxxx_common[];
+extern char l12c_xxxxxxxxxxxx_bss[];
+extern char l12c_xxxxxxxxxxxx_common[];
+
+/* Data Symbols: Initialized Data (libl12.expsyms.a) */
+extern char l12a_xxxxxxxxxxxx_data[];
+extern char l12a_xxxxxxxxxxxx_ptr[];
+extern char l12b_xxxxxxxxxxxx_data[];
+extern char l12b_xxxxxxxxxxxx_ptr[];
+extern char l12c_xxxxxxxxxxxx_data[];
+extern char l12c_xxxxxxxxxxxx_ptr[];
+
+/* Data Symbols: Read-Only Section (libl12.expsyms.a) */
+extern char l12a_xxxxxxxxxxxx_rodata[];
+extern char l12b_xxxxxxxxxxxx_rodata[];
+extern char l12c_xxxxxxxxxxxx_rodata[];
+
+/* Data Symbols: Weak Symbols (libl12.expsyms.a) */
+extern char l12a_xxxxxxxxxxxx_weak[];
+extern char l12a_xxxxxxxxxxxx_weakobj[];
+extern char l12b_xxxxxxxxxxxx_weak[];
+extern char l12b_xxxxxxxxxxxx_weakobj[];
+extern char l12c_xxxxxxxxxxxx_weak[];
+extern char l12c_xxxxxxxxxxxx_weakobj[];
+
+/* Text Section: Public Interfaces (libl12.expsyms.a) */
+extern int l12a_xxxxxxxxxxxx_text();
+extern int l12b_xxxxxxxxxxxx_text();
+extern int l12c_xxxxxxxxxxxx_text();
+
+/* Data Symbols: Common Section (libl13.expsyms.a) */
+extern char l13a_xxxxxxxxxxxxx_bss[];
+extern char l13a_xxxxxxxxxxxxx_common[];
+extern char l13b_xxxxxxxxxxxxx_bss[];
+extern char l13b_xxxxxxxxxxxxx_common[];
+extern char l13c_xxxxxxxxxxxxx_bss[];
+extern char l13c_xxxxxxxxxxxxx_common[];
+
+/* Data Symbols: Initialized Data (libl13.expsyms.a) */
+extern char l13a_xxxxxxxxxxxxx_data[];
+extern char l13a_xxxxxxxxxxxxx_ptr[];
+extern char l13b_xxxxxxxxxxxxx_data[];
+extern char l13b_xxxxxxxxxxxxx_ptr[];
+extern char l13c_xxxxxxxxxxxxx_data[];
+extern char l13c_xxxxxxxxxxxxx_ptr[];
+
+/* Data Symbols: Read-Only Section (libl13.expsyms.a) */
+extern char l13a_xxxxxxxxxxxxx_rodata[];
+extern char l13b_xxxxxxxxxxxxx_rodata[];
+extern char l13c_xxxxxxxxxxxxx_rodata[];
+
+/* Data Symbols: Weak Symbols (libl13.expsyms.a) */
+extern char l13a_xxxxxxxxxxxxx_weak[];
+extern char l13a_xxxxxxxxxxxxx_weakobj[];
+extern char l13b_xxxxxxxxxxxxx_weak[];
+extern char l13b_xxxxxxxxxxxxx_weakobj[];
+extern char l13c_xxxxxxxxxxxxx_weak[];
+extern char l13c_xxxxxxxxxxxxx_weakobj[];
+
+/* Text Section: Public Interfaces (libl13.expsyms.a) */
+extern int l13a_xxxxxxxxxxxxx_text();
+extern int l13b_xxxxxxxxxxxxx_text();
+extern int l13c_xxxxxxxxxxxxx_text();
+
+/* Data Symbols: Common Section (libl14.expsyms.a) */
+extern char l14a_xxxxxxxxxxxxxx_bss[];
+extern char l14a_xxxxxxxxxxxxxx_common[];
+extern char l14b_xxxxxxxxxxxxxx_bss[];
+extern char l14b_xxxxxxxxxxxxxx_common[];
+extern char l14c_xxxxxxxxxxxxxx_bss[];
+extern char l14c_xxxxxxxxxxxxxx_common[];
+
+/* Data Symbols: Initialized Data (libl14.expsyms.a) */
+extern char l14a_xxxxxxxxxxxxxx_data[];
+extern char l14a_xxxxxxxxxxxxxx_ptr[];
+extern char l14b_xxxxxxxxxxxxxx_data[];
+extern char l14b_xxxxxxxxxxxxxx_ptr[];
+extern char l14c_xxxxxxxxxxxxxx_data[];
+extern char l14c_xxxxxxxxxxxxxx_ptr[];
+
+/* Data Symbols: Read-Only Section (libl14.expsyms.a) */
+extern char l14a_xxxxxxxxxxxxxx_rodata[];
+extern char l14b_xxxxxxxxxxxxxx_rodata[];
+extern char l14c_xxxxxxxxxxxxxx_rodata[];
+
+/* Data Symbols: Weak Symbols (libl14.expsyms.a) */
+extern char l14a_xxxxxxxxxxxxxx_weak[];
+extern char l14a_xxxxxxxxxxxxxx_weakobj[];
+extern char l14b_xxxxxxxxxxxxxx_weak[];
+extern char l14b_xxxxxxxxxxxxxx_weakobj[];
+extern char l14c_xxxxxxxxxxxxxx_weak[];
+extern char l14c_xxxxxxxxxxxxxx_weakobj[];
+
+/* Text Section: Public Interfaces (libl14.expsyms.a) */
+extern int l14a_xxxxxxxxxxxxxx_text();
+extern int l14b_xxxxxxxxxxxxxx_text();
+extern int l14c_xxxxxxxxxxxxxx_text();
+
+/* Data Symbols: Common Section (libl15.expsyms.a) */
+extern char l15a_xxxxxxxxxxxxxxx_bss[];
+extern char l15a_xxxxxxxxxxxxxxx_common[];
+extern char l15b_xxxxxxxxxxxxxxx_bss[];
+extern char l15b_xxxxxxxxxxxxxxx_common[];
+extern char l15c_xxxxxxxxxxxxxxx_bss[];
+extern char l15c_xxxxxxxxxxxxxxx_common[];
+
+/* Data Symbols: Initialized Data (libl15.expsyms.a) */
+extern char l15a_xxxxxxxxxxxxxxx_data[];
+extern char l15a_xxxxxxxxxxxxxxx_ptr[];
+extern char l15b_xxxxxxxxxxxxxxx_data[];
+extern char l15b_xxxxxxxxxxxxxxx_ptr[];
+extern char l15c_xxxxxxxxxxxxxxx_data[];
+extern char l15c_xxxxxxxxxxxxxxx_ptr[];
+
+/* Data Symbols: Read-Only Section (libl15.expsyms.a) */
+extern char l15a_xxxxxxxxxxxxxxx_rodata[];
+extern char l15b_xxxxxxxxxxxxxxx_rodata[];
+extern char l15c_xxxxxxxxxxxxxxx_rodata[];
+
+/* Data Symbols: Weak Symbols (libl15.expsyms.a) */
+extern char l15a_xxxxxxxxxxxxxxx_weak[];
+extern char l15a_xxxxxxxxxxxxxxx_weakobj[];
+extern char l15b_xxxxxxxxxxxxxxx_weak[];
+extern char l15b_xxxxxxxxxxxxxxx_weakobj[];
+extern char l15c_xxxxxxxxxxxxxxx_weak[];
+extern char l15c_xxxxxxxxxxxxxxx_weakobj[];
+
+/* Text Section: Public Interfaces (libl15.expsyms.a) */
+extern int l15a_xxxxxxxxxxxxxxx_text();
+extern int l15b_xxxxxxxxxxxxxxx_text();
+extern int l15c_xxxxxxxxxxxxxxx_text();
+
+/* Data Symbols: Common Section (libl16.expsyms.a) */
+extern char l16a_xxxxxxxxxxxxxxxx_bss[];
+extern char l16a_xxxxxxxxxxxxxxxx_common[];
+extern char l16b_xxxxxxxxxxxxxxxx_bss[];
+extern char l16b_xxxxxxxxxxxxxxxx_common[];
+extern char l16c_xxxxxxxxxxxxxxxx_bss[];
+extern char l16c_xxxxxxxxxxxxxxxx_common[];
+
+/* Data Symbols: Initialized Data (libl16.expsyms.a) */
+extern char l16a_xxxxxxxxxxxxxxxx_data[];
+extern char l16a_xxxxxxxxxxxxxxxx_ptr[];
+extern char l16b_xxxxxxxxxxxxxxxx_data[];
+extern char l16b_xxxxxxxxxxxxxxxx_ptr[];
+extern char l16c_xxxxxxxxxxxxxxxx_data[];
+extern char l16c_xxxxxxxxxxxxxxxx_ptr[];
+
+/* Data Symbols: Read-Only Section (libl16.expsyms.a) */
+extern char l16a_xxxxxxxxxxxxxxxx_rodata[];
+extern char l16b_xxxxxxxxxxxxxxxx_rodata[];
+extern char l16c_xxxxxxxxxxxxxxxx_rodata[];
+
+/* Data Symbols: Weak Symbols (libl16.expsyms.a) */
+extern char l16a_xxxxxxxxxxxxxxxx_weak[];
+extern char l16a_xxxxxxxxxxxxxxxx_weakobj[];
+extern char l16b_xxxxxxxxxxxxxxxx_weak[];
+extern char l16b_xxxxxxxxxxxxxxxx_weakobj[];
+extern char l16c_xxxxxxxxxxxxxxxx_weak[];
+extern char l16c_xxxxxxxxxxxxxxxx_weakobj[];
+
+/* Text Section: Public Interfaces (libl16.expsyms.a) */
+extern int l16a_xxxxxxxxxxxxxxxx_text();
+extern int l16b_xxxxxxxxxxxxxxxx_text();
+extern int l16c_xxxxxxxxxxxxxxxx_text();
+
+/* name-address Public ABI struct definition */
+struct lt_dlsym_symdef {
+	const char *   dlsym_name;
+	void *         dlsym_addr;
+};
+
+/* dlsym vtable */
+extern const struct lt_dlsym_symdef lt__PROGRAM__LTX_preloaded_symbols[];
+
+const struct lt_dlsym_symdef lt__PROGRAM__LTX_preloaded_symbols[] = {
+	{"@PROGRAM@",                     0},
+
+	{"libl01.expsyms.a",              0},
+
+	{"l01a_x_bss",                    l01a_x_bss},
+	{"l01a_x_common",                 l01a_x_common},
+	{"l01b_x_bss",                    l01b_x_bss},
+	{"l01b_x_common",                 l01b_x_common},
+	{"l01c_x_bss",                    l01c_x_bss},
+	{"l01c_x_common",                 l01c_x_common},
+
+	{"l01a_x_data",                   l01a_x_data},
+	{"l01a_x_ptr",                    l01a_x_ptr},
+	{"l01b_x_data",                   l01b_x_data},
+	{"l01b_x_ptr",                    l01b_x_ptr},
+	{"l01c_x_data",                   l01c_x_data},
+	{"l01c_x_ptr",                    l01c_x_ptr},
+
+	{"l01a_x_rodata",                 l01a_x_rodata},
+	{"l01b_x_rodata",                 l01b_x_rodata},
+	{"l01c_x_rodata",                 l01c_x_rodata},
+
+	{"l01a_x_text",                   &l01a_x_text},
+	{"l01b_x_text",                   &l01b_x_text},
+	{"l01c_x_text",                   &l01c_x_text},
+
+	{"libl02.expsyms.a",              0},
+
+	{"l02a_xx_bss",                   l02a_xx_bss},
+	{"l02a_xx_common",                l02a_xx_common},
+	{"l02b_xx_bss",                   l02b_xx_bss},
+	{"l02b_xx_common",                l02b_xx_common},
+	{"l02c_xx_bss",                   l02c_xx_bss},
+	{"l02c_xx_common",                l02c_xx_common},
+
+	{"l02a_xx_data",                  l02a_xx_data},
+	{"l02a_xx_ptr",                   l02a_xx_ptr},
+	{"l02b_xx_data",                  l02b_xx_data},
+	{"l02b_xx_ptr",                   l02b_xx_ptr},
+	{"l02c_xx_data",                  l02c_xx_data},
+	{"l02c_xx_ptr",                   l02c_xx_ptr},
+
+	{"l02a_xx_rodata",                l02a_xx_rodata},
+	{"l02b_xx_rodata",                l02b_xx_rodata},
+	{"l02c_xx_rodata",                l02c_xx_rodata},
+
+	{"l02a_xx_text",                  &l02a_xx_text},
+	{"l02b_xx_text",                  &l02b_xx_text},
+	{"l02c_xx_text",                  &l02c_xx_text},
+
+	{"libl03.expsyms.a",              0},
+
+	{"l03a_xxx_bss",                  l03a_xxx_bss},
+	{"l03a_xxx_common",               l03a_xxx_common},
+	{"l03b_xxx_bss",                  l03b_xxx_bss},
+	{"l03b_xxx_common",               l03b_xxx_common},
+	{"l03c_xxx_bss",                  l03c_xxx_bss},
+	{"l03c_xxx_common",               l03c_xxx_common},
+
+	{"l03a_xxx_data",                 l03a_xxx_data},
+	{"l03a_xxx_ptr",                  l03a_xxx_ptr},
+	{"l03b_xxx_data",                 l03b_xxx_data},
+	{"l03b_xxx_ptr",                  l03b_xxx_ptr},
+	{"l03c_xxx_data",                 l03c_xxx_data},
+	{"l03c_xxx_ptr",                  l03c_xxx_ptr},
+
+	{"l03a_xxx_rodata",               l03a_xxx_rodata},
+	{"l03b_xxx_rodata",               l03b_xxx_rodata},
+	{"l03c_xxx_rodata",               l03c_xxx_rodata},
+
+	{"l03a_xxx_text",                 &l03a_xxx_text},
+	{"l03b_xxx_text",                 &l03b_xxx_text},
+	{"l03c_xxx_text",                 &l03c_xxx_text},
+
+	{"libl04.expsyms.a",              0},
+
+	{"l04a_xxxx_bss",                 l04a_xxxx_bss},
+	{"l04a_xxxx_common",              l04a_xxxx_common},
+	{"l04b_xxxx_bss",                 l04b_xxxx_bss},
+	{"l04b_xxxx_common",              l04b_xxxx_common},
+	{"l04c_xxxx_bss",                 l04c_xxxx_bss},
+	{"l04c_xxxx_common",              l04c_xxxx_common},
+
+	{"l04a_xxxx_data",                l04a_xxxx_data},
+	{"l04a_xxxx_ptr",                 l04a_xxxx_ptr},
+	{"l04b_xxxx_data",                l04b_xxxx_data},
+	{"l04b_xxxx_ptr",                 l04b_xxxx_ptr},
+	{"l04c_xxxx_data",                l04c_xxxx_data},
+	{"l04c_xxxx_ptr",                 l04c_xxxx_ptr},
+
+	{"l04a_xxxx_rodata",              l04a_xxxx_rodata},
+	{"l04b_xxxx_rodata",              l04b_xxxx_rodata},
+	{"l04c_xxxx_rodata",              l04c_xxxx_rodata},
+
+	{"l04a_xxxx_text",                &l04a_xxxx_text},
+	{"l04b_xxxx_text",                &l04b_xxxx_text},
+	{"l04c_xxxx_text",                &l04c_xxxx_text},
+
+	{"libl05.expsyms.a",              0},
+
+	{"l05a_xxxxx_bss",                l05a_xxxxx_bss},
+	{"l05a_xxxxx_common",             l05a_xxxxx_common},
+	{"l05b_xxxxx_bss",                l05b_xxxxx_bss},
+	{"l05b_xxxxx_common",             l05b_xxxxx_common},
+	{"l05c_xxxxx_bss",                l05c_xxxxx_bss},
+	{"l05c_xxxxx_common",             l05c_xxxxx_common},
+
+	{"l05a_xxxxx_data",               l05a_xxxxx_data},
+	{"l05a_xxxxx_ptr",                l05a_xxxxx_ptr},
+	{"l05b_xxxxx_data",               l05b_xxxxx_data},
+	{"l05b_xxxxx_ptr",                l05b_xxxxx_ptr},
+	{"l05c_xxxxx_data",               l05c_xxxxx_data},
+	{"l05c_xxxxx_ptr",                l05c_xxxxx_ptr},
+
+	{"l05a_xxxxx_rodata",             l05a_xxxxx_rodata},
+	{"l05b_xxxxx_rodata",             l05b_xxxxx_rodata},
+	{"l05c_xxxxx_rodata",             l05c_xxxxx_rodata},
+
+	{"l05a_xxxxx_text",               &l05a_xxxxx_text},
+	{"l05b_xxxxx_text",               &l05b_xxxxx_text},
+	{"l05c_xxxxx_text",               &l05c_xxxxx_text},
+
+	{"libl06.expsyms.a",              0},
+
+	{"l06a_xxxxxx_bss",               l06a_xxxxxx_bss},
+	{"l06a_xxxxxx_common",            l06a_xxxxxx_common},
+	{"l06b_xxxxxx_bss",               l06b_xxxxxx_bss},
+	{"l06b_xxxxxx_common",            l06b_xxxxxx_common},
+	{"l06c_xxxxxx_bss",               l06c_xxxxxx_bss},
+	{"l06c_xxxxxx_common",            l06c_xxxxxx_common},
+
+	{"l06a_xxxxxx_data",              l06a_xxxxxx_data},
+	{"l06a_xxxxxx_ptr",               l06a_xxxxxx_ptr},
+	{"l06b_xxxxxx_data",              l06b_xxxxxx_data},
+	{"l06b_xxxxxx_ptr",               l06b_xxxxxx_ptr},
+	{"l06c_xxxxxx_data",              l06c_xxxxxx_data},
+	{"l06c_xxxxxx_ptr",               l06c_xxxxxx_ptr},
+
+	{"l06a_xxxxxx_rodata",            l06a_xxxxxx_rodata},
+	{"l06b_xxxxxx_rodata",            l06b_xxxxxx_rodata},
+	{"l06c_xxxxxx_rodata",            l06c_xxxxxx_rodata},
+
+	{"l06a_xxxxxx_text",              &l06a_xxxxxx_text},
+	{"l06b_xxxxxx_text",              &l06b_xxxxxx_text},
+	{"l06c_xxxxxx_text",              &l06c_xxxxxx_text},
+
+	{"libl07.expsyms.a",              0},
+
+	{"l07a_xxxxxxx_bss",              l07a_xxxxxxx_bss},
+	{"l07a_xxxxxxx_common",           l07a_xxxxxxx_common},
+	{"l07b_xxxxxxx_bss",              l07b_xxxxxxx_bss},
+	{"l07b_xxxxxxx_common",           l07b_xxxxxxx_common},
+	{"l07c_xxxxxxx_bss",              l07c_xxxxxxx_bss},
+	{"l07c_xxxxxxx_common",           l07c_xxxxxxx_common},
+
+	{"l07a_xxxxxxx_data",             l07a_xxxxxxx_data},
+	{"l07a_xxxxxxx_ptr",              l07a_xxxxxxx_ptr},
+	{"l07b_xxxxxxx_data",             l07b_xxxxxxx_data},
+	{"l07b_xxxxxxx_ptr",              l07b_xxxxxxx_ptr},
+	{"l07c_xxxxxxx_data",             l07c_xxxxxxx_data},
+	{"l07c_xxxxxxx_ptr",              l07c_xxxxxxx_ptr},
+
+	{"l07a_xxxxxxx_rodata",           l07a_xxxxxxx_rodata},
+	{"l07b_xxxxxxx_rodata",           l07b_xxxxxxx_rodata},
+	{"l07c_xxxxxxx_rodata",           l07c_xxxxxxx_rodata},
+
+	{"l07a_xxxxxxx_text",             &l07a_xxxxxxx_text},
+	{"l07b_xxxxxxx_text",             &l07b_xxxxxxx_text},
+	{"l07c_xxxxxxx_text",             &l07c_xxxxxxx_text},
+
+	{"libl08.expsyms.a",              0},
+
+	{"l08a_xxxxxxxx_bss",             l08a_xxxxxxxx_bss},
+	{"l08a_xxxxxxxx_common",          l08a_xxxxxxxx_common},
+	{"l08b_xxxxxxxx_bss",             l08b_xxxxxxxx_bss},
+	{"l08b_xxxxxxxx_common",          l08b_xxxxxxxx_common},
+	{"l08c_xxxxxxxx_bss",             l08c_xxxxxxxx_bss},
+	{"l08c_xxxxxxxx_common",          l08c_xxxxxxxx_common},
+
+	{"l08a_xxxxxxxx_data",            l08a_xxxxxxxx_data},
+	{"l08a_xxxxxxxx_ptr",             l08a_xxxxxxxx_ptr},
+	{"l08b_xxxxxxxx_data",            l08b_xxxxxxxx_data},
+	{"l08b_xxxxxxxx_ptr",             l08b_xxxxxxxx_ptr},
+	{"l08c_xxxxxxxx_data",            l08c_xxxxxxxx_data},
+	{"l08c_xxxxxxxx_ptr",             l08c_xxxxxxxx_ptr},
+
+	{"l08a_xxxxxxxx_rodata",          l08a_xxxxxxxx_rodata},
+	{"l08b_xxxxxxxx_rodata",          l08b_xxxxxxxx_rodata},
+	{"l08c_xxxxxxxx_rodata",          l08c_xxxxxxxx_rodata},
+
+	{"l08a_xxxxxxxx_text",            &l08a_xxxxxxxx_text},
+	{"l08b_xxxxxxxx_text",            &l08b_xxxxxxxx_text},
+	{"l08c_xxxxxxxx_text",            &l08c_xxxxxxxx_text},
+
+	{"libl09.expsyms.a",              0},
+
+	{"l09a_xxxxxxxxx_bss",            l09a_xxxxxxxxx_bss},
+	{"l09a_xxxxxxxxx_common",         l09a_xxxxxxxxx_common},
+	{"l09b_xxxxxxxxx_bss",            l09b_xxxxxxxxx_bss},
+	{"l09b_xxxxxxxxx_common",         l09b_xxxxxxxxx_common},
+	{"l09c_xxxxxxxxx_bss",            l09c_xxxxxxxxx_bss},
+	{"l09c_xxxxxxxxx_common",         l09c_xxxxxxxxx_common},
+
+	{"l09a_xxxxxxxxx_data",           l09a_xxxxxxxxx_data},
+	{"l09a_xxxxxxxxx_ptr",            l09a_xxxxxxxxx_ptr},
+	{"l09b_xxxxxxxxx_data",           l09b_xxxxxxxxx_data},
+	{"l09b_xxxxxxxxx_ptr",            l09b_xxxxxxxxx_ptr},
+	{"l09c_xxxxxxxxx_data",           l09c_xxxxxxxxx_data},
+	{"l09c_xxxxxxxxx_ptr",            l09c_xxxxxxxxx_ptr},
+
+	{"l09a_xxxxxxxxx_rodata",         l09a_xxxxxxxxx_rodata},
+	{"l09b_xxxxxxxxx_rodata",         l09b_xxxxxxxxx_rodata},
+	{"l09c_xxxxxxxxx_rodata",         l09c_xxxxxxxxx_rodata},
+
+	{"l09a_xxxxxxxxx_text",           &l09a_xxxxxxxxx_text},
+	{"l09b_xxxxxxxxx_text",           &l09b_xxxxxxxxx_text},
+	{"l09c_xxxxxxxxx_text",           &l09c_xxxxxxxxx_text},
+
+	{"libl10.expsyms.a",              0},
+
+	{"l10a_xxxxxxxxxx_bss",           l10a_xxxxxxxxxx_bss},
+	{"l10a_xxxxxxxxxx_common",        l10a_xxxxxxxxxx_common},
+	{"l10b_xxxxxxxxxx_bss",           l10b_xxxxxxxxxx_bss},
+	{"l10b_xxxxxxxxxx_common",        l10b_xxxxxxxxxx_common},
+	{"l10c_xxxxxxxxxx_bss",           l10c_xxxxxxxxxx_bss},
+	{"l10c_xxxxxxxxxx_common",        l10c_xxxxxxxxxx_common},
+
+	{"l10a_xxxxxxxxxx_data",          l10a_xxxxxxxxxx_data},
+	{"l10a_xxxxxxxxxx_ptr",           l10a_xxxxxxxxxx_ptr},
+	{"l10b_xxxxxxxxxx_data",          l10b_xxxxxxxxxx_data},
+	{"l10b_xxxxxxxxxx_ptr",           l10b_xxxxxxxxxx_ptr},
+	{"l10c_xxxxxxxxxx_data",          l10c_xxxxxxxxxx_data},
+	{"l10c_xxxxxxxxxx_ptr",           l10c_xxxxxxxxxx_ptr},
+
+	{"l10a_xxxxxxxxxx_rodata",        l10a_xxxxxxxxxx_rodata},
+	{"l10b_xxxxxxxxxx_rodata",        l10b_xxxxxxxxxx_rodata},
+	{"l10c_xxxxxxxxxx_rodata",        l10c_xxxxxxxxxx_rodata},
+
+	{"l10a_xxxxxxxxxx_text",          &l10a_xxxxxxxxxx_text},
+	{"l10b_xxxxxxxxxx_text",          &l10b_xxxxxxxxxx_text},
+	{"l10c_xxxxxxxxxx_text",          &l10c_xxxxxxxxxx_text},
+
+	{"libl11.expsyms.a",              0},
+
+	{"l11a_xxxxxxxxxxx_bss",          l11a_xxxxxxxxxxx_bss},
+	{"l11a_xxxxxxxxxxx_common",       l11a_xxxxxxxxxxx_common},
+	{"l11b_xxxxxxxxxxx_bss",          l11b_xxxxxxxxxxx_bss},
+	{"l11b_xxxxxxxxxxx_common",       l11b_xxxxxxxxxxx_common},
+	{"l11c_xxxxxxxxxxx_bss",          l11c_xxxxxxxxxxx_bss},
+	{"l11c_xxxxxxxxxxx_common",       l11c_xxxxxxxxxxx_common},
+
+	{"l11a_xxxxxxxxxxx_data",         l11a_xxxxxxxxxxx_data},
+	{"l11a_xxxxxxxxxxx_ptr",          l11a_xxxxxxxxxxx_ptr},
+	{"l11b_xxxxxxxxxxx_data",         l11b_xxxxxxxxxxx_data},
+	{"l11b_xxxxxxxxxxx_ptr",          l11b_xxxxxxxxxxx_ptr},
+	{"l11c_xxxxxxxxxxx_data",         l11c_xxxxxxxxxxx_data},
+	{"l11c_xxxxxxxxxxx_ptr",          l11c_xxxxxxxxxxx_ptr},
+
+	{"l11a_xxxxxxxxxxx_rodata",       l11a_xxxxxxxxxxx_rodata},
+	{"l11b_xxxxxxxxxxx_rodata",       l11b_xxxxxxxxxxx_rodata},
+	{"l11c_xxxxxxxxxxx_rodata",       l11c_xxxxxxxxxxx_rodata},
+
+	{"l11a_xxxxxxxxxxx_text",         &l11a_xxxxxxxxxxx_text},
+	{"l11b_xxxxxxxxxxx_text",         &l11b_xxxxxxxxxxx_text},
+	{"l11c_xxxxxxxxxxx_text",         &l11c_xxxxxxxxxxx_text},
+
+	{"libl12.expsyms.a",              0},
+
+	{"l12a_xxxxxxxxxxxx_bss",         l12a_xxxxxxxxxxxx_bss},
+	{"l12a_xxxxxxxxxxxx_common",      l12a_xxxxxxxxxxxx_common},
+	{"l12b_xxxxxxxxxxxx_bss",         l12b_xxxxxxxxxxxx_bss},
+	{"l12b_xxxxxxxxxxxx_common",      l12b_xxxxxxxxxxxx_common},
+	{"l12c_xxxxxxxxxxxx_bss",         l12c_xxxxxxxxxxxx_bss},
+	{"l12c_xxxxxxxxxxxx_common",      l12c_xxxxxxxxxxxx_common},
+
+	{"l12a_xxxxxxxxxxxx_data",        l12a_xxxxxxxxxxxx_data},
+	{"l12a_xxxxxxxxxxxx_ptr",         l12a_xxxxxxxxxxxx_ptr},
+	{"l12b_xxxxxxxxxxxx_data",        l12b_xxxxxxxxxxxx_data},
+	{"l12b_xxxxxxxxxxxx_ptr",         l12b_xxxxxxxxxxxx_ptr},
+	{"l12c_xxxxxxxxxxxx_data",        l12c_xxxxxxxxxxxx_data},
+	{"l12c_xxxxxxxxxxxx_ptr",         l12c_xxxxxxxxxxxx_ptr},
+
+	{"l12a_xxxxxxxxxxxx_rodata",      l12a_xxxxxxxxxxxx_rodata},
+	{"l12b_xxxxxxxxxxxx_rodata",      l12b_xxxxxxxxxxxx_rodata},
+	{"l12c_xxxxxxxxxxxx_rodata",      l12c_xxxxxxxxxxxx_rodata},
+
+	{"l12a_xxxxxxxxxxxx_text",        &l12a_xxxxxxxxxxxx_text},
+	{"l12b_xxxxxxxxxxxx_text",        &l12b_xxxxxxxxxxxx_text},
+	{"l12c_xxxxxxxxxxxx_text",        &l12c_xxxxxxxxxxxx_text},
+
+	{"libl13.expsyms.a",              0},
+
+	{"l13a_xxxxxxxxxxxxx_bss",        l13a_xxxxxxxxxxxxx_bss},
+	{"l13a_xxxxxxxxxxxxx_common",     l13a_xxxxxxxxxxxxx_common},
+	{"l13b_xxxxxxxxxxxxx_bss",        l13b_xxxxxxxxxxxxx_bss},
+	{"l13b_xxxxxxxxxxxxx_common",     l13b_xxxxxxxxxxxxx_common},
+	{"l13c_xxxxxxxxxxxxx_bss",        l13c_xxxxxxxxxxxxx_bss},
+	{"l13c_xxxxxxxxxxxxx_common",     l13c_xxxxxxxxxxxxx_common},
+
+	{"l13a_xxxxxxxxxxxxx_data",       l13a_xxxxxxxxxxxxx_data},
+	{"l13a_xxxxxxxxxxxxx_ptr",        l13a_xxxxxxxxxxxxx_ptr},
+	{"l13b_xxxxxxxxxxxxx_data",       l13b_xxxxxxxxxxxxx_data},
+	{"l13b_xxxxxxxxxxxxx_ptr",        l13b_xxxxxxxxxxxxx_ptr},
+	{"l13c_xxxxxxxxxxxxx_data",       l13c_xxxxxxxxxxxxx_data},
+	{"l13c_xxxxxxxxxxxxx_ptr",        l13c_xxxxxxxxxxxxx_ptr},
+
+	{"l13a_xxxxxxxxxxxxx_rodata",     l13a_xxxxxxxxxxxxx_rodata},
+	{"l13b_xxxxxxxxxxxxx_rodata",     l13b_xxxxxxxxxxxxx_rodata},
+	{"l13c_xxxxxxxxxxxxx_rodata",     l13c_xxxxxxxxxxxxx_rodata},
+
+	{"l13a_xxxxxxxxxxxxx_text",       &l13a_xxxxxxxxxxxxx_text},
+	{"l13b_xxxxxxxxxxxxx_text",       &l13b_xxxxxxxxxxxxx_text},
+	{"l13c_xxxxxxxxxxxxx_text",       &l13c_xxxxxxxxxxxxx_text},
+
+	{"libl14.expsyms.a",              0},
+
+	{"l14a_xxxxxxxxxxxxxx_bss",       l14a_xxxxxxxxxxxxxx_bss},
+	{"l14a_xxxxxxxxxxxxxx_common",    l14a_xxxxxxxxxxxxxx_common},
+	{"l14b_xxxxxxxxxxxxxx_bss",       l14b_xxxxxxxxxxxxxx_bss},
+	{"l14b_xxxxxxxxxxxxxx_common",    l14b_xxxxxxxxxxxxxx_common},
+	{"l14c_xxxxxxxxxxxxxx_bss",       l14c_xxxxxxxxxxxxxx_bss},
+	{"l14c_xxxxxxxxxxxxxx_common",    l14c_xxxxxxxxxxxxxx_common},
+
+	{"l14a_xxxxxxxxxxxxxx_data",      l14a_xxxxxxxxxxxxxx_data},
+	{"l14a_xxxxxxxxxxxxxx_ptr",       l14a_xxxxxxxxxxxxxx_ptr},
+	{"l14b_xxxxxxxxxxxxxx_data",      l14b_xxxxxxxxxxxxxx_data},
+	{"l14b_xxxxxxxxxxxxxx_ptr",       l14b_xxxxxxxxxxxxxx_ptr},
+	{"l14c_xxxxxxxxxxxxxx_data",      l14c_xxxxxxxxxxxxxx_data},
+	{"l14c_xxxxxxxxxxxxxx_ptr",       l14c_xxxxxxxxxxxxxx_ptr},
+
+	{"l14a_xxxxxxxxxxxxxx_rodata",    l14a_xxxxxxxxxxxxxx_rodata},
+	{"l14b_xxxxxxxxxxxxxx_rodata",    l14b_xxxxxxxxxxxxxx_rodata},
+	{"l14c_xxxxxxxxxxxxxx_rodata",    l14c_xxxxxxxxxxxxxx_rodata},
+
+	{"l14a_xxxxxxxxxxxxxx_text",      &l14a_xxxxxxxxxxxxxx_text},
+	{"l14b_xxxxxxxxxxxxxx_text",      &l14b_xxxxxxxxxxxxxx_text},
+	{"l14c_xxxxxxxxxxxxxx_text",      &l14c_xxxxxxxxxxxxxx_text},
+
+	{"libl15.expsyms.a",              0},
+
+	{"l15a_xxxxxxxxxxxxxxx_bss",      l15a_xxxxxxxxxxxxxxx_bss},
+	{"l15a_xxxxxxxxxxxxxxx_common",   l15a_xxxxxxxxxxxxxxx_common},
+	{"l15b_xxxxxxxxxxxxxxx_bss",      l15b_xxxxxxxxxxxxxxx_bss},
+	{"l15b_xxxxxxxxxxxxxxx_common",   l15b_xxxxxxxxxxxxxxx_common},
+	{"l15c_xxxxxxxxxxxxxxx_bss",      l15c_xxxxxxxxxxxxxxx_bss},
+	{"l15c_xxxxxxxxxxxxxxx_common",   l15c_xxxxxxxxxxxxxxx_common},
+
+	{"l15a_xxxxxxxxxxxxxxx_data",     l15a_xxxxxxxxxxxxxxx_data},
+	{"l15a_xxxxxxxxxxxxxxx_ptr",      l15a_xxxxxxxxxxxxxxx_ptr},
+	{"l15b_xxxxxxxxxxxxxxx_data",     l15b_xxxxxxxxxxxxxxx_data},
+	{"l15b_xxxxxxxxxxxxxxx_ptr",      l15b_xxxxxxxxxxxxxxx_ptr},
+	{"l15c_xxxxxxxxxxxxxxx_data",     l15c_xxxxxxxxxxxxxxx_data},
+	{"l15c_xxxxxxxxxxxxxxx_ptr",      l15c_xxxxxxxxxxxxxxx_ptr},
+
+	{"l15a_xxxxxxxxxxxxxxx_rodata",   l15a_xxxxxxxxxxxxxxx_rodata},
+	{"l15b_xxxxxxxxxxxxxxx_rodata",   l15b_xxxxxxxxxxxxxxx_rodata},
+	{"l15c_xxxxxxxxxxxxxxx_rodata",   l15c_xxxxxxxxxxxxxxx_rodata},
+
+	{"l15a_xxxxxxxxxxxxxxx_text",     &l15a_xxxxxxxxxxxxxxx_text},
+	{"l15b_xxxxxxxxxxxxxxx_text",     &l15b_xxxxxxxxxxxxxxx_text},
+	{"l15c_xxxxxxxxxxxxxxx_text",     &l15c_xxxxxxxxxxxxxxx_text},
+
+	{"libl16.expsyms.a",              0},
+
+	{"l16a_xxxxxxxxxxxxxxxx_bss",     l16a_xxxxxxxxxxxxxxxx_bss},
+	{"l16a_xxxxxxxxxxxxxxxx_common",  l16a_xxxxxxxxxxxxxxxx_common},
+	{"l16b_xxxxxxxxxxxxxxxx_bss",     l16b_xxxxxxxxxxxxxxxx_bss},
+	{"l16b_xxxxxxxxxxxxxxxx_common",  l16b_xxxxxxxxxxxxxxxx_common},
+	{"l16c_xxxxxxxxxxxxxxxx_bss",     l16c_xxxxxxxxxxxxxxxx_bss},
+	{"l16c_xxxxxxxxxxxxxxxx_common",  l16c_xxxxxxxxxxxxxxxx_common},
+
+	{"l16a_xxxxxxxxxxxxxxxx_data",    l16a_xxxxxxxxxxxxxxxx_data},
+	{"l16a_xxxxxxxxxxxxxxxx_ptr",     l16a_xxxxxxxxxxxxxxxx_ptr},
+	{"l16b_xxxxxxxxxxxxxxxx_data",    l16b_xxxxxxxxxxxxxxxx_data},
+	{"l16b_xxxxxxxxxxxxxxxx_ptr",     l16b_xxxxxxxxxxxxxxxx_ptr},
+	{"l16c_xxxxxxxxxxxxxxxx_data",    l16c_xxxxxxxxxxxxxxxx_data},
+	{"l16c_xxxxxxxxxxxxxxxx_ptr",     l16c_xxxxxxxxxxxxxxxx_ptr},
+
+	{"l16a_xxxxxxxxxxxxxxxx_rodata",  l16a_xxxxxxxxxxxxxxxx_rodata},
+	{"l16b_xxxxxxxxxxxxxxxx_rodata",  l16b_xxxxxxxxxxxxxxxx_rodata},
+	{"l16c_xxxxxxxxxxxxxxxx_rodata",  l16c_xxxxxxxxxxxxxxxx_rodata},
+
+	{"l16a_xxxxxxxxxxxxxxxx_text",    &l16a_xxxxxxxxxxxxxxxx_text},
+	{"l16b_xxxxxxxxxxxxxxxx_text",    &l16b_xxxxxxxxxxxxxxxx_text},
+	{"l16c_xxxxxxxxxxxxxxxx_text",    &l16c_xxxxxxxxxxxxxxxx_text},
+
+	{0,                               0}
+};
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,148 @@
+#!/bin/sh
+
+# slbt-check-dlsyms.sh: link a program against a synthetic set of
+# -dlpreopen libraries, using the host compiler, and compare the
+# generated dlsym table with its golden copy. the banner of the
+# generated file (slibtool version and commit) is not compared.
+# this file is covered by COPYING.SLIBTOOL.
+
+set -eu
+
+usage()
+{
+cat << EOF >&2
+
+Usage:
+  -h            show this HELP message
+  -s  SLIBTOOL  slibtool binary to check
+  -c  CC        host compiler                            [cc]
+  -g  GOLDEN    golden copy of the generated dlsym table
+  -w  WORKDIR   scratch directory (removed and re-created)
+  -u            update GOLDEN rather than compare with it
+
+EOF
+exit 1
+}
+
+
+# one
+slibtool=
+cc=cc
+golden=
+workdir=
+update=
+
+
+while getopts "hs:c:g:w:u" opt; do
+	case $opt in
+	h)
+		usage
+		;;
+	s)
+		slibtool="$OPTARG"
+		;;
+	c)
+		cc="$OPTARG"
+		;;
+	g)
+		golden="$OPTARG"
+		;;
+	w)
+		workdir="$OPTARG"
+		;;
+	u)
+		update=yes
+		;;
+	\?)
+		printf 'Invalid option: -%s' "$OPTARG" >&2
+		usage
+		;;
+	esac
+done
+
+
+# two
+if [ -z "$slibtool" ] || [ -z "$golden" ] || [ -z "$workdir" ]; then
+	usage
+fi
+
+abspath()
+{
+	case "$1" in
+		/*) printf '%s' "$1" ;;
+		*)  printf '%s/%s' "$(pwd -P)" "$1" ;;
+	esac
+}
+
+slibtool=$(abspath "$slibtool")
+golden=$(abspath "$golden")
+
+rm -rf -- "$workdir"
+mkdir -p -- "$workdir"
+cd -- "$workdir"
+
+
+# three: sixteen libraries of three units each; every unit defines
+# symbols of each class, with names of varying length, so that the
+# table spans all sections and several column widths.
+nlibs=16
+dlpreopen=
+
+lib=1
+
+while [ $lib -le $nlibs ]; do
+	name=$(printf 'l%02d' $lib)
+	pad=$(printf '%*s' $lib '' | tr ' ' 'x')
+	objs=
+
+	for unit in a b c; do
+		sym="${name}${unit}_${pad}"
+		src="${name}${unit}.c"
+
+		{
+			printf 'int %s_text(void) { return %d; }\n' "$sym" $lib
+			printf 'int %s_data = %d;\n' "$sym" $lib
+			printf 'int %s_bss;\n' "$sym"
+			printf 'int %s_common;\n' "$sym"
+			printf 'const int %s_rodata = %d;\n' "$sym" $lib
+			printf '__attribute__((weak)) int %s_weak(void) { return 0; }\n' "$sym"
+			printf '__attribute__((weak)) int %s_weakobj = 1;\n' "$sym"
+			printf 'static int %s_local(void) { return 0; }\n' "$sym"
+			printf 'int (*%s_ptr)(void) = %s_local;\n' "$sym" "$sym"
+		} > "$src"
+
+		"$slibtool" --silent --mode=compile "$cc" -fcommon -c -o "${name}${unit}.lo" "$src"
+		objs="$objs ${name}${unit}.lo"
+	done
+
+	"$slibtool" --silent --mode=link "$cc" -o "lib$name.la" -rpath /usr/lib $objs
+	dlpreopen="$dlpreopen -dlpreopen lib$name.la"
+	lib=$((lib + 1))
+done
+
+printf 'int main(void) { return 0; }\n' > main.c
+
+"$slibtool" --silent --mode=compile "$cc" -c -o main.lo main.c
+"$slibtool" --silent --mode=link "$cc" -o prog main.lo $dlpreopen
+
+
+# four: compare (or update)
+sed -e '1,5d' .libs/prog.dlopen.c > dlsyms.c
+
+if [ -n "$update" ]; then
+	cp dlsyms.c "$golden"
+	printf 'slbt-check-dlsyms: updated %s\n' "$golden"
+	exit 0
+fi
+
+if ! cmp -s dlsyms.c "$golden"; then
+	diff -u "$golden" dlsyms.c >&2 || true
+	printf 'slbt-check-dlsyms: generated dlsym table differs from %s\n' "$golden" >&2
+	exit 1
+fi
+
+printf 'slbt-check-dlsyms: %d libraries: ok\n' $nlibs
+
+
+# all done
+exit 0
@@ -0,0 +1,136 @@
+#!/bin/sh
+
+# slbt-check-implib.sh: write PE/COFF import libraries from a .def
+# file for each supported target machine, and compare them with their
+# golden copies; when llvm-dlltool is available, also compare their
+# short import members with those of llvm-dlltool's output.
+# this file is covered by COPYING.SLIBTOOL.
+
+set -eu
+
+usage()
+{
+cat << EOF >&2
+
+Usage:
+  -h            show this HELP message
+  -x  CHECKER   import library driver (slbt-check-implib)
+  -d  DLLTOOL   reference llvm-dlltool, skipped if absent [llvm-dlltool]
+  -g  GOLDEN    directory of implib.def and the golden archives
+  -w  WORKDIR   scratch directory (removed and re-created)
+  -u            update the golden archives rather than compare
+
+EOF
+exit 1
+}
+
+
+# one
+checker=
+dlltool=llvm-dlltool
+golden=
+workdir=
+update=
+
+
+while getopts "hx:d:g:w:u" opt; do
+	case $opt in
+	h)
+		usage
+		;;
+	x)
+		checker="$OPTARG"
+		;;
+	d)
+		dlltool="$OPTARG"
+		;;
+	g)
+		golden="$OPTARG"
+		;;
+	w)
+		workdir="$OPTARG"
+		;;
+	u)
+		update=yes
+		;;
+	\?)
+		printf 'Invalid option: -%s' "$OPTARG" >&2
+		usage
+		;;
+	esac
+done
+
+
+# two
+if [ -z "$checker" ] || [ -z "$golden" ] || [ -z "$workdir" ]; then
+	usage
+fi
+
+abspath()
+{
+	case "$1" in
+		/*) printf '%s' "$1" ;;
+		*)  printf '%s/%s' "$(pwd -P)" "$1" ;;
+	esac
+}
+
+checker=$(abspath "$checker")
+golden=$(abspath "$golden")
+
+if ! command -v "$dlltool" > /dev/null 2>&1; then
+	printf 'slbt-check-implib: %s not found, skipping the reference comparison\n' "$dlltool"
+	dlltool=
+fi
+
+rm -rf -- "$workdir"
+mkdir -p -- "$workdir"
+cd -- "$workdir"
+
+
+# three: <host> <llvm-dlltool machine>
+dll=libcheck-1.dll
+status=0
+
+for target in 'i686-w64-mingw32 i386' \
+		'x86_64-w64-mingw32 i386:x86-64' \
+		'aarch64-w64-mingw32 arm64'; do
+	set -- $target
+
+	host="$1"
+	machine="$2"
+	arch="${host%%-*}"
+	implib="implib-$arch.a"
+	fail=
+
+	"$checker" create "$host" "$golden/implib.def" "$dll" "$implib"
+
+	if [ -n "$update" ]; then
+		cp "$implib" "$golden/$implib"
+		printf 'slbt-check-implib: updated %s\n' "$golden/$implib"
+		continue
+	fi
+
+	if ! cmp -s "$implib" "$golden/$implib"; then
+		printf 'slbt-check-implib: %s: differs from %s\n' "$host" "$golden/$implib" >&2
+		fail=yes
+	fi
+
+	if [ -n "$dlltool" ]; then
+		"$dlltool" -m "$machine" -d "$golden/implib.def" -D "$dll" -l "ref-$arch.a"
+
+		if ! "$checker" compare "$implib" "ref-$arch.a"; then
+			printf 'slbt-check-implib: %s: short import members differ from %s\n' "$host" "$dlltool" >&2
+			fail=yes
+		fi
+	fi
+
+	if [ -n "$fail" ]; then
+		status=1
+	else
+		printf 'slbt-check-implib: %s: ok\n' "$host"
+	fi
+done
+
+
+# all done
+exit $status
@@ -0,0 +1,231 @@
+/*******************************************************************/
+/*  slibtool: a strong libtool implementation, written in C        */
+/*  Copyright (C) 2016--2024  SysDeer Technologies, LLC            */
+/*  Released under the Standard MIT License; see COPYING.SLIBTOOL. */
+/*******************************************************************/
+
+/*****************************************************************/
+/* slbt-check-implib: drive the in-process import library writer */
+/* on a linux host, and compare its short import members with    */
+/* those of a reference archive (as written by llvm-dlltool).    */
+/*                                                               */
+/* create  <host> <def> <dll> <implib>: write <implib> from      */
+/*         <def> as slibtool would when linking for <host>.       */
+/* compare <implib> <reference>: byte-compare the short import   */
+/*         members of the two archives, in archive order.        */
+/*****************************************************************/
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <slibtool/slibtool.h>
+#include "slibtool_ar_impl.h"
+
+#define CHECK_AR_SIGNATURE	"!<arch>\n"
+#define CHECK_AR_HDR_SIZE	(60)
+#define CHECK_IMPORT_HDR_SIZE	(20)
+
+struct check_member {
+	const unsigned char *	data;
+	size_t			size;
+};
+
+static const char * check_program;
+
+
+static void check_die(const char * msg, const char * arg)
+{
+	fprintf(stderr,"%s: %s%s%s\n",
+		check_program,msg,
+		arg ? ": " : "",
+		arg ? arg : "");
+
+	exit(2);
+}
+
+static unsigned char * check_read_file(const char * path, size_t * size)
+{
+	int		fd;
+	ssize_t		nread;
+	size_t		cnt;
+	struct stat	st;
+	unsigned char *	data;
+
+	if ((fd = open(path,O_RDONLY)) < 0)
+		check_die("cannot open",path);
+
+	if (fstat(fd,&st) < 0)
+		check_die("cannot stat",path);
+
+	if (!(data = malloc(st.st_size + 1)))
+		check_die("out of memory",0);
+
+	for (cnt=0; cnt < (size_t)st.st_size; cnt+=nread)
+		if ((nread = read(fd,&data[cnt],st.st_size - cnt)) <= 0)
+			check_die("cannot read",path);
+
+	close(fd);
+
+	*size = st.st_size;
+
+	return data;
+}
+
+
+/* short import members: Sig1 == 0x0000, Sig2 == 0xffff */
+static size_t check_import_members(
+	const char *		path,
+	const unsigned char *	data,
+	size_t			size,
+	struct check_member *	memberv,
+	size_t			cap)
+{
+	const unsigned char *	ch;
+	const unsigned char *	end;
+	size_t			nmembers;
+	size_t			msize;
+	char			field[11];
+
+	if ((size < 8) || memcmp(data,CHECK_AR_SIGNATURE,8))
+		check_die("not an archive",path);
+
+	ch  = &data[8];
+	end = &data[size];
+
+	for (nmembers=0; ch + CHECK_AR_HDR_SIZE <= end; ) {
+		memcpy(field,&ch[48],10);
+		field[10] = 0;
+
+		msize = strtoul(field,0,10);
+		ch   += CHECK_AR_HDR_SIZE;
+
+		if (ch + msize > end)
+			check_die("truncated archive",path);
+
+		if ((msize >= CHECK_IMPORT_HDR_SIZE)
+				&& (ch[0] == 0x00) && (ch[1] == 0x00)
+				&& (ch[2] == 0xff) && (ch[3] == 0xff)) {
+			if (nmembers == cap)
+				check_die("too many members",path);
+
+			memberv[nmembers].data = ch;
+			memberv[nmembers].size = msize;
+			nmembers++;
+		}
+
+		ch += msize + (msize & 1);
+	}
+
+	return nmembers;
+}
+
+static int check_compare(const char * implib, const char * reference)
+{
+	unsigned char *		adata;
+	unsigned char *		bdata;
+	size_t			asize;
+	size_t			bsize;
+	size_t			acnt;
+	size_t			bcnt;
+	size_t			idx;
+	struct check_member *	av;
+	struct check_member *	bv;
+	int			ret;
+
+	adata = check_read_file(implib,&asize);
+	bdata = check_read_file(reference,&bsize);
+
+	av = calloc(asize / CHECK_AR_HDR_SIZE + 1,sizeof(*av));
+	bv = calloc(bsize / CHECK_AR_HDR_SIZE + 1,sizeof(*bv));
+
+	if (!av || !bv)
+		check_die("out of memory",0);
+
+	acnt = check_import_members(implib,adata,asize,av,asize / CHECK_AR_HDR_SIZE);
+	bcnt = check_import_members(reference,bdata,bsize,bv,bsize / CHECK_AR_HDR_SIZE);
+
+	ret = 0;
+
+	if (!acnt || (acnt != bcnt)) {
+		fprintf(stderr,"%s: %s: %zu short import members, %s: %zu\n",
+			check_program,implib,acnt,reference,bcnt);
+		ret = 1;
+	}
+
+	for (idx=0; !ret && (idx < acnt); idx++) {
+		if ((av[idx].size != bv[idx].size)
+				|| memcmp(av[idx].data,bv[idx].data,av[idx].size)) {
+			fprintf(stderr,"%s: %s: short import member #%zu differs from %s\n",
+				check_program,implib,idx,reference);
+			ret = 1;
+		}
+	}
+
+	free(av);
+	free(bv);
+	free(adata);
+	free(bdata);
+
+	return ret;
+}
+
+
+static int check_create(
+	const char *		host,
+	const char *		deffile,
+	const char *		dllname,
+	const char *		implib)
+{
+	int			ret;
+	char *			argv[8];
+	char			hostarg[PATH_MAX];
+	struct slbt_driver_ctx *dctx;
+
+	if (snprintf(hostarg,sizeof(hostarg),"--host=%s",host) >= (int)sizeof(hostarg))
+		check_die("host name too long",host);
+
+	argv[0] = "slibtool";
+	argv[1] = hostarg;
+	argv[2] = "--mode=link";
+	argv[3] = "cc";
+	argv[4] = "-o";
+	argv[5] = "check";
+	argv[6] = 0;
+
+	if (slbt_lib_get_driver_ctx(argv,0,SLBT_DRIVER_VERBOSITY_ERRORS,0,&dctx) < 0)
+		check_die("could not create a driver context",host);
+
+	if (!slbt_ar_implib_supported(dctx))
+		check_die("unsupported host",host);
+
+	if ((ret = slbt_ar_create_implib(dctx,deffile,dllname,implib,0644)) < 0)
+		slbt_output_error_vector(dctx);
+
+	slbt_lib_free_driver_ctx(dctx);
+
+	return ret ? 1 : 0;
+}
+
+
+int main(int argc, char ** argv)
+{
+	check_program = argv[0];
+
+	if ((argc == 6) && !strcmp(argv[1],"create"))
+		return check_create(argv[2],argv[3],argv[4],argv[5]);
+
+	if ((argc == 4) && !strcmp(argv[1],"compare"))
+		return check_compare(argv[2],argv[3]);
+
+	fprintf(stderr,
+		"usage: %s create <host> <def> <dll> <implib>\n"
+		"       %s compare <implib> <reference>\n",
+		argv[0],argv[0]);
+
+	return 2;
+}
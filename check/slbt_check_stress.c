@@ -0,0 +1,247 @@
+/*******************************************************************/
+/*  slibtool: a strong libtool implementation, written in C        */
+/*  Copyright (C) 2016--2024  SysDeer Technologies, LLC            */
+/*  Released under the Standard MIT License; see COPYING.SLIBTOOL. */
+/*******************************************************************/
+
+/*****************************************************************/
+/* slbt-check-stress: run many dry-run compilations concurrently */
+/* in one process. half of the threads share a single driver     */
+/* context; the other half create driver contexts of their own,  */
+/* all of which refer to the same libtool script, and thereby to */
+/* the same toolchain context. every thread also records errors  */
+/* in its driver context, and allocates exec contexts. races are */
+/* reported when the library and this program are built with     */
+/* -fsanitize=thread (see project/check.mk).                     */
+/*****************************************************************/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#include <slibtool/slibtool.h>
+
+#define CHECK_STRESS_THREADS	256
+#define CHECK_STRESS_ITERATIONS	16
+
+struct check_thread {
+	pthread_t			tid;
+	struct slbt_driver_ctx *	dctx;
+	int				status;
+};
+
+static const char * check_program;
+
+static struct slbt_fd_ctx check_fdctx;
+
+static char * check_argv[] = {
+	"slibtool","--heuristics=./libtool","--dry-run",
+	"--mode=compile","--tag=CC","cc",
+	"-DHAVE_CONFIG_H","-I.","-O2",
+	"-c","-o","foo.lo","foo.c",0};
+
+static const char check_libtool[] =
+	"#! /bin/sh\n"
+	"# libtool: stand-in script for slbt-check-stress\n"
+	"build_libtool_libs=yes\n"
+	"build_old_libs=yes\n"
+	"host=x86_64-pc-linux-gnu\n"
+	"AR=\"ar\"\n"
+	"NM=\"nm -B\"\n"
+	"RANLIB=\"ranlib\"\n"
+	"AS=\"as\"\n"
+	"DLLTOOL=\"dlltool\"\n";
+
+
+static void check_die(const char * msg, const char * arg)
+{
+	fprintf(stderr,"%s: %s%s%s\n",
+		check_program,msg,
+		arg ? ": " : "",
+		arg ? arg : "");
+
+	exit(2);
+}
+
+static void check_write_file(const char * path, const char * data)
+{
+	int		fd;
+	ssize_t		nwritten;
+	size_t		size;
+
+	if ((fd = open(path,O_WRONLY|O_CREAT|O_TRUNC,0644)) < 0)
+		check_die("cannot create",path);
+
+	for (size=strlen(data); size; data+=nwritten, size-=nwritten)
+		if ((nwritten = write(fd,data,size)) < 0)
+			check_die("cannot write",path);
+
+	close(fd);
+}
+
+/* argv is modified in place during the call, hence a private copy */
+static int check_driver_ctx(struct slbt_driver_ctx ** pctx)
+{
+	char *	argv[sizeof(check_argv) / sizeof(*check_argv)];
+
+	memcpy(argv,check_argv,sizeof(argv));
+
+	return slbt_lib_get_driver_ctx(
+		argv,0,
+		SLBT_DRIVER_VERBOSITY_ERRORS,
+		&check_fdctx,pctx);
+}
+
+
+/* every error that was recorded must be an expected one */
+static int check_error_vector(const struct slbt_driver_ctx * dctx)
+{
+	struct slbt_error_info **	perr;
+	int				nerrors;
+
+	for (nerrors=0, perr=dctx->errv; *perr; perr++, nerrors++) {
+		if ((*perr)->edctx != dctx)
+			return -1;
+
+		if ((*perr)->esyscode && ((*perr)->esyscode != ENOENT))
+			return -1;
+	}
+
+	return (nerrors > 64) ? -1 : 0;
+}
+
+
+static void * check_thread_entry(void * arg)
+{
+	struct check_thread *		thread;
+	struct slbt_driver_ctx *	dctx;
+	struct slbt_exec_ctx *		ectx;
+	struct slbt_txtfile_ctx *	tctx;
+	int				idx;
+
+	thread = arg;
+	dctx   = thread->dctx;
+
+	if (!dctx && (check_driver_ctx(&dctx) < 0)) {
+		thread->status = -1;
+		return 0;
+	}
+
+	for (idx=0; idx<CHECK_STRESS_ITERATIONS; idx++) {
+		if (slbt_exec_compile(dctx) < 0)
+			thread->status = -1;
+
+		if (slbt_ectx_get_exec_ctx(dctx,&ectx) < 0)
+			thread->status = -1;
+		else
+			slbt_ectx_free_exec_ctx(ectx);
+
+		/* concurrent error recording (ENOENT copies the path) */
+		if (slbt_lib_get_txtfile_ctx(dctx,"missing.txt",&tctx) == 0) {
+			slbt_lib_free_txtfile_ctx(tctx);
+			thread->status = -1;
+		}
+	}
+
+	if (!thread->dctx) {
+		if (check_error_vector(dctx) < 0)
+			thread->status = -1;
+
+		slbt_lib_free_driver_ctx(dctx);
+	}
+
+	return 0;
+}
+
+
+int main(int argc, char ** argv)
+{
+	int				ret;
+	int				fdnull;
+	long				idx;
+	long				nthreads;
+	long				nfailed;
+	char *				end;
+	struct check_thread *		threadv;
+	struct slbt_driver_ctx *	dctx;
+
+	check_program = argv[0];
+
+	if ((argc < 2) || (argc > 3)) {
+		fprintf(stderr,"usage: %s <workdir> [<nthreads>]\n",argv[0]);
+		return 2;
+	}
+
+	nthreads = CHECK_STRESS_THREADS;
+
+	if (argc == 3) {
+		errno    = 0;
+		nthreads = strtol(argv[2],&end,10);
+
+		if (errno || *end || (nthreads < 2))
+			check_die("invalid thread count",argv[2]);
+	}
+
+	/* scratch directory, libtool script, source file */
+	mkdir(argv[1],0755);
+
+	if (chdir(argv[1]) < 0)
+		check_die("cannot enter",argv[1]);
+
+	check_write_file("libtool",check_libtool);
+	check_write_file("foo.c","int foo(void) { return 0; }\n");
+
+	/* diagnostics are checked by way of the error vector */
+	if ((fdnull = open("/dev/null",O_WRONLY)) < 0)
+		check_die("cannot open","/dev/null");
+
+	check_fdctx.fdin  = STDIN_FILENO;
+	check_fdctx.fdout = fdnull;
+	check_fdctx.fderr = fdnull;
+	check_fdctx.fdlog = (-1);
+	check_fdctx.fdcwd = AT_FDCWD;
+	check_fdctx.fddst = AT_FDCWD;
+
+	/* the shared driver context */
+	if (check_driver_ctx(&dctx) < 0)
+		check_die("could not create a driver context",0);
+
+	if (!(threadv = calloc(nthreads,sizeof(*threadv))))
+		check_die("out of memory",0);
+
+	/* even threads share dctx, odd threads create their own */
+	for (idx=0; idx<nthreads; idx++) {
+		threadv[idx].dctx = (idx % 2) ? 0 : dctx;
+
+		if ((ret = pthread_create(
+				&threadv[idx].tid,0,
+				check_thread_entry,
+				&threadv[idx])))
+			check_die("pthread_create",strerror(ret));
+	}
+
+	for (nfailed=0, idx=0; idx<nthreads; idx++) {
+		pthread_join(threadv[idx].tid,0);
+
+		if (threadv[idx].status)
+			nfailed++;
+	}
+
+	if (check_error_vector(dctx) < 0)
+		nfailed++;
+
+	slbt_lib_free_driver_ctx(dctx);
+	free(threadv);
+	close(fdnull);
+
+	printf("%s: %ld threads, %d iterations each: %s\n",
+		check_program,nthreads,CHECK_STRESS_ITERATIONS,
+		nfailed ? "FAILED" : "ok");
+
+	return nfailed ? 1 : 0;
+}
@@ -69,7 +69,11 @@ extern "C" {
 
 #define SLBT_DRIVER_IMPLIB_IDATA	SLBT_DRIVER_XFLAG(0x0001)
 #define SLBT_DRIVER_IMPLIB_DSOMETA	SLBT_DRIVER_XFLAG(0x0002)
+#define SLBT_DRIVER_IMPLIB_DLLTOOL	SLBT_DRIVER_XFLAG(0x0004)
 #define SLBT_DRIVER_EXPORT_DYNAMIC	SLBT_DRIVER_XFLAG(0x0010)
+#define SLBT_DRIVER_INCREMENTAL_ARCHIVE	SLBT_DRIVER_XFLAG(0x0020)
+#define SLBT_DRIVER_THIN_ARCHIVE	SLBT_DRIVER_XFLAG(0x0040)
+#define SLBT_DRIVER_SORT_SYMBOLS	SLBT_DRIVER_XFLAG(0x0080)
 #define SLBT_DRIVER_STATIC_LIBTOOL_LIBS	SLBT_DRIVER_XFLAG(0x0100)
 
 #define SLBT_DRIVER_OUTPUT_SHARED_EXT	SLBT_DRIVER_XFLAG(0x0400)
@@ -155,6 +159,9 @@ enum slbt_custom_error {
 	SLBT_ERR_AR_DLUNIT_NOT_SPECIFIED,
 	SLBT_ERR_AR_OUTPUT_NOT_SPECIFIED,
 	SLBT_ERR_AR_OUTPUT_NOT_APPLICABLE,
+	SLBT_ERR_BATCH_ERROR,
+	SLBT_ERR_AR_THIN_MISMATCH,
+	SLBT_ERR_CLEAN_FAIL,
 };
 
 /* execution modes */
@@ -171,6 +178,8 @@ enum slbt_mode {
 	SLBT_MODE_UNINSTALL,
 	SLBT_MODE_AR,
 	SLBT_MODE_STOOLIE,
+	SLBT_MODE_BATCH,
+	SLBT_MODE_SERVER,
 };
 
 enum slbt_tag {
@@ -356,6 +365,13 @@ struct slbt_common_ctx {
 	const char *			expsyms;
 	const char *			regex;
 	const char *			user;
+	const char *			objcache;
+	const char *			objcachemax;
+	const char *			batch;
+	const char *			batchjobs;
+	const char *			server;
+	const char *			installjobs;
+	const char *			cleanjobs;
 };
 
 struct slbt_driver_ctx {
@@ -417,6 +433,8 @@ slbt_api int  slbt_fs_map_input         (const struct slbt_driver_ctx *,
 slbt_api int  slbt_fs_unmap_input       (struct slbt_input *);
 
 /* driver api */
+/* (slbt_lib_get_driver_ctx() temporarily modifies argv; concurrent calls */
+/*  must accordingly pass argument vectors of their own.)                 */
 slbt_api int  slbt_lib_get_driver_ctx   (char ** argv, char ** envp, uint64_t flags,
                                          const struct slbt_fd_ctx *,
                                          struct slbt_driver_ctx **);
@@ -442,6 +460,7 @@ slbt_api void slbt_ectx_reset_argvector (struct slbt_exec_ctx *);
 slbt_api void slbt_ectx_reset_arguments (struct slbt_exec_ctx *);
 
 /* core api */
+slbt_api int  slbt_exec_clean           (const struct slbt_driver_ctx *);
 slbt_api int  slbt_exec_compile         (const struct slbt_driver_ctx *);
 slbt_api int  slbt_exec_execute         (const struct slbt_driver_ctx *);
 slbt_api int  slbt_exec_install         (const struct slbt_driver_ctx *);
@@ -450,8 +469,15 @@ slbt_api int  slbt_exec_uninstall       (const struct slbt_driver_ctx *);
 slbt_api int  slbt_exec_ar              (const struct slbt_driver_ctx *);
 slbt_api int  slbt_exec_stoolie         (const struct slbt_driver_ctx *);
 slbt_api int  slbt_exec_slibtoolize     (const struct slbt_driver_ctx *);
+slbt_api int  slbt_exec_batch           (const struct slbt_driver_ctx *);
+slbt_api int  slbt_exec_server          (const struct slbt_driver_ctx *);
 
 /* host and flavor interfaces */
+/* (slbt_host_set_althost() and slbt_host_reset_althost() modify the     */
+/*  alternate host members of the driver context, namely cctx->ahost,    */
+/*  cctx->asettings, and cctx->acfgmeta; a caller that shares a driver   */
+/*  context among threads must serialize these calls with any access to  */
+/*  those members, as slbt_exec_install() does.)                         */
 slbt_api int  slbt_host_set_althost     (const struct slbt_driver_ctx *, const char * host, const char * flavor);
 
 slbt_api void slbt_host_reset_althost   (const struct slbt_driver_ctx *);
@@ -499,6 +525,14 @@ slbt_api void slbt_ar_free_archive_meta (struct slbt_archive_meta *);
 slbt_api int  slbt_ar_merge_archives    (struct slbt_archive_ctx * const [],
                                          struct slbt_archive_ctx **);
 
+slbt_api int  slbt_ar_merge_thin        (struct slbt_archive_ctx * const [],
+                                         const char * path,
+                                         struct slbt_archive_ctx **);
+
+slbt_api int  slbt_ar_update_archive    (struct slbt_archive_ctx *,
+                                         struct slbt_archive_ctx *,
+                                         struct slbt_archive_ctx **);
+
 slbt_api int  slbt_ar_store_archive     (struct slbt_archive_ctx *,
                                          const char *, mode_t);
 
@@ -525,6 +559,7 @@ slbt_api int  slbt_output_features      (const struct slbt_driver_ctx *);
 slbt_api int  slbt_output_fdcwd         (const struct slbt_driver_ctx *);
 
 slbt_api int  slbt_output_exec          (const struct slbt_exec_ctx *, const char *);
+slbt_api int  slbt_output_clean         (const struct slbt_exec_ctx *);
 slbt_api int  slbt_output_compile       (const struct slbt_exec_ctx *);
 slbt_api int  slbt_output_execute       (const struct slbt_exec_ctx *);
 slbt_api int  slbt_output_install       (const struct slbt_exec_ctx *);
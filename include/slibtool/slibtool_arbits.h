@@ -8,6 +8,7 @@ extern "C" {
 #include <stddef.h>
 
 #define AR_SIGNATURE            "!<arch>\n"
+#define AR_THIN_SIGNATURE       "!<thin>\n"
 
 #define AR_MEMBER_ATTR_DEFAULT  (0x00)
 #define AR_MEMBER_ATTR_ASCII    (0x01)
@@ -17,6 +18,7 @@ extern "C" {
 #define AR_MEMBER_ATTR_ARMAP    (0x10)
 #define AR_MEMBER_ATTR_NAMESTRS (0x20)
 #define AR_MEMBER_ATTR_LINKINFO (0x40)
+#define AR_MEMBER_ATTR_THIN     (0x80)
 
 #define AR_HEADER_ATTR_DEFAULT  (0x00)
 #define AR_HEADER_ATTR_FILE_ID  (0x01)
@@ -0,0 +1,65 @@
+BENCH_DIR		= build/bench
+BENCH_TOOL		= $(BENCH_DIR)/slbt-bench-tool$(OS_APP_SUFFIX)
+BENCH_RUN		= $(BENCH_DIR)/slbt-bench-run$(OS_APP_SUFFIX)
+BENCH_MICRO		= $(BENCH_DIR)/slbt-bench-micro$(OS_APP_SUFFIX)
+
+BENCH_LIBS		= 16
+BENCH_OBJS		= 16
+BENCH_CONV		= 8
+BENCH_DLOPEN		= 8
+BENCH_PREFIX		= 2000
+BENCH_REPEAT		= 8
+BENCH_JOBS		= 4
+BENCH_ARGCS		= 1000 5000 10000 20000
+
+BENCH_MICRO_TIME	= 200
+BENCH_MICRO_OUTPUT	= $(BENCH_DIR)/micro.json
+BENCH_MICRO_CFLAGS	= -DSLBT_BENCH_MALLOC_WRAP
+BENCH_MICRO_LDFLAGS	= -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=strdup,--wrap=strndup
+
+bench:			app $(BENCH_TOOL) $(BENCH_RUN)
+			$(SOURCE_DIR)/bench/slbt-bench.sh	\
+				-s $(APP)			\
+				-t $(BENCH_TOOL)		\
+				-r $(BENCH_RUN)			\
+				-w $(BENCH_DIR)/tree		\
+				-l $(BENCH_LIBS)		\
+				-m $(BENCH_OBJS)		\
+				-c $(BENCH_CONV)		\
+				-d $(BENCH_DLOPEN)		\
+				-p $(BENCH_PREFIX)		\
+				-n $(BENCH_REPEAT)		\
+				-j $(BENCH_JOBS)		\
+				-a "$(BENCH_ARGCS)"
+
+bench-micro:		static-lib $(BENCH_TOOL) $(BENCH_MICRO)
+			$(BENCH_MICRO) $(BENCH_DIR)/micro $(BENCH_TOOL) $(BENCH_MICRO_TIME) \
+				> $(BENCH_MICRO_OUTPUT).tmp
+			mv $(BENCH_MICRO_OUTPUT).tmp $(BENCH_MICRO_OUTPUT)
+			cat $(BENCH_MICRO_OUTPUT)
+
+$(BENCH_TOOL):		$(SOURCE_DIR)/bench/slbt_bench_tool.c dirs.tag
+			mkdir -p $(BENCH_DIR)
+			$(NATIVE_CC) $(NATIVE_CFLAGS) -o $@ $(SOURCE_DIR)/bench/slbt_bench_tool.c $(NATIVE_LDFLAGS)
+
+$(BENCH_RUN):		$(SOURCE_DIR)/bench/slbt_bench_run.c dirs.tag
+			mkdir -p $(BENCH_DIR)
+			$(NATIVE_CC) $(NATIVE_CFLAGS) -o $@ $(SOURCE_DIR)/bench/slbt_bench_run.c $(NATIVE_LDFLAGS)
+
+$(BENCH_MICRO):		$(SOURCE_DIR)/bench/slbt_bench_micro.c $(STATIC_LIB)
+			mkdir -p $(BENCH_DIR)
+			$(CC) $(CFLAGS_STATIC) $(BENCH_MICRO_CFLAGS) -o $@ \
+				$(SOURCE_DIR)/bench/slbt_bench_micro.c $(STATIC_LIB) \
+				$(LDFLAGS_APP) $(BENCH_MICRO_LDFLAGS)
+
+clean:			clean-bench
+
+clean-bench:
+			rm -f $(BENCH_TOOL)
+			rm -f $(BENCH_RUN)
+			rm -f $(BENCH_MICRO)
+			rm -f $(BENCH_MICRO_OUTPUT)
+			rm -rf $(BENCH_DIR)/tree
+			rm -rf $(BENCH_DIR)/micro
+
+.PHONY:			bench bench-micro clean-bench
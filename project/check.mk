@@ -0,0 +1,53 @@
+CHECK_DIR		= build/check
+CHECK_STRESS		= $(CHECK_DIR)/slbt-check-stress$(OS_APP_SUFFIX)
+CHECK_IMPLIB		= $(CHECK_DIR)/slbt-check-implib$(OS_APP_SUFFIX)
+CHECK_GOLDEN_DIR	= $(SOURCE_DIR)/check/golden
+CHECK_CC		= $(NATIVE_CC)
+CHECK_DLLTOOL		= llvm-dlltool
+
+# races are reported when the tree is configured with -fsanitize=thread
+CHECK_STRESS_THREADS	= 256
+
+check:			check-stress
+check:			check-dlsyms
+check:			check-implib
+
+check-stress:		$(CHECK_STRESS)
+			$(CHECK_STRESS) $(CHECK_DIR)/stress $(CHECK_STRESS_THREADS)
+
+check-dlsyms:		app
+			$(SOURCE_DIR)/check/slbt-check-dlsyms.sh	\
+				-s $(APP)				\
+				-c $(CHECK_CC)				\
+				-g $(CHECK_GOLDEN_DIR)/dlsyms.c		\
+				-w $(CHECK_DIR)/dlsyms
+
+check-implib:		$(CHECK_IMPLIB)
+			$(SOURCE_DIR)/check/slbt-check-implib.sh	\
+				-x $(CHECK_IMPLIB)			\
+				-d $(CHECK_DLLTOOL)			\
+				-g $(CHECK_GOLDEN_DIR)			\
+				-w $(CHECK_DIR)/implib
+
+$(CHECK_STRESS):	$(SOURCE_DIR)/check/slbt_check_stress.c $(STATIC_LIB)
+			mkdir -p $(CHECK_DIR)
+			$(CC) $(CFLAGS_STATIC) -o $@ \
+				$(SOURCE_DIR)/check/slbt_check_stress.c $(STATIC_LIB) \
+				$(LDFLAGS_APP)
+
+$(CHECK_IMPLIB):	$(SOURCE_DIR)/check/slbt_check_implib.c $(STATIC_LIB)
+			mkdir -p $(CHECK_DIR)
+			$(CC) $(CFLAGS_STATIC) -o $@ \
+				$(SOURCE_DIR)/check/slbt_check_implib.c $(STATIC_LIB) \
+				$(LDFLAGS_APP)
+
+clean:			clean-check
+
+clean-check:
+			rm -f $(CHECK_STRESS)
+			rm -f $(CHECK_IMPLIB)
+			rm -rf $(CHECK_DIR)/stress
+			rm -rf $(CHECK_DIR)/dlsyms
+			rm -rf $(CHECK_DIR)/implib
+
+.PHONY:			check check-stress check-dlsyms check-implib clean-check
@@ -1,6 +1,7 @@
 API_SRCS = \
 	src/arbits/slbt_archive_ctx.c \
 	src/arbits/slbt_archive_dlsyms.c \
+	src/arbits/slbt_archive_implib.c \
 	src/arbits/slbt_archive_mapfile.c \
 	src/arbits/slbt_archive_mapstrv.c \
 	src/arbits/slbt_archive_merge.c \
@@ -8,6 +9,7 @@ API_SRCS = \
 	src/arbits/slbt_archive_store.c \
 	src/arbits/slbt_archive_symfile.c \
 	src/arbits/slbt_archive_syminfo.c \
+	src/arbits/slbt_archive_thin.c \
 	src/arbits/slbt_armap_bsd_32.c \
 	src/arbits/slbt_armap_bsd_64.c \
 	src/arbits/slbt_armap_sysv_32.c \
@@ -34,16 +36,20 @@ API_SRCS = \
 	src/util/slbt_map_input.c \
 	src/util/slbt_realpath.c \
 	src/logic/slbt_exec_ar.c \
+	src/logic/slbt_exec_batch.c \
+	src/logic/slbt_exec_clean.c \
 	src/logic/slbt_exec_compile.c \
 	src/logic/slbt_exec_ctx.c \
 	src/logic/slbt_exec_execute.c \
 	src/logic/slbt_exec_install.c \
 	src/logic/slbt_exec_link.c \
+	src/logic/slbt_exec_server.c \
 	src/logic/slbt_exec_stoolie.c \
 	src/logic/slbt_exec_uninstall.c \
 	src/logic/linkcmd/slbt_linkcmd_archive.c \
 	src/logic/linkcmd/slbt_linkcmd_argv.c \
 	src/logic/linkcmd/slbt_linkcmd_deps.c \
+	src/logic/linkcmd/slbt_linkcmd_dlsyms.c \
 	src/logic/linkcmd/slbt_linkcmd_dsolib.c \
 	src/logic/linkcmd/slbt_linkcmd_executable.c \
 	src/logic/linkcmd/slbt_linkcmd_host.c \
@@ -70,19 +76,25 @@ INTERNAL_SRCS = \
 	src/internal/$(PACKAGE)_coff_impl.c \
 	src/internal/$(PACKAGE)_dprintf_impl.c \
 	src/internal/$(PACKAGE)_errinfo_impl.c \
+	src/internal/$(PACKAGE)_installer_impl.c \
 	src/internal/$(PACKAGE)_lconf_impl.c \
 	src/internal/$(PACKAGE)_libmeta_impl.c \
 	src/internal/$(PACKAGE)_m4fake_impl.c \
 	src/internal/$(PACKAGE)_mapfile_impl.c \
 	src/internal/$(PACKAGE)_mkvars_impl.c \
 	src/internal/$(PACKAGE)_objlist_impl.c \
+	src/internal/$(PACKAGE)_objcache_impl.c \
 	src/internal/$(PACKAGE)_objmeta_impl.c \
 	src/internal/$(PACKAGE)_pecoff_impl.c \
 	src/internal/$(PACKAGE)_realpath_impl.c \
+	src/internal/$(PACKAGE)_rspfile_impl.c \
+	src/internal/$(PACKAGE)_sha256_impl.c \
 	src/internal/$(PACKAGE)_snprintf_impl.c \
 	src/internal/$(PACKAGE)_symlink_impl.c \
 	src/internal/$(PACKAGE)_tmpfile_impl.c \
+	src/internal/$(PACKAGE)_toolchain_impl.c \
 	src/internal/$(PACKAGE)_txtline_impl.c \
+	src/internal/$(PACKAGE)_which_impl.c \
 
 APP_SRCS = \
 	src/slibtool.c
@@ -34,6 +34,11 @@ cfgdefs_perform_common_tests()
 {
 	# headers
 	cfgtest_header_presence 'sys/syscall.h'
+
+	# libraries (shared driver state is guarded by pthread mutexes)
+	if cfgtest_library_presence '-lpthread'; then
+		cfgtest_ldflags_append '-lpthread'
+	fi
 }
 
 
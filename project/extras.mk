@@ -28,6 +28,7 @@ install-app-extras:
 	rm -f bin/$(NICKNAME)-shared$(OS_APP_SUFFIX).tmp
 	rm -f bin/$(NICKNAME)-static$(OS_APP_SUFFIX).tmp
 	rm -f bin/$(NICKNAME)-ar$(OS_APP_SUFFIX).tmp
+	rm -f bin/$(NICKNAME)-client$(OS_APP_SUFFIX).tmp
 
 	rm -f bin/$(DBGNAME)$(OS_APP_SUFFIX).tmp
 	rm -f bin/$(DBGNAME)-shared$(OS_APP_SUFFIX).tmp
@@ -54,6 +55,7 @@ install-app-extras:
 	ln -s ./$(NICKNAME)$(OS_APP_SUFFIX) bin/$(NICKNAME)-shared$(OS_APP_SUFFIX).tmp
 	ln -s ./$(NICKNAME)$(OS_APP_SUFFIX) bin/$(NICKNAME)-static$(OS_APP_SUFFIX).tmp
 	ln -s ./$(NICKNAME)$(OS_APP_SUFFIX) bin/$(NICKNAME)-ar$(OS_APP_SUFFIX).tmp
+	ln -s ./$(NICKNAME)$(OS_APP_SUFFIX) bin/$(NICKNAME)-client$(OS_APP_SUFFIX).tmp
 
 	ln -s ./$(NICKNAME)$(OS_APP_SUFFIX) bin/$(DBGNAME)$(OS_APP_SUFFIX).tmp
 	ln -s ./$(NICKNAME)$(OS_APP_SUFFIX) bin/$(DBGNAME)-shared$(OS_APP_SUFFIX).tmp
@@ -80,6 +82,7 @@ install-app-extras:
 	mv bin/$(NICKNAME)-shared$(OS_APP_SUFFIX).tmp $(DESTDIR)$(BINDIR)/$(NICKNAME)-shared$(OS_APP_SUFFIX)
 	mv bin/$(NICKNAME)-static$(OS_APP_SUFFIX).tmp $(DESTDIR)$(BINDIR)/$(NICKNAME)-static$(OS_APP_SUFFIX)
 	mv bin/$(NICKNAME)-ar$(OS_APP_SUFFIX).tmp     $(DESTDIR)$(BINDIR)/$(NICKNAME)-ar$(OS_APP_SUFFIX)
+	mv bin/$(NICKNAME)-client$(OS_APP_SUFFIX).tmp $(DESTDIR)$(BINDIR)/$(NICKNAME)-client$(OS_APP_SUFFIX)
 
 	mv bin/$(DBGNAME)$(OS_APP_SUFFIX).tmp         $(DESTDIR)$(BINDIR)/$(DBGNAME)$(OS_APP_SUFFIX)
 	mv bin/$(DBGNAME)-shared$(OS_APP_SUFFIX).tmp  $(DESTDIR)$(BINDIR)/$(DBGNAME)-shared$(OS_APP_SUFFIX)
@@ -10,6 +10,7 @@
 #include "slibtool_dprintf_impl.h"
 #include "slibtool_errinfo_impl.h"
 #include "slibtool_ar_impl.h"
+#include "slibtool_visibility_impl.h"
 
 #define SLBT_PRETTY_FLAGS       (SLBT_PRETTY_YAML      \
 	                         | SLBT_PRETTY_POSIX    \
@@ -60,7 +61,9 @@ static int slbt_au_output_arname_yaml(
 	return 0;
 }
 
-int slbt_au_output_arname(const struct slbt_archive_ctx * actx)
+slbt_hidden int slbt_au_output_arname_fdout(
+	const struct slbt_archive_ctx * actx,
+	int                             fdout)
 {
 	const struct slbt_driver_ctx *  dctx;
 	struct slbt_fd_ctx              fdctx;
@@ -70,6 +73,8 @@ int slbt_au_output_arname(const struct slbt_archive_ctx * actx)
 	if (slbt_lib_get_driver_fdctx(dctx,&fdctx) < 0)
 		return SLBT_NESTED_ERROR(dctx);
 
+	fdctx.fdout = fdout;
+
 	switch (dctx->cctx->fmtflags & SLBT_PRETTY_FLAGS) {
 		case SLBT_PRETTY_YAML:
 			return slbt_au_output_arname_yaml(
@@ -84,3 +89,13 @@ int slbt_au_output_arname(const struct slbt_archive_ctx * actx)
 				dctx,actx,&fdctx);
 	}
 }
+
+int slbt_au_output_arname(const struct slbt_archive_ctx * actx)
+{
+	const struct slbt_driver_ctx *  dctx;
+
+	dctx = (slbt_get_archive_ictx(actx))->dctx;
+
+	return slbt_au_output_arname_fdout(
+		actx,slbt_driver_fdout(dctx));
+}
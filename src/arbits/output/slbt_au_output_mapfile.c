@@ -5,6 +5,15 @@
 /*******************************************************************/
 
 #include <slibtool/slibtool.h>
+#include "slibtool_ar_impl.h"
+#include "slibtool_visibility_impl.h"
+
+slbt_hidden int slbt_au_output_mapfile_fdout(
+	const struct slbt_archive_meta *  meta,
+	int                               fdout)
+{
+	return slbt_ar_output_mapfile_fdout(meta,fdout);
+}
 
 int slbt_au_output_mapfile(const struct slbt_archive_meta * meta)
 {
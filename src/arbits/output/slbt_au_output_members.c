@@ -13,6 +13,7 @@
 #include "slibtool_dprintf_impl.h"
 #include "slibtool_errinfo_impl.h"
 #include "slibtool_ar_impl.h"
+#include "slibtool_visibility_impl.h"
 
 #define SLBT_PRETTY_FLAGS       (SLBT_PRETTY_YAML      \
 	                         | SLBT_PRETTY_POSIX    \
@@ -249,7 +250,9 @@ static int slbt_au_output_members_yaml(
 	return 0;
 }
 
-int slbt_au_output_members(const struct slbt_archive_meta * meta)
+slbt_hidden int slbt_au_output_members_fdout(
+	const struct slbt_archive_meta * meta,
+	int                              fdout)
 {
 	const struct slbt_driver_ctx *  dctx;
 	struct slbt_fd_ctx              fdctx;
@@ -259,6 +262,8 @@ int slbt_au_output_members(const struct slbt_archive_meta * meta)
 	if (slbt_lib_get_driver_fdctx(dctx,&fdctx) < 0)
 		return SLBT_NESTED_ERROR(dctx);
 
+	fdctx.fdout = fdout;
+
 	if (!meta->a_memberv)
 		return 0;
 
@@ -276,3 +281,13 @@ int slbt_au_output_members(const struct slbt_archive_meta * meta)
 				dctx,meta,&fdctx);
 	}
 }
+
+int slbt_au_output_members(const struct slbt_archive_meta * meta)
+{
+	const struct slbt_driver_ctx *  dctx;
+
+	dctx = (slbt_archive_meta_ictx(meta))->dctx;
+
+	return slbt_au_output_members_fdout(
+		meta,slbt_driver_fdout(dctx));
+}
@@ -14,8 +14,8 @@
 #include "slibtool_dprintf_impl.h"
 #include "slibtool_errinfo_impl.h"
 #include "slibtool_pecoff_impl.h"
-#include "slibtool_tmpfile_impl.h"
 #include "slibtool_ar_impl.h"
+#include "slibtool_visibility_impl.h"
 
 #define SLBT_PRETTY_FLAGS       (SLBT_PRETTY_YAML      \
 	                         | SLBT_PRETTY_POSIX    \
@@ -81,24 +81,21 @@ static int slbt_au_output_symbols_posix(
 
 static int slbt_au_output_one_symbol_yaml(
 	int                             fdout,
-	struct slbt_archive_meta_impl * mctx,
+	struct ar_meta_symbol_info *    syminfo,
 	const char *                    symname)
 {
-	struct ar_meta_symbol_info **   syminfv;
-
-	for (syminfv=mctx->syminfv; *syminfv; syminfv++)
-		if (!strcmp(syminfv[0]->ar_symbol_name,symname))
-			return slbt_dprintf(
-				fdout,
-				"    - Symbol:\n"
-				"      - [ object_name: " "%s"    " ]\n"
-				"      - [ symbol_name: " "%s"    " ]\n"
-				"      - [ symbol_type: " "%s"    " ]\n\n",
-				syminfv[0]->ar_object_name,
-				symname,
-				syminfv[0]->ar_symbol_type);
+	if (!syminfo->ar_symbol_type)
+		return 0;
 
-	return 0;
+	return slbt_dprintf(
+		fdout,
+		"    - Symbol:\n"
+		"      - [ object_name: " "%s"    " ]\n"
+		"      - [ symbol_name: " "%s"    " ]\n"
+		"      - [ symbol_type: " "%s"    " ]\n\n",
+		syminfo->ar_object_name,
+		symname,
+		syminfo->ar_symbol_type);
 }
 
 static int slbt_au_output_symbols_yaml(
@@ -106,14 +103,14 @@ static int slbt_au_output_symbols_yaml(
 	struct slbt_archive_meta_impl * mctx,
 	int                             fdout)
 {
-	int                             fdtmp;
 	bool                            fsort;
 	bool                            fcoff;
+	uint64_t                        idx;
 	const char *                    dot;
 	const char *                    mark;
 	const char *                    regex;
-	const char **                   symv;
-	const char **                   symstrv;
+	const char *                    symname;
+	struct ar_meta_symbol_info *    syminfo;
 	regex_t                         regctx;
 	regmatch_t                      pmatch[2] = {{0,0},{0,0}};
 	char                            strbuf[4096];
@@ -121,38 +118,35 @@ static int slbt_au_output_symbols_yaml(
 	fsort = !(dctx->cctx->fmtflags & SLBT_OUTPUT_ARCHIVE_NOSORT);
 	fcoff = (mctx->ofmtattr & AR_OBJECT_ATTR_COFF);
 
-	if ((fdtmp = slbt_tmpfile()) < 0)
-		return SLBT_SYSTEM_ERROR(dctx,0);
-
-	if (fsort && !mctx->mapstrv)
-		if (slbt_update_mapstrv(dctx,mctx) < 0)
+	if (!mctx->syminfo)
+		if (slbt_ar_update_syminfo(mctx->actx) < 0)
 			return SLBT_NESTED_ERROR(dctx);
 
-	if (slbt_ar_update_syminfo_ex(mctx->actx,fdtmp) < 0)
-		return SLBT_NESTED_ERROR(dctx);
-
 	if ((regex = dctx->cctx->regex))
 		if (regcomp(&regctx,regex,REG_EXTENDED|REG_NEWLINE))
 			return SLBT_CUSTOM_ERROR(
 				dctx,
 				SLBT_ERR_FLOW_ERROR);
 
-	symstrv = fsort ? mctx->mapstrv : mctx->symstrv;
-
 	if (slbt_dprintf(fdout,"  - Symbols:\n") < 0)
 		return SLBT_SYSTEM_ERROR(dctx,0);
 
-	for (symv=symstrv; *symv; symv++) {
-		if (!fcoff || slbt_is_strong_coff_symbol(*symv)) {
-			if (!regex || !regexec(&regctx,*symv,1,pmatch,0)) {
+	/* syminfv is sorted in the same (coff-aware) order as mapstrv, */
+	/* and syminfo follows the armap order of symstrv.              */
+	for (idx=0; idx<mctx->armaps.armap_nsyms; idx++) {
+		syminfo = fsort ? mctx->syminfv[idx] : &mctx->syminfo[idx];
+		symname = syminfo->ar_symbol_name;
+
+		if (!fcoff || slbt_is_strong_coff_symbol(symname)) {
+			if (!regex || !regexec(&regctx,symname,1,pmatch,0)) {
 				if (slbt_au_output_one_symbol_yaml(
-						fdout,mctx,*symv) < 0)
+						fdout,syminfo,symname) < 0)
 					return SLBT_SYSTEM_ERROR(dctx,0);
 			}
 
 		/* coff weak symbols: expsym = .weak.alias.strong */
-		} else if (fcoff && !strncmp(*symv,".weak.",6)) {
-			mark = &(*symv)[6];
+		} else if (fcoff && !strncmp(symname,".weak.",6)) {
+			mark = &symname[6];
 			dot  = strchr(mark,'.');
 
 			strncpy(strbuf,mark,dot-mark);
@@ -160,7 +154,7 @@ static int slbt_au_output_symbols_yaml(
 
 			if (!regex || !regexec(&regctx,strbuf,1,pmatch,0))
 				if (slbt_au_output_one_symbol_yaml(
-						fdout,mctx,strbuf) < 0)
+						fdout,syminfo,strbuf) < 0)
 					return SLBT_SYSTEM_ERROR(dctx,0);
 		}
 	}
@@ -171,17 +165,16 @@ static int slbt_au_output_symbols_yaml(
 	return 0;
 }
 
-int slbt_au_output_symbols(const struct slbt_archive_meta * meta)
+slbt_hidden int slbt_au_output_symbols_fdout(
+	const struct slbt_archive_meta * meta,
+	int                              fdout)
 {
 	struct slbt_archive_meta_impl * mctx;
 	const struct slbt_driver_ctx *  dctx;
-	int                             fdout;
 
 	mctx = slbt_archive_meta_ictx(meta);
 	dctx = (slbt_archive_meta_ictx(meta))->dctx;
 
-	fdout = slbt_driver_fdout(dctx);
-
 	if (!meta->a_memberv)
 		return 0;
 
@@ -199,3 +192,13 @@ int slbt_au_output_symbols(const struct slbt_archive_meta * meta)
 				dctx,mctx,fdout);
 	}
 }
+
+int slbt_au_output_symbols(const struct slbt_archive_meta * meta)
+{
+	const struct slbt_driver_ctx *  dctx;
+
+	dctx = (slbt_archive_meta_ictx(meta))->dctx;
+
+	return slbt_au_output_symbols_fdout(
+		meta,slbt_driver_fdout(dctx));
+}
@@ -4,16 +4,96 @@
 /*  Released under the Standard MIT License; see COPYING.SLIBTOOL. */
 /*******************************************************************/
 
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
 #include <slibtool/slibtool.h>
 #include "slibtool_ar_impl.h"
 #include "slibtool_driver_impl.h"
 #include "slibtool_snprintf_impl.h"
 #include "slibtool_errinfo_impl.h"
+#include "slibtool_sha256_impl.h"
+#include "slibtool_visibility_impl.h"
+
+#define SLBT_DLSYMS_NTYPES      10
+
+#define SLBT_DLSYMS_SIGNATURE   "slibtool dlsyms vtable, version 1"
+
+/* symbol types, in order of declaration */
+static const struct {
+	char            stype;
+	const char *    desc;
+} slbt_dlsyms_stypes[SLBT_DLSYMS_NTYPES] = {
+	{'A',"Data Symbols: Absolute Values"},
+	{'B',"Data Symbols: BSS Section"},
+	{'C',"Data Symbols: Common Section"},
+	{'D',"Data Symbols: Initialized Data"},
+
+	{'G',"Data Symbols: Small Globals"},
+	{'I',"Data Symbols: Indirect References"},
+	{'R',"Data Symbols: Read-Only Section"},
+
+	{'S',"Data Symbols: Small Objects"},
+	{'W',"Data Symbols: Weak Symbols"},
+
+	{'T',"Text Section: Public Interfaces"},
+};
+
+/* symbol type --> bucket index (plus one) */
+static const unsigned char slbt_dlsyms_bucket['Z'-'A'+1] = {
+	['A'-'A'] = 1,
+	['B'-'A'] = 2,
+	['C'-'A'] = 3,
+	['D'-'A'] = 4,
+	['G'-'A'] = 5,
+	['I'-'A'] = 6,
+	['R'-'A'] = 7,
+	['S'-'A'] = 8,
+	['W'-'A'] = 9,
+	['T'-'A'] = 10,
+};
+
+/* vtable entries, in order of emission (as generated to date) */
+static const char slbt_dlsyms_vtable_order[] = "ABCDGIRSST";
+
+struct slbt_dlsyms_symbol {
+	const char *                    symname;
+	size_t                          symlen;
+};
+
+struct slbt_dlsyms_archive {
+	const char *                    arname;
+	struct slbt_dlsyms_symbol *     symv[SLBT_DLSYMS_NTYPES];
+	uint64_t                        nsyms[SLBT_DLSYMS_NTYPES];
+};
+
+struct slbt_dlsyms_ctx {
+	struct slbt_dlsyms_archive *    archivev;
+	struct slbt_dlsyms_symbol *     symbolv;
+	char *                          strpool;
+	size_t                          maxlen;
+};
+
+static int slbt_dlsyms_bucket_idx(const struct ar_meta_symbol_info * syminfo)
+{
+	char stype = syminfo->ar_symbol_type[0];
+
+	if ((stype < 'A') || (stype > 'Z'))
+		return -1;
+
+	return slbt_dlsyms_bucket[stype - 'A'] - 1;
+}
+
+static bool slbt_dlsyms_is_coff_weak(const char * symname, bool fcoff)
+{
+	return fcoff && !strncmp(symname,".weak.",6);
+}
 
 static const char * slbt_strong_symname(
 	const char *    symname,
 	bool            fcoff,
-	char            (*strbuf)[4096])
+	char **         pstrpool)
 {
 	const char *    dot;
 	const char *    mark;
@@ -26,135 +106,199 @@ static const char * slbt_strong_symname(
 		if (strncmp(symname,".weak.",6))
 			return symname;
 
-		sym  = *strbuf;
+		sym  = *pstrpool;
 		mark = &symname[6];
-		dot  = strchr(mark,'.');
 
-		strncpy(sym,mark,dot-mark);
+		if (!(dot = strchr(mark,'.')))
+			dot = &mark[strlen(mark)];
+
+		memcpy(sym,mark,dot-mark);
 		sym[dot-mark] = '\0';
 
+		*pstrpool += dot - mark + 1;
+
 		return sym;
 	}
 
 	return symname;
 }
 
+static void slbt_ar_dlsyms_free_ctx(struct slbt_dlsyms_ctx * sctx)
+{
+	free(sctx->archivev);
+	free(sctx->symbolv);
+	free(sctx->strpool);
+}
 
-static int slbt_ar_dlsyms_define_by_type(
-	int                                 fdout,
-	const char *                        arname,
-	struct slbt_archive_meta_impl *     mctx,
-	const char *                        desc,
-	const char                          stype)
+static int slbt_ar_dlsyms_classify(
+	const struct slbt_driver_ctx *      dctx,
+	struct slbt_archive_ctx **          arctxv,
+	struct slbt_dlsyms_ctx *            sctx)
 {
-	uint64_t      idx;
-	uint64_t      nsyms;
-	bool          fcoff;
-	const char *  symname;
-	char          strbuf[4096];
+	int                                 bidx;
+	uint64_t                            idx;
+	size_t                              narchives;
+	size_t                              nsymbols;
+	size_t                              poolsize;
+	bool                                fcoff;
+	const char *                        symname;
+	char *                              strpool;
+	struct slbt_archive_ctx **          parctx;
+	struct slbt_archive_ctx_impl *      ictx;
+	struct slbt_archive_meta_impl *     mctx;
+	struct slbt_dlsyms_archive *        dlar;
+	struct slbt_dlsyms_symbol *         sym;
+	struct ar_meta_symbol_info *        syminfo;
 
-	for (idx=0,nsyms=0; idx<mctx->armaps.armap_nsyms; idx++)
-		if (mctx->syminfv[idx]->ar_symbol_type[0] == stype)
-			nsyms++;
+	/* vector sizes */
+	narchives = 0;
+	nsymbols  = 0;
+	poolsize  = 1;
 
-	if (nsyms == 0)
-		return 0;
+	for (parctx=arctxv; *parctx; parctx++) {
+		ictx = slbt_get_archive_ictx(*parctx);
+		mctx = slbt_archive_meta_ictx(ictx->meta);
 
-	fcoff  = slbt_host_objfmt_is_coff(mctx->dctx);
-	fcoff |= (mctx->ofmtattr & AR_OBJECT_ATTR_COFF);
+		fcoff  = slbt_host_objfmt_is_coff(dctx);
+		fcoff |= (mctx->ofmtattr & AR_OBJECT_ATTR_COFF);
 
-	if (slbt_dprintf(fdout,"/* %s (%s) */\n",desc,arname) < 0)
-		return SLBT_SYSTEM_ERROR(mctx->dctx,0);
+		for (idx=0; idx<mctx->armaps.armap_nsyms; idx++)
+			if (slbt_dlsyms_is_coff_weak(mctx->syminfv[idx]->ar_symbol_name,fcoff))
+				poolsize += strlen(mctx->syminfv[idx]->ar_symbol_name);
 
-	for (idx=0; idx<mctx->armaps.armap_nsyms; idx++)
-		if (mctx->syminfv[idx]->ar_symbol_type[0] == stype)
-			if ((symname = slbt_strong_symname(
-					mctx->syminfv[idx]->ar_symbol_name,
-					fcoff,&strbuf)))
-				if (slbt_dprintf(fdout,
-						(stype == 'T')
-							? "extern int %s();\n"
-							: "extern char %s[];\n",
-						symname) < 0)
-					return SLBT_SYSTEM_ERROR(mctx->dctx,0);
+		nsymbols += mctx->armaps.armap_nsyms;
+		narchives++;
+	}
 
-	if (slbt_dprintf(fdout,"\n") < 0)
-		return SLBT_SYSTEM_ERROR(mctx->dctx,0);
+	if (!(sctx->archivev = calloc(narchives + 1,sizeof(*sctx->archivev))))
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	if (!(sctx->symbolv = calloc(nsymbols + 1,sizeof(*sctx->symbolv))))
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	if (!(sctx->strpool = calloc(poolsize,1)))
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	/* one pass over each archive's symbols: count by type, then bucket */
+	sym     = sctx->symbolv;
+	strpool = sctx->strpool;
+	dlar    = sctx->archivev;
+
+	for (parctx=arctxv; *parctx; parctx++,dlar++) {
+		ictx = slbt_get_archive_ictx(*parctx);
+		mctx = slbt_archive_meta_ictx(ictx->meta);
+
+		if ((dlar->arname = strrchr(*(*parctx)->path,'/')))
+			dlar->arname++;
+
+		if (!dlar->arname)
+			dlar->arname = *(*parctx)->path;
+
+		if (sctx->maxlen < strlen(dlar->arname))
+			sctx->maxlen = strlen(dlar->arname);
+
+		fcoff  = slbt_host_objfmt_is_coff(dctx);
+		fcoff |= (mctx->ofmtattr & AR_OBJECT_ATTR_COFF);
+
+		for (idx=0; idx<mctx->armaps.armap_nsyms; idx++)
+			if ((bidx = slbt_dlsyms_bucket_idx(mctx->syminfv[idx])) >= 0)
+				dlar->nsyms[bidx]++;
+
+		for (bidx=0; bidx<SLBT_DLSYMS_NTYPES; bidx++) {
+			dlar->symv[bidx] = sym;
+			sym += dlar->nsyms[bidx];
+			dlar->nsyms[bidx] = 0;
+		}
+
+		for (idx=0; idx<mctx->armaps.armap_nsyms; idx++) {
+			syminfo = mctx->syminfv[idx];
+
+			if ((bidx = slbt_dlsyms_bucket_idx(syminfo)) < 0)
+				continue;
+
+			symname = slbt_strong_symname(
+				syminfo->ar_symbol_name,
+				fcoff,&strpool);
+
+			dlar->symv[bidx][dlar->nsyms[bidx]].symname = symname;
+			dlar->symv[bidx][dlar->nsyms[bidx]].symlen  = symname ? strlen(symname) : 0;
+
+			if (sctx->maxlen < dlar->symv[bidx][dlar->nsyms[bidx]].symlen)
+				sctx->maxlen = dlar->symv[bidx][dlar->nsyms[bidx]].symlen;
+
+			dlar->nsyms[bidx]++;
+		}
+	}
 
 	return 0;
 }
 
-static int slbt_ar_dlsyms_get_max_len_by_type(
-	int                                 mlen,
-	struct slbt_archive_meta_impl *     mctx,
-	const char                          stype)
+
+static int slbt_ar_dlsyms_define_by_type(
+	int                                 fdout,
+	const struct slbt_driver_ctx *      dctx,
+	const struct slbt_dlsyms_archive *  dlar,
+	int                                 bidx)
 {
-	int           len;
-	uint64_t      idx;
-	bool          fcoff;
-	const char *  symname;
-	char          strbuf[4096];
-
-	fcoff  = slbt_host_objfmt_is_coff(mctx->dctx);
-	fcoff |= (mctx->ofmtattr & AR_OBJECT_ATTR_COFF);
-
-	for (idx=0; idx<mctx->armaps.armap_nsyms; idx++)
-		if (mctx->syminfv[idx]->ar_symbol_type[0] == stype)
-			if ((symname = slbt_strong_symname(
-					mctx->syminfv[idx]->ar_symbol_name,
-					fcoff,&strbuf)))
-				if ((len = strlen(symname)) > mlen)
-					mlen = len;
-
-	return mlen;
+	uint64_t                            idx;
+	const struct slbt_dlsyms_symbol *   sym;
+	char                                stype;
+
+	if (dlar->nsyms[bidx] == 0)
+		return 0;
+
+	stype = slbt_dlsyms_stypes[bidx].stype;
+
+	if (slbt_dprintf(fdout,"/* %s (%s) */\n",
+			slbt_dlsyms_stypes[bidx].desc,
+			dlar->arname) < 0)
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	for (idx=0,sym=dlar->symv[bidx]; idx<dlar->nsyms[bidx]; idx++,sym++)
+		if (sym->symname)
+			if (slbt_dprintf(fdout,
+					(stype == 'T')
+						? "extern int %s();\n"
+						: "extern char %s[];\n",
+					sym->symname) < 0)
+				return SLBT_SYSTEM_ERROR(dctx,0);
+
+	if (slbt_dprintf(fdout,"\n") < 0)
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	return 0;
 }
 
 static int slbt_ar_dlsyms_add_by_type(
 	int                                 fdout,
-	struct slbt_archive_meta_impl *     mctx,
+	const struct slbt_driver_ctx *      dctx,
+	const struct slbt_dlsyms_archive *  dlar,
 	const char *                        fmt,
-	const char                          stype,
+	int                                 bidx,
 	char                                (*namebuf)[4096])
 {
-	uint64_t      idx;
-	uint64_t      nsyms;
-	bool          fcoff;
-	const char *  symname;
-	char          strbuf[4096];
+	uint64_t                            idx;
+	const struct slbt_dlsyms_symbol *   sym;
+	char                                stype;
 
-	nsyms   = 0;
-	symname = *namebuf;
-
-	fcoff  = slbt_host_objfmt_is_coff(mctx->dctx);
-	fcoff |= (mctx->ofmtattr & AR_OBJECT_ATTR_COFF);
-
-	for (idx=0; idx<mctx->armaps.armap_nsyms; idx++)
-		if (mctx->syminfv[idx]->ar_symbol_type[0] == stype)
-			nsyms++;
-
-	if (nsyms == 0)
+	if (dlar->nsyms[bidx] == 0)
 		return 0;
 
+	stype = slbt_dlsyms_stypes[bidx].stype;
+
 	if (slbt_dprintf(fdout,"\n") < 0)
-		return SLBT_SYSTEM_ERROR(mctx->dctx,0);
+		return SLBT_SYSTEM_ERROR(dctx,0);
 
-	for (idx=0; idx<mctx->armaps.armap_nsyms; idx++) {
-		if (mctx->syminfv[idx]->ar_symbol_type[0] == stype) {
-			symname = slbt_strong_symname(
-				mctx->syminfv[idx]->ar_symbol_name,
-				fcoff,&strbuf);
-
-			if (symname) {
-				if (slbt_snprintf(*namebuf,sizeof(*namebuf),
-						"%s\",",symname) < 0)
-					return SLBT_SYSTEM_ERROR(mctx->dctx,0);
-
-				if (slbt_dprintf(fdout,fmt,
-						*namebuf,
-						(stype == 'T') ? "&" : "",
-						symname) < 0)
-					return SLBT_NESTED_ERROR(mctx->dctx);
-			}
+	for (idx=0,sym=dlar->symv[bidx]; idx<dlar->nsyms[bidx]; idx++,sym++) {
+		if (sym->symname) {
+			memcpy(*namebuf,sym->symname,sym->symlen);
+			memcpy(&(*namebuf)[sym->symlen],"\",",3);
+
+			if (slbt_dprintf(fdout,fmt,
+					*namebuf,
+					(stype == 'T') ? "&" : "",
+					sym->symname) < 0)
+				return SLBT_NESTED_ERROR(dctx);
 		}
 	}
 
@@ -162,29 +306,25 @@ static int slbt_ar_dlsyms_add_by_type(
 }
 
 
-static int slbt_ar_output_dlsyms_impl(
+static int slbt_ar_output_dlsyms_vtable(
 	int                                 fdout,
 	const struct slbt_driver_ctx *      dctx,
 	struct slbt_archive_ctx **          arctxv,
+	struct slbt_dlsyms_ctx *            sctx,
 	const char *                        dsounit)
 {
 	int                                 ret;
 	int                                 idx;
 	unsigned                            len;
-	unsigned                            cmp;
-	const char *                        arname;
 	const char *                        soname;
-	struct slbt_archive_ctx *           actx;
-	struct slbt_archive_ctx **          parctx;
-	struct slbt_archive_ctx_impl *      ictx;
-	struct slbt_archive_meta_impl *     mctx;
+	const char *                        stype;
+	struct slbt_dlsyms_archive *        dlar;
 	const struct slbt_source_version *  verinfo;
 	char                                dlsymfmt[32];
 	char                                cline[6][73];
 	char                                symname[4096];
 
 	/* init */
-	actx    = arctxv[0];
 	verinfo = slbt_api_source_version();
 
 	/* preamble */
@@ -235,35 +375,10 @@ static int slbt_ar_output_dlsyms_impl(
 		return SLBT_SYSTEM_ERROR(dctx,0);
 
 	/* declarations */
-	for (parctx=arctxv; *parctx; parctx++) {
-		actx   = *parctx;
-		ictx   = slbt_get_archive_ictx(actx);
-		mctx   = slbt_archive_meta_ictx(ictx->meta);
-
-		if ((arname = strrchr(*actx->path,'/')))
-			arname++;
-
-		if (!arname)
-			arname = *actx->path;
-
-		ret  = slbt_ar_dlsyms_define_by_type(fdout,arname,mctx,"Data Symbols: Absolute Values",     'A');
-		ret |= slbt_ar_dlsyms_define_by_type(fdout,arname,mctx,"Data Symbols: BSS Section",         'B');
-		ret |= slbt_ar_dlsyms_define_by_type(fdout,arname,mctx,"Data Symbols: Common Section",      'C');
-		ret |= slbt_ar_dlsyms_define_by_type(fdout,arname,mctx,"Data Symbols: Initialized Data",    'D');
-
-		ret |= slbt_ar_dlsyms_define_by_type(fdout,arname,mctx,"Data Symbols: Small Globals",       'G');
-		ret |= slbt_ar_dlsyms_define_by_type(fdout,arname,mctx,"Data Symbols: Indirect References", 'I');
-		ret |= slbt_ar_dlsyms_define_by_type(fdout,arname,mctx,"Data Symbols: Read-Only Section",   'R');
-
-		ret |= slbt_ar_dlsyms_define_by_type(fdout,arname,mctx,"Data Symbols: Small Objects",       'S');
-		ret |= slbt_ar_dlsyms_define_by_type(fdout,arname,mctx,"Data Symbols: Weak Symbols",        'W');
-
-		ret |= slbt_ar_dlsyms_define_by_type(fdout,arname,mctx,"Text Section: Public Interfaces",   'T');
-
-		if (ret < 0)
-			return SLBT_NESTED_ERROR(dctx);
-
-	}
+	for (dlar=sctx->archivev; dlar->arname; dlar++)
+		for (idx=0; idx<SLBT_DLSYMS_NTYPES; idx++)
+			if (slbt_ar_dlsyms_define_by_type(fdout,dctx,dlar,idx) < 0)
+				return SLBT_NESTED_ERROR(dctx);
 
 	/* vtable struct definition */
 	if (slbt_dprintf(fdout,
@@ -285,43 +400,15 @@ static int slbt_ar_output_dlsyms_impl(
 			soname,soname) < 0)
 		return SLBT_NESTED_ERROR(dctx);
 
-	/* align dlsym_name and dlsym_addr columsn (because we can) */
-	for (parctx=arctxv,len=0; *parctx; parctx++) {
-		actx = *parctx;
-		ictx = slbt_get_archive_ictx(actx);
-		mctx = slbt_archive_meta_ictx(ictx->meta);
-
-		if ((arname = strrchr(*actx->path,'/')))
-			arname++;
-
-		if (!arname)
-			arname = *actx->path;
-
-		if (len < (cmp = strlen(arname)))
-			len = cmp;
-
-		len  = slbt_ar_dlsyms_get_max_len_by_type(len,mctx,'A');
-		len  = slbt_ar_dlsyms_get_max_len_by_type(len,mctx,'B');
-		len  = slbt_ar_dlsyms_get_max_len_by_type(len,mctx,'C');
-		len  = slbt_ar_dlsyms_get_max_len_by_type(len,mctx,'D');
-
-		len  = slbt_ar_dlsyms_get_max_len_by_type(len,mctx,'G');
-		len  = slbt_ar_dlsyms_get_max_len_by_type(len,mctx,'I');
-		len  = slbt_ar_dlsyms_get_max_len_by_type(len,mctx,'R');
-
-		len  = slbt_ar_dlsyms_get_max_len_by_type(len,mctx,'S');
-		len  = slbt_ar_dlsyms_get_max_len_by_type(len,mctx,'T');
-		len  = slbt_ar_dlsyms_get_max_len_by_type(len,mctx,'W');
-	}
-
-	/* quote, comma */
-	len += 2;
-
-	if (len >= sizeof(symname))
+	/* align dlsym_name and dlsym_addr columns (because we can), */
+	/* quote, comma                                                */
+	if (sctx->maxlen + 2 >= sizeof(symname))
 		return SLBT_CUSTOM_ERROR(
 			dctx,
 			SLBT_ERR_FLOW_ERROR);
 
+	len = sctx->maxlen + 2;
+
 	/* aligned print format */
 	snprintf(dlsymfmt,sizeof(dlsymfmt),"\t{\"%%-%ds %%s%%s},\n",len);
 
@@ -333,51 +420,36 @@ static int slbt_ar_output_dlsyms_impl(
 		return SLBT_NESTED_ERROR(dctx);
 
 	/* (-dlopen force) */
+	dlar = sctx->archivev;
+
 	if (!arctxv[0]->meta->a_memberv)
 		if (!strcmp(*arctxv[0]->path,"@PROGRAM@"))
-			arctxv++;
+			dlar++;
 
 	/* at long last */
-	for (parctx=arctxv; *parctx; parctx++) {
-		actx = *parctx;
-		ictx = slbt_get_archive_ictx(actx);
-		mctx = slbt_archive_meta_ictx(ictx->meta);
-
-		if ((arname = strrchr(*actx->path,'/')))
-			arname++;
-
-		if (!arname)
-			arname = *actx->path;
-
+	for (; dlar->arname; dlar++) {
 		if (slbt_dprintf(fdout,"\n") < 0)
-			return SLBT_NESTED_ERROR(mctx->dctx);
+			return SLBT_NESTED_ERROR(dctx);
 
-		if (slbt_snprintf(symname,sizeof(symname),"%s\",",arname) < 0)
-			return SLBT_SYSTEM_ERROR(mctx->dctx,0);
+		if (slbt_snprintf(symname,sizeof(symname),"%s\",",dlar->arname) < 0)
+			return SLBT_SYSTEM_ERROR(dctx,0);
 
 		if (slbt_dprintf(fdout,dlsymfmt,symname,"","0") < 0)
-			return SLBT_NESTED_ERROR(mctx->dctx);
-
-		ret  = slbt_ar_dlsyms_add_by_type(fdout,mctx,dlsymfmt,'A',&symname);
-		ret |= slbt_ar_dlsyms_add_by_type(fdout,mctx,dlsymfmt,'B',&symname);
-		ret |= slbt_ar_dlsyms_add_by_type(fdout,mctx,dlsymfmt,'C',&symname);
-		ret |= slbt_ar_dlsyms_add_by_type(fdout,mctx,dlsymfmt,'D',&symname);
-
-		ret |= slbt_ar_dlsyms_add_by_type(fdout,mctx,dlsymfmt,'G',&symname);
-		ret |= slbt_ar_dlsyms_add_by_type(fdout,mctx,dlsymfmt,'I',&symname);
-		ret |= slbt_ar_dlsyms_add_by_type(fdout,mctx,dlsymfmt,'R',&symname);
+			return SLBT_NESTED_ERROR(dctx);
 
-		ret |= slbt_ar_dlsyms_add_by_type(fdout,mctx,dlsymfmt,'S',&symname);
-		ret |= slbt_ar_dlsyms_add_by_type(fdout,mctx,dlsymfmt,'S',&symname);
-		ret |= slbt_ar_dlsyms_add_by_type(fdout,mctx,dlsymfmt,'T',&symname);
+		for (stype=slbt_dlsyms_vtable_order; *stype; stype++) {
+			idx = slbt_dlsyms_bucket[*stype - 'A'] - 1;
+			ret = slbt_ar_dlsyms_add_by_type(
+				fdout,dctx,dlar,dlsymfmt,idx,&symname);
 
-		if (ret < 0)
-			return SLBT_NESTED_ERROR(dctx);
+			if (ret < 0)
+				return SLBT_NESTED_ERROR(dctx);
+		}
 	}
 
 	/* null-terminate the vtable */
 	if (slbt_dprintf(fdout,"\n\t{%d,%*c%d}\n",0,len,' ',0) < 0)
-		return SLBT_NESTED_ERROR(mctx->dctx);
+		return SLBT_NESTED_ERROR(dctx);
 
 	/* close vtable, wrap translation unit */
 	if (slbt_dprintf(fdout,
@@ -391,6 +463,26 @@ static int slbt_ar_output_dlsyms_impl(
 }
 
 
+static int slbt_ar_output_dlsyms_impl(
+	int                                 fdout,
+	const struct slbt_driver_ctx *      dctx,
+	struct slbt_archive_ctx **          arctxv,
+	const char *                        dsounit)
+{
+	int                                 ret;
+	struct slbt_dlsyms_ctx              sctx = {0};
+
+	/* classify and measure all symbols once, then emit by bucket */
+	if ((ret = slbt_ar_dlsyms_classify(dctx,arctxv,&sctx)) == 0)
+		ret = slbt_ar_output_dlsyms_vtable(
+			fdout,dctx,arctxv,&sctx,dsounit);
+
+	slbt_ar_dlsyms_free_ctx(&sctx);
+
+	return (ret < 0) ? SLBT_NESTED_ERROR(dctx) : 0;
+}
+
+
 static int slbt_ar_create_dlsyms_impl(
 	struct slbt_archive_ctx **        arctxv,
 	const char *                      dlunit,
@@ -456,3 +548,71 @@ int slbt_ar_create_dlsyms(
 {
 	return slbt_ar_create_dlsyms_impl(arctxv,dlunit,path,mode);
 }
+
+
+slbt_hidden int slbt_ar_get_dlsyms_digest(
+	struct slbt_archive_ctx **          arctxv,
+	const char *                        dlunit,
+	char                                (*digest)[SLBT_SHA256_HEXDIGEST_SIZE])
+{
+	uint64_t                            idx;
+	bool                                fcoff;
+	unsigned char                       flags[2];
+	struct slbt_archive_ctx **          parctx;
+	struct slbt_archive_meta_impl *     mctx;
+	struct ar_meta_symbol_info *        syminfo;
+	const struct slbt_driver_ctx *      dctx;
+	const struct slbt_source_version *  verinfo;
+	struct slbt_sha256_ctx              sha;
+	char                                verbuf[64];
+
+	mctx    = slbt_archive_meta_ictx(arctxv[0]->meta);
+	dctx    = mctx->dctx;
+	verinfo = slbt_api_source_version();
+
+	/* everything that the generated vtable source depends on */
+	snprintf(verbuf,sizeof(verbuf),"%d.%d.%d",
+		verinfo->major,verinfo->minor,verinfo->revision);
+
+	slbt_sha256_init(&sha);
+	slbt_sha256_update(&sha,SLBT_DLSYMS_SIGNATURE,sizeof(SLBT_DLSYMS_SIGNATURE));
+	slbt_sha256_update(&sha,verbuf,strlen(verbuf)+1);
+	slbt_sha256_update(&sha,verinfo->commit,strlen(verinfo->commit)+1);
+	slbt_sha256_update(&sha,dctx->program,strlen(dctx->program)+1);
+	slbt_sha256_update(&sha,dlunit,strlen(dlunit)+1);
+
+	for (parctx=arctxv; *parctx; parctx++) {
+		mctx = slbt_archive_meta_ictx((*parctx)->meta);
+
+		if (!mctx->syminfo)
+			if (slbt_ar_update_syminfo(*parctx) < 0)
+				return SLBT_NESTED_ERROR(dctx);
+
+		fcoff  = slbt_host_objfmt_is_coff(dctx);
+		fcoff |= (mctx->ofmtattr & AR_OBJECT_ATTR_COFF);
+
+		flags[0] = fcoff;
+		flags[1] = !!(*parctx)->meta->a_memberv;
+
+		slbt_sha256_update(&sha,*(*parctx)->path,strlen(*(*parctx)->path)+1);
+		slbt_sha256_update(&sha,flags,sizeof(flags));
+
+		for (idx=0; idx<mctx->armaps.armap_nsyms; idx++) {
+			syminfo = mctx->syminfv[idx];
+
+			if (!syminfo->ar_symbol_type || !syminfo->ar_symbol_name)
+				continue;
+
+			slbt_sha256_update(&sha,syminfo->ar_symbol_type,1);
+			slbt_sha256_update(&sha,
+				syminfo->ar_symbol_name,
+				strlen(syminfo->ar_symbol_name)+1);
+		}
+
+		slbt_sha256_update(&sha,"",1);
+	}
+
+	slbt_sha256_hexdigest(&sha,*digest);
+
+	return 0;
+}
@@ -0,0 +1,916 @@
+/*******************************************************************/
+/*  slibtool: a strong libtool implementation, written in C        */
+/*  Copyright (C) 2016--2024  SysDeer Technologies, LLC            */
+/*  Released under the Standard MIT License; see COPYING.SLIBTOOL. */
+/*******************************************************************/
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <sys/types.h>
+
+#include <slibtool/slibtool.h>
+#include <slibtool/slibtool_arbits.h>
+#include "slibtool_ar_impl.h"
+#include "slibtool_driver_impl.h"
+#include "slibtool_errinfo_impl.h"
+#include "slibtool_visibility_impl.h"
+
+/*****************************************************************/
+/* PE/COFF import libraries in the short import format: a GNU    */
+/* archive whose head holds the import descriptor and the null   */
+/* import descriptor objects, followed by one short import       */
+/* member (header, symbol name, dll name) per exported symbol,   */
+/* and whose tail holds the null thunk object; member names      */
+/* follow that order, since the linker sorts .idata by member.   */
+/* Time stamps, owners, and modes are fixed, so that the output  */
+/* depends only on the .def file, dll name, and target machine.  */
+/*****************************************************************/
+
+#define PE_IMPORT_CODE                  (0)
+#define PE_IMPORT_DATA                  (1)
+#define PE_IMPORT_CONST                 (2)
+
+#define PE_IMPORT_ORDINAL               (0)
+#define PE_IMPORT_NAME                  (1)
+#define PE_IMPORT_NAME_NOPREFIX         (2)
+
+#define PE_FILE_32BIT_MACHINE           (0x0100)
+
+#define PE_SCN_CNT_INITIALIZED_DATA     (0x00000040)
+#define PE_SCN_ALIGN_2BYTES             (0x00200000)
+#define PE_SCN_ALIGN_4BYTES             (0x00300000)
+#define PE_SCN_ALIGN_8BYTES             (0x00400000)
+#define PE_SCN_MEM_READ                 (0x40000000)
+#define PE_SCN_MEM_WRITE                (0x80000000)
+
+#define PE_SCN_IDATA                    (PE_SCN_CNT_INITIALIZED_DATA \
+                                        | PE_SCN_MEM_READ            \
+                                        | PE_SCN_MEM_WRITE)
+
+#define PE_SYM_CLASS_EXTERNAL           (2)
+#define PE_SYM_CLASS_STATIC             (3)
+
+#define PE_COFF_HEADER_SIZE             (20)
+#define PE_SECTION_HEADER_SIZE          (40)
+#define PE_RELOC_SIZE                   (10)
+#define PE_SYMBOL_SIZE                  (18)
+#define PE_IMPORT_HEADER_SIZE           (20)
+#define PE_IMPORT_DIRECTORY_SIZE        (20)
+
+static const char slbt_implib_desc_prefix[] = "__IMPORT_DESCRIPTOR_";
+static const char slbt_implib_null_desc[]   = "__NULL_IMPORT_DESCRIPTOR";
+static const char slbt_implib_thunk_suffix[]= "_NULL_THUNK_DATA";
+static const char slbt_implib_imp_prefix[]  = "__imp_";
+
+struct slbt_implib_arch {
+	uint16_t        machine;
+	uint16_t        reltype;
+	uint16_t        fileattr;
+	uint32_t        vasize;
+	uint32_t        thunkalign;
+	bool            fprefix;
+};
+
+static const struct slbt_implib_arch slbt_implib_arch_i386 = {
+	.machine    = 0x014c,
+	.reltype    = 0x0007,
+	.fileattr   = PE_FILE_32BIT_MACHINE,
+	.vasize     = 4,
+	.thunkalign = PE_SCN_ALIGN_4BYTES,
+	.fprefix    = true,
+};
+
+static const struct slbt_implib_arch slbt_implib_arch_x86_64 = {
+	.machine    = 0x8664,
+	.reltype    = 0x0003,
+	.fileattr   = 0,
+	.vasize     = 8,
+	.thunkalign = PE_SCN_ALIGN_8BYTES,
+	.fprefix    = false,
+};
+
+static const struct slbt_implib_arch slbt_implib_arch_arm64 = {
+	.machine    = 0xaa64,
+	.reltype    = 0x0002,
+	.fileattr   = 0,
+	.vasize     = 8,
+	.thunkalign = PE_SCN_ALIGN_8BYTES,
+	.fprefix    = false,
+};
+
+struct slbt_implib_export {
+	const char *    symname;
+	size_t          symlen;
+	uint16_t        ordinal;
+	uint16_t        type;
+	uint16_t        nametype;
+};
+
+struct slbt_implib_ctx {
+	const struct slbt_implib_arch * arch;
+	struct slbt_implib_export *     exportv;
+	size_t                          nexports;
+	char *                          strbuf;
+	const char *                    dllname;
+	size_t                          dlllen;
+	char                            descsym[PATH_MAX];
+	char                            thunksym[PATH_MAX];
+};
+
+static const struct slbt_implib_arch * slbt_implib_get_arch(const char * host)
+{
+	if (!host)
+		return 0;
+
+	if (!strncmp(host,"x86_64-",7) || !strncmp(host,"amd64-",6))
+		return &slbt_implib_arch_x86_64;
+
+	if (!strncmp(host,"aarch64-",8) || !strncmp(host,"arm64-",6))
+		return &slbt_implib_arch_arm64;
+
+	if ((host[0] == 'i')
+			&& (host[1] >= '3')
+			&& (host[1] <= '6')
+			&& (host[2] == '8')
+			&& (host[3] == '6')
+			&& (host[4] == '-'))
+		return &slbt_implib_arch_i386;
+
+	return 0;
+}
+
+slbt_hidden bool slbt_ar_implib_supported(const struct slbt_driver_ctx * dctx)
+{
+	return slbt_implib_get_arch(dctx->cctx->host.host);
+}
+
+
+/* .def file parsing */
+static const char * slbt_implib_def_sections[] = {
+	"LIBRARY","NAME","DESCRIPTION","VERSION",
+	"STACKSIZE","HEAPSIZE","CODE","DATA",
+	"SECTIONS","EXPORTS","IMPORTS",
+	0
+};
+
+static bool slbt_implib_is_delim(char ch)
+{
+	return !ch || (ch == ';') || isspace((int)(unsigned char)ch);
+}
+
+static const char * slbt_implib_skip_space(const char * ch)
+{
+	for (; *ch && isspace((int)(unsigned char)*ch); )
+		ch++;
+
+	return ch;
+}
+
+static const char * slbt_implib_def_keyword(const char * line, const char * keyword)
+{
+	size_t len = strlen(keyword);
+
+	if (strncmp(line,keyword,len) || !slbt_implib_is_delim(line[len]))
+		return 0;
+
+	return slbt_implib_skip_space(&line[len]);
+}
+
+static const char * slbt_implib_def_token(
+	const char *    ch,
+	const char **   tok,
+	size_t *        toklen)
+{
+	char quote;
+
+	if ((*ch == '"') || (*ch == '\'')) {
+		quote = *ch++;
+		*tok  = ch;
+
+		for (; *ch && (*ch != quote); )
+			ch++;
+
+		if (!*ch)
+			return 0;
+
+		*toklen = ch - *tok;
+		return ++ch;
+	}
+
+	*tok = ch;
+
+	for (; !slbt_implib_is_delim(*ch) && (*ch != '='); )
+		ch++;
+
+	*toklen = ch - *tok;
+
+	return *toklen ? ch : 0;
+}
+
+static int slbt_implib_def_export(
+	struct slbt_implib_ctx *    ictx,
+	const char *                ch,
+	char **                     pstr)
+{
+	struct slbt_implib_export * exp;
+	const char *                name;
+	const char *                word;
+	size_t                      namelen;
+	size_t                      wordlen;
+	unsigned long               ordinal;
+	char *                      end;
+	bool                        fnoname;
+	bool                        fprivate;
+	bool                        fprefix;
+
+	if (!(ch = slbt_implib_def_token(ch,&name,&namelen)))
+		return -1;
+
+	exp      = &ictx->exportv[ictx->nexports];
+	fnoname  = false;
+	fprivate = false;
+
+	exp->ordinal = 0;
+	exp->type    = PE_IMPORT_CODE;
+
+	for (ch=slbt_implib_skip_space(ch); *ch && (*ch != ';'); ) {
+		/* name=internal, name==exportas */
+		if (*ch == '=') {
+			ch += (ch[1] == '=') ? 2 : 1;
+			ch  = slbt_implib_skip_space(ch);
+
+			if (!(ch = slbt_implib_def_token(ch,&word,&wordlen)))
+				return -1;
+
+		/* @ordinal */
+		} else if (*ch == '@') {
+			ch = slbt_implib_skip_space(&ch[1]);
+
+			if ((*ch < '0') || (*ch > '9'))
+				return -1;
+
+			ordinal = strtoul(ch,&end,10);
+
+			if (!ordinal || (ordinal > 0xffff))
+				return -1;
+
+			if (!slbt_implib_is_delim(*end))
+				return -1;
+
+			exp->ordinal = ordinal;
+			ch = end;
+
+		} else {
+			if (!(ch = slbt_implib_def_token(ch,&word,&wordlen)))
+				return -1;
+
+			if ((wordlen == 6) && !strncmp(word,"NONAME",6))
+				fnoname = true;
+
+			else if ((wordlen == 4) && !strncmp(word,"DATA",4))
+				exp->type = PE_IMPORT_DATA;
+
+			else if ((wordlen == 8) && !strncmp(word,"CONSTANT",8))
+				exp->type = PE_IMPORT_CONST;
+
+			else if ((wordlen == 7) && !strncmp(word,"PRIVATE",7))
+				fprivate = true;
+
+			else
+				return -1;
+		}
+
+		ch = slbt_implib_skip_space(ch);
+	}
+
+	/* private symbols are not part of the import library */
+	if (fprivate)
+		return 0;
+
+	if (fnoname && !exp->ordinal)
+		return -1;
+
+	/* i386: cdecl symbols carry a leading underscore */
+	fprefix = ictx->arch->fprefix && (name[0] != '?') && (name[0] != '@');
+
+	exp->symname = *pstr;
+
+	if (fprefix)
+		*(*pstr)++ = '_';
+
+	memcpy(*pstr,name,namelen);
+	*pstr += namelen;
+	*(*pstr)++ = '\0';
+
+	exp->symlen   = *pstr - exp->symname - 1;
+	exp->nametype = fnoname ? PE_IMPORT_ORDINAL
+		: fprefix ? PE_IMPORT_NAME_NOPREFIX
+		: PE_IMPORT_NAME;
+
+	ictx->nexports++;
+
+	return 0;
+}
+
+static int slbt_implib_parse_def(
+	const struct slbt_driver_ctx *  dctx,
+	struct slbt_implib_ctx *        ictx,
+	const char *                    deffilename)
+{
+	struct slbt_txtfile_ctx *       tctx;
+	const char **                   pline;
+	const char **                   psection;
+	const char *                    ch;
+	const char *                    next;
+	char *                          str;
+	size_t                          nlines;
+	size_t                          size;
+	bool                            fexports;
+
+	if (slbt_lib_get_txtfile_ctx(dctx,deffilename,&tctx) < 0)
+		return SLBT_NESTED_ERROR(dctx);
+
+	for (nlines=0, size=0, pline=tctx->txtlinev; *pline; pline++) {
+		size += strlen(*pline) + 2;
+		nlines++;
+	}
+
+	ictx->exportv = calloc(nlines+1,sizeof(*ictx->exportv));
+	ictx->strbuf  = malloc(size+1);
+
+	if (!ictx->exportv || !ictx->strbuf) {
+		slbt_lib_free_txtfile_ctx(tctx);
+		return SLBT_SYSTEM_ERROR(dctx,0);
+	}
+
+	str      = ictx->strbuf;
+	fexports = false;
+
+	for (pline=tctx->txtlinev; *pline; pline++) {
+		ch = *pline;
+
+		if (*ch == ';')
+			continue;
+
+		/* section keyword, possibly followed by an entry */
+		for (psection=slbt_implib_def_sections, next=0; *psection && !next; )
+			if (!(next = slbt_implib_def_keyword(ch,*psection)))
+				psection++;
+
+		if (next) {
+			fexports = !strcmp(*psection,"EXPORTS");
+			ch       = next;
+		}
+
+		if (!fexports || !*ch || (*ch == ';'))
+			continue;
+
+		if (slbt_implib_def_export(ictx,ch,&str) < 0) {
+			slbt_lib_free_txtfile_ctx(tctx);
+			return SLBT_CUSTOM_ERROR(dctx,SLBT_ERR_BAD_DATA);
+		}
+	}
+
+	slbt_lib_free_txtfile_ctx(tctx);
+
+	return 0;
+}
+
+
+/* member writers */
+static unsigned char * slbt_implib_le16(unsigned char * ch, uint16_t val)
+{
+	ch[0] = val;
+	ch[1] = val >> 8;
+
+	return &ch[2];
+}
+
+static unsigned char * slbt_implib_le32(unsigned char * ch, uint32_t val)
+{
+	return &ch[slbt_armap_write_le_32(ch,val)];
+}
+
+static unsigned char * slbt_implib_bytes(unsigned char * ch, const void * buf, size_t len)
+{
+	if (buf)
+		memcpy(ch,buf,len);
+	else
+		memset(ch,0,len);
+
+	return &ch[len];
+}
+
+static void slbt_implib_ar_field(char * field, size_t size, const char * fmt, uint64_t val)
+{
+	char    buf[32];
+	int     len;
+
+	len = snprintf(buf,sizeof(buf),fmt,val);
+	memcpy(field,buf,((size_t)len < size) ? (size_t)len : size);
+}
+
+static unsigned char * slbt_implib_ar_header(
+	unsigned char * ch,
+	const char *    name,
+	const char *    mode,
+	uint64_t        size)
+{
+	struct ar_raw_file_header * arhdr;
+
+	arhdr = (struct ar_raw_file_header *)ch;
+	memset(arhdr,AR_DEC_PADDING,sizeof(*arhdr));
+
+	memcpy(arhdr->ar_file_id,name,strlen(name));
+
+	if (mode) {
+		arhdr->ar_time_date_stamp[0] = '0';
+		arhdr->ar_uid[0]             = '0';
+		arhdr->ar_gid[0]             = '0';
+		memcpy(arhdr->ar_file_mode,mode,strlen(mode));
+	}
+
+	slbt_implib_ar_field(
+		arhdr->ar_file_size,
+		sizeof(arhdr->ar_file_size),
+		"%"PRIu64,size);
+
+	arhdr->ar_end_tag[0] = '`';
+	arhdr->ar_end_tag[1] = '\n';
+
+	return &ch[sizeof(*arhdr)];
+}
+
+static unsigned char * slbt_implib_coff_header(
+	unsigned char *                 ch,
+	const struct slbt_implib_arch * arch,
+	uint16_t                        nsections,
+	uint32_t                        symoff,
+	uint32_t                        nsyms)
+{
+	ch = slbt_implib_le16(ch,arch->machine);
+	ch = slbt_implib_le16(ch,nsections);
+	ch = slbt_implib_le32(ch,0);
+	ch = slbt_implib_le32(ch,symoff);
+	ch = slbt_implib_le32(ch,nsyms);
+	ch = slbt_implib_le16(ch,0);
+	ch = slbt_implib_le16(ch,arch->fileattr);
+
+	return ch;
+}
+
+static unsigned char * slbt_implib_section_header(
+	unsigned char * ch,
+	const char *    name,
+	uint32_t        size,
+	uint32_t        dataoff,
+	uint32_t        reloff,
+	uint16_t        nrelocs,
+	uint32_t        attr)
+{
+	ch = slbt_implib_bytes(ch,name,8);
+	ch = slbt_implib_le32(ch,0);
+	ch = slbt_implib_le32(ch,0);
+	ch = slbt_implib_le32(ch,size);
+	ch = slbt_implib_le32(ch,dataoff);
+	ch = slbt_implib_le32(ch,reloff);
+	ch = slbt_implib_le32(ch,0);
+	ch = slbt_implib_le16(ch,nrelocs);
+	ch = slbt_implib_le16(ch,0);
+	ch = slbt_implib_le32(ch,attr);
+
+	return ch;
+}
+
+static unsigned char * slbt_implib_reloc(
+	unsigned char * ch,
+	uint32_t        addr,
+	uint32_t        symidx,
+	uint16_t        type)
+{
+	ch = slbt_implib_le32(ch,addr);
+	ch = slbt_implib_le32(ch,symidx);
+	ch = slbt_implib_le16(ch,type);
+
+	return ch;
+}
+
+/* name: eight characters or less; otherwise, a string table offset */
+static unsigned char * slbt_implib_symbol(
+	unsigned char * ch,
+	const char *    name,
+	uint32_t        stroff,
+	uint16_t        secnum,
+	unsigned char   sclass)
+{
+	if (name) {
+		memset(ch,0,8);
+		memcpy(ch,name,strlen(name));
+		ch = &ch[8];
+	} else {
+		ch = slbt_implib_le32(ch,0);
+		ch = slbt_implib_le32(ch,stroff);
+	}
+
+	ch = slbt_implib_le32(ch,0);
+	ch = slbt_implib_le16(ch,secnum);
+	ch = slbt_implib_le16(ch,0);
+
+	*ch++ = sclass;
+	*ch++ = 0;
+
+	return ch;
+}
+
+static size_t slbt_implib_desc_size(const struct slbt_implib_ctx * ictx)
+{
+	return PE_COFF_HEADER_SIZE
+		+ 4 * PE_SECTION_HEADER_SIZE
+		+ PE_IMPORT_DIRECTORY_SIZE
+		+ 3 * PE_RELOC_SIZE
+		+ ictx->dlllen + 1
+		+ 7 * PE_SYMBOL_SIZE
+		+ sizeof(uint32_t)
+		+ strlen(ictx->descsym) + 1
+		+ sizeof(slbt_implib_null_desc)
+		+ strlen(ictx->thunksym) + 1;
+}
+
+static size_t slbt_implib_null_desc_size(void)
+{
+	return PE_COFF_HEADER_SIZE
+		+ PE_SECTION_HEADER_SIZE
+		+ PE_IMPORT_DIRECTORY_SIZE
+		+ PE_SYMBOL_SIZE
+		+ sizeof(uint32_t)
+		+ sizeof(slbt_implib_null_desc);
+}
+
+static size_t slbt_implib_thunk_size(const struct slbt_implib_ctx * ictx)
+{
+	return PE_COFF_HEADER_SIZE
+		+ 2 * PE_SECTION_HEADER_SIZE
+		+ 2 * ictx->arch->vasize
+		+ PE_SYMBOL_SIZE
+		+ sizeof(uint32_t)
+		+ strlen(ictx->thunksym) + 1;
+}
+
+static size_t slbt_implib_import_size(
+	const struct slbt_implib_ctx *      ictx,
+	const struct slbt_implib_export *   exp)
+{
+	return PE_IMPORT_HEADER_SIZE + exp->symlen + 1 + ictx->dlllen + 1;
+}
+
+/* import descriptor: .idata$2 (directory entry), .idata$6 (dll name), */
+/* and empty .idata$4 and .idata$5 sections that mark the beginning of */
+/* the dll's lookup and address tables (the null thunk ends both).     */
+static unsigned char * slbt_implib_write_desc(
+	unsigned char *                 ch,
+	const struct slbt_implib_ctx *  ictx)
+{
+	const struct slbt_implib_arch * arch;
+	uint32_t                        dataoff;
+	uint32_t                        reloff;
+	uint32_t                        nameoff;
+	uint32_t                        symoff;
+	uint32_t                        stroff;
+	size_t                          desclen;
+	size_t                          thunklen;
+
+	arch     = ictx->arch;
+	desclen  = strlen(ictx->descsym) + 1;
+	thunklen = strlen(ictx->thunksym) + 1;
+
+	dataoff  = PE_COFF_HEADER_SIZE + 4 * PE_SECTION_HEADER_SIZE;
+	reloff   = dataoff + PE_IMPORT_DIRECTORY_SIZE;
+	nameoff  = reloff  + 3 * PE_RELOC_SIZE;
+	symoff   = nameoff + ictx->dlllen + 1;
+
+	ch = slbt_implib_coff_header(ch,arch,4,symoff,7);
+
+	ch = slbt_implib_section_header(
+		ch,".idata$2",
+		PE_IMPORT_DIRECTORY_SIZE,dataoff,reloff,3,
+		PE_SCN_ALIGN_4BYTES | PE_SCN_IDATA);
+
+	ch = slbt_implib_section_header(
+		ch,".idata$6",
+		ictx->dlllen + 1,nameoff,0,0,
+		PE_SCN_ALIGN_2BYTES | PE_SCN_IDATA);
+
+	ch = slbt_implib_section_header(
+		ch,".idata$4",0,0,0,0,
+		arch->thunkalign | PE_SCN_IDATA);
+
+	ch = slbt_implib_section_header(
+		ch,".idata$5",0,0,0,0,
+		arch->thunkalign | PE_SCN_IDATA);
+
+	/* directory entry: lookup table, name, and address table rvas */
+	ch = slbt_implib_bytes(ch,0,PE_IMPORT_DIRECTORY_SIZE);
+	ch = slbt_implib_reloc(ch,12,2,arch->reltype);
+	ch = slbt_implib_reloc(ch,0,3,arch->reltype);
+	ch = slbt_implib_reloc(ch,16,4,arch->reltype);
+
+	ch = slbt_implib_bytes(ch,ictx->dllname,ictx->dlllen + 1);
+
+	/* symbols */
+	stroff = sizeof(uint32_t);
+
+	ch = slbt_implib_symbol(ch,0,stroff,1,PE_SYM_CLASS_EXTERNAL);
+	ch = slbt_implib_symbol(ch,".idata$2",0,1,PE_SYM_CLASS_STATIC);
+	ch = slbt_implib_symbol(ch,".idata$6",0,2,PE_SYM_CLASS_STATIC);
+	ch = slbt_implib_symbol(ch,".idata$4",0,3,PE_SYM_CLASS_STATIC);
+	ch = slbt_implib_symbol(ch,".idata$5",0,4,PE_SYM_CLASS_STATIC);
+
+	/* pull in the null import descriptor and the null thunk */
+	stroff += desclen;
+	ch = slbt_implib_symbol(ch,0,stroff,0,PE_SYM_CLASS_EXTERNAL);
+
+	stroff += sizeof(slbt_implib_null_desc);
+	ch = slbt_implib_symbol(ch,0,stroff,0,PE_SYM_CLASS_EXTERNAL);
+
+	/* string table */
+	stroff += thunklen;
+	ch = slbt_implib_le32(ch,stroff);
+	ch = slbt_implib_bytes(ch,ictx->descsym,desclen);
+	ch = slbt_implib_bytes(ch,slbt_implib_null_desc,sizeof(slbt_implib_null_desc));
+	ch = slbt_implib_bytes(ch,ictx->thunksym,thunklen);
+
+	return ch;
+}
+
+/* null import descriptor: terminates the import directory (.idata$3) */
+static unsigned char * slbt_implib_write_null_desc(
+	unsigned char *                 ch,
+	const struct slbt_implib_ctx *  ictx)
+{
+	uint32_t dataoff;
+
+	dataoff = PE_COFF_HEADER_SIZE + PE_SECTION_HEADER_SIZE;
+
+	ch = slbt_implib_coff_header(
+		ch,ictx->arch,1,
+		dataoff + PE_IMPORT_DIRECTORY_SIZE,1);
+
+	ch = slbt_implib_section_header(
+		ch,".idata$3",
+		PE_IMPORT_DIRECTORY_SIZE,dataoff,0,0,
+		PE_SCN_ALIGN_4BYTES | PE_SCN_IDATA);
+
+	ch = slbt_implib_bytes(ch,0,PE_IMPORT_DIRECTORY_SIZE);
+	ch = slbt_implib_symbol(ch,0,sizeof(uint32_t),1,PE_SYM_CLASS_EXTERNAL);
+
+	ch = slbt_implib_le32(ch,sizeof(uint32_t) + sizeof(slbt_implib_null_desc));
+	ch = slbt_implib_bytes(ch,slbt_implib_null_desc,sizeof(slbt_implib_null_desc));
+
+	return ch;
+}
+
+/* null thunk: terminates the address (.idata$5) and lookup (.idata$4) tables */
+static unsigned char * slbt_implib_write_thunk(
+	unsigned char *                 ch,
+	const struct slbt_implib_ctx *  ictx)
+{
+	const struct slbt_implib_arch * arch;
+	uint32_t                        dataoff;
+	size_t                          thunklen;
+
+	arch     = ictx->arch;
+	thunklen = strlen(ictx->thunksym) + 1;
+	dataoff  = PE_COFF_HEADER_SIZE + 2 * PE_SECTION_HEADER_SIZE;
+
+	ch = slbt_implib_coff_header(
+		ch,arch,2,
+		dataoff + 2 * arch->vasize,1);
+
+	ch = slbt_implib_section_header(
+		ch,".idata$5",
+		arch->vasize,dataoff,0,0,
+		arch->thunkalign | PE_SCN_IDATA);
+
+	ch = slbt_implib_section_header(
+		ch,".idata$4",
+		arch->vasize,dataoff + arch->vasize,0,0,
+		arch->thunkalign | PE_SCN_IDATA);
+
+	ch = slbt_implib_bytes(ch,0,2 * arch->vasize);
+	ch = slbt_implib_symbol(ch,0,sizeof(uint32_t),1,PE_SYM_CLASS_EXTERNAL);
+
+	ch = slbt_implib_le32(ch,sizeof(uint32_t) + thunklen);
+	ch = slbt_implib_bytes(ch,ictx->thunksym,thunklen);
+
+	return ch;
+}
+
+static unsigned char * slbt_implib_write_import(
+	unsigned char *                     ch,
+	const struct slbt_implib_ctx *      ictx,
+	const struct slbt_implib_export *   exp)
+{
+	ch = slbt_implib_le16(ch,0);
+	ch = slbt_implib_le16(ch,0xffff);
+	ch = slbt_implib_le16(ch,0);
+	ch = slbt_implib_le16(ch,ictx->arch->machine);
+	ch = slbt_implib_le32(ch,0);
+	ch = slbt_implib_le32(ch,exp->symlen + 1 + ictx->dlllen + 1);
+	ch = slbt_implib_le16(ch,exp->ordinal);
+	ch = slbt_implib_le16(ch,exp->type | (exp->nametype << 2));
+
+	ch = slbt_implib_bytes(ch,exp->symname,exp->symlen + 1);
+	ch = slbt_implib_bytes(ch,ictx->dllname,ictx->dlllen + 1);
+
+	return ch;
+}
+
+static int slbt_implib_free_ctx(struct slbt_implib_ctx * ictx, int ret)
+{
+	free(ictx->exportv);
+	free(ictx->strbuf);
+
+	return ret;
+}
+
+slbt_hidden int slbt_ar_create_implib(
+	const struct slbt_driver_ctx *  dctx,
+	const char *                    deffilename,
+	const char *                    dllname,
+	const char *                    implibname,
+	mode_t                          mode)
+{
+	struct slbt_archive_ctx *       arctx;
+	struct slbt_implib_ctx          ictx;
+	struct slbt_implib_export *     exp;
+	struct slbt_implib_export *     cap;
+	unsigned char *                 base;
+	unsigned char *                 ch;
+	unsigned char *                 mapref;
+	unsigned char *                 mapstr;
+	const char *                    dot;
+	char                            membername[32];
+	size_t                          nsyms;
+	size_t                          sarmap;
+	size_t                          smember;
+	size_t                          sarchive;
+	size_t                          liblen;
+
+	/* target machine, dll name, descriptor symbols */
+	memset(&ictx,0,sizeof(ictx));
+
+	if (!(ictx.arch = slbt_implib_get_arch(dctx->cctx->host.host)))
+		return SLBT_CUSTOM_ERROR(dctx,SLBT_ERR_FLOW_ERROR);
+
+	ictx.dllname = dllname;
+	ictx.dlllen  = strlen(dllname);
+
+	dot    = strrchr(dllname,'.');
+	liblen = dot ? (size_t)(dot - dllname) : ictx.dlllen;
+
+	if (snprintf(ictx.descsym,sizeof(ictx.descsym),"%s%.*s",
+			slbt_implib_desc_prefix,(int)liblen,dllname)
+			>= (int)sizeof(ictx.descsym))
+		return SLBT_BUFFER_ERROR(dctx);
+
+	if (snprintf(ictx.thunksym,sizeof(ictx.thunksym),"\177%.*s%s",
+			(int)liblen,dllname,slbt_implib_thunk_suffix)
+			>= (int)sizeof(ictx.thunksym))
+		return SLBT_BUFFER_ERROR(dctx);
+
+	/* exports */
+	if (slbt_implib_parse_def(dctx,&ictx,deffilename) < 0)
+		return slbt_implib_free_ctx(&ictx,SLBT_NESTED_ERROR(dctx));
+
+	cap = &ictx.exportv[ictx.nexports];
+
+	/* armap: member offsets (big endian), then symbol names */
+	nsyms   = 3;
+	sarmap  = strlen(ictx.descsym) + 1;
+	sarmap += sizeof(slbt_implib_null_desc);
+	sarmap += strlen(ictx.thunksym) + 1;
+
+	for (exp=ictx.exportv; exp<cap; exp++) {
+		nsyms  += 1;
+		sarmap += sizeof(slbt_implib_imp_prefix) + exp->symlen;
+
+		if (exp->type != PE_IMPORT_DATA) {
+			nsyms  += 1;
+			sarmap += exp->symlen + 1;
+		}
+	}
+
+	sarmap += sizeof(uint32_t) * (nsyms + 1);
+	sarmap += sarmap & 1;
+
+	/* archive size */
+	sarchive  = sizeof(struct ar_raw_signature);
+	sarchive += sizeof(struct ar_raw_file_header) + sarmap;
+
+	smember   = slbt_implib_desc_size(&ictx);
+	sarchive += sizeof(struct ar_raw_file_header) + smember + (smember & 1);
+
+	smember   = slbt_implib_null_desc_size();
+	sarchive += sizeof(struct ar_raw_file_header) + smember + (smember & 1);
+
+	smember   = slbt_implib_thunk_size(&ictx);
+	sarchive += sizeof(struct ar_raw_file_header) + smember + (smember & 1);
+
+	for (exp=ictx.exportv; exp<cap; exp++) {
+		smember   = slbt_implib_import_size(&ictx,exp);
+		sarchive += sizeof(struct ar_raw_file_header) + smember + (smember & 1);
+	}
+
+	/* in-memory archive */
+	if (slbt_create_anonymous_archive_ctx(dctx,sarchive,&arctx) < 0)
+		return slbt_implib_free_ctx(&ictx,SLBT_NESTED_ERROR(dctx));
+
+	base = arctx->map->map_addr;
+	ch   = slbt_implib_bytes(base,AR_SIGNATURE,sizeof(struct ar_raw_signature));
+
+	/* armap */
+	ch     = slbt_implib_ar_header(ch,"/","0",sarmap);
+	ch    += slbt_armap_write_be_32(ch,nsyms);
+	mapref = ch;
+	mapstr = &ch[sizeof(uint32_t) * nsyms];
+
+	memset(mapstr,0,&ch[sarmap - sizeof(uint32_t)] - mapstr);
+	ch = &ch[sarmap - sizeof(uint32_t)];
+
+	/*****************************************************/
+	/* the linker sorts .idata$4 and .idata$5 by member  */
+	/* name, hence: descriptor (dh.o) before the imports */
+	/* (ds<index>.o), and the null thunk (dt.o) after.   */
+	/*****************************************************/
+
+	/* import descriptor */
+	mapref += slbt_armap_write_be_32(mapref,ch - base);
+	mapstr  = slbt_implib_bytes(mapstr,ictx.descsym,strlen(ictx.descsym) + 1);
+
+	smember = slbt_implib_desc_size(&ictx);
+	ch = slbt_implib_ar_header(ch,"dh.o/","644",smember);
+	ch = slbt_implib_write_desc(ch,&ictx);
+
+	if (smember & 1)
+		*ch++ = AR_OBJ_PADDING;
+
+	/* null import descriptor */
+	mapref += slbt_armap_write_be_32(mapref,ch - base);
+	mapstr  = slbt_implib_bytes(mapstr,slbt_implib_null_desc,sizeof(slbt_implib_null_desc));
+
+	smember = slbt_implib_null_desc_size();
+	ch = slbt_implib_ar_header(ch,"dn.o/","644",smember);
+	ch = slbt_implib_write_null_desc(ch,&ictx);
+
+	if (smember & 1)
+		*ch++ = AR_OBJ_PADDING;
+
+	/* short import members: __imp_ symbol, and a thunk unless data */
+	for (exp=ictx.exportv; exp<cap; exp++) {
+		mapref += slbt_armap_write_be_32(mapref,ch - base);
+		mapstr  = slbt_implib_bytes(mapstr,slbt_implib_imp_prefix,sizeof(slbt_implib_imp_prefix) - 1);
+		mapstr  = slbt_implib_bytes(mapstr,exp->symname,exp->symlen + 1);
+
+		if (exp->type != PE_IMPORT_DATA) {
+			mapref += slbt_armap_write_be_32(mapref,ch - base);
+			mapstr  = slbt_implib_bytes(mapstr,exp->symname,exp->symlen + 1);
+		}
+
+		sprintf(membername,"ds%06zu.o/",(size_t)(exp - ictx.exportv));
+
+		smember = slbt_implib_import_size(&ictx,exp);
+		ch = slbt_implib_ar_header(ch,membername,"644",smember);
+		ch = slbt_implib_write_import(ch,&ictx,exp);
+
+		if (smember & 1)
+			*ch++ = AR_OBJ_PADDING;
+	}
+
+	/* null thunk */
+	mapref += slbt_armap_write_be_32(mapref,ch - base);
+	mapstr  = slbt_implib_bytes(mapstr,ictx.thunksym,strlen(ictx.thunksym) + 1);
+
+	smember = slbt_implib_thunk_size(&ictx);
+	ch = slbt_implib_ar_header(ch,"dt.o/","644",smember);
+	ch = slbt_implib_write_thunk(ch,&ictx);
+
+	if (smember & 1)
+		*ch++ = AR_OBJ_PADDING;
+
+	/* store */
+	slbt_implib_free_ctx(&ictx,0);
+
+	if (slbt_ar_store_archive(arctx,implibname,mode) < 0) {
+		slbt_ar_free_archive_ctx(arctx);
+		return SLBT_NESTED_ERROR(dctx);
+	}
+
+	slbt_ar_free_archive_ctx(arctx);
+
+	return 0;
+}
@@ -15,6 +15,7 @@
 #include "slibtool_errinfo_impl.h"
 #include "slibtool_pecoff_impl.h"
 #include "slibtool_ar_impl.h"
+#include "slibtool_visibility_impl.h"
 
 /********************************************************/
 /* Generate a symbol mapfile (aka version script) that  */
@@ -73,7 +74,7 @@ static int slbt_ar_output_mapfile_impl(
 
 	symstrv = fsort ? mctx->mapstrv : mctx->symstrv;
 
-	for (symv=symstrv; *symv; symv++) {
+	for (symv=symstrv; symv && *symv; symv++) {
 		if (!fcoff || slbt_is_strong_coff_symbol(*symv)) {
 			if (!regex || !regexec(&regctx,*symv,1,pmatch,0)) {
 				if (fcoff) {
@@ -115,7 +116,8 @@ static int slbt_ar_output_mapfile_impl(
 static int slbt_ar_create_mapfile_impl(
 	const struct slbt_archive_meta *  meta,
 	const char *                      path,
-	mode_t                            mode)
+	mode_t                            mode,
+	int                               fdalt)
 {
 	int                             ret;
 	struct slbt_archive_meta_impl * mctx;
@@ -138,6 +140,8 @@ static int slbt_ar_create_mapfile_impl(
 				O_WRONLY|O_CREAT|O_TRUNC,
 				mode)) < 0)
 			return SLBT_SYSTEM_ERROR(dctx,path);
+	} else if (fdalt >= 0) {
+		fdout = fdalt;
 	} else {
 		fdout = fdctx.fdout;
 	}
@@ -158,5 +162,13 @@ int slbt_ar_create_mapfile(
 	const char *                      path,
 	mode_t                            mode)
 {
-	return slbt_ar_create_mapfile_impl(meta,path,mode);
+	return slbt_ar_create_mapfile_impl(meta,path,mode,-1);
+}
+
+
+slbt_hidden int slbt_ar_output_mapfile_fdout(
+	const struct slbt_archive_meta *  meta,
+	int                               fdout)
+{
+	return slbt_ar_create_mapfile_impl(meta,0,0,fdout);
 }
@@ -30,13 +30,13 @@ slbt_hidden int slbt_update_mapstrv(
 	fcoff  = slbt_host_objfmt_is_coff(dctx);
 	fcoff |= (mctx->ofmtattr & AR_OBJECT_ATTR_COFF);
 
-	for (nsyms=0,symv=mctx->symstrv; *symv; symv++)
+	for (nsyms=0,symv=mctx->symstrv; symv && *symv; symv++)
 		nsyms++;
 
 	if (!(mapstrv = calloc(nsyms+1,sizeof(const char *))))
 		return SLBT_SYSTEM_ERROR(dctx,0);
 
-	for (nsyms=0,symv=mctx->symstrv; *symv; symv++)
+	for (nsyms=0,symv=mctx->symstrv; symv && *symv; symv++)
 		mapstrv[nsyms++] = *symv;
 
 	qsort(mapstrv,nsyms,sizeof(const char *),fcoff ? slbt_coff_qsort_strcmp : slbt_qsort_strcmp);
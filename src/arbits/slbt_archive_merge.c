@@ -48,7 +48,7 @@ struct armap_buffer_64 {
 
 static const char ar_signature[] = AR_SIGNATURE;
 
-static int slbt_create_anonymous_archive_ctx(
+slbt_hidden int slbt_create_anonymous_archive_ctx(
 	const struct slbt_driver_ctx *	dctx,
 	size_t                          size,
 	struct slbt_archive_ctx **	pctx)
@@ -78,7 +78,7 @@ static int slbt_create_anonymous_archive_ctx(
 	return 0;
 }
 
-static off_t slbt_armap_write_be_32(unsigned char * mark, uint32_t val)
+slbt_hidden off_t slbt_armap_write_be_32(unsigned char * mark, uint32_t val)
 {
 	mark[0] = val >> 24;
 	mark[1] = val >> 16;
@@ -88,7 +88,7 @@ static off_t slbt_armap_write_be_32(unsigned char * mark, uint32_t val)
 	return sizeof(uint32_t);
 }
 
-static off_t slbt_armap_write_le_32(unsigned char * mark, uint32_t val)
+slbt_hidden off_t slbt_armap_write_le_32(unsigned char * mark, uint32_t val)
 {
 	mark[0] = val;
 	mark[1] = val >> 8;
@@ -98,7 +98,7 @@ static off_t slbt_armap_write_le_32(unsigned char * mark, uint32_t val)
 	return sizeof(uint32_t);
 }
 
-static off_t slbt_armap_write_be_64(unsigned char * mark, uint64_t val)
+slbt_hidden off_t slbt_armap_write_be_64(unsigned char * mark, uint64_t val)
 {
 	slbt_armap_write_be_32(&mark[0],val >> 32);
 	slbt_armap_write_be_32(&mark[4],val);
@@ -106,7 +106,7 @@ static off_t slbt_armap_write_be_64(unsigned char * mark, uint64_t val)
 	return sizeof(uint64_t);
 }
 
-static off_t slbt_armap_write_le_64(unsigned char * mark, uint64_t val)
+slbt_hidden off_t slbt_armap_write_le_64(unsigned char * mark, uint64_t val)
 {
 	slbt_armap_write_be_32(&mark[0],val);
 	slbt_armap_write_be_32(&mark[4],val >> 32);
@@ -134,6 +134,49 @@ static int slbt_ar_merge_archives_fail(
 }
 
 
+/* thin input archives are merged by way of their regular equivalents */
+static int slbt_ar_merge_thin_inputs(
+	const struct slbt_driver_ctx *  dctx,
+	struct slbt_archive_ctx * const arctxv[],
+	struct slbt_archive_ctx **      arctxm)
+{
+	int                             ret;
+	size_t                          nunits;
+	size_t                          idx;
+	struct slbt_archive_ctx **      xctxv;
+	struct slbt_archive_ctx **      xctxo;
+
+	for (nunits=0; arctxv[nunits]; )
+		nunits++;
+
+	/* merge vector (null-terminated), followed by the owned copies */
+	if (!(xctxv = calloc(2*nunits + 1,sizeof(*xctxv))))
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	xctxo = &xctxv[nunits + 1];
+
+	for (ret=0, idx=0; (ret == 0) && (idx < nunits); idx++) {
+		if (slbt_ar_archive_is_thin(arctxv[idx])) {
+			ret = slbt_ar_expand_thin_archive(arctxv[idx],&xctxv[idx]);
+			xctxo[idx] = xctxv[idx];
+		} else {
+			xctxv[idx] = arctxv[idx];
+		}
+	}
+
+	if (ret == 0)
+		ret = slbt_ar_merge_archives(xctxv,arctxm);
+
+	for (idx=0; idx<nunits; idx++)
+		if (xctxo[idx])
+			slbt_ar_free_archive_ctx(xctxo[idx]);
+
+	free(xctxv);
+
+	return (ret < 0) ? SLBT_NESTED_ERROR(dctx) : 0;
+}
+
+
 int slbt_ar_merge_archives(
 	struct slbt_archive_ctx * const arctxv[],
 	struct slbt_archive_ctx **      arctxm)
@@ -216,6 +259,10 @@ int slbt_ar_merge_archives(
 	if (!(dctx = slbt_get_archive_ictx(arctxv[0])->dctx))
 		return -1;
 
+	for (arctxp=arctxv; *arctxp; arctxp++)
+		if (slbt_ar_archive_is_thin(*arctxp))
+			return slbt_ar_merge_thin_inputs(dctx,arctxv,arctxm);
+
 	/* determine armap type and size of archive elements */
 	for (armap=0,arnames=0,arctxp=arctxv; *arctxp; arctxp++) {
 		if (slbt_get_archive_ictx(*arctxp)->dctx != dctx)
@@ -734,3 +781,573 @@ int slbt_ar_get_varchive_ctx(
 
 	return 0;
 }
+
+
+/*******************************************************/
+/* incremental update: replace members of an existing  */
+/* archive with the same-named members of an update    */
+/* archive, preserving member order. symbol references */
+/* of unchanged members are carried over from the      */
+/* existing armap, those of replaced members are taken */
+/* from the armap of the update archive (sysv only).   */
+/*******************************************************/
+
+struct slbt_ar_update_src {
+	const struct slbt_archive_meta *        meta;
+	struct slbt_archive_meta_impl *         mctx;
+	const struct ar_meta_armap_common_32 *  armap32;
+	const struct ar_meta_armap_common_64 *  armap64;
+	struct ar_meta_member_info *            armap;
+	struct ar_meta_member_info *            arnames;
+	uint32_t                                mapattr;
+	uint64_t                                nsyms;
+	uint64_t *                              symfirst;
+	uint64_t *                              symidx;
+};
+
+struct slbt_ar_update_member {
+	struct slbt_ar_update_src *             src;
+	struct ar_meta_member_info *            meminfo;
+	uint64_t                                entry;
+};
+
+static int slbt_ar_update_fail(
+	struct slbt_archive_ctx *       arctx,
+	struct slbt_ar_update_src *     srcv,
+	struct slbt_ar_update_member *  outv,
+	int                             ret)
+{
+	int idx;
+
+	for (idx=0; idx<2; idx++) {
+		free(srcv[idx].symfirst);
+		free(srcv[idx].symidx);
+	}
+
+	free(outv);
+
+	if (arctx)
+		slbt_ar_free_archive_ctx(arctx);
+
+	return ret;
+}
+
+static int slbt_ar_update_init_src(
+	const struct slbt_driver_ctx *  dctx,
+	struct slbt_archive_ctx *       actx,
+	struct slbt_ar_update_src *     src,
+	uint64_t *                      nmembers)
+{
+	struct ar_meta_member_info **   memberp;
+	struct ar_meta_member_info *    meminfo;
+	uint64_t                        nentries;
+	uint64_t                        idx;
+	uint64_t                        entry;
+	uint64_t                        moffset;
+
+	src->meta    = actx->meta;
+	src->mctx    = slbt_archive_meta_ictx(actx->meta);
+	src->armap32 = src->meta->a_armap_primary.ar_armap_common_32;
+	src->armap64 = src->meta->a_armap_primary.ar_armap_common_64;
+
+	if (src->armap32) {
+		src->mapattr = src->armap32->ar_armap_attr;
+		src->nsyms   = src->armap32->ar_num_of_symbols;
+		src->armap   = src->armap32->ar_member;
+
+	} else if (src->armap64) {
+		src->mapattr = src->armap64->ar_armap_attr;
+		src->nsyms   = src->armap64->ar_num_of_symbols;
+		src->armap   = src->armap64->ar_member;
+	}
+
+	if (src->mapattr && !(src->mapattr & AR_ARMAP_ATTR_SYSV))
+		return SLBT_CUSTOM_ERROR(
+			dctx,
+			SLBT_ERR_AR_ARMAP_MISMATCH);
+
+	for (*nmembers=0, memberp=src->meta->a_memberv; memberp && *memberp; memberp++) {
+		meminfo = *memberp;
+
+		switch (meminfo->ar_member_attr) {
+			case AR_MEMBER_ATTR_ARMAP:
+				break;
+
+			case AR_MEMBER_ATTR_NAMESTRS:
+				src->arnames = meminfo;
+				break;
+
+			case AR_MEMBER_ATTR_LINKINFO:
+				return SLBT_CUSTOM_ERROR(
+					dctx,
+					SLBT_ERR_FLOW_ERROR);
+
+			case AR_MEMBER_ATTR_THIN:
+				return SLBT_CUSTOM_ERROR(
+					dctx,
+					SLBT_ERR_AR_THIN_MISMATCH);
+
+			default:
+				if (!(meminfo->ar_file_header.ar_header_attr & AR_HEADER_ATTR_SYSV))
+					return SLBT_CUSTOM_ERROR(
+						dctx,
+						SLBT_ERR_FLOW_ERROR);
+
+				(*nmembers)++;
+				break;
+		}
+	}
+
+	/* symbol references, grouped by member entry */
+	nentries = src->mctx->nentries;
+
+	if (!(src->symfirst = calloc(nentries + 1,sizeof(uint64_t))))
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	if (!(src->symidx = calloc(src->nsyms + 1,sizeof(uint64_t))))
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	for (idx=0; idx<src->nsyms; idx++) {
+		moffset = src->armap32
+			? src->armap32->ar_symrefs[idx].ar_member_offset
+			: src->armap64->ar_symrefs[idx].ar_member_offset;
+
+		if (!(meminfo = slbt_archive_member_from_offset(src->mctx,moffset)))
+			return SLBT_CUSTOM_ERROR(
+				dctx,
+				SLBT_ERR_AR_INVALID_ARMAP_MEMBER_OFFSET);
+
+		entry = meminfo - src->mctx->members;
+		src->symfirst[entry + 1]++;
+	}
+
+	for (entry=0; entry<nentries; entry++)
+		src->symfirst[entry + 1] += src->symfirst[entry];
+
+	for (idx=0; idx<src->nsyms; idx++) {
+		moffset = src->armap32
+			? src->armap32->ar_symrefs[idx].ar_member_offset
+			: src->armap64->ar_symrefs[idx].ar_member_offset;
+
+		meminfo = slbt_archive_member_from_offset(src->mctx,moffset);
+		entry   = meminfo - src->mctx->members;
+
+		src->symidx[src->symfirst[entry]++] = idx;
+	}
+
+	for (entry=nentries; entry; entry--)
+		src->symfirst[entry] = src->symfirst[entry - 1];
+
+	src->symfirst[0] = 0;
+
+	return 0;
+}
+
+static const char * slbt_ar_update_symname(
+	const struct slbt_ar_update_src *       src,
+	uint64_t                                idx)
+{
+	return src->armap32
+		? &src->armap32->ar_string_table[src->armap32->ar_symrefs[idx].ar_name_offset]
+		: &src->armap64->ar_string_table[src->armap64->ar_symrefs[idx].ar_name_offset];
+}
+
+static int slbt_ar_update_write_header(
+	const struct slbt_driver_ctx *  dctx,
+	struct ar_raw_file_header *     arhdr,
+	const struct ar_meta_member_info * tmpl,
+	uint64_t                        size)
+{
+	size_t  nbytes;
+	ssize_t nwritten;
+	int64_t atint;
+
+	memcpy(arhdr,tmpl->ar_member_data,sizeof(*arhdr));
+
+	/* deterministic archives: leave the zero time stamp alone */
+	if (tmpl->ar_file_header.ar_time_date_stamp) {
+		if ((nwritten = sprintf(arhdr->ar_time_date_stamp,PPRII64,(atint = time(0)))) < 0)
+			return SLBT_SYSTEM_ERROR(dctx,0);
+
+		for (nbytes=nwritten; nbytes < sizeof(arhdr->ar_time_date_stamp); nbytes++)
+			arhdr->ar_time_date_stamp[nbytes] = AR_DEC_PADDING;
+	}
+
+	if ((nwritten = sprintf(arhdr->ar_file_size,PPRIU64,size)) < 0)
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	for (nbytes=nwritten; nbytes < sizeof(arhdr->ar_file_size); nbytes++)
+		arhdr->ar_file_size[nbytes] = AR_DEC_PADDING;
+
+	memcpy(arhdr->ar_end_tag,"`\n",sizeof(arhdr->ar_end_tag));
+
+	return 0;
+}
+
+int slbt_ar_update_archive(
+	struct slbt_archive_ctx *       arctx,
+	struct slbt_archive_ctx *       upctx,
+	struct slbt_archive_ctx **      arctxm)
+{
+	const struct slbt_driver_ctx *          dctx;
+	struct slbt_archive_ctx *               actx;
+	struct slbt_archive_ctx_impl *          ictx;
+	struct slbt_ar_update_src               srcv[2];
+	struct slbt_ar_update_src *             asrc;
+	struct slbt_ar_update_src *             usrc;
+	struct slbt_ar_update_member *          outv;
+	struct slbt_ar_update_member *          outp;
+	struct ar_meta_member_info **           memberp;
+	struct ar_meta_member_info **           upmemberp;
+	struct ar_meta_member_info *            meminfo;
+	const struct ar_meta_member_info *      armap;
+	const struct ar_meta_member_info *      arnames;
+	struct ar_raw_file_header *             arhdr;
+	const char *                            symname;
+	uint64_t                                namembers;
+	uint64_t                                numembers;
+	uint64_t                                nreplaced;
+	uint64_t                                nsymrefs;
+	uint64_t                                ssymstrs;
+	uint64_t                                snamestrs;
+	uint64_t                                sarmap;
+	uint64_t                                sarchive;
+	uint64_t                                omember;
+	uint64_t                                idx;
+	uint32_t                                mapattr;
+	size_t                                  nbytes;
+	ssize_t                                 nwritten;
+	char *                                  base;
+	unsigned char *                         uch;
+	char *                                  ch;
+	char *                                  namebase;
+	char *                                  namestr;
+
+	off_t (*armap_write_uint32)(
+		unsigned char *,
+		uint32_t);
+
+	off_t (*armap_write_uint64)(
+		unsigned char *,
+		uint64_t);
+
+	/* init */
+	if (!arctx || !upctx)
+		return -1;
+
+	if (!(dctx = slbt_get_archive_ictx(arctx)->dctx))
+		return -1;
+
+	if (slbt_get_archive_ictx(upctx)->dctx != dctx)
+		return SLBT_CUSTOM_ERROR(
+			dctx,
+			SLBT_ERR_AR_DRIVER_MISMATCH);
+
+	memset(srcv,0,sizeof(srcv));
+
+	asrc = &srcv[0];
+	usrc = &srcv[1];
+	outv = 0;
+
+	if (slbt_ar_update_init_src(dctx,arctx,asrc,&namembers) < 0)
+		return slbt_ar_update_fail(
+			0,srcv,outv,
+			SLBT_NESTED_ERROR(dctx));
+
+	if (slbt_ar_update_init_src(dctx,upctx,usrc,&numembers) < 0)
+		return slbt_ar_update_fail(
+			0,srcv,outv,
+			SLBT_NESTED_ERROR(dctx));
+
+	/* armap type */
+	if (asrc->mapattr && usrc->mapattr && (asrc->mapattr != usrc->mapattr))
+		return slbt_ar_update_fail(
+			0,srcv,outv,
+			SLBT_CUSTOM_ERROR(
+				dctx,
+				SLBT_ERR_AR_ARMAP_MISMATCH));
+
+	mapattr = asrc->mapattr ? asrc->mapattr : usrc->mapattr;
+	armap   = asrc->armap   ? asrc->armap   : usrc->armap;
+	arnames = asrc->arnames ? asrc->arnames : usrc->arnames;
+
+	/* output member vector */
+	if (!(outv = calloc(namembers + 1,sizeof(*outv))))
+		return slbt_ar_update_fail(
+			0,srcv,outv,
+			SLBT_SYSTEM_ERROR(dctx,0));
+
+	outp      = outv;
+	nreplaced = 0;
+	nsymrefs  = 0;
+	ssymstrs  = 0;
+	snamestrs = 0;
+	sarchive  = 0;
+
+	for (memberp=asrc->meta->a_memberv; memberp && *memberp; memberp++) {
+		meminfo = *memberp;
+
+		switch (meminfo->ar_member_attr) {
+			case AR_MEMBER_ATTR_ARMAP:
+			case AR_MEMBER_ATTR_NAMESTRS:
+				break;
+
+			default:
+				outp->src     = asrc;
+				outp->meminfo = meminfo;
+
+				upmemberp = usrc->meta->a_memberv;
+
+				for (; upmemberp && *upmemberp; upmemberp++) {
+					switch ((*upmemberp)->ar_member_attr) {
+						case AR_MEMBER_ATTR_ARMAP:
+						case AR_MEMBER_ATTR_NAMESTRS:
+							break;
+
+						default:
+							if (!strcmp(
+									(*upmemberp)->ar_file_header.ar_member_name,
+									meminfo->ar_file_header.ar_member_name)) {
+								if (outp->src == usrc)
+									return slbt_ar_update_fail(
+										0,srcv,outv,
+										SLBT_CUSTOM_ERROR(
+											dctx,
+											SLBT_ERR_FLOW_ERROR));
+
+								outp->src     = usrc;
+								outp->meminfo = *upmemberp;
+								nreplaced++;
+							}
+
+							break;
+					}
+				}
+
+				meminfo     = outp->meminfo;
+				outp->entry = meminfo - outp->src->mctx->members;
+
+				/* symbol references */
+				for (idx=outp->src->symfirst[outp->entry]; idx<outp->src->symfirst[outp->entry + 1]; idx++) {
+					symname   = slbt_ar_update_symname(outp->src,outp->src->symidx[idx]);
+					ssymstrs += strlen(symname) + 1;
+					nsymrefs++;
+				}
+
+				/* long names */
+				if (meminfo->ar_file_header.ar_header_attr & AR_HEADER_ATTR_NAME_REF)
+					snamestrs += strlen(meminfo->ar_file_header.ar_member_name) + 2;
+
+				/* member */
+				sarchive += sizeof(struct ar_raw_file_header);
+				sarchive += meminfo->ar_file_header.ar_file_size;
+				sarchive += 1;
+				sarchive |= 1;
+				sarchive ^= 1;
+
+				outp++;
+				break;
+		}
+	}
+
+	/* every member of the update archive must replace an existing one */
+	if (nreplaced != numembers)
+		return slbt_ar_update_fail(
+			0,srcv,outv,
+			SLBT_CUSTOM_ERROR(
+				dctx,
+				SLBT_ERR_FLOW_ERROR));
+
+	/* armap size */
+	if (!nsymrefs) {
+		sarmap = 0;
+		armap  = 0;
+
+	} else if (mapattr & (AR_ARMAP_ATTR_LE_32|AR_ARMAP_ATTR_BE_32)) {
+		sarmap  = sizeof(uint32_t);
+		sarmap += sizeof(uint32_t) * nsymrefs;
+
+	} else {
+		sarmap  = sizeof(uint64_t);
+		sarmap += sizeof(uint64_t) * nsymrefs;
+	}
+
+	ssymstrs += 1;
+	ssymstrs |= 1;
+	ssymstrs ^= 1;
+
+	snamestrs += 1;
+	snamestrs |= 1;
+	snamestrs ^= 1;
+
+	if (!nsymrefs)
+		ssymstrs = 0;
+
+	if (snamestrs && !arnames)
+		return slbt_ar_update_fail(
+			0,srcv,outv,
+			SLBT_CUSTOM_ERROR(
+				dctx,
+				SLBT_ERR_FLOW_ERROR));
+
+	/* archive size */
+	omember   = sizeof(struct ar_raw_signature);
+	omember  += armap     ? sizeof(struct ar_raw_file_header) : 0;
+	omember  += sarmap;
+	omember  += ssymstrs;
+	omember  += snamestrs ? sizeof(struct ar_raw_file_header) : 0;
+	omember  += snamestrs;
+	sarchive += omember;
+
+	if ((mapattr & (AR_ARMAP_ATTR_LE_32|AR_ARMAP_ATTR_BE_32)) && (sarchive > UINT32_MAX))
+		return slbt_ar_update_fail(
+			0,srcv,outv,
+			SLBT_CUSTOM_ERROR(
+				dctx,
+				SLBT_ERR_AR_ARMAP_MISMATCH));
+
+	/* create in-memory archive */
+	if (slbt_create_anonymous_archive_ctx(dctx,sarchive,&actx) < 0)
+		return slbt_ar_update_fail(
+			0,srcv,outv,
+			SLBT_NESTED_ERROR(dctx));
+
+	base = actx->map->map_addr;
+	ch   = base;
+
+	memcpy(ch,ar_signature,sizeof(struct ar_raw_signature));
+	ch += sizeof(struct ar_raw_signature);
+
+	/* armap */
+	armap_write_uint32 = 0;
+	armap_write_uint64 = 0;
+
+	if (mapattr & AR_ARMAP_ATTR_BE_32)
+		armap_write_uint32 = slbt_armap_write_be_32;
+
+	else if (mapattr & AR_ARMAP_ATTR_LE_32)
+		armap_write_uint32 = slbt_armap_write_le_32;
+
+	else if (mapattr & AR_ARMAP_ATTR_BE_64)
+		armap_write_uint64 = slbt_armap_write_be_64;
+
+	else if (mapattr & AR_ARMAP_ATTR_LE_64)
+		armap_write_uint64 = slbt_armap_write_le_64;
+
+	if (armap) {
+		if (slbt_ar_update_write_header(
+				dctx,(struct ar_raw_file_header *)ch,
+				armap,sarmap + ssymstrs) < 0)
+			return slbt_ar_update_fail(
+				actx,srcv,outv,
+				SLBT_NESTED_ERROR(dctx));
+
+		uch  = (unsigned char *)ch;
+		uch += sizeof(struct ar_raw_file_header);
+
+		ch  = (char *)uch;
+		ch += sarmap;
+
+		uch += armap_write_uint32
+			? armap_write_uint32(uch,nsymrefs)
+			: armap_write_uint64(uch,nsymrefs);
+
+		/* member offsets are final once the layout is known */
+		for (outp=outv; outp->meminfo; outp++) {
+			for (idx=outp->src->symfirst[outp->entry]; idx<outp->src->symfirst[outp->entry + 1]; idx++) {
+				uch += armap_write_uint32
+					? armap_write_uint32(uch,omember)
+					: armap_write_uint64(uch,omember);
+
+				strcpy(ch,slbt_ar_update_symname(outp->src,outp->src->symidx[idx]));
+				ch += strlen(ch);
+				ch++;
+			}
+
+			omember += sizeof(struct ar_raw_file_header);
+			omember += outp->meminfo->ar_file_header.ar_file_size;
+			omember += 1;
+			omember |= 1;
+			omember ^= 1;
+		}
+
+		ch  = base;
+		ch += sizeof(struct ar_raw_signature);
+		ch += sizeof(struct ar_raw_file_header);
+		ch += sarmap;
+		ch += ssymstrs;
+	}
+
+	/* long names */
+	namebase = 0;
+	namestr  = 0;
+
+	if (snamestrs) {
+		if (slbt_ar_update_write_header(
+				dctx,(struct ar_raw_file_header *)ch,
+				arnames,snamestrs) < 0)
+			return slbt_ar_update_fail(
+				actx,srcv,outv,
+				SLBT_NESTED_ERROR(dctx));
+
+		ch += sizeof(struct ar_raw_file_header);
+
+		namebase = ch;
+		namestr  = ch;
+
+		memset(namebase,AR_OBJ_PADDING,snamestrs);
+
+		ch += snamestrs;
+	}
+
+	/* public members */
+	for (outp=outv; outp->meminfo; outp++) {
+		meminfo = outp->meminfo;
+		arhdr   = (struct ar_raw_file_header *)ch;
+
+		memcpy(
+			arhdr,meminfo->ar_member_data,
+			sizeof(*arhdr) + meminfo->ar_file_header.ar_file_size);
+
+		if (meminfo->ar_file_header.ar_header_attr & AR_HEADER_ATTR_NAME_REF) {
+			nwritten = sprintf(
+				arhdr->ar_file_id,"/"PPRIU64,
+				(uint64_t)(namestr - namebase));
+
+			if (nwritten < 0)
+				return slbt_ar_update_fail(
+					actx,srcv,outv,
+					SLBT_SYSTEM_ERROR(dctx,0));
+
+			for (nbytes=nwritten; nbytes < sizeof(arhdr->ar_file_id); nbytes++)
+				arhdr->ar_file_id[nbytes] = AR_DEC_PADDING;
+
+			strcpy(namestr,meminfo->ar_file_header.ar_member_name);
+			namestr += strlen(namestr);
+			*namestr++ = '/';
+			*namestr++ = AR_OBJ_PADDING;
+		}
+
+		ch += sizeof(*arhdr);
+		ch += meminfo->ar_file_header.ar_file_size;
+
+		if (meminfo->ar_file_header.ar_file_size % 2)
+			*ch++ = AR_OBJ_PADDING;
+	}
+
+	slbt_ar_update_fail(0,srcv,outv,0);
+
+	/* meta */
+	ictx = slbt_get_archive_ictx(actx);
+
+	if (slbt_ar_get_archive_meta(dctx,actx->map,&ictx->meta) < 0) {
+		slbt_ar_free_archive_ctx(actx);
+		return SLBT_NESTED_ERROR(dctx);
+	}
+
+	ictx->actx.meta = ictx->meta;
+
+	*arctxm = actx;
+
+	return 0;
+}
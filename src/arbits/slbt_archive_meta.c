@@ -8,6 +8,7 @@
 #include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdbool.h>
 #include <sys/mman.h>
 
 #include <slibtool/slibtool.h>
@@ -21,9 +22,11 @@
 struct ar_header_info {
 	struct ar_raw_file_header * phdr;
 	uint32_t                    attr;
+	bool                        fthin;
 };
 
 static const char ar_signature[] = AR_SIGNATURE;
+static const char ar_thin_signature[] = AR_THIN_SIGNATURE;
 
 static int slbt_ar_free_archive_meta_impl(struct slbt_archive_meta_impl * meta, int ret)
 {
@@ -326,6 +329,9 @@ int slbt_ar_get_archive_meta(
 	const char *                    slash;
 	const char *                    ch;
 	const char *                    fldcap;
+	const char *                    namecap;
+	bool                            fthin;
+	bool                            fintern;
 	size_t				nelements;
 	uint64_t                        nentries;
 	uint64_t                        nmembers;
@@ -366,7 +372,13 @@ int slbt_ar_get_archive_meta(
 			dctx,
 			SLBT_ERR_AR_INVALID_SIGNATURE);
 
-	else if (strncmp(mark,ar_signature,sizeof(struct ar_raw_signature)))
+	else if (!strncmp(mark,ar_signature,sizeof(struct ar_raw_signature)))
+		fthin = false;
+
+	else if (!strncmp(mark,ar_thin_signature,sizeof(struct ar_raw_signature)))
+		fthin = true;
+
+	else
 		return SLBT_CUSTOM_ERROR(
 			dctx,
 			SLBT_ERR_AR_INVALID_SIGNATURE);
@@ -376,7 +388,8 @@ int slbt_ar_get_archive_meta(
 		return SLBT_SYSTEM_ERROR(dctx,0);
 
 	/* associated driver context */
-	m->dctx = dctx;
+	m->dctx  = dctx;
+	m->fthin = fthin;
 
 	/* archive map info */
 	m->armeta.r_archive.map_addr = archive->map_addr;
@@ -384,7 +397,9 @@ int slbt_ar_get_archive_meta(
 
 	/* archive signature */
 	m->armeta.r_signature = (struct ar_raw_signature *)mark;
-	m->armeta.m_signature = (struct ar_meta_signature *)ar_signature;
+	m->armeta.m_signature = fthin
+		? (struct ar_meta_signature *)ar_thin_signature
+		: (struct ar_meta_signature *)ar_signature;
 
 	/* signature only? */
 	if (archive->map_size == sizeof(struct ar_raw_signature)) {
@@ -404,7 +419,7 @@ int slbt_ar_get_archive_meta(
 						SLBT_ERR_AR_INVALID_HEADER));
 
 	/* count entries, calculate string table size */
-	for (nentries=0,stblsize=0,arlongnames=0; mark<cap; nentries++) {
+	for (nentries=0,stblsize=0,arlongnames=0,namecap=0; mark<cap; nentries++) {
 		arhdr = (struct ar_raw_file_header *)mark;
 
 		/* file size */
@@ -420,7 +435,8 @@ int slbt_ar_get_archive_meta(
 		mark += sizeof(struct ar_raw_file_header);
 
 		/* stblsize, member name type */
-		fldcap = &arhdr->ar_file_id[sizeof(arhdr->ar_file_id)];
+		fldcap  = &arhdr->ar_file_id[sizeof(arhdr->ar_file_id)];
+		fintern = false;
 
 		/* sysv long names table? */
 		if ((arhdr->ar_file_id[0] == '/') && (arhdr->ar_file_id[1] == '/')) {
@@ -457,6 +473,8 @@ int slbt_ar_get_archive_meta(
 			stblsize += namelen;
 
 			arlongnames = arhdr;
+			namecap     = &mark[namelen];
+			fintern     = true;
 
 		/* the /SYM64/ string must be special cased, also below when it gets copied */
 		} else if (!strncmp(arhdr->ar_file_id,"/SYM64/",7)) {
@@ -469,6 +487,7 @@ int slbt_ar_get_archive_meta(
 
 			attr      = AR_HEADER_ATTR_FILE_ID | AR_HEADER_ATTR_SYSV;
 			stblsize += 8;
+			fintern   = true;
 
 		/* sysv armap member or sysv long name reference? */
 		} else if (arhdr->ar_file_id[0] == '/') {
@@ -485,6 +504,7 @@ int slbt_ar_get_archive_meta(
 				attr = AR_HEADER_ATTR_FILE_ID | AR_HEADER_ATTR_SYSV;
 				stblsize++;
 				stblsize++;
+				fintern = true;
 			} else {
 				attr = AR_HEADER_ATTR_NAME_REF | AR_HEADER_ATTR_SYSV;
 			}
@@ -529,6 +549,10 @@ int slbt_ar_get_archive_meta(
 
 		}
 
+		/* thin archive: member data resides in an external file */
+		if (fthin && !fintern)
+			filesize = 0;
+
 		/* truncated data? */
 		if (cap < &mark[filesize])
 			return slbt_ar_free_archive_meta_impl(
@@ -564,8 +588,9 @@ int slbt_ar_get_archive_meta(
 						SLBT_ERR_AR_TRUNCATED_DATA));
 
 			for (idx=0; idx<nentries; idx++) {
-				hdrinfov_next[idx].phdr = hdrinfov[idx].phdr;
-				hdrinfov_next[idx].attr = hdrinfov[idx].attr;
+				hdrinfov_next[idx].phdr  = hdrinfov[idx].phdr;
+				hdrinfov_next[idx].attr  = hdrinfov[idx].attr;
+				hdrinfov_next[idx].fthin = hdrinfov[idx].fthin;
 			};
 
 			if (hdrinfov != hdrinfobuf)
@@ -576,8 +601,9 @@ int slbt_ar_get_archive_meta(
 			m->hdrinfov  = hdrinfov;
 		}
 
-		hdrinfov[nentries].phdr = arhdr;
-		hdrinfov[nentries].attr = attr;
+		hdrinfov[nentries].phdr  = arhdr;
+		hdrinfov[nentries].attr  = attr;
+		hdrinfov[nentries].fthin = fthin && !fintern;
 	}
 
 	/* allocate name strings, member vector */
@@ -690,8 +716,17 @@ int slbt_ar_get_archive_meta(
 			ch += sizeof(*arlongnames);
 			ch += nameoff;
 
-			for (; *ch && (*ch != '/') && (*ch != AR_OBJ_PADDING); )
-				*longnamep++ = *ch++;
+			/* thin archives: a path name, terminated by "/\n" */
+			if (hdrinfov[idx].fthin) {
+				for (; (ch < namecap) && *ch && (*ch != AR_OBJ_PADDING); )
+					*longnamep++ = *ch++;
+
+				if (longnamep[-1] == '/')
+					*--longnamep = '\0';
+			} else {
+				for (; *ch && (*ch != '/') && (*ch != AR_OBJ_PADDING); )
+					*longnamep++ = *ch++;
+			}
 
 			longnamep++;
 
@@ -733,7 +768,12 @@ int slbt_ar_get_archive_meta(
 		memberp->ar_object_size = memberp->ar_file_header.ar_file_size - namelen;
 
 		/* member attribute */
-		memberp->ar_member_attr = slbt_ar_get_member_attr(memberp);
+		if (hdrinfov[idx].fthin) {
+			memberp->ar_object_data = 0;
+			memberp->ar_member_attr = AR_MEMBER_ATTR_THIN;
+		} else {
+			memberp->ar_member_attr = slbt_ar_get_member_attr(memberp);
+		}
 
 		/* pe/coff second linker member? */
 		if ((idx == 1) && (memberp->ar_member_attr == AR_MEMBER_ATTR_ARMAP))
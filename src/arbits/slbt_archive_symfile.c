@@ -60,7 +60,7 @@ static int slbt_ar_output_symfile_impl(
 
 	symstrv = fsort ? mctx->mapstrv : mctx->symstrv;
 
-	for (symv=symstrv; *symv; symv++) {
+	for (symv=symstrv; symv && *symv; symv++) {
 		if (!fcoff || slbt_is_strong_coff_symbol(*symv)) {
 			if (!regex || !regexec(&regctx,*symv,1,pmatch,0)) {
 				if (slbt_dprintf(fdout,"%s\n",*symv) < 0)
@@ -5,6 +5,7 @@
 /*******************************************************************/
 
 #include <ctype.h>
+#include <errno.h>
 #include <fcntl.h>
 #include <stdio.h>
 #include <limits.h>
@@ -72,24 +73,21 @@ static void slbt_ar_update_syminfo_child(
 static int slbt_obtain_nminfo(
 	struct slbt_archive_ctx_impl *  ictx,
 	const struct slbt_driver_ctx *  dctx,
-	struct slbt_archive_meta_impl * mctx,
-	int                             fdout)
+	struct slbt_archive_meta_impl * mctx)
 {
-	int     ret;
-	int     pos;
-	int	fdcwd;
-	int     fdarg;
+	int     fd[2];
 	pid_t   pid;
 	pid_t   rpid;
 	int     ecode;
+	ssize_t nread;
+	size_t  nbytes;
+	size_t  buflen;
+	char *  buf;
+	char *  nbuf;
 	char ** argv;
 	char    arname [PATH_MAX];
-	char    output [PATH_MAX];
 	char	program[PATH_MAX];
 
-	/* fdcwd */
-	fdcwd = slbt_driver_fdcwd(dctx);
-
 	/* tool-specific argument vector */
 	argv = (slbt_get_driver_ictx(dctx))->host.nm_argv;
 
@@ -104,146 +102,304 @@ static int slbt_obtain_nminfo(
 			return SLBT_BUFFER_ERROR(dctx);
 	}
 
-	/* arname (.nm suffix, buf treat as .syminfo) */
-	pos = slbt_snprintf(
-		arname,sizeof(arname)-8,"%s",
-		ictx->path);
+	/* arname */
+	if (slbt_snprintf(arname,sizeof(arname),"%s",ictx->path) < 0)
+		return SLBT_BUFFER_ERROR(dctx);
 
-	/* output */
-	if ((fdarg = fdout) < 0) {
-		strcpy(output,arname);
-		strcpy(&output[pos],".nm");
+	/* nm output is captured in memory */
+	buflen = 0x10000;
 
-		if ((fdout = openat(fdcwd,output,O_CREAT|O_TRUNC|O_RDWR,0644)) < 0)
-			return SLBT_SYSTEM_ERROR(dctx,output);
-	} else {
-		strcpy(output,"@nminfo@");
+	if (!(buf = malloc(buflen)))
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	if (pipe(fd) < 0) {
+		free(buf);
+		return SLBT_SYSTEM_ERROR(dctx,0);
 	}
 
+	/* keep the pipe out of nm processes spawned by other threads */
+	fcntl(fd[0],F_SETFD,FD_CLOEXEC);
+	fcntl(fd[1],F_SETFD,FD_CLOEXEC);
+
 	/* fork */
 	if ((pid = slbt_fork()) < 0) {
-		close(fdout);
+		close(fd[0]);
+		close(fd[1]);
+		free(buf);
 		return SLBT_SYSTEM_ERROR(dctx,0);
 	}
 
 	/* child */
-	if (pid == 0)
+	if (pid == 0) {
+		close(fd[0]);
 		slbt_ar_update_syminfo_child(
-			program,arname,fdout);
+			program,arname,fd[1]);
+	}
 
 	/* parent */
+	close(fd[1]);
+
+	for (nbytes=0; (nread = read(fd[0],&buf[nbytes],buflen-nbytes-1)); ) {
+		if ((nread < 0) && (errno == EINTR))
+			continue;
+
+		if (nread < 0)
+			break;
+
+		if ((nbytes += nread) == buflen - 1) {
+			if (!(nbuf = realloc(buf,2*buflen))) {
+				nread = -1;
+				break;
+			}
+
+			buf     = nbuf;
+			buflen *= 2;
+		}
+	}
+
+	close(fd[0]);
+
 	rpid = waitpid(
 		pid,
 		&ecode,
 		0);
 
-	/* nm output */
-	if ((rpid > 0)  && (ecode == 0))
-		ret = slbt_impl_get_txtfile_ctx(
-			dctx,output,fdout,
-			&mctx->nminfo);
-
-	if (fdarg < 0)
-		close(fdout);
-
-	if (rpid < 0) {
+	if ((rpid < 0) || (nread < 0)) {
+		free(buf);
 		return SLBT_SYSTEM_ERROR(dctx,0);
 
 	} else if (ecode) {
+		free(buf);
 		return SLBT_CUSTOM_ERROR(
 			dctx,
 			SLBT_ERR_FLOW_ERROR);
 	}
 
-	return (ret < 0) ? SLBT_NESTED_ERROR(dctx) : 0;
+	/* nm output */
+	buf[nbytes] = '\0';
+
+	if (slbt_impl_get_txtfile_ctx_from_buffer(
+			dctx,"@nminfo@",buf,nbytes,
+			&mctx->nminfo) < 0)
+		return SLBT_NESTED_ERROR(dctx);
+
+	return 0;
 }
 
-static int slbt_get_symbol_nm_info(
-	struct slbt_archive_ctx *       actx,
-	struct slbt_archive_meta_impl * mctx,
-	uint64_t                        idx)
+/* one parsed line of nm -P -A output: archive[object]: name type ... */
+struct slbt_nminfo_entry {
+	const char *    objname;
+	size_t          objlen;
+	const char *    symname;
+	size_t          symlen;
+	char            symtype;
+};
+
+static int slbt_nminfo_entry_cmp(
+	const char * symname, size_t symlen,
+	const char * objname, size_t objlen,
+	const struct slbt_nminfo_entry * entry)
+{
+	int ret;
+
+	if ((ret = memcmp(symname,entry->symname,
+			(symlen < entry->symlen) ? symlen : entry->symlen)))
+		return ret;
+
+	if (symlen != entry->symlen)
+		return (symlen < entry->symlen) ? -1 : 1;
+
+	if (!objname)
+		return 0;
+
+	if ((ret = memcmp(objname,entry->objname,
+			(objlen < entry->objlen) ? objlen : entry->objlen)))
+		return ret;
+
+	if (objlen != entry->objlen)
+		return (objlen < entry->objlen) ? -1 : 1;
+
+	return 0;
+}
+
+static int slbt_qsort_nminfo_cmp(const void * a, const void * b)
+{
+	const struct slbt_nminfo_entry * entrya;
+	const struct slbt_nminfo_entry * entryb;
+
+	entrya = (const struct slbt_nminfo_entry *)a;
+	entryb = (const struct slbt_nminfo_entry *)b;
+
+	return slbt_nminfo_entry_cmp(
+		entrya->symname,entrya->symlen,
+		entrya->objname,entrya->objlen,
+		entryb);
+}
+
+static int slbt_parse_nminfo_line(
+	const char *                    line,
+	struct slbt_nminfo_entry *      entry)
 {
 	int                             cint;
-	const char **                   pline;
 	const char *                    mark;
 	const char *                    cap;
-	const char *                    objname;
-	const char *                    symname;
-	struct ar_meta_symbol_info *    syminfo;
-	struct ar_meta_member_info **   pmember;
 
-	symname = mctx->symstrv[idx];
-	syminfo = &mctx->syminfo[idx];
+	if (!(mark = strchr(line,'[')))
+		return -1;
 
-	for (pline=mctx->nminfo->txtlinev; *pline; pline++) {
-		mark = *pline;
+	if (!(cap = strchr(++mark,']')))
+		return -1;
 
-		if (!(mark = strchr(mark,']')))
-			return -1;
+	entry->objname = mark;
+	entry->objlen  = cap - mark;
 
-		if ((*++mark != ':') || (*++mark != ' '))
-			return -1;
+	if ((*++cap != ':') || (*++cap != ' '))
+		return -1;
 
-		cap = ++mark;
+	mark = ++cap;
 
-		for (; *cap && !isspace((cint = *cap)); )
-			cap++;
+	for (; *cap && !isspace((cint = *cap)); )
+		cap++;
 
-		if (*cap != ' ')
-			return -1;
+	if (*cap != ' ')
+		return -1;
 
-		if (!(strncmp(symname,mark,cap-mark))) {
-			mark = ++cap;
-
-			/* space only according to posix, but ... */
-			if (mark[1] && (mark[1] != ' '))
-				return -1;
-
-			switch (mark[0]) {
-				case 'A':
-				case 'B':
-				case 'C':
-				case 'D':
-				case 'G':
-				case 'I':
-				case 'R':
-				case 'S':
-				case 'T':
-				case 'W':
-					syminfo->ar_symbol_type = ar_symbol_type[mark[0]-'A'];
-					break;
-
-				default:
-					break;
-			}
+	entry->symname = mark;
+	entry->symlen  = cap - mark;
 
-			if (syminfo->ar_symbol_type) {
-				syminfo->ar_archive_name = *actx->path;
-				syminfo->ar_symbol_name  = symname;
+	/* space only according to posix, but ... */
+	mark = ++cap;
 
-				if (!(mark = strchr(*pline,'[')))
-					return -1;
+	if (mark[0] && mark[1] && (mark[1] != ' '))
+		return -1;
 
-				if (!(cap = strchr(++mark,']')))
-					return -1;
-			}
+	entry->symtype = mark[0];
 
-			pmember = mctx->memberv;
+	return 0;
+}
 
-			for (; *pmember && !syminfo->ar_object_name; ) {
-				objname = (*pmember)->ar_file_header.ar_member_name;
+/* locate the entry of the given symbol (and object, if specified) */
+static const struct slbt_nminfo_entry * slbt_nminfo_entry_find(
+	const struct slbt_nminfo_entry *        entryv,
+	size_t                                  nentries,
+	const char *                            symname,
+	const char *                            objname)
+{
+	size_t                                  l,r,m;
+	size_t                                  symlen;
+	size_t                                  objlen;
+
+	symlen = strlen(symname);
+	objlen = objname ? strlen(objname) : 0;
+
+	for (l=0, r=nentries; l<r; ) {
+		m = l + (r - l) / 2;
+
+		if (slbt_nminfo_entry_cmp(
+				symname,symlen,
+				objname,objlen,
+				&entryv[m]) > 0)
+			l = m + 1;
+		else
+			r = m;
+	}
 
-				if (!(strncmp(objname,mark,cap-mark)))
-					syminfo->ar_object_name = objname;
+	if (l == nentries)
+		return 0;
 
-				pmember++;
-			}
+	if (slbt_nminfo_entry_cmp(symname,symlen,objname,objlen,&entryv[l]))
+		return 0;
+
+	return &entryv[l];
+}
+
+static int slbt_get_symbol_nm_info(
+	struct slbt_archive_ctx *       actx,
+	struct slbt_archive_meta_impl * mctx)
+{
+	uint64_t                        idx;
+	size_t                          nentries;
+	off_t                           offset;
+	const char **                   pline;
+	const char *                    symname;
+	const char *                    objname;
+	struct slbt_nminfo_entry *      entryv;
+	const struct slbt_nminfo_entry *entry;
+	struct ar_meta_symbol_info *    syminfo;
+	struct ar_meta_member_info *    member;
+
+	/* index the nm output once, by symbol name and object name */
+	for (nentries=0,pline=mctx->nminfo->txtlinev; *pline; pline++)
+		nentries++;
+
+	if (!(entryv = calloc(nentries + 1,sizeof(*entryv))))
+		return -1;
+
+	for (nentries=0,pline=mctx->nminfo->txtlinev; *pline; pline++)
+		if (slbt_parse_nminfo_line(*pline,&entryv[nentries++]) < 0) {
+			free(entryv);
+			return -1;
+		}
+
+	qsort(entryv,nentries,sizeof(*entryv),slbt_qsort_nminfo_cmp);
+
+	/* armap symbols: the armap already tells the defining member */
+	for (idx=0; idx<mctx->armaps.armap_nsyms; idx++) {
+		symname = mctx->symstrv[idx];
+		syminfo = &mctx->syminfo[idx];
+		objname = 0;
+
+		if (mctx->armaps.armap_symrefs_32)
+			offset = mctx->armaps.armap_symrefs_32[idx].ar_member_offset;
+		else
+			offset = mctx->armaps.armap_symrefs_64[idx].ar_member_offset;
+
+		if ((member = slbt_archive_member_from_offset(mctx,offset)))
+			objname = member->ar_file_header.ar_member_name;
 
-			mctx->syminfv[idx] = syminfo;
+		if (!objname || !(entry = slbt_nminfo_entry_find(
+				entryv,nentries,symname,objname)))
+			entry = slbt_nminfo_entry_find(
+				entryv,nentries,symname,0);
+
+		if (!entry) {
+			free(entryv);
+			return -1;
+		}
+
+		switch (entry->symtype) {
+			case 'A':
+			case 'B':
+			case 'C':
+			case 'D':
+			case 'G':
+			case 'I':
+			case 'R':
+			case 'S':
+			case 'T':
+			case 'W':
+				syminfo->ar_symbol_type = ar_symbol_type[entry->symtype-'A'];
+				break;
+
+			/* weak object */
+			case 'V':
+				syminfo->ar_symbol_type = ar_symbol_type_W;
+				break;
+
+			default:
+				break;
 		}
+
+		syminfo->ar_archive_name = *actx->path;
+		syminfo->ar_object_name  = objname;
+		syminfo->ar_symbol_name  = symname;
+
+		mctx->syminfv[idx] = syminfo;
 	}
 
-	return (mctx->syminfv[idx] ? 0 : (-1));
+	free(entryv);
+
+	return 0;
 }
 
 static int slbt_qsort_syminfo_cmp(const void * a, const void * b)
@@ -273,13 +429,11 @@ static int slbt_coff_qsort_syminfo_cmp(const void * a, const void * b)
 }
 
 static int slbt_ar_update_syminfo_impl(
-	struct slbt_archive_ctx *       actx,
-	int                             fdout)
+	struct slbt_archive_ctx *       actx)
 {
 	const struct slbt_driver_ctx *  dctx;
 	struct slbt_archive_ctx_impl *  ictx;
 	struct slbt_archive_meta_impl * mctx;
-	uint64_t                        idx;
 	bool                            fcoff;
 
 	/* driver context, etc. */
@@ -287,9 +441,23 @@ static int slbt_ar_update_syminfo_impl(
 	mctx = slbt_archive_meta_ictx(ictx->meta);
 	dctx = ictx->dctx;
 
+	/* free old nm output and syminfo vectors */
+	if (mctx->nminfo)
+		slbt_lib_free_txtfile_ctx(mctx->nminfo);
+
+	if (mctx->syminfo)
+		free(mctx->syminfo);
+
+	if (mctx->syminfv)
+		free(mctx->syminfv);
+
+	mctx->nminfo  = 0;
+	mctx->syminfo = 0;
+	mctx->syminfv = 0;
+
 	/* nm -P -A -g */
 	if (mctx->armaps.armap_nsyms) {
-		if (slbt_obtain_nminfo(ictx,dctx,mctx,fdout) < 0)
+		if (slbt_obtain_nminfo(ictx,dctx,mctx) < 0)
 			return SLBT_NESTED_ERROR(dctx);
 	} else {
 		if (slbt_lib_get_txtfile_ctx(
@@ -298,10 +466,6 @@ static int slbt_ar_update_syminfo_impl(
 			return SLBT_NESTED_ERROR(dctx);
 	}
 
-	/* free old syminfo vector */
-	if (mctx->syminfv)
-		free(mctx->syminfv);
-
 	/* syminfo vector: armap symbols only */
 	if (!(mctx->syminfo = calloc(
 			mctx->armaps.armap_nsyms + 1,
@@ -314,11 +478,10 @@ static int slbt_ar_update_syminfo_impl(
 		return SLBT_SYSTEM_ERROR(dctx,0);
 
 	/* do the thing */
-	for (idx=0; idx<mctx->armaps.armap_nsyms; idx++)
-		if (slbt_get_symbol_nm_info(actx,mctx,idx) < 0)
-			return SLBT_CUSTOM_ERROR(
-				dctx,
-				SLBT_ERR_FLOW_ERROR);
+	if (slbt_get_symbol_nm_info(actx,mctx) < 0)
+		return SLBT_CUSTOM_ERROR(
+			dctx,
+			SLBT_ERR_FLOW_ERROR);
 
 	/* coff-aware sorting */
 	fcoff  = slbt_host_objfmt_is_coff(dctx);
@@ -334,12 +497,5 @@ static int slbt_ar_update_syminfo_impl(
 slbt_hidden int slbt_ar_update_syminfo(
 	struct slbt_archive_ctx * actx)
 {
-	return slbt_ar_update_syminfo_impl(actx,(-1));
-}
-
-slbt_hidden int slbt_ar_update_syminfo_ex(
-	struct slbt_archive_ctx * actx,
-	int                       fdout)
-{
-	return slbt_ar_update_syminfo_impl(actx,fdout);
+	return slbt_ar_update_syminfo_impl(actx);
 }
@@ -0,0 +1,696 @@
+/*******************************************************************/
+/*  slibtool: a strong libtool implementation, written in C        */
+/*  Copyright (C) 2016--2024  SysDeer Technologies, LLC            */
+/*  Released under the Standard MIT License; see COPYING.SLIBTOOL. */
+/*******************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <sys/mman.h>
+
+#include <slibtool/slibtool.h>
+#include <slibtool/slibtool_arbits.h>
+#include "slibtool_ar_impl.h"
+#include "slibtool_driver_impl.h"
+#include "slibtool_errinfo_impl.h"
+#include "slibtool_realpath_impl.h"
+#include "slibtool_snprintf_impl.h"
+#include "slibtool_visibility_impl.h"
+
+/* file size format specifier */
+#define PPRIU64 "%"PRIu64
+
+static const char ar_signature[]      = AR_SIGNATURE;
+static const char ar_thin_signature[] = AR_THIN_SIGNATURE;
+
+/* a public member of the archive being written: in a thin archive */
+/* the name is the path of the member file relative to the archive, */
+/* and the member data is not stored in the archive itself.         */
+struct ar_thin_member {
+	const struct ar_meta_member_info *      meminfo;
+	const char *                            name;
+	const void *                            data;
+	uint64_t                                size;
+	char *                                  namebuf;
+	struct slbt_input                       map;
+};
+
+struct ar_thin_symbol {
+	const char *                            name;
+	uint64_t                                member;
+};
+
+struct ar_thin_state {
+	struct ar_thin_member *                 memberv;
+	struct ar_thin_symbol *                 symv;
+	uint64_t *                              outidxv;
+	uint64_t                                nmembers;
+	uint64_t                                nsyms;
+};
+
+static off_t slbt_ar_thin_write_le_32(unsigned char * mark, uint64_t val)
+{
+	return slbt_armap_write_le_32(mark,(uint32_t)val);
+}
+
+static off_t slbt_ar_thin_write_be_32(unsigned char * mark, uint64_t val)
+{
+	return slbt_armap_write_be_32(mark,(uint32_t)val);
+}
+
+static void slbt_ar_thin_set_field(char * fld, size_t fldlen, const char * str)
+{
+	size_t len;
+
+	if ((len = strlen(str)) > fldlen)
+		len = fldlen;
+
+	memset(fld,AR_DEC_PADDING,fldlen);
+	memcpy(fld,str,len);
+}
+
+static void slbt_ar_thin_set_decimal(char * fld, size_t fldlen, uint64_t val)
+{
+	char buf[24];
+
+	sprintf(buf,PPRIU64,val);
+	slbt_ar_thin_set_field(fld,fldlen,buf);
+}
+
+static void slbt_ar_thin_init_header(
+	struct ar_raw_file_header *     arhdr,
+	const char *                    fileid,
+	const char *                    attrval,
+	uint64_t                        size)
+{
+	slbt_ar_thin_set_field(arhdr->ar_file_id,sizeof(arhdr->ar_file_id),fileid);
+	slbt_ar_thin_set_field(arhdr->ar_time_date_stamp,sizeof(arhdr->ar_time_date_stamp),attrval);
+	slbt_ar_thin_set_field(arhdr->ar_uid,sizeof(arhdr->ar_uid),attrval);
+	slbt_ar_thin_set_field(arhdr->ar_gid,sizeof(arhdr->ar_gid),attrval);
+	slbt_ar_thin_set_field(arhdr->ar_file_mode,sizeof(arhdr->ar_file_mode),attrval);
+	slbt_ar_thin_set_decimal(arhdr->ar_file_size,sizeof(arhdr->ar_file_size),size);
+
+	arhdr->ar_end_tag[0] = 0x60;
+	arhdr->ar_end_tag[1] = AR_OBJ_PADDING;
+}
+
+/* write a sysv archive: signature, armap, long names, and members; */
+/* every member name is stored in (and referenced by its offset to) */
+/* the long names table, which in a thin archive holds member paths */
+static int slbt_ar_thin_write_archive(
+	const struct slbt_driver_ctx *  dctx,
+	bool                            fthin,
+	uint32_t                        mapattr,
+	const struct ar_thin_state *    state,
+	struct slbt_archive_ctx **      pctx)
+{
+	struct slbt_archive_ctx *       arctx;
+	struct slbt_archive_ctx_impl *  ictx;
+	struct ar_raw_file_header *     arhdr;
+	const struct ar_thin_member *   member;
+	char *                          base;
+	char *                          ch;
+	unsigned char *                 uch;
+	uint64_t *                      offv;
+	uint64_t                        wordsize;
+	uint64_t                        sarmap;
+	uint64_t                        ssymstrs;
+	uint64_t                        snamestrs;
+	uint64_t                        sarchive;
+	uint64_t                        omembers;
+	uint64_t                        onamestr;
+	uint64_t                        idx;
+	char                            fileid[24];
+
+	off_t (*armap_write_uint)(
+		unsigned char *,
+		uint64_t);
+
+	/* armap word size and byte order */
+	wordsize = (mapattr & (AR_ARMAP_ATTR_LE_64|AR_ARMAP_ATTR_BE_64)) ? 8 : 4;
+
+	if (mapattr & AR_ARMAP_ATTR_LE_64)
+		armap_write_uint = slbt_armap_write_le_64;
+
+	else if (mapattr & AR_ARMAP_ATTR_BE_64)
+		armap_write_uint = slbt_armap_write_be_64;
+
+	else if (mapattr & AR_ARMAP_ATTR_LE_32)
+		armap_write_uint = slbt_ar_thin_write_le_32;
+
+	else
+		armap_write_uint = slbt_ar_thin_write_be_32;
+
+	/* armap size */
+	for (ssymstrs=0, idx=0; idx<state->nsyms; idx++)
+		ssymstrs += strlen(state->symv[idx].name) + 1;
+
+	sarmap  = mapattr ? wordsize * (state->nsyms + 1) + ssymstrs : 0;
+	sarmap += 1;
+	sarmap |= 1;
+	sarmap ^= 1;
+
+	/* long names size */
+	for (snamestrs=0, idx=0; idx<state->nmembers; idx++)
+		snamestrs += strlen(state->memberv[idx].name) + 2;
+
+	snamestrs += 1;
+	snamestrs |= 1;
+	snamestrs ^= 1;
+
+	/* member offsets, archive size */
+	if (!(offv = calloc(state->nmembers + 1,sizeof(*offv))))
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	omembers  = sizeof(struct ar_raw_signature);
+	omembers += mapattr   ? sizeof(struct ar_raw_file_header) + sarmap : 0;
+	omembers += snamestrs ? sizeof(struct ar_raw_file_header) + snamestrs : 0;
+
+	for (sarchive=omembers, idx=0; idx<state->nmembers; idx++) {
+		offv[idx]  = sarchive;
+		sarchive  += sizeof(struct ar_raw_file_header);
+		sarchive  += fthin ? 0 : state->memberv[idx].size;
+		sarchive  += 1;
+		sarchive  |= 1;
+		sarchive  ^= 1;
+	}
+
+	/* create in-memory archive */
+	if (slbt_create_anonymous_archive_ctx(dctx,sarchive,&arctx) < 0) {
+		free(offv);
+		return SLBT_NESTED_ERROR(dctx);
+	}
+
+	base = arctx->map->map_addr;
+	ch   = base;
+
+	/* archive signature */
+	memcpy(ch,fthin ? ar_thin_signature : ar_signature,sizeof(struct ar_raw_signature));
+	ch += sizeof(struct ar_raw_signature);
+
+	/* armap */
+	if (mapattr) {
+		arhdr = (struct ar_raw_file_header *)ch;
+		slbt_ar_thin_init_header(arhdr,(wordsize == 8) ? "/SYM64/" : "/","0",sarmap);
+
+		uch  = (unsigned char *)ch;
+		uch += sizeof(*arhdr);
+		uch += armap_write_uint(uch,state->nsyms);
+
+		for (idx=0; idx<state->nsyms; idx++)
+			uch += armap_write_uint(uch,offv[state->symv[idx].member]);
+
+		for (ch=(char *)uch, idx=0; idx<state->nsyms; idx++) {
+			strcpy(ch,state->symv[idx].name);
+			ch += strlen(ch);
+			ch++;
+		}
+
+		ch  = (char *)arhdr;
+		ch += sizeof(*arhdr);
+		ch += sarmap;
+	}
+
+	/* long names */
+	if (snamestrs) {
+		arhdr = (struct ar_raw_file_header *)ch;
+		slbt_ar_thin_init_header(arhdr,"//","",snamestrs);
+
+		ch += sizeof(*arhdr);
+		memset(ch,AR_OBJ_PADDING,snamestrs);
+	}
+
+	/* members */
+	for (onamestr=0, idx=0; idx<state->nmembers; idx++) {
+		member = &state->memberv[idx];
+
+		sprintf(&ch[onamestr],"%s/",member->name);
+		sprintf(fileid,"/"PPRIU64,onamestr);
+
+		onamestr += strlen(member->name) + 1;
+		ch[onamestr++] = AR_OBJ_PADDING;
+
+		arhdr = (struct ar_raw_file_header *)&base[offv[idx]];
+		memcpy(arhdr,member->meminfo->ar_member_data,sizeof(*arhdr));
+
+		slbt_ar_thin_set_field(arhdr->ar_file_id,sizeof(arhdr->ar_file_id),fileid);
+		slbt_ar_thin_set_decimal(arhdr->ar_file_size,sizeof(arhdr->ar_file_size),member->size);
+
+		if (!fthin && member->size) {
+			memcpy(&arhdr[1],member->data,member->size);
+
+			if (member->size % 2)
+				((char *)&arhdr[1])[member->size] = AR_OBJ_PADDING;
+		}
+	}
+
+	free(offv);
+
+	/* meta */
+	ictx = slbt_get_archive_ictx(arctx);
+
+	if (slbt_ar_get_archive_meta(dctx,arctx->map,&ictx->meta) < 0) {
+		slbt_ar_free_archive_ctx(arctx);
+		return SLBT_NESTED_ERROR(dctx);
+	}
+
+	ictx->actx.meta = ictx->meta;
+
+	*pctx = arctx;
+
+	return 0;
+}
+
+/* lexically resolve . and .. components of an absolute path */
+static void slbt_ar_thin_normalize_path(char * path)
+{
+	char *  src;
+	char *  dst;
+	char *  comp;
+	size_t  len;
+
+	for (src=path, dst=path; *src; ) {
+		for (; *src == '/'; )
+			src++;
+
+		for (comp=src; *src && (*src != '/'); )
+			src++;
+
+		if ((len = src - comp) == 0)
+			continue;
+
+		if ((len == 1) && (comp[0] == '.'))
+			continue;
+
+		if ((len == 2) && (comp[0] == '.') && (comp[1] == '.')) {
+			for (; (dst > path) && (*--dst != '/'); )
+				(void)0;
+
+			continue;
+		}
+
+		*dst++ = '/';
+		memmove(dst,comp,len);
+		dst += len;
+	}
+
+	if (dst == path)
+		*dst++ = '/';
+
+	*dst = '\0';
+}
+
+/* path of (normalized, absolute) target relative to (normalized, absolute) dir */
+static int slbt_ar_thin_relative_path(
+	const char *    dir,
+	const char *    target,
+	char *          buf,
+	size_t          buflen)
+{
+	const char *    d;
+	const char *    t;
+	const char *    dcommon;
+	const char *    tcommon;
+	char *          mark;
+	char *          cap;
+
+	for (d=dir, t=target, dcommon=dir, tcommon=target; *d && (*d == *t); d++, t++)
+		if (*d == '/')
+			dcommon = d, tcommon = t;
+
+	if ((!*d && (*t == '/')) || (!*t && (*d == '/')))
+		dcommon = d, tcommon = t;
+
+	mark = buf;
+	cap  = &buf[buflen];
+
+	for (d=dcommon; *d; d++) {
+		if ((d[0] == '/') && d[1]) {
+			if (cap - mark <= 3)
+				return -1;
+
+			memcpy(mark,"../",3);
+			mark += 3;
+		}
+	}
+
+	for (t=tcommon; *t == '/'; )
+		t++;
+
+	if (cap - mark <= (ptrdiff_t)strlen(t))
+		return -1;
+
+	strcpy(mark,t);
+
+	return 0;
+}
+
+/* real path of the directory in which path resides */
+static int slbt_ar_thin_realdir(
+	const struct slbt_driver_ctx *  dctx,
+	const char *                    path,
+	char *                          buf,
+	size_t                          buflen)
+{
+	const char *    slash;
+	char            dir[PATH_MAX];
+
+	if (!path || !(slash = strrchr(path,'/')))
+		strcpy(dir,".");
+
+	else if (slash == path)
+		strcpy(dir,"/");
+
+	else if (slash - path >= PATH_MAX)
+		return SLBT_BUFFER_ERROR(dctx);
+
+	else {
+		memcpy(dir,path,slash - path);
+		dir[slash - path] = '\0';
+	}
+
+	if (slbt_realpath(slbt_driver_fdcwd(dctx),dir,0,buf,buflen) < 0)
+		return SLBT_SYSTEM_ERROR(dctx,dir);
+
+	return 0;
+}
+
+static int slbt_ar_thin_free_state(struct ar_thin_state * state, int ret)
+{
+	uint64_t idx;
+
+	for (idx=0; idx<state->nmembers; idx++) {
+		if (state->memberv[idx].namebuf)
+			free(state->memberv[idx].namebuf);
+
+		if (state->memberv[idx].map.addr)
+			slbt_fs_unmap_input(&state->memberv[idx].map);
+	}
+
+	free(state->memberv);
+	free(state->symv);
+	free(state->outidxv);
+
+	return ret;
+}
+
+/* thin member name in the output archive */
+static int slbt_ar_thin_member_path(
+	const struct slbt_driver_ctx *  dctx,
+	const char *                    srcdir,
+	const char *                    dstdir,
+	const char *                    name,
+	char **                         pname)
+{
+	char    path[PATH_MAX];
+	char    relpath[PATH_MAX];
+
+	if (name[0] == '/') {
+		*pname = strdup(name);
+
+	} else {
+		if (slbt_snprintf(path,sizeof(path),"%s/%s",srcdir,name) < 0)
+			return SLBT_BUFFER_ERROR(dctx);
+
+		slbt_ar_thin_normalize_path(path);
+
+		if (slbt_ar_thin_relative_path(dstdir,path,relpath,sizeof(relpath)) < 0)
+			return SLBT_BUFFER_ERROR(dctx);
+
+		*pname = strdup(relpath);
+	}
+
+	return *pname ? 0 : SLBT_SYSTEM_ERROR(dctx,0);
+}
+
+/* thin member data, as found in the file system */
+static int slbt_ar_thin_member_data(
+	const struct slbt_driver_ctx *  dctx,
+	const char *                    arpath,
+	struct ar_thin_member *         member)
+{
+	const char *    name;
+	const char *    slash;
+	char            path[PATH_MAX];
+
+	name  = member->meminfo->ar_file_header.ar_member_name;
+	slash = arpath ? strrchr(arpath,'/') : 0;
+
+	if ((name[0] == '/') || !slash) {
+		if (slbt_snprintf(path,sizeof(path),"%s",name) < 0)
+			return SLBT_BUFFER_ERROR(dctx);
+
+	} else if (slbt_snprintf(path,sizeof(path),"%.*s/%s",
+			(int)(slash - arpath),arpath,name) < 0) {
+		return SLBT_BUFFER_ERROR(dctx);
+	}
+
+	if (slbt_fs_map_input(dctx,-1,path,PROT_READ,&member->map) < 0)
+		return SLBT_NESTED_ERROR(dctx);
+
+	member->data = member->map.addr;
+	member->size = member->map.size;
+
+	/* the regular member is named after the file */
+	member->name = (slash = strrchr(name,'/')) ? ++slash : name;
+
+	return 0;
+}
+
+/* dstpath: thin output archive; or null for a regular output archive */
+static int slbt_ar_thin_merge_impl(
+	struct slbt_archive_ctx * const arctxv[],
+	const char *                    dstpath,
+	struct slbt_archive_ctx **      arctxm)
+{
+	struct slbt_archive_ctx * const *       arctxp;
+	const struct slbt_driver_ctx *          dctx;
+	const struct slbt_archive_meta *        meta;
+	struct slbt_archive_meta_impl *         mctx;
+	struct ar_meta_member_info *            meminfo;
+	const struct ar_meta_armap_common_32 *  armap32;
+	const struct ar_meta_armap_common_64 *  armap64;
+	struct ar_thin_member *                 member;
+	struct ar_thin_state                    state;
+	const char *                            arpath;
+	uint32_t                                armapattr;
+	uint32_t                                mapattr;
+	uint64_t                                nentries;
+	uint64_t                                nmembers;
+	uint64_t                                nsyms;
+	uint64_t                                ebase;
+	uint64_t                                idx;
+	uint64_t                                symidx;
+	char                                    srcdir[PATH_MAX];
+	char                                    dstdir[PATH_MAX];
+	int                                     ret;
+
+	if (!arctxv || !arctxv[0])
+		return -1;
+
+	if (!(dctx = slbt_get_archive_ictx(arctxv[0])->dctx))
+		return -1;
+
+	/* armap type, number of members and symbols */
+	for (arctxp=arctxv, mapattr=0, nentries=0, nmembers=0, nsyms=0; *arctxp; arctxp++) {
+		if (slbt_get_archive_ictx(*arctxp)->dctx != dctx)
+			return SLBT_CUSTOM_ERROR(
+				dctx,
+				SLBT_ERR_AR_DRIVER_MISMATCH);
+
+		meta    = (*arctxp)->meta;
+		mctx    = slbt_archive_meta_ictx(meta);
+		armap32 = meta->a_armap_primary.ar_armap_common_32;
+		armap64 = meta->a_armap_primary.ar_armap_common_64;
+
+		if (armap32 || armap64) {
+			armapattr = armap32
+				? armap32->ar_armap_attr
+				: armap64->ar_armap_attr;
+
+			if (!(armapattr & AR_ARMAP_ATTR_SYSV))
+				return SLBT_CUSTOM_ERROR(
+					dctx,
+					SLBT_ERR_AR_ARMAP_MISMATCH);
+
+			if (mapattr && (mapattr != armapattr))
+				return SLBT_CUSTOM_ERROR(
+					dctx,
+					SLBT_ERR_AR_ARMAP_MISMATCH);
+
+			mapattr = armapattr;
+			nsyms  += armap32
+				? armap32->ar_num_of_symbols
+				: armap64->ar_num_of_symbols;
+		}
+
+		for (idx=0; idx<mctx->nentries; idx++) {
+			switch (mctx->memberv[idx]->ar_member_attr) {
+				case AR_MEMBER_ATTR_ARMAP:
+				case AR_MEMBER_ATTR_LINKINFO:
+				case AR_MEMBER_ATTR_NAMESTRS:
+					break;
+
+				case AR_MEMBER_ATTR_THIN:
+					nmembers++;
+					break;
+
+				default:
+					if (dstpath)
+						return SLBT_CUSTOM_ERROR(
+							dctx,
+							SLBT_ERR_AR_THIN_MISMATCH);
+
+					nmembers++;
+					break;
+			}
+		}
+
+		nentries += mctx->nentries;
+	}
+
+	/* state */
+	memset(&state,0,sizeof(state));
+
+	state.memberv = calloc(nmembers + 1,sizeof(*state.memberv));
+	state.symv    = calloc(nsyms + 1,sizeof(*state.symv));
+	state.outidxv = calloc(nentries + 1,sizeof(*state.outidxv));
+
+	if (!state.memberv || !state.symv || !state.outidxv)
+		return slbt_ar_thin_free_state(
+			&state,SLBT_SYSTEM_ERROR(dctx,0));
+
+	if (dstpath && (slbt_ar_thin_realdir(dctx,dstpath,dstdir,sizeof(dstdir)) < 0))
+		return slbt_ar_thin_free_state(
+			&state,SLBT_NESTED_ERROR(dctx));
+
+	/* members, in order */
+	for (arctxp=arctxv, ebase=0; *arctxp; arctxp++) {
+		meta   = (*arctxp)->meta;
+		mctx   = slbt_archive_meta_ictx(meta);
+		arpath = (*arctxp)->path ? *(*arctxp)->path : 0;
+
+		if (dstpath && (slbt_ar_thin_realdir(dctx,arpath,srcdir,sizeof(srcdir)) < 0))
+			return slbt_ar_thin_free_state(
+				&state,SLBT_NESTED_ERROR(dctx));
+
+		for (idx=0; idx<mctx->nentries; idx++) {
+			meminfo = mctx->memberv[idx];
+
+			switch (meminfo->ar_member_attr) {
+				case AR_MEMBER_ATTR_ARMAP:
+				case AR_MEMBER_ATTR_LINKINFO:
+				case AR_MEMBER_ATTR_NAMESTRS:
+					continue;
+
+				default:
+					break;
+			}
+
+			member          = &state.memberv[state.nmembers];
+			member->meminfo = meminfo;
+			member->name    = meminfo->ar_file_header.ar_member_name;
+			member->data    = meminfo->ar_object_data;
+			member->size    = meminfo->ar_object_size;
+
+			state.outidxv[ebase + idx] = state.nmembers++;
+
+			if (dstpath)
+				ret = slbt_ar_thin_member_path(
+					dctx,srcdir,dstdir,member->name,
+					&member->namebuf);
+
+			else if (meminfo->ar_member_attr == AR_MEMBER_ATTR_THIN)
+				ret = slbt_ar_thin_member_data(
+					dctx,arpath,member);
+
+			else
+				ret = 0;
+
+			if (ret < 0)
+				return slbt_ar_thin_free_state(
+					&state,SLBT_NESTED_ERROR(dctx));
+
+			if (member->namebuf)
+				member->name = member->namebuf;
+		}
+
+		/* symbols, mapped onto output members */
+		armap32 = meta->a_armap_primary.ar_armap_common_32;
+		armap64 = meta->a_armap_primary.ar_armap_common_64;
+
+		for (idx=0; armap32 && (idx<armap32->ar_num_of_symbols); idx++) {
+			meminfo = slbt_archive_member_from_offset(
+				mctx,armap32->ar_symrefs[idx].ar_member_offset);
+
+			symidx  = meminfo - mctx->members;
+
+			state.symv[state.nsyms].member = state.outidxv[ebase + symidx];
+			state.symv[state.nsyms].name   = &armap32->ar_string_table[
+				armap32->ar_symrefs[idx].ar_name_offset];
+
+			state.nsyms++;
+		}
+
+		for (idx=0; armap64 && (idx<armap64->ar_num_of_symbols); idx++) {
+			meminfo = slbt_archive_member_from_offset(
+				mctx,armap64->ar_symrefs[idx].ar_member_offset);
+
+			symidx  = meminfo - mctx->members;
+
+			state.symv[state.nsyms].member = state.outidxv[ebase + symidx];
+			state.symv[state.nsyms].name   = &armap64->ar_string_table[
+				armap64->ar_symrefs[idx].ar_name_offset];
+
+			state.nsyms++;
+		}
+
+		ebase += mctx->nentries;
+	}
+
+	/* the in-memory archive */
+	ret = slbt_ar_thin_write_archive(
+		dctx,!!dstpath,
+		mapattr,&state,arctxm);
+
+	return slbt_ar_thin_free_state(
+		&state,(ret < 0) ? SLBT_NESTED_ERROR(dctx) : 0);
+}
+
+int slbt_ar_merge_thin(
+	struct slbt_archive_ctx * const arctxv[],
+	const char *                    path,
+	struct slbt_archive_ctx **      arctxm)
+{
+	if (!path)
+		return -1;
+
+	return slbt_ar_thin_merge_impl(arctxv,path,arctxm);
+}
+
+slbt_hidden int slbt_ar_expand_thin_archive(
+	struct slbt_archive_ctx *       arctx,
+	struct slbt_archive_ctx **      pctx)
+{
+	struct slbt_archive_ctx *       arctxv[2];
+
+	arctxv[0] = arctx;
+	arctxv[1] = 0;
+
+	return slbt_ar_thin_merge_impl(arctxv,0,pctx);
+}
+
+slbt_hidden bool slbt_ar_archive_is_thin(const struct slbt_archive_ctx * arctx)
+{
+	return (arctx->map->map_size >= sizeof(struct ar_raw_signature))
+		&& !memcmp(
+			arctx->map->map_addr,
+			ar_thin_signature,
+			sizeof(struct ar_raw_signature));
+}
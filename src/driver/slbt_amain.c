@@ -13,6 +13,8 @@
 #include <slibtool/slibtool.h>
 #include "slibtool_driver_impl.h"
 #include "slibtool_dprintf_impl.h"
+#include "slibtool_server_impl.h"
+#include "slibtool_visibility_impl.h"
 
 #ifndef SLBT_DRIVER_FLAGS
 #define SLBT_DRIVER_FLAGS	SLBT_DRIVER_VERBOSITY_ERRORS \
@@ -88,6 +90,9 @@ static void slbt_perform_driver_actions(struct slbt_driver_ctx * dctx)
 	if (dctx->cctx->mode == SLBT_MODE_CONFIG)
 		slbt_output_config(dctx);
 
+	if (dctx->cctx->mode == SLBT_MODE_CLEAN)
+		slbt_exec_clean(dctx);
+
 	if (dctx->cctx->mode == SLBT_MODE_COMPILE)
 		slbt_exec_compile(dctx);
 
@@ -108,6 +113,12 @@ static void slbt_perform_driver_actions(struct slbt_driver_ctx * dctx)
 
 	if (dctx->cctx->mode == SLBT_MODE_STOOLIE)
 		slbt_exec_stoolie(dctx);
+
+	if (dctx->cctx->mode == SLBT_MODE_BATCH)
+		slbt_exec_batch(dctx);
+
+	if (dctx->cctx->mode == SLBT_MODE_SERVER)
+		slbt_exec_server(dctx);
 }
 
 static int slbt_exit(struct slbt_driver_ctx * dctx, int ret)
@@ -117,25 +128,19 @@ static int slbt_exit(struct slbt_driver_ctx * dctx, int ret)
 	return ret;
 }
 
-int slbt_main(char ** argv, char ** envp, const struct slbt_fd_ctx * fdctx)
+slbt_hidden uint64_t slbt_main_driver_flags(const char * argv0)
 {
-	int				ret;
-	int				fdout;
-	uint64_t			flags;
-	uint64_t			noclr;
-	struct slbt_driver_ctx *	dctx;
-	char *				program;
-	char *				dash;
+	uint64_t	flags;
+	const char *	program;
+	const char *	dash;
 
 	flags = SLBT_DRIVER_FLAGS;
-	fdout = fdctx ? fdctx->fdout : STDOUT_FILENO;
-	noclr = getenv("NO_COLOR") ? SLBT_DRIVER_ANNOTATE_NEVER : 0;
 
 	/* program */
-	if ((program = strrchr(argv[0],'/')))
+	if ((program = strrchr(argv0,'/')))
 		program++;
 	else
-		program = argv[0];
+		program = argv0;
 
 	/* dash */
 	if ((dash = strrchr(program,'-')))
@@ -198,12 +203,11 @@ int slbt_main(char ** argv, char ** envp, const struct slbt_fd_ctx * fdctx)
                           | SLBT_DRIVER_DEBUG
                           | SLBT_DRIVER_LEGABITS);
 
-	/* driver context */
-	if ((ret = slbt_lib_get_driver_ctx(argv,envp,flags|noclr,fdctx,&dctx)))
-		return (ret == SLBT_USAGE)
-			? !argv || !argv[0] || !argv[1] || !argv[2]
-			: SLBT_ERROR;
+	return flags;
+}
 
+slbt_hidden int slbt_main_driver_actions(struct slbt_driver_ctx * dctx, int fdout)
+{
 	/* --dumpmachine disables all other actions */
 	if (dctx->cctx->drvflags & SLBT_DRIVER_OUTPUT_MACHINE)
 		return slbt_output_machine(dctx)
@@ -252,3 +256,30 @@ int slbt_main(char ** argv, char ** envp, const struct slbt_fd_ctx * fdctx)
 
 	return slbt_exit(dctx,dctx->errv[0] ? SLBT_ERROR : SLBT_OK);
 }
+
+int slbt_main(char ** argv, char ** envp, const struct slbt_fd_ctx * fdctx)
+{
+	int				ret;
+	int				fdout;
+	uint64_t			flags;
+	uint64_t			noclr;
+	struct slbt_driver_ctx *	dctx;
+	const char *			dash;
+
+	/* thin client (slibtool-client) */
+	if ((dash = strrchr(argv[0],'-')) && !strcmp(dash,"-client"))
+		return slbt_server_client_main(argv,envp,fdctx);
+
+	fdout = fdctx ? fdctx->fdout : STDOUT_FILENO;
+	noclr = getenv("NO_COLOR") ? SLBT_DRIVER_ANNOTATE_NEVER : 0;
+	flags = slbt_main_driver_flags(argv[0]);
+
+	/* driver context */
+	if ((ret = slbt_lib_get_driver_ctx(argv,envp,flags|noclr,fdctx,&dctx)))
+		return (ret == SLBT_USAGE)
+			? !argv || !argv[0] || !argv[1] || !argv[2]
+			: SLBT_ERROR;
+
+	/* perform the requested actions */
+	return slbt_main_driver_actions(dctx,fdout);
+}
@@ -22,6 +22,7 @@
 #include "slibtool_objlist_impl.h"
 #include "slibtool_errinfo_impl.h"
 #include "slibtool_lconf_impl.h"
+#include "slibtool_toolchain_impl.h"
 #include "slibtool_mkvars_impl.h"
 #include "slibtool_txtline_impl.h"
 #include "slibtool_stoolie_impl.h"
@@ -162,6 +163,22 @@ slbt_hidden int slbt_optv_init(
 }
 
 
+slbt_hidden int slbt_optv_index(
+	const struct argv_option **	optv,
+	struct argv_optidx *		optidx)
+{
+	return argv_optidx_init(optv,optidx) ? 0 : -1;
+}
+
+
+slbt_hidden const struct argv_option * slbt_optv_lookup(
+	const struct argv_optidx *	optidx,
+	const char *			name)
+{
+	return argv_exact_option(name,optidx);
+}
+
+
 slbt_hidden void slbt_argv_scan(
 	char **				argv,
 	const struct argv_option **	optv,
@@ -326,6 +343,8 @@ static struct slbt_driver_ctx_impl * slbt_driver_ctx_alloc(
 	ictx->ctx.errinfp  = &ictx->ctx.erriptr[0];
 	ictx->ctx.erricap  = &ictx->ctx.erriptr[--elements];
 
+	pthread_mutex_init(&ictx->ctx.errlock,0);
+
 	ictx->ctx.objlistv = objlistv;
 
 	ictx->ctx.ctx.errv = ictx->ctx.errinfp;
@@ -498,6 +517,7 @@ int slbt_lib_get_driver_ctx(
 				case TAG_HELP:
 				case TAG_HELP_ALL:
 					switch (cctx.mode) {
+						case SLBT_MODE_CLEAN:
 						case SLBT_MODE_INSTALL:
 						case SLBT_MODE_UNINSTALL:
 						case SLBT_MODE_AR:
@@ -718,8 +738,9 @@ int slbt_lib_get_driver_ctx(
 					break;
 
 				case TAG_AS:
-					cctx.host.as = entry->arg;
-					cfgmeta_as   = cfgexplicit;
+					cctx.host.as  = entry->arg;
+					cfgmeta_as    = cfgexplicit;
+					cctx.drvflags |= SLBT_DRIVER_IMPLIB_DLLTOOL;
 					break;
 
 				case TAG_NM:
@@ -739,6 +760,7 @@ int slbt_lib_get_driver_ctx(
 				case TAG_DLLTOOL:
 					cctx.host.dlltool = entry->arg;
 					cfgmeta_dlltool   = cfgexplicit;
+					cctx.drvflags    |= SLBT_DRIVER_IMPLIB_DLLTOOL;
 					break;
 
 				case TAG_MDSO:
@@ -842,6 +864,46 @@ int slbt_lib_get_driver_ctx(
 
 				case TAG_WEAK:
 					break;
+
+				case TAG_OBJECT_CACHE:
+					cctx.objcache = entry->arg;
+					break;
+
+				case TAG_OBJECT_CACHE_SIZE:
+					cctx.objcachemax = entry->arg;
+					break;
+
+				case TAG_INCREMENTAL_ARCHIVE:
+					cctx.drvflags |= SLBT_DRIVER_INCREMENTAL_ARCHIVE;
+					break;
+
+				case TAG_THIN_ARCHIVE:
+					cctx.drvflags |= SLBT_DRIVER_THIN_ARCHIVE;
+					break;
+
+				case TAG_SORT_SYMBOLS:
+					cctx.drvflags |= SLBT_DRIVER_SORT_SYMBOLS;
+					break;
+
+				case TAG_BATCH:
+					cctx.batch = entry->arg;
+					break;
+
+				case TAG_BATCH_JOBS:
+					cctx.batchjobs = entry->arg;
+					break;
+
+				case TAG_SERVER:
+					cctx.server = entry->arg;
+					break;
+
+				case TAG_INSTALL_JOBS:
+					cctx.installjobs = entry->arg;
+					break;
+
+				case TAG_CLEAN_JOBS:
+					cctx.cleanjobs = entry->arg;
+					break;
 			}
 		}
 	}
@@ -943,6 +1005,14 @@ int slbt_lib_get_driver_ctx(
 	if (cctx.drvflags & (SLBT_DRIVER_INFO | SLBT_DRIVER_FEATURES))
 		cctx.mode = SLBT_MODE_INFO;
 
+	/* batch mode */
+	else if (cctx.batch)
+		cctx.mode = SLBT_MODE_BATCH;
+
+	/* server mode */
+	else if (cctx.server)
+		cctx.mode = SLBT_MODE_SERVER;
+
 	/* --tag */
 	if (cctx.mode == SLBT_MODE_COMPILE)
 		if (cctx.tag == SLBT_TAG_UNKNOWN)
@@ -1019,6 +1089,8 @@ int slbt_lib_get_driver_ctx(
 		switch (cctx.mode) {
 			case SLBT_MODE_UNKNOWN:
 			case SLBT_MODE_STOOLIE:
+			case SLBT_MODE_BATCH:
+			case SLBT_MODE_SERVER:
 				break;
 
 			case SLBT_MODE_CONFIG:
@@ -1197,7 +1269,7 @@ static void slbt_lib_free_driver_ctx_impl(struct slbt_driver_ctx_alloc * ictx)
 	struct slbt_error_info *  erri;
 	struct slbt_obj_list *    objlistp;
 
-	for (perr=ictx->ctx.errinfp; *perr; perr++) {
+	for (perr=ictx->ctx.erriptr; *perr; perr++) {
 		erri = *perr;
 
 		if (erri->eany && (erri->esyscode == ENOENT))
@@ -1210,13 +1282,8 @@ static void slbt_lib_free_driver_ctx_impl(struct slbt_driver_ctx_alloc * ictx)
 	if (ictx->ctx.dlopenv)
 		free(ictx->ctx.dlopenv);
 
-	if (ictx->ctx.lconf.addr)
-		munmap(
-			ictx->ctx.lconf.addr,
-			ictx->ctx.lconf.size);
-
-	if (ictx->ctx.lconfctx)
-		slbt_lib_free_txtfile_ctx(ictx->ctx.lconfctx);
+	if (ictx->ctx.toolchain)
+		slbt_toolchain_release(ictx->ctx.toolchain);
 
 	if (ictx->ctx.mkvarsctx)
 		slbt_lib_free_txtfile_ctx(ictx->ctx.mkvarsctx);
@@ -1236,6 +1303,8 @@ static void slbt_lib_free_driver_ctx_impl(struct slbt_driver_ctx_alloc * ictx)
 	slbt_free_host_params(&ictx->ctx.ahost);
 	argv_free(ictx->ctx.meta);
 
+	pthread_mutex_destroy(&ictx->ctx.errlock);
+
 	free(ictx);
 }
 
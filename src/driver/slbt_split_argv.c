@@ -4,6 +4,7 @@
 /*  Released under the Standard MIT License; see COPYING.SLIBTOOL. */
 /*******************************************************************/
 
+#include <fcntl.h>
 #include <stdint.h>
 #include <string.h>
 #include <unistd.h>
@@ -22,7 +23,7 @@
 
 static char * slbt_default_cargv[] = {"cc",0};
 
-slbt_hidden int slbt_split_argv(
+static int slbt_split_argv_impl(
 	char **				argv,
 	uint64_t			flags,
 	struct slbt_split_vector *	sargv,
@@ -56,6 +57,8 @@ slbt_hidden int slbt_split_argv(
 	struct argv_entry *		info;
 	struct argv_entry *		config;
 	struct argv_entry *		finish;
+	struct argv_entry *		batch;
+	struct argv_entry *		server;
 	struct argv_entry *		features;
 	struct argv_entry *		ccwrap;
 	struct argv_entry *		dumpmachine;
@@ -63,12 +66,13 @@ slbt_hidden int slbt_split_argv(
 	struct argv_entry *		printext;
 	struct argv_entry *		aropt;
 	struct argv_entry *		stoolieopt;
-	const struct argv_option **	popt;
 	const struct argv_option **	optout;
 	const struct argv_option *	optv[SLBT_OPTV_ELEMENTS];
-	struct argv_ctx			ctx = {ARGV_VERBOSITY_NONE,
+	struct argv_optidx		optidx;
+	struct argv_ctx			ctx = {ARGV_VERBOSITY_NONE
+						| ARGV_SCAN_UNTIL_UNIT,
 						ARGV_MODE_SCAN,
-						0,0,0,0,0,0,0,0};
+						0,0,0,0,0,0,0,0,0};
 
 	program = slbt_program_name(argv[0]);
 
@@ -88,7 +92,7 @@ slbt_hidden int slbt_split_argv(
 			0,optv,0,sargv,0,
 			!!getenv("NO_COLOR"));
 
-	/* initial argv scan: ... --mode=xxx ... <compiler> ... */
+	/* initial argv scan: ... --mode=xxx ... <compiler>, stop there */
 	slbt_argv_scan(argv,optv,&ctx,0);
 
 	/* invalid slibtool arguments? */
@@ -125,9 +129,9 @@ slbt_hidden int slbt_split_argv(
 		return -1;
 	}
 
-	/* missing all of --mode, --help, --version, --info, --config, --dumpmachine, --features, and --finish? */
+	/* missing all of --mode, --help, --version, --info, --config, --dumpmachine, --features, --finish, --batch, and --server? */
 	/* as well as -print-aux-dir and -print-m4-dir? */
-	mode = help = version = info = config = finish = features = ccwrap = dumpmachine = printdir = printext = aropt = stoolieopt = 0;
+	mode = help = version = info = config = finish = batch = server = features = ccwrap = dumpmachine = printdir = printext = aropt = stoolieopt = 0;
 
 	for (entry=meta->entries; entry->fopt; entry++)
 		if (entry->tag == TAG_MODE)
@@ -142,6 +146,10 @@ slbt_hidden int slbt_split_argv(
 			config = entry;
 		else if (entry->tag == TAG_FINISH)
 			finish = entry;
+		else if (entry->tag == TAG_BATCH)
+			batch = entry;
+		else if (entry->tag == TAG_SERVER)
+			server = entry;
 		else if (entry->tag == TAG_FEATURES)
 			features = entry;
 		else if (entry->tag == TAG_CCWRAP)
@@ -180,7 +188,7 @@ slbt_hidden int slbt_split_argv(
 		return -1;
 	}
 
-	if (!mode && !help && !version && !info && !config && !finish && !features && !dumpmachine && !printdir && !printext && !altmode) {
+	if (!mode && !help && !version && !info && !config && !finish && !batch && !server && !features && !dumpmachine && !printdir && !printext && !altmode) {
 		slbt_dprintf(fderr,
 			"%s: error: --mode must be specified.\n",
 			program);
@@ -188,7 +196,7 @@ slbt_hidden int slbt_split_argv(
 	}
 
 	/* missing compiler? */
-	if (!ctx.unitidx && !help && !info && !config && !version && !finish && !features && !dumpmachine && !printdir && !printext) {
+	if (!ctx.unitidx && !help && !info && !config && !version && !finish && !batch && !server && !features && !dumpmachine && !printdir && !printext) {
 		if (!altmode && !aropt && !stoolieopt) {
 			if (flags & SLBT_DRIVER_VERBOSITY_ERRORS)
 				slbt_dprintf(fderr,
@@ -350,7 +358,7 @@ slbt_hidden int slbt_split_argv(
 	if (ctx.unitidx) {
 		(void)0;
 
-	} else if (help || version || features || info || config || dumpmachine || printdir || printext || altmode) {
+	} else if (help || version || features || info || config || batch || server || dumpmachine || printdir || printext || altmode) {
 		for (i=0; i<argc; i++)
 			sargv->targv[i] = argv[i];
 
@@ -397,6 +405,9 @@ slbt_hidden int slbt_split_argv(
 	for (optout=optv; optout[0] && (optout[0]->tag != TAG_OUTPUT); optout++)
 		(void)0;
 
+	if (slbt_optv_index(optout,&optidx) < 0)
+		return -1;
+
 	/* compiler, archiver, etc. */
 	if (altmode) {
 		i = 0;
@@ -552,11 +563,7 @@ slbt_hidden int slbt_split_argv(
 				*targv++ = argv[i];
 			}
 		} else {
-			for (popt=optout; popt[0] && popt[0]->long_name; popt++)
-				if (!(strcmp(popt[0]->long_name,&argv[i][1])))
-					break;
-
-			if (popt[0] && popt[0]->long_name)
+			if (slbt_optv_lookup(&optidx,&argv[i][1]))
 				*targv++ = argv[i];
 			else
 				*cargv++ = argv[i];
@@ -565,3 +572,108 @@ slbt_hidden int slbt_split_argv(
 
 	return 0;
 }
+
+static bool slbt_split_argv_is_rspfile(int fdcwd, const char * arg)
+{
+	return (arg[0] == '@') && arg[1] && !faccessat(fdcwd,&arg[1],R_OK,0);
+}
+
+static void slbt_split_argv_free_rsplistv(struct slbt_obj_list * rsplistv)
+{
+	struct slbt_obj_list * rsplistp;
+
+	for (rsplistp=rsplistv; rsplistp->name; rsplistp++) {
+		free(rsplistp->objv);
+		free(rsplistp->addr);
+	}
+
+	free(rsplistv);
+}
+
+slbt_hidden int slbt_split_argv(
+	char **				argv,
+	uint64_t			flags,
+	struct slbt_split_vector *	sargv,
+	struct slbt_obj_list **		aobjlistv,
+	int				fderr,
+	int				fdcwd)
+{
+	int				ret;
+	int				nrsp;
+	size_t				argc;
+	char **				parg;
+	char **				xargv;
+	char **				dst;
+	char **				objv;
+	struct slbt_obj_list *		rsplistv;
+	struct slbt_obj_list *		rsplistp;
+
+	/* response files: arguments of the executed program are not ours */
+	for (parg=&argv[1], nrsp=0; *parg; parg++) {
+		if (!strcmp(*parg,"--mode=execute"))
+			return slbt_split_argv_impl(
+				argv,flags,sargv,aobjlistv,
+				fderr,fdcwd);
+
+		if (!strcmp(*parg,"--mode") && parg[1] && !strcmp(parg[1],"execute"))
+			return slbt_split_argv_impl(
+				argv,flags,sargv,aobjlistv,
+				fderr,fdcwd);
+
+		nrsp += slbt_split_argv_is_rspfile(fdcwd,*parg);
+	}
+
+	if (!nrsp)
+		return slbt_split_argv_impl(
+			argv,flags,sargv,aobjlistv,
+			fderr,fdcwd);
+
+	/* @file --> file content, a missing file is a regular argument */
+	if (!(rsplistv = calloc(nrsp+1,sizeof(*rsplistv))))
+		return -1;
+
+	for (parg=&argv[1], rsplistp=rsplistv, argc=1; *parg; parg++) {
+		if (slbt_split_argv_is_rspfile(fdcwd,*parg)) {
+			rsplistp->name = &(*parg)[1];
+
+			if (slbt_rsplist_read(fdcwd,rsplistp) < 0) {
+				rsplistp->name = 0;
+				slbt_split_argv_free_rsplistv(rsplistv);
+				return -1;
+			}
+
+			argc += rsplistp++->objc;
+		} else {
+			argc++;
+		}
+	}
+
+	if (!(xargv = calloc(argc+1,sizeof(char *)))) {
+		slbt_split_argv_free_rsplistv(rsplistv);
+		return -1;
+	}
+
+	dst    = xargv;
+	*dst++ = argv[0];
+
+	for (parg=&argv[1], rsplistp=rsplistv; *parg; parg++) {
+		if (rsplistp->name && (&(*parg)[1] == rsplistp->name)) {
+			for (objv=rsplistp->objv; *objv; objv++)
+				*dst++ = *objv;
+
+			rsplistp++;
+		} else {
+			*dst++ = *parg;
+		}
+	}
+
+	/* all argument strings are copied by the split */
+	ret = slbt_split_argv_impl(
+		xargv,flags,sargv,aobjlistv,
+		fderr,fdcwd);
+
+	slbt_split_argv_free_rsplistv(rsplistv);
+	free(xargv);
+
+	return ret;
+}
@@ -9,12 +9,94 @@
 #include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 #include <sys/mman.h>
 
 #include <slibtool/slibtool.h>
+#include "slibtool_coff_impl.h"
 #include "slibtool_driver_impl.h"
+#include "slibtool_dprintf_impl.h"
 #include "slibtool_errinfo_impl.h"
 
+/********************************************************/
+/* Symbol list: one symbol per line. As with the text   */
+/* file context, the file is mapped privately and each  */
+/* symbol is null-terminated in place, unless the size  */
+/* of the file is a multiple of the page size.          */
+/*                                                      */
+/* Repeated symbols are dropped as the list is loaded,  */
+/* so that symstrv holds every symbol once, in order of */
+/* first appearance. With --sort-symbols, mapstrv       */
+/* holds the same symbols in sorted order, and is what  */
+/* the mapfile writer then emits.                       */
+/********************************************************/
+
+static int slbt_qsort_strcmp(const void * a, const void * b)
+{
+	return strcmp(*(const char **)a,*(const char **)b);
+}
+
+static uint32_t slbt_symlist_hash(const char * sym)
+{
+	uint32_t hash;
+
+	/* fnv-1a */
+	for (hash=2166136261u; *sym; sym++) {
+		hash ^= (unsigned char)*sym;
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+static int slbt_symlist_dedup(
+	const struct slbt_driver_ctx *  dctx,
+	const char **                   symstrv,
+	size_t                          nsyms,
+	size_t *                        nuniq)
+{
+	size_t          idx;
+	size_t          mask;
+	size_t          nslots;
+	const char **   slotv;
+	const char **   slot;
+	const char **   psym;
+	const char **   pdst;
+
+	*nuniq = 0;
+
+	/* open addressing, load factor of at most one half */
+	for (nslots=64; nslots < 2*nsyms; )
+		nslots <<= 1;
+
+	if (!(slotv = calloc(nslots,sizeof(*slotv))))
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	mask = nslots - 1;
+
+	for (psym=symstrv,pdst=symstrv; *psym; psym++) {
+		idx  = slbt_symlist_hash(*psym) & mask;
+		slot = &slotv[idx];
+
+		for (; *slot && strcmp(*slot,*psym); ) {
+			idx  = (idx + 1) & mask;
+			slot = &slotv[idx];
+		}
+
+		if (!*slot) {
+			*slot   = *psym;
+			*pdst++ = *psym;
+		}
+	}
+
+	*pdst  = 0;
+	*nuniq = pdst - symstrv;
+
+	free(slotv);
+
+	return 0;
+}
+
 static int slbt_lib_free_symlist_ctx_impl(
 	struct slbt_symlist_ctx_impl *  ctx,
 	struct slbt_input *             mapinfo,
@@ -33,6 +115,11 @@ static int slbt_lib_free_symlist_ctx_impl(
 		if (ctx->symstrv)
 			free(ctx->symstrv);
 
+		if (ctx->mapstrv)
+			free(ctx->mapstrv);
+
+		slbt_fs_unmap_input(&ctx->symmap);
+
 		free(ctx);
 	}
 
@@ -47,16 +134,18 @@ int slbt_lib_get_symlist_ctx(
 	struct slbt_symlist_ctx_impl *  ctx;
 	struct slbt_input               mapinfo;
 	size_t                          nsyms;
+	size_t                          nuniq;
+	bool                            fcoff;
 	char *                          ch;
 	char *                          cap;
 	char *                          src;
+	char *                          mark;
 	const char **                   psym;
-	char                            dummy;
+	long                            pagesize;
 	int                             cint;
-	bool                            fvalid;
 
-	/* map symlist file temporarily */
-	if (slbt_fs_map_input(dctx,-1,path,PROT_READ,&mapinfo) < 0)
+	/* map symlist file, copy-on-write */
+	if (slbt_fs_map_input(dctx,-1,path,PROT_READ|PROT_WRITE,&mapinfo) < 0)
 		return SLBT_NESTED_ERROR(dctx);
 
 	/* alloc context */
@@ -65,71 +154,118 @@ int slbt_lib_get_symlist_ctx(
 			ctx,&mapinfo,
 			SLBT_BUFFER_ERROR(dctx));
 
-	/* count symbols */
-	src = mapinfo.size ? mapinfo.addr : &dummy;
-	cap = &src[mapinfo.size];
+	/* room for the terminator? tokenize in place */
+	pagesize = sysconf(_SC_PAGESIZE);
+
+	if (mapinfo.size && (pagesize > 0) && (mapinfo.size % pagesize)) {
+		ctx->symmap = mapinfo;
+		src = mapinfo.addr;
 
-	for (; (src<cap) && isspace((cint=*src)); )
-		src++;
+	} else {
+		if (!(ctx->symstrs = calloc(mapinfo.size+1,1)))
+			return slbt_lib_free_symlist_ctx_impl(
+				ctx,&mapinfo,
+				SLBT_SYSTEM_ERROR(dctx,0));
+
+		if (mapinfo.size)
+			memcpy(ctx->symstrs,mapinfo.addr,mapinfo.size);
+
+		slbt_fs_unmap_input(&mapinfo);
+		src = ctx->symstrs;
+	}
+
+	/* count symbols: a single token per non-empty line */
+	cap = &src[mapinfo.size];
 
 	for (ch=src,nsyms=0; ch<cap; nsyms++) {
-		for (; (ch<cap) && !isspace((cint=*ch)); )
+		for (; (ch<cap) && isspace((cint=*ch)); )
 			ch++;
 
-		fvalid = false;
+		if (ch == cap)
+			break;
 
-		for (; (ch<cap) && isspace((cint=*ch)); )
-			fvalid = (*ch++ == '\n') || fvalid;
+		if (!(mark = memchr(ch,'\n',cap-ch)))
+			return slbt_lib_free_symlist_ctx_impl(
+				ctx,0,
+				SLBT_CUSTOM_ERROR(
+					dctx,
+					SLBT_ERR_FLOW_ERROR));
+
+		for (; (ch<mark) && !isspace((cint=*ch)); )
+			ch++;
 
-		if (!fvalid)
+		for (; (ch<mark) && isspace((cint=*ch)); )
+			ch++;
+
+		if (ch < mark)
 			return slbt_lib_free_symlist_ctx_impl(
-				ctx,&mapinfo,
+				ctx,0,
 				SLBT_CUSTOM_ERROR(
 					dctx,
 					SLBT_ERR_FLOW_ERROR));
+
+		ch = &mark[1];
 	}
 
-	/* clone path, alloc string buffer and symbol vector */
+	/* clone path, alloc symbol vector */
 	if (!(ctx->pathbuf = strdup(path)))
 		return slbt_lib_free_symlist_ctx_impl(
-			ctx,&mapinfo,
-			SLBT_SYSTEM_ERROR(dctx,0));
-
-	if (!(ctx->symstrs = calloc(mapinfo.size+1,1)))
-		return slbt_lib_free_symlist_ctx_impl(
-			ctx,&mapinfo,
+			ctx,0,
 			SLBT_SYSTEM_ERROR(dctx,0));
 
 	if (!(ctx->symstrv = calloc(nsyms+1,sizeof(char *))))
 		return slbt_lib_free_symlist_ctx_impl(
-			ctx,&mapinfo,
+			ctx,0,
 			SLBT_SYSTEM_ERROR(dctx,0));
 
-	/* copy the source to the allocated string buffer */
-	memcpy(ctx->symstrs,mapinfo.addr,mapinfo.size);
-	slbt_fs_unmap_input(&mapinfo);
-
 	/* populate the symbol vector, handle whitespace */
-	src = ctx->symstrs;
-	cap = &src[mapinfo.size];
+	for (ch=src,psym=ctx->symstrv; ch<cap; psym++) {
+		for (; (ch<cap) && isspace((cint=*ch)); )
+			ch++;
 
-	for (; (src<cap) && isspace((cint=*src)); )
-		src++;
+		if (ch == cap)
+			break;
 
-	for (ch=src,psym=ctx->symstrv; ch<cap; psym++) {
 		*psym = ch;
+		mark  = memchr(ch,'\n',cap-ch);
 
-		for (; (ch<cap) && !isspace((cint=*ch)); )
+		for (; !isspace((cint=*ch)); )
 			ch++;
 
-		for (; (ch<cap) && isspace((cint=*ch)); )
-			*ch++ = '\0';
+		*ch = '\0';
+		ch  = &mark[1];
 	}
 
+	/* drop repeated symbols */
+	if (slbt_symlist_dedup(dctx,ctx->symstrv,nsyms,&nuniq) < 0)
+		return slbt_lib_free_symlist_ctx_impl(
+			ctx,0,
+			SLBT_NESTED_ERROR(dctx));
+
+	/* sorted symbol vector (optional) */
+	if (dctx->cctx->drvflags & SLBT_DRIVER_SORT_SYMBOLS) {
+		if (!(ctx->mapstrv = calloc(nuniq+1,sizeof(char *))))
+			return slbt_lib_free_symlist_ctx_impl(
+				ctx,0,
+				SLBT_SYSTEM_ERROR(dctx,0));
+
+		memcpy(ctx->mapstrv,ctx->symstrv,nuniq*sizeof(char *));
+
+		fcoff = slbt_host_objfmt_is_coff(dctx);
+
+		qsort(ctx->mapstrv,nuniq,sizeof(const char *),
+			fcoff ? slbt_coff_qsort_strcmp : slbt_qsort_strcmp);
+	}
+
+	if (dctx->cctx->drvflags & SLBT_DRIVER_DEBUG)
+		slbt_dprintf(slbt_driver_fderr(dctx),
+			"%s: symbol list: %s: %zu symbols, %zu unique.\n",
+			dctx->program,path,nsyms,nuniq);
+
 	/* all done */
 	ctx->dctx         = dctx;
 	ctx->path         = ctx->pathbuf;
-	ctx->sctx.path	  = &ctx->path;
+	ctx->sctx.path    = &ctx->path;
 	ctx->sctx.symstrv = ctx->symstrv;
 
 	*pctx = &ctx->sctx;
@@ -9,6 +9,7 @@
 #include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 #include <sys/mman.h>
 
 #include <slibtool/slibtool.h>
@@ -20,6 +21,11 @@
 /* Read a text file, and create an in-memory vecotr of  */
 /* normalized text lines, stripped of both leading and  */
 /* trailing white space.                                */
+/*                                                      */
+/* The file is mapped privately, and lines are null-    */
+/* terminated in place (copy-on-write). Files whose     */
+/* size is a multiple of the page size, and which thus  */
+/* lack a zero-filled tail, are copied instead.         */
 /********************************************************/
 
 static int slbt_lib_free_txtfile_ctx_impl(
@@ -40,92 +46,87 @@ static int slbt_lib_free_txtfile_ctx_impl(
 		if (ctx->txtlinev)
 			free(ctx->txtlinev);
 
+		slbt_fs_unmap_input(&ctx->txtmap);
+
 		free(ctx);
 	}
 
 	return ret;
 }
 
-static int slbt_lib_get_txtfile_ctx_impl(
+/* txtlines: either a malloc'ed, (size + 1) byte buffer, or  */
+/* the address of a private mapping (mapinfo); in both cases */
+/* txtlines[size] is zero, and is owned by the context.      */
+static int slbt_lib_txtfile_ctx_from_buffer(
 	const struct slbt_driver_ctx *  dctx,
 	const char *                    path,
-	int                             fdsrc,
+	char *                          txtlines,
+	size_t                          size,
+	struct slbt_input *             mapinfo,
 	struct slbt_txtfile_ctx **      pctx)
 {
 	struct slbt_txtfile_ctx_impl *  ctx;
-	struct slbt_input               mapinfo;
 	size_t                          nlines;
 	char *                          ch;
 	char *                          cap;
 	char *                          src;
 	char *                          mark;
 	const char **                   pline;
-	char                            dummy;
 	int                             cint;
 
-	/* map txtfile file temporarily */
-	if (slbt_fs_map_input(dctx,fdsrc,path,PROT_READ,&mapinfo) < 0)
-		return SLBT_NESTED_ERROR(dctx);
+	/* alloc context, which now owns the string buffer */
+	if (!(ctx = calloc(1,sizeof(*ctx)))) {
+		if (mapinfo)
+			slbt_fs_unmap_input(mapinfo);
+		else
+			free(txtlines);
 
-	/* alloc context */
-	if (!(ctx = calloc(1,sizeof(*ctx))))
-		return slbt_lib_free_txtfile_ctx_impl(
-			ctx,&mapinfo,
-			SLBT_BUFFER_ERROR(dctx));
+		return SLBT_BUFFER_ERROR(dctx);
+	}
+
+	if (mapinfo)
+		ctx->txtmap = *mapinfo;
+	else
+		ctx->txtlines = txtlines;
 
 	/* count lines */
-	src = mapinfo.size ? mapinfo.addr : &dummy;
-	cap = &src[mapinfo.size];
+	src = txtlines;
+	cap = &src[size];
 
 	for (; (src<cap) && isspace((cint=*src)); )
 		src++;
 
-	for (ch=src,nlines=0; ch<cap; ch++)
-		nlines += (*ch == '\n');
+	for (ch=src,nlines=0; (ch=memchr(ch,'\n',cap-ch)); ch++)
+		nlines++;
 
-	nlines += (ch[-1] != '\n');
+	nlines += size && (cap[-1] != '\n');
 
-	/* clone path, alloc string buffer and line vector */
+	/* clone path, alloc line vector */
 	if (!(ctx->pathbuf = strdup(path)))
 		return slbt_lib_free_txtfile_ctx_impl(
-			ctx,&mapinfo,
-			SLBT_SYSTEM_ERROR(dctx,0));
-
-	if (!(ctx->txtlines = calloc(mapinfo.size+1,1)))
-		return slbt_lib_free_txtfile_ctx_impl(
-			ctx,&mapinfo,
+			ctx,0,
 			SLBT_SYSTEM_ERROR(dctx,0));
 
 	if (!(ctx->txtlinev = calloc(nlines+1,sizeof(char *))))
 		return slbt_lib_free_txtfile_ctx_impl(
-			ctx,&mapinfo,
+			ctx,0,
 			SLBT_SYSTEM_ERROR(dctx,0));
 
-	/* copy the source to the allocated string buffer */
-	memcpy(ctx->txtlines,mapinfo.addr,mapinfo.size);
-	slbt_fs_unmap_input(&mapinfo);
-
 	/* populate the line vector, handle whitespace */
-	src = ctx->txtlines;
-	cap = &src[mapinfo.size];
-
-	for (; (src<cap) && isspace((cint=*src)); )
-		*src++ = '\0';
-
-	for (ch=src,pline=ctx->txtlinev; ch<cap; pline++) {
+	for (ch=src,pline=ctx->txtlinev; ch<cap; ) {
 		for (; (ch<cap) && isspace((cint = *ch)); )
 			ch++;
 
-		if (ch < cap)
-			*pline = ch;
+		if (ch == cap)
+			break;
 
-		for (; (ch<cap) && (*ch != '\n'); )
-			ch++;
+		*pline++ = ch;
 
-		mark = ch;
+		if (!(mark = memchr(ch,'\n',cap-ch)))
+			mark = cap;
 
-		for (--ch; (ch > *pline) && isspace((cint = *ch)); ch--)
-			*ch = '\0';
+		for (src=mark; isspace((cint = src[-1])); )
+			*--src = '\0';
 
 		if ((ch = mark) < cap)
 			*ch++ = '\0';
@@ -142,6 +143,44 @@ static int slbt_lib_get_txtfile_ctx_impl(
 	return 0;
 }
 
+static int slbt_lib_get_txtfile_ctx_impl(
+	const struct slbt_driver_ctx *  dctx,
+	const char *                    path,
+	int                             fdsrc,
+	struct slbt_txtfile_ctx **      pctx)
+{
+	struct slbt_input               mapinfo;
+	char *                          txtlines;
+	long                            pagesize;
+
+	/* map txtfile file, copy-on-write */
+	if (slbt_fs_map_input(dctx,fdsrc,path,PROT_READ|PROT_WRITE,&mapinfo) < 0)
+		return SLBT_NESTED_ERROR(dctx);
+
+	/* room for the terminator? tokenize in place */
+	pagesize = sysconf(_SC_PAGESIZE);
+
+	if (mapinfo.size && (pagesize > 0) && (mapinfo.size % pagesize))
+		return slbt_lib_txtfile_ctx_from_buffer(
+			dctx,path,mapinfo.addr,
+			mapinfo.size,&mapinfo,pctx);
+
+	/* copy the source to an allocated string buffer */
+	if (!(txtlines = calloc(mapinfo.size+1,1)))
+		return slbt_lib_free_txtfile_ctx_impl(
+			0,&mapinfo,
+			SLBT_SYSTEM_ERROR(dctx,0));
+
+	if (mapinfo.size)
+		memcpy(txtlines,mapinfo.addr,mapinfo.size);
+
+	slbt_fs_unmap_input(&mapinfo);
+
+	return slbt_lib_txtfile_ctx_from_buffer(
+		dctx,path,txtlines,
+		mapinfo.size,0,pctx);
+}
+
 slbt_hidden int slbt_impl_get_txtfile_ctx(
 	const struct slbt_driver_ctx *  dctx,
 	const char *                    path,
@@ -151,6 +190,16 @@ slbt_hidden int slbt_impl_get_txtfile_ctx(
 	return slbt_lib_get_txtfile_ctx_impl(dctx,path,fdsrc,pctx);
 }
 
+slbt_hidden int slbt_impl_get_txtfile_ctx_from_buffer(
+	const struct slbt_driver_ctx *  dctx,
+	const char *                    path,
+	char *                          txtbuf,
+	size_t                          size,
+	struct slbt_txtfile_ctx **      pctx)
+{
+	return slbt_lib_txtfile_ctx_from_buffer(dctx,path,txtbuf,size,0,pctx);
+}
+
 int slbt_lib_get_txtfile_ctx(
 	const struct slbt_driver_ctx *  dctx,
 	const char *                    path,
@@ -12,7 +12,9 @@
 #include <stdbool.h>
 #include <fcntl.h>
 #include <spawn.h>
+#include <pthread.h>
 #include <sys/wait.h>
+#include <sys/stat.h>
 
 #include <slibtool/slibtool.h>
 #include "slibtool_driver_impl.h"
@@ -20,6 +22,8 @@
 #include "slibtool_errinfo_impl.h"
 #include "slibtool_visibility_impl.h"
 #include "slibtool_ar_impl.h"
+#include "slibtool_snprintf_impl.h"
+#include "slibtool_which_impl.h"
 
 
 /* annotation strings */
@@ -60,6 +64,173 @@ static void slbt_get_host_quad(
 }
 
 
+/* probe results, shared by all driver contexts of the current process; */
+/* each result is stamped with the identity of the probed program, and */
+/* is discarded once that program has been replaced or removed.        */
+struct slbt_host_probe {
+	struct slbt_host_probe *	next;
+	char *				value;
+	char *				program;
+	char *				stamp;
+	char				key[];
+};
+
+static struct slbt_host_probe * slbt_host_probes;
+static pthread_mutex_t          slbt_host_probe_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void slbt_host_probe_free(struct slbt_host_probe * probe)
+{
+	free(probe->value);
+	free(probe->program);
+	free(probe->stamp);
+	free(probe);
+}
+
+static int slbt_host_probe_stamp(
+	const struct slbt_driver_ctx *	dctx,
+	const char *			program,
+	char *				stamp,
+	size_t				buflen)
+{
+	struct stat	st;
+	char		path[PATH_MAX];
+
+	if (slbt_which(dctx,program,path,sizeof(path),&st) < 0)
+		return slbt_snprintf(stamp,buflen,"-");
+
+	return slbt_snprintf(stamp,buflen,
+		"%s:%jd:%jd:%jd:%jd.%ld",
+		path,
+		(intmax_t)st.st_dev,
+		(intmax_t)st.st_ino,
+		(intmax_t)st.st_size,
+		(intmax_t)st.st_mtim.tv_sec,
+		(long)st.st_mtim.tv_nsec);
+}
+
+static bool slbt_host_probe_get(
+	const struct slbt_driver_ctx *	dctx,
+	const char *			kind,
+	const char *			arg1,
+	const char *			arg2,
+	char *				value,
+	size_t				buflen)
+{
+	struct slbt_host_probe **	pprobe;
+	struct slbt_host_probe *	probe;
+	bool				fhit;
+	char				key[PATH_MAX];
+	char				stamp[PATH_MAX];
+
+	if (slbt_snprintf(key,sizeof(key),"%s:%s:%s",kind,arg1,arg2) < 0)
+		return false;
+
+	pthread_mutex_lock(&slbt_host_probe_lock);
+
+	for (fhit=false, pprobe=&slbt_host_probes; *pprobe; pprobe=&(*pprobe)->next) {
+		if (!strcmp((*pprobe)->key,key)) {
+			probe = *pprobe;
+
+			if (slbt_host_probe_stamp(dctx,probe->program,stamp,sizeof(stamp)) < 0)
+				break;
+
+			if (!strcmp(probe->stamp,stamp)) {
+				fhit = (strlen(probe->value) < buflen);
+
+				if (fhit)
+					strcpy(value,probe->value);
+
+				break;
+			}
+
+			*pprobe = probe->next;
+			slbt_host_probe_free(probe);
+			break;
+		}
+	}
+
+	pthread_mutex_unlock(&slbt_host_probe_lock);
+
+	return fhit;
+}
+
+static void slbt_host_probe_set(
+	const struct slbt_driver_ctx *	dctx,
+	const char *			kind,
+	const char *			arg1,
+	const char *			arg2,
+	const char *			program,
+	const char *			value)
+{
+	struct slbt_host_probe *	probe;
+	char				key[PATH_MAX];
+	char				stamp[PATH_MAX];
+	size_t				keylen;
+
+	if (slbt_snprintf(key,sizeof(key),"%s:%s:%s",kind,arg1,arg2) < 0)
+		return;
+
+	if (slbt_host_probe_stamp(dctx,program,stamp,sizeof(stamp)) < 0)
+		return;
+
+	keylen = strlen(key);
+
+	if (!(probe = calloc(1,sizeof(*probe) + keylen + 1)))
+		return;
+
+	probe->value   = strdup(value);
+	probe->program = strdup(program);
+	probe->stamp   = strdup(stamp);
+
+	if (!probe->value || !probe->program || !probe->stamp) {
+		slbt_host_probe_free(probe);
+		return;
+	}
+
+	memcpy(probe->key,key,keylen);
+
+	pthread_mutex_lock(&slbt_host_probe_lock);
+
+	probe->next      = slbt_host_probes;
+	slbt_host_probes = probe;
+
+	pthread_mutex_unlock(&slbt_host_probe_lock);
+}
+
+slbt_hidden void slbt_host_flush_probes(void)
+{
+	struct slbt_host_probe *	probe;
+	struct slbt_host_probe *	next;
+
+	pthread_mutex_lock(&slbt_host_probe_lock);
+
+	for (probe=slbt_host_probes; probe; probe=next) {
+		next = probe->next;
+		slbt_host_probe_free(probe);
+	}
+
+	slbt_host_probes = 0;
+
+	pthread_mutex_unlock(&slbt_host_probe_lock);
+}
+
+static int slbt_host_dump_machine(
+	const struct slbt_driver_ctx *	dctx,
+	const char *			compiler,
+	char *				machine,
+	size_t				buflen)
+{
+	if (slbt_host_probe_get(dctx,"dumpmachine",compiler,"",machine,buflen))
+		return 0;
+
+	if (slbt_util_dump_machine(compiler,machine,buflen) < 0)
+		return -1;
+
+	slbt_host_probe_set(dctx,"dumpmachine",compiler,"",compiler,machine);
+
+	return 0;
+}
+
 static void slbt_spawn_ar(char ** argv, int * ecode)
 {
 	int	estatus;
@@ -169,7 +340,7 @@ slbt_hidden int slbt_init_host_params(
 		host->host    = drvhost->machine;
 		cfgmeta->host = cfgnmachine;
 
-	} else if (slbt_util_dump_machine(cctx->cargv[0],buf,sizeof(buf)) < 0) {
+	} else if (slbt_host_dump_machine(dctx,cctx->cargv[0],buf,sizeof(buf)) < 0) {
 		if (dctx)
 			slbt_dprintf(
 				slbt_driver_fderr(dctx),
@@ -277,6 +448,18 @@ slbt_hidden int slbt_init_host_params(
 			arprobe = false;
 		}
 
+		/* arprobe: reuse a previous result */
+		if (arprobe && slbt_host_probe_get(dctx,"ar",host->host,base,drvhost->ar,toollen)) {
+			arprobe = false;
+
+			if (!strcmp(drvhost->ar,"ar")) {
+				cfgmeta->ar = cfgnative;
+				fnative     = true;
+			} else {
+				cfgmeta->ar = cfghost;
+			}
+		}
+
 		/* arprobe */
 		if (arprobe) {
 			sprintf(drvhost->ar,"%s-ar",host->host);
@@ -331,6 +514,9 @@ slbt_hidden int slbt_init_host_params(
 				unlinkat(fdcwd,archivename,0);
 				close(arfd);
 			}
+
+			/* share the result */
+			slbt_host_probe_set(dctx,"ar",host->host,base,drvhost->ar,drvhost->ar);
 		}
 
 		host->ar = drvhost->ar;
@@ -597,6 +783,13 @@ int  slbt_host_set_althost(
 	addr = (uintptr_t)ctx - offsetof(struct slbt_driver_ctx_alloc,ctx);
 	addr = addr - offsetof(struct slbt_driver_ctx_impl,ctx);
 	ictx = (struct slbt_driver_ctx_alloc *)addr;
+
+	/* same alternate host as before? */
+	if (ictx->ctx.ahost.host && ictx->ctx.ahost.flavor)
+		if (!strcmp(ictx->ctx.ahost.host,host))
+			if (!strcmp(ictx->ctx.ahost.flavor,flavor))
+				return 0;
+
 	slbt_free_host_params(&ictx->ctx.ahost);
 
 	if (!(ictx->ctx.ahost.host = strdup(host)))
@@ -19,12 +19,17 @@
 #define ARGV_VERBOSITY_NONE		0x00
 #define ARGV_VERBOSITY_ERRORS		0x01
 #define ARGV_VERBOSITY_STATUS		0x02
+#define ARGV_SCAN_UNTIL_UNIT		0x40
 #define ARGV_CLONE_VECTOR		0x80
 
 #ifndef ARGV_TAB_WIDTH
 #define ARGV_TAB_WIDTH			8
 #endif
 
+#ifndef ARGV_OPTV_INDEX_ELEMENTS
+#define ARGV_OPTV_INDEX_ELEMENTS	256
+#endif
+
 /*******************************************/
 /*                                         */
 /* support of hybrid options               */
@@ -152,6 +157,17 @@ struct argv_ctx {
 	const struct argv_option *	erropt;
 	const char *			program;
 	size_t				keyvlen;
+	int *				optcache;
+};
+
+/* option vector index: short options by name, long options */
+/* stably sorted by their first character, with the vector   */
+/* order preserved within each bucket (first match wins).    */
+struct argv_optidx {
+	const struct argv_option *	shortv[256];
+	const struct argv_option *	longv[ARGV_OPTV_INDEX_ELEMENTS];
+	size_t				lenv[ARGV_OPTV_INDEX_ELEMENTS];
+	int				bucketv[257];
 };
 
 #ifdef ARGV_DRIVER
@@ -214,55 +230,109 @@ static int argv_optv_init(
 	return i;
 }
 
-static const struct argv_option * argv_short_option(
-	const char *			ch,
+static bool argv_optidx_init(
 	const struct argv_option **	optv,
-	struct argv_entry *		entry)
+	struct argv_optidx *		optidx)
 {
 	const struct argv_option *	option;
+	unsigned char			c;
+	int				nlong;
+	int				i;
 
-	for (; *optv; optv++) {
-		option = *optv;
+	memset(optidx->shortv,0,sizeof(optidx->shortv));
+	memset(optidx->bucketv,0,sizeof(optidx->bucketv));
+
+	/* first pass: short options, long option bucket sizes */
+	for (i=0,nlong=0; (option = optv[i]); i++) {
+		if ((c = option->short_name))
+			if (!optidx->shortv[c])
+				optidx->shortv[c] = option;
+
+		if (option->long_name && option->long_name[0]) {
+			optidx->bucketv[(unsigned char)option->long_name[0] + 1]++;
+			nlong++;
+		}
+	}
+
+	if (nlong > ARGV_OPTV_INDEX_ELEMENTS)
+		return false;
+
+	for (i=0; i<256; i++)
+		optidx->bucketv[i+1] += optidx->bucketv[i];
+
+	/* second pass: stable placement, bucketv[c] ends up at the next bucket */
+	for (i=0; (option = optv[i]); i++) {
+		if (option->long_name && option->long_name[0]) {
+			c = option->long_name[0];
+			nlong = optidx->bucketv[c]++;
 
-		if (option->short_name == *ch) {
-			entry->tag	= option->tag;
-			entry->fopt	= true;
-			return option;
+			optidx->longv[nlong] = option;
+			optidx->lenv[nlong]  = strlen(option->long_name);
 		}
 	}
 
+	for (i=256; i; i--)
+		optidx->bucketv[i] = optidx->bucketv[i-1];
+
+	optidx->bucketv[0] = 0;
+
+	return true;
+}
+
+static const struct argv_option * argv_exact_option(
+	const char *			name,
+	const struct argv_optidx *	optidx)
+{
+	int	i;
+	int	cap;
+
+	i   = optidx->bucketv[(unsigned char)*name];
+	cap = optidx->bucketv[(unsigned char)*name + 1];
+
+	for (; i<cap; i++)
+		if (!strcmp(optidx->longv[i]->long_name,name))
+			return optidx->longv[i];
+
 	return 0;
 }
 
-static const struct argv_option * argv_long_option(
+static const struct argv_option * argv_short_option(
 	const char *			ch,
-	const struct argv_option **	optv,
-	struct argv_entry *		entry)
+	const struct argv_optidx *	optidx)
+{
+	return optidx->shortv[(unsigned char)*ch];
+}
+
+static int argv_long_option_idx(
+	const char *			ch,
+	const struct argv_optidx *	optidx)
 {
 	const struct argv_option *	option;
 	const char *			arg;
 	size_t				len;
+	int				i;
+	int				cap;
 
-	for (; *optv; optv++) {
-		option = *optv;
-		len    = option->long_name ? strlen(option->long_name) : 0;
+	i   = optidx->bucketv[(unsigned char)*ch];
+	cap = optidx->bucketv[(unsigned char)*ch + 1];
+
+	for (; i<cap; i++) {
+		option = optidx->longv[i];
+		len    = optidx->lenv[i];
 
-		if (len && !(strncmp(option->long_name,ch,len))) {
+		if (!(strncmp(option->long_name,ch,len))) {
 			arg = ch + len;
 
 			if (!*arg
 				|| (*arg == '=')
 				|| (option->flags & ARGV_OPTION_HYBRID_JOINED)
 				|| ((option->flags & ARGV_OPTION_HYBRID_COMMA)
-					&& (*arg == ','))) {
-				entry->tag	= option->tag;
-				entry->fopt	= true;
-				return option;
-			}
+					&& (*arg == ',')))
+				return i;
 		}
 	}
 
-	return 0;
+	return -1;
 }
 
 static inline bool is_short_option(const char * arg)
@@ -282,24 +352,53 @@ static inline bool is_last_option(const char * arg)
 
 static inline bool is_hybrid_option(
 	const char *			arg,
-	const struct argv_option **	optv)
+	const struct argv_option *	option,
+	const struct argv_optidx *	optidx)
 {
-	const struct argv_option *	option;
-	struct argv_entry		entry;
-
 	if (!is_short_option(arg))
 		return false;
 
-	if (!(option = argv_long_option(++arg,optv,&entry)))
+	if (!option)
 		return false;
 
 	if (!(option->flags & ARGV_OPTION_HYBRID_SWITCH))
-		if (argv_short_option(arg,optv,&entry))
+		if (argv_short_option(++arg,optidx))
 			return false;
 
 	return true;
 }
 
+/* the long (or hybrid) option matching an argument, if any, looked */
+/* up once per argument and shared by the scan and copy passes.    */
+static const struct argv_option * argv_long_option(
+	char **				parg,
+	char **				argv,
+	const struct argv_optidx *	optidx,
+	struct argv_ctx *		ctx)
+{
+	const char *	ch;
+	int *		cached;
+	int		i;
+
+	ch     = *parg;
+	cached = ctx->optcache ? &ctx->optcache[parg - argv] : 0;
+
+	if (cached && *cached)
+		return (*cached > 0) ? optidx->longv[*cached - 1] : 0;
+
+	if (is_long_option(ch))
+		i = argv_long_option_idx(&ch[2],optidx);
+	else if (is_short_option(ch))
+		i = argv_long_option_idx(&ch[1],optidx);
+	else
+		i = -1;
+
+	if (cached)
+		*cached = (i < 0) ? -1 : i + 1;
+
+	return (i < 0) ? 0 : optidx->longv[i];
+}
+
 static inline bool is_arg_in_paradigm(const char * arg, const char * paradigm)
 {
 	size_t		len;
@@ -459,7 +558,8 @@ static void argv_scan(
 	const char *			ch;
 	const char *			val;
 	const struct argv_option *	option;
-	struct argv_entry		entry;
+	const struct argv_option *	loption;
+	struct argv_optidx		optidx;
 	struct argv_entry *		mentry;
 	enum argv_error			ferr;
 	bool				fval;
@@ -482,8 +582,16 @@ static void argv_scan(
 	ctx->unitidx = 0;
 	ctx->erridx  = 0;
 
+	if (!argv_optidx_init(optv,&optidx)) {
+		ctx->errcode = ARGV_ERROR_INTERNAL;
+		ctx->errch   = ch;
+		ctx->erridx  = 1;
+		return;
+	}
+
 	while (ch && (ferr == ARGV_ERROR_OK)) {
 		option  = 0;
+		loption = 0;
 		fhybrid = false;
 
 		if (fnoscan)
@@ -492,14 +600,17 @@ static void argv_scan(
 		else if (is_last_option(ch))
 			fnoscan = true;
 
-		else if (!fshort && is_hybrid_option(ch,optv))
+		else if (!fshort)
+			loption = argv_long_option(parg,argv,&optidx,ctx);
+
+		if (loption && is_hybrid_option(ch,loption,&optidx))
 			fhybrid = true;
 
 		if (!fnoscan && !fhybrid && (fshort || is_short_option(ch))) {
 			if (!fshort)
 				ch++;
 
-			if ((option = argv_short_option(ch,optv,&entry))) {
+			if ((option = argv_short_option(ch,&optidx))) {
 				if (ch[1]) {
 					ch++;
 					fnext	= false;
@@ -556,7 +667,7 @@ static void argv_scan(
 		} else if (!fnoscan && (fhybrid || is_long_option(ch))) {
 			ch += (fhybrid ? 1 : 2);
 
-			if ((option = argv_long_option(ch,optv,&entry))) {
+			if ((option = loption)) {
 				val = ch + strlen(option->long_name);
 
 				/* val[0] is either '=' (or ',') or '\0' */
@@ -655,6 +766,9 @@ static void argv_scan(
 			return;
 		}
 
+		if (ctx->unitidx && (ctx->flags & ARGV_SCAN_UNTIL_UNIT))
+			return;
+
 		if (ctx->mode == ARGV_MODE_SCAN) {
 			if (!fnoscan)
 				ctx->nentries++;
@@ -1005,8 +1119,18 @@ static struct argv_meta * argv_get(
 	int				fd)
 {
 	struct argv_meta *	meta;
-	struct argv_ctx		ctx = {flags,ARGV_MODE_SCAN,0,0,0,0,0,0,0,0};
+	char **			parg;
+	int *			optcache;
+	struct argv_ctx		ctx = {flags,ARGV_MODE_SCAN,0,0,0,0,0,0,0,0,0};
+
+	/* per-argument option lookups, shared by both passes */
+	for (parg=argv; *parg; parg++)
+		(void)0;
 
+	if (!(optcache = calloc(parg-argv+1,sizeof(int))))
+		return 0;
+
+	ctx.optcache = optcache;
 	argv_scan(argv,optv,&ctx,0);
 
 	if (ctx.errcode != ARGV_ERROR_OK) {
@@ -1015,14 +1139,18 @@ static struct argv_meta * argv_get(
 		if (ctx.flags & ARGV_VERBOSITY_ERRORS)
 			argv_show_error(fd,&ctx);
 
+		free(optcache);
 		return 0;
 	}
 
-	if (!(meta = argv_alloc(argv,&ctx)))
+	if (!(meta = argv_alloc(argv,&ctx))) {
+		free(optcache);
 		return 0;
+	}
 
 	ctx.mode = ARGV_MODE_COPY;
 	argv_scan(meta->argv,optv,&ctx,meta);
+	free(optcache);
 
 	if (ctx.errcode != ARGV_ERROR_OK) {
 		ctx.program = argv[0];
@@ -7,9 +7,12 @@
 #ifndef SLIBTOOL_AR_IMPL_H
 #define SLIBTOOL_AR_IMPL_H
 
+#include <stdbool.h>
+
 #include "argv/argv.h"
 #include <slibtool/slibtool.h>
 #include <slibtool/slibtool_arbits.h>
+#include "slibtool_sha256_impl.h"
 
 /* decimal values in archive header are right padded with ascii spaces */
 #define AR_DEC_PADDING (0x20)
@@ -51,6 +54,7 @@ struct slbt_archive_meta_impl {
 	struct ar_meta_member_info *    members;
 	struct ar_armaps_impl           armaps;
 	struct slbt_txtfile_ctx *       nminfo;
+	bool                            fthin;
 	struct slbt_archive_meta        armeta;
 };
 
@@ -81,9 +85,62 @@ int slbt_update_mapstrv(
 int slbt_ar_update_syminfo(
 	struct slbt_archive_ctx * actx);
 
-int slbt_ar_update_syminfo_ex(
-	struct slbt_archive_ctx * actx,
-	int                       fdout);
+int slbt_ar_output_mapfile_fdout(
+	const struct slbt_archive_meta * meta,
+	int                              fdout);
+
+int slbt_au_output_arname_fdout(
+	const struct slbt_archive_ctx *  actx,
+	int                              fdout);
+
+int slbt_au_output_members_fdout(
+	const struct slbt_archive_meta * meta,
+	int                              fdout);
+
+int slbt_au_output_symbols_fdout(
+	const struct slbt_archive_meta * meta,
+	int                              fdout);
+
+int slbt_au_output_mapfile_fdout(
+	const struct slbt_archive_meta * meta,
+	int                              fdout);
+
+int slbt_ar_get_dlsyms_digest(
+	struct slbt_archive_ctx **  arctxv,
+	const char *                dlunit,
+	char                        (*digest)[SLBT_SHA256_HEXDIGEST_SIZE]);
+
+int slbt_create_anonymous_archive_ctx(
+	const struct slbt_driver_ctx *  dctx,
+	size_t                          size,
+	struct slbt_archive_ctx **      pctx);
+
+off_t slbt_armap_write_be_32(unsigned char * mark, uint32_t val);
+off_t slbt_armap_write_le_32(unsigned char * mark, uint32_t val);
+off_t slbt_armap_write_be_64(unsigned char * mark, uint64_t val);
+off_t slbt_armap_write_le_64(unsigned char * mark, uint64_t val);
+
+int slbt_ar_expand_thin_archive(
+	struct slbt_archive_ctx *       arctx,
+	struct slbt_archive_ctx **      pctx);
+
+bool slbt_ar_archive_is_thin(
+	const struct slbt_archive_ctx * arctx);
+
+int slbt_util_import_thin_archive(
+	const struct slbt_exec_ctx *    ectx,
+	char *                          dstarchive,
+	char *                          srcarchive);
+
+bool slbt_ar_implib_supported(
+	const struct slbt_driver_ctx *  dctx);
+
+int slbt_ar_create_implib(
+	const struct slbt_driver_ctx *  dctx,
+	const char *                    deffilename,
+	const char *                    dllname,
+	const char *                    implibname,
+	mode_t                          mode);
 
 static inline struct slbt_archive_meta_impl * slbt_archive_meta_ictx(const struct slbt_archive_meta * meta)
 {
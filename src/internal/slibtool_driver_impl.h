@@ -9,12 +9,14 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <pthread.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 
 #include <slibtool/slibtool.h>
 #include "slibtool_dprintf_impl.h"
 #include "slibtool_mapfile_impl.h"
+#include "slibtool_sha256_impl.h"
 #include "slibtool_visibility_impl.h"
 #include "argv/argv.h"
 
@@ -96,6 +98,16 @@ enum app_tags {
 	TAG_VERBATIM_FLAG,
 	TAG_THREAD_SAFE,
 	TAG_WEAK,
+	TAG_OBJECT_CACHE,
+	TAG_OBJECT_CACHE_SIZE,
+	TAG_INCREMENTAL_ARCHIVE,
+	TAG_THIN_ARCHIVE,
+	TAG_SORT_SYMBOLS,
+	TAG_BATCH,
+	TAG_BATCH_JOBS,
+	TAG_SERVER,
+	TAG_INSTALL_JOBS,
+	TAG_CLEAN_JOBS,
 	/* ar mode */
 	TAG_AR_HELP,
 	TAG_AR_VERSION,
@@ -110,8 +122,10 @@ enum app_tags {
 	TAG_AR_POSIX,
 	TAG_AR_YAML,
 	TAG_AR_MERGE,
+	TAG_AR_THIN,
 	TAG_AR_OUTPUT,
 	TAG_AR_VERBOSE,
+	TAG_AR_JOBS,
 	/* slibtoolize (stoolie) mode */
 	TAG_STLE_VERSION,
 	TAG_STLE_HELP,
@@ -125,6 +139,7 @@ enum app_tags {
 	TAG_STLE_WARNINGS,
 	TAG_STLE_NO_WARNINGS,
 	TAG_STLE_LTDL,
+	TAG_STLE_JOBS,
 };
 
 struct slbt_split_vector {
@@ -169,7 +184,7 @@ struct slbt_driver_ctx_impl {
 	struct slbt_host_strs           host;
 	struct slbt_host_strs           ahost;
 	struct slbt_fd_ctx              fdctx;
-	struct slbt_map_info            lconf;
+	struct slbt_toolchain_ctx *     toolchain;
 	struct slbt_txtfile_ctx *       lconfctx;
 	struct slbt_txtfile_ctx *       mkvarsctx;
 	struct slbt_obj_list *          objlistv;
@@ -187,10 +202,12 @@ struct slbt_driver_ctx_impl {
 	char **                         cargv;
 	char **                         envp;
 
+	pthread_mutex_t                 errlock;
 	struct slbt_error_info**        errinfp;
 	struct slbt_error_info**        erricap;
 	struct slbt_error_info *        erriptr[64];
 	struct slbt_error_info          erribuf[64];
+	pthread_t                       erritid[64];
 };
 
 struct slbt_driver_ctx_alloc {
@@ -204,6 +221,7 @@ struct slbt_exec_ctx_impl {
 	struct slbt_exec_ctx            ctx;
 	struct slbt_archive_ctx **      dlactxv;
 	struct slbt_archive_ctx *       dlpreopen;
+	struct slbt_deps_node *         depnodes;
 	char **                         dlargv;
 	int                             argc;
 	char *                          args;
@@ -212,7 +230,11 @@ struct slbt_exec_ctx_impl {
 	size_t                          size;
 	size_t                          exts;
 	int                             fdwrapper;
+	int                             fdlauncher;
+	int                             fdout;
+	int                             fderr;
 	char                            sbuf[PATH_MAX];
+	char                            dlsymsdigest[SLBT_SHA256_HEXDIGEST_SIZE];
 	char **                         lout[2];
 	char **                         mout[2];
 	char **                         vbuffer;
@@ -233,6 +255,8 @@ struct slbt_symlist_ctx_impl {
 	char *                          pathbuf;
 	char *                          symstrs;
 	const char **                   symstrv;
+	const char **                   mapstrv;
+	struct slbt_input               symmap;
 	struct slbt_symlist_ctx         sctx;
 };
 
@@ -243,6 +267,7 @@ struct slbt_txtfile_ctx_impl {
 	char *                          pathbuf;
 	char *                          txtlines;
 	const char **                   txtlinev;
+	struct slbt_input               txtmap;
 	struct slbt_txtfile_ctx         tctx;
 };
 
@@ -267,10 +292,26 @@ struct slbt_stoolie_ctx_impl {
 const char * slbt_program_name(const char *);
 
 
+uint64_t slbt_main_driver_flags(const char * argv0);
+
+
+int slbt_main_driver_actions(
+	struct slbt_driver_ctx *	dctx,
+	int				fdout);
+
+
 int slbt_optv_init(
 	const struct argv_option[],
 	const struct argv_option **);
 
+int slbt_optv_index(
+	const struct argv_option **	optv,
+	struct argv_optidx *		optidx);
+
+const struct argv_option * slbt_optv_lookup(
+	const struct argv_optidx *	optidx,
+	const char *			name);
+
 
 uint64_t slbt_argv_flags(uint64_t flags);
 
@@ -347,6 +388,9 @@ int slbt_init_host_params(
 void slbt_free_host_params(struct slbt_host_strs * host);
 
 
+void slbt_host_flush_probes(void);
+
+
 int slbt_init_link_params(struct slbt_driver_ctx_impl * ctx);
 
 
@@ -371,6 +415,13 @@ int slbt_impl_get_txtfile_ctx(
 	int                             fdsrc,
 	struct slbt_txtfile_ctx **      pctx);
 
+int slbt_impl_get_txtfile_ctx_from_buffer(
+	const struct slbt_driver_ctx *  dctx,
+	const char *                    path,
+	char *                          txtbuf,
+	size_t                          size,
+	struct slbt_txtfile_ctx **      pctx);
+
 
 static inline struct slbt_archive_ctx_impl * slbt_get_archive_ictx(const struct slbt_archive_ctx * actx)
 {
@@ -512,4 +563,54 @@ static inline void slbt_exec_close_fdwrapper(const struct slbt_exec_ctx * ectx)
 	ictx->fdwrapper = (-1);
 }
 
+static inline int slbt_exec_get_fdlauncher(const struct slbt_exec_ctx * ectx)
+{
+	struct slbt_exec_ctx_impl * ictx;
+	ictx = slbt_get_exec_ictx(ectx);
+	return ictx->fdlauncher;
+}
+
+static inline void slbt_exec_set_fdlauncher(const struct slbt_exec_ctx * ectx, int fd)
+{
+	struct slbt_exec_ctx_impl * ictx;
+	ictx = slbt_get_exec_ictx(ectx);
+	ictx->fdlauncher = fd;
+}
+
+static inline void slbt_exec_close_fdlauncher(const struct slbt_exec_ctx * ectx)
+{
+	struct slbt_exec_ctx_impl * ictx;
+	ictx = slbt_get_exec_ictx(ectx);
+	close(ictx->fdlauncher);
+	ictx->fdlauncher = (-1);
+}
+
+static inline int slbt_exec_get_fdout(const struct slbt_exec_ctx * ectx)
+{
+	struct slbt_exec_ctx_impl * ictx;
+	ictx = slbt_get_exec_ictx(ectx);
+	return (ictx->fdout >= 0) ? ictx->fdout : slbt_driver_fdout(ictx->dctx);
+}
+
+static inline void slbt_exec_set_fdout(const struct slbt_exec_ctx * ectx, int fd)
+{
+	struct slbt_exec_ctx_impl * ictx;
+	ictx = slbt_get_exec_ictx(ectx);
+	ictx->fdout = fd;
+}
+
+static inline int slbt_exec_get_fderr(const struct slbt_exec_ctx * ectx)
+{
+	struct slbt_exec_ctx_impl * ictx;
+	ictx = slbt_get_exec_ictx(ectx);
+	return (ictx->fderr >= 0) ? ictx->fderr : slbt_driver_fderr(ictx->dctx);
+}
+
+static inline void slbt_exec_set_fderr(const struct slbt_exec_ctx * ectx, int fd)
+{
+	struct slbt_exec_ctx_impl * ictx;
+	ictx = slbt_get_exec_ictx(ectx);
+	ictx->fderr = fd;
+}
+
 #endif
@@ -4,6 +4,11 @@
 /*  Released under the Standard MIT License; see COPYING.SLIBTOOL. */
 /*******************************************************************/
 
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <pthread.h>
+
 #include <slibtool/slibtool.h>
 #include "slibtool_driver_impl.h"
 #include "slibtool_errinfo_impl.h"
@@ -23,8 +28,12 @@ slbt_hidden int slbt_record_error(
 
 	ictx = slbt_get_driver_ictx(dctx);
 
-	if (ictx->errinfp == ictx->erricap)
+	pthread_mutex_lock(&ictx->errlock);
+
+	if (ictx->errinfp == ictx->erricap) {
+		pthread_mutex_unlock(&ictx->errlock);
 		return -1;
+	}
 
 	*ictx->errinfp = &ictx->erribuf[ictx->errinfp - ictx->erriptr];
 	erri = *ictx->errinfp;
@@ -37,7 +46,92 @@ slbt_hidden int slbt_record_error(
 	erri->eflags    = eflags;
 	erri->eany      = (eany && (esyscode == ENOENT)) ? strdup(eany) : eany;
 
+	ictx->erritid[ictx->errinfp - ictx->erriptr] = pthread_self();
 	ictx->errinfp++;
 
+	pthread_mutex_unlock(&ictx->errlock);
+
 	return -1;
 }
+
+slbt_hidden struct slbt_error_info ** slbt_error_info_mark(
+	const struct slbt_driver_ctx *	dctx)
+{
+	struct slbt_driver_ctx_impl *	ictx;
+	struct slbt_error_info **	mark;
+
+	ictx = slbt_get_driver_ictx(dctx);
+
+	pthread_mutex_lock(&ictx->errlock);
+	mark = ictx->errinfp;
+	pthread_mutex_unlock(&ictx->errlock);
+
+	return mark;
+}
+
+/* of the errors that were recorded since mark, keep those whose  */
+/* recording thread is (fmatch) or is not (!fmatch) tid, and free */
+/* the path copies of the others.                                 */
+static void slbt_error_info_filter(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_error_info **	mark,
+	pthread_t			tid,
+	bool				fmatch)
+{
+	struct slbt_driver_ctx_impl *	ictx;
+	struct slbt_error_info **	perr;
+	struct slbt_error_info **	pdst;
+	struct slbt_error_info *	erri;
+	ptrdiff_t			sidx;
+	ptrdiff_t			didx;
+	bool				fkeep;
+
+	ictx = slbt_get_driver_ictx(dctx);
+
+	pthread_mutex_lock(&ictx->errlock);
+
+	for (perr=mark, pdst=mark; perr<ictx->errinfp; perr++) {
+		sidx = perr - ictx->erriptr;
+		didx = pdst - ictx->erriptr;
+		erri = *perr;
+
+		fkeep = pthread_equal(ictx->erritid[sidx],tid)
+			? fmatch : !fmatch;
+
+		if (fkeep) {
+			ictx->erribuf[didx] = *erri;
+			ictx->erritid[didx] = ictx->erritid[sidx];
+			*pdst++ = &ictx->erribuf[didx];
+
+		} else if (erri->eany && (erri->esyscode == ENOENT)) {
+			free(erri->eany);
+		}
+	}
+
+	for (perr=pdst; perr<ictx->errinfp; perr++)
+		*perr = 0;
+
+	ictx->errinfp = pdst;
+
+	pthread_mutex_unlock(&ictx->errlock);
+}
+
+/* of the errors that were recorded since mark, keep only those */
+/* that were recorded by tid, so that the error vector which    */
+/* follows concurrent work does not depend on thread timing.    */
+slbt_hidden void slbt_error_info_select(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_error_info **	mark,
+	pthread_t			tid)
+{
+	slbt_error_info_filter(dctx,mark,tid,true);
+}
+
+/* drop the errors that the calling thread recorded since mark, */
+/* as when a failed attempt is followed by a fallback.          */
+slbt_hidden void slbt_error_info_discard(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_error_info **	mark)
+{
+	slbt_error_info_filter(dctx,mark,pthread_self(),false);
+}
@@ -8,6 +8,7 @@
 #define SLIBTOOL_ERRINFO_IMPL_H
 
 #include <errno.h>
+#include <pthread.h>
 #include <slibtool/slibtool.h>
 
 int slbt_record_error(
@@ -19,6 +20,18 @@ int slbt_record_error(
 	unsigned	eflags,
 	void *		eany);
 
+struct slbt_error_info ** slbt_error_info_mark(
+	const struct slbt_driver_ctx *);
+
+void slbt_error_info_select(
+	const struct slbt_driver_ctx *,
+	struct slbt_error_info **	mark,
+	pthread_t			tid);
+
+void slbt_error_info_discard(
+	const struct slbt_driver_ctx *,
+	struct slbt_error_info **	mark);
+
 #define SLBT_SYSTEM_ERROR(dctx,eany)      \
 	slbt_record_error(                \
 		dctx,                     \
@@ -0,0 +1,535 @@
+/*******************************************************************/
+/*  slibtool: a strong libtool implementation, written in C        */
+/*  Copyright (C) 2016--2024  SysDeer Technologies, LLC            */
+/*  Released under the Standard MIT License; see COPYING.SLIBTOOL. */
+/*******************************************************************/
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pwd.h>
+#include <grp.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+#endif
+
+#ifdef HAVE_SYS_SYSCALL_H
+#include <sys/syscall.h>
+#endif
+
+#include <slibtool/slibtool.h>
+#include "slibtool_driver_impl.h"
+#include "slibtool_dprintf_impl.h"
+#include "slibtool_errinfo_impl.h"
+#include "slibtool_install_impl.h"
+#include "slibtool_installer_impl.h"
+#include "slibtool_snprintf_impl.h"
+#include "slibtool_spawn_impl.h"
+#include "slibtool_visibility_impl.h"
+
+/*****************************************************************/
+/* common install(1) invocations (-c, -m <octal>, -d, -p, -t,    */
+/* and -o, -g when running as root) are performed in-process:    */
+/* the source is copied (reflink, copy_file_range, read/write)   */
+/* to a temporary file next to the destination, which then       */
+/* receives its ownership, mode, and timestamps, and is finally  */
+/* renamed over the destination. anything else is left to the    */
+/* install program.                                              */
+/*****************************************************************/
+
+#ifndef O_DIRECTORY
+#define O_DIRECTORY 0
+#endif
+
+#define SLBT_INSTALLER_BUFSIZE	65536
+
+static const char * slbt_installer_programs[] = {
+	"install",
+	"ginstall",
+	"install-sh",
+	"shtool",
+	0
+};
+
+static void slbt_installer_set_fallback(
+	struct slbt_installer *	inst,
+	const char *		reason,
+	const char *		arg)
+{
+	if (!inst->fallback[0])
+		snprintf(
+			inst->fallback,sizeof(inst->fallback),
+			"%s%s%s",reason,
+			arg ? " " : "",
+			arg ? arg : "");
+}
+
+static bool slbt_installer_get_mode(const char * arg, mode_t * mode)
+{
+	const char *	ch;
+	unsigned	val;
+
+	for (ch=arg, val=0; *ch; ch++) {
+		if ((*ch < '0') || (*ch > '7'))
+			return false;
+
+		if ((val = 8*val + (*ch - '0')) > 07777)
+			return false;
+	}
+
+	*mode = val;
+
+	return (ch > arg);
+}
+
+static bool slbt_installer_get_uid(const char * arg, uid_t * uid)
+{
+	char *		mark;
+	unsigned long	val;
+	struct passwd *	pwd;
+
+	if ((pwd = getpwnam(arg))) {
+		*uid = pwd->pw_uid;
+		return true;
+	}
+
+	val = strtoul(arg,&mark,10);
+
+	if (!*arg || *mark)
+		return false;
+
+	*uid = val;
+
+	return true;
+}
+
+static bool slbt_installer_get_gid(const char * arg, gid_t * gid)
+{
+	char *		mark;
+	unsigned long	val;
+	struct group *	grp;
+
+	if ((grp = getgrnam(arg))) {
+		*gid = grp->gr_gid;
+		return true;
+	}
+
+	val = strtoul(arg,&mark,10);
+
+	if (!*arg || *mark)
+		return false;
+
+	*gid = val;
+
+	return true;
+}
+
+/* name lookups take place here, before entries are installed concurrently */
+slbt_hidden void slbt_installer_init(
+	const char *			program,
+	struct argv_meta *		meta,
+	struct slbt_installer *		inst)
+{
+	const char **		pname;
+	const char *		base;
+	struct argv_entry *	entry;
+	bool			fdirs;
+
+	memset(inst,0,sizeof(*inst));
+	inst->mode = 0755;
+	fdirs      = false;
+
+	/* install program */
+	base = strrchr(program,'/');
+	base = base ? &base[1] : program;
+
+	for (pname=slbt_installer_programs; *pname; pname++)
+		if (!strcmp(*pname,base))
+			break;
+
+	if (!*pname)
+		slbt_installer_set_fallback(
+			inst,"unrecognized install program",
+			program);
+
+	/* options */
+	for (entry=meta->entries; entry->fopt || entry->arg; entry++) {
+		if (!entry->fopt)
+			continue;
+
+		switch (entry->tag) {
+			case TAG_INSTALL_SYSROOT:
+			case TAG_INSTALL_COPY:
+				break;
+
+			case TAG_INSTALL_MKDIR:
+				fdirs = true;
+				break;
+
+			case TAG_INSTALL_PRESERVE:
+				inst->fpreserve = true;
+				break;
+
+			case TAG_INSTALL_DSTDIR:
+				inst->dstdir = entry->arg;
+				break;
+
+			case TAG_INSTALL_MODE:
+				if (!slbt_installer_get_mode(entry->arg,&inst->mode))
+					slbt_installer_set_fallback(
+						inst,"unsupported mode",
+						entry->arg);
+				break;
+
+			case TAG_INSTALL_USER:
+				if (geteuid())
+					slbt_installer_set_fallback(
+						inst,"-o without root privileges",0);
+
+				else if (!(inst->fuid = slbt_installer_get_uid(entry->arg,&inst->uid)))
+					slbt_installer_set_fallback(
+						inst,"unknown user",
+						entry->arg);
+				break;
+
+			case TAG_INSTALL_GROUP:
+				if (geteuid())
+					slbt_installer_set_fallback(
+						inst,"-g without root privileges",0);
+
+				else if (!(inst->fgid = slbt_installer_get_gid(entry->arg,&inst->gid)))
+					slbt_installer_set_fallback(
+						inst,"unknown group",
+						entry->arg);
+				break;
+
+			case TAG_INSTALL_FORCE:
+				slbt_installer_set_fallback(inst,"unsupported option -f",0);
+				break;
+
+			case TAG_INSTALL_TARGET_MKDIR:
+				slbt_installer_set_fallback(inst,"unsupported option -D",0);
+				break;
+
+			case TAG_INSTALL_STRIP:
+				slbt_installer_set_fallback(inst,"unsupported option -s",0);
+				break;
+
+			default:
+				slbt_installer_set_fallback(inst,"unsupported option",0);
+				break;
+		}
+	}
+
+	if (fdirs && inst->dstdir)
+		slbt_installer_set_fallback(inst,"-d combined with -t",0);
+}
+
+static int slbt_installer_spawn(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_exec_ctx *		ectx,
+	const char *			reason)
+{
+	if (dctx->cctx->drvflags & SLBT_DRIVER_DEBUG)
+		slbt_dprintf(slbt_exec_get_fderr(ectx),
+			"%s: install: %s, spawning %s.\n",
+			dctx->program,reason,ectx->program);
+
+	if ((slbt_spawn(ectx,true) < 0) && (ectx->pid < 0)) {
+		return SLBT_SPAWN_ERROR(dctx);
+
+	} else if (ectx->exitcode) {
+		return SLBT_CUSTOM_ERROR(
+			dctx,
+			SLBT_ERR_INSTALL_ERROR);
+	}
+
+	return 0;
+}
+
+static int slbt_installer_copy_bytes(int fdsrc, int fddst, off_t size)
+{
+	ssize_t		nbytes;
+	ssize_t		nwritten;
+	char *		ch;
+	char		buf[SLBT_INSTALLER_BUFSIZE];
+
+	/* reflink */
+#ifdef FICLONE
+	if (!ioctl(fddst,FICLONE,fdsrc))
+		return 0;
+#endif
+
+	/* in-kernel copy; any bytes not copied here are copied below */
+#ifdef SYS_copy_file_range
+	while (size > 0) {
+		nbytes = syscall(
+			SYS_copy_file_range,
+			fdsrc,0,fddst,0,
+			(size_t)size,0);
+
+		while ((nbytes < 0) && (errno == EINTR))
+			nbytes = syscall(
+				SYS_copy_file_range,
+				fdsrc,0,fddst,0,
+				(size_t)size,0);
+
+		if (nbytes <= 0)
+			break;
+
+		size -= nbytes;
+	}
+#else
+	(void)size;
+#endif
+
+	/* read, write */
+	for (nbytes=1; nbytes; ) {
+		nbytes = read(fdsrc,buf,sizeof(buf));
+
+		while ((nbytes < 0) && (errno == EINTR))
+			nbytes = read(fdsrc,buf,sizeof(buf));
+
+		if (nbytes < 0)
+			return -1;
+
+		for (ch=buf; nbytes>0; ch+=nwritten, nbytes-=nwritten) {
+			nwritten = write(fddst,ch,nbytes);
+
+			while ((nwritten < 0) && (errno == EINTR))
+				nwritten = write(fddst,ch,nbytes);
+
+			if (nwritten < 0)
+				return -1;
+		}
+
+		nbytes = (ch > buf);
+	}
+
+	return 0;
+}
+
+static int slbt_installer_finalize(
+	const struct slbt_installer *	inst,
+	int				fddst,
+	const struct stat *		srcst)
+{
+	struct timespec	ts[2];
+
+	/* ownership first, since chown may clear the set-id bits */
+	if (inst->fuid || inst->fgid)
+		if (fchown(fddst,
+				inst->fuid ? inst->uid : (uid_t)-1,
+				inst->fgid ? inst->gid : (gid_t)-1) < 0)
+			return -1;
+
+	if (fchmod(fddst,inst->mode) < 0)
+		return -1;
+
+	if (inst->fpreserve) {
+		ts[0] = srcst->st_atim;
+		ts[1] = srcst->st_mtim;
+
+		if (futimens(fddst,ts) < 0)
+			return -1;
+	}
+
+	return 0;
+}
+
+slbt_hidden int slbt_installer_install_file(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_exec_ctx *		ectx,
+	const struct slbt_installer *	inst,
+	const char *			src,
+	const char *			dst)
+{
+	int		fdcwd;
+	int		fdsrc;
+	int		fddir;
+	int		fddst;
+	const char *	base;
+	const char *	slash;
+	struct stat	st;
+	char		dirname[PATH_MAX];
+	char		tmpname[NAME_MAX + 1];
+
+	if (inst->fallback[0])
+		return slbt_installer_spawn(dctx,ectx,inst->fallback);
+
+	fdcwd = slbt_driver_fdcwd(dctx);
+
+	/* destination directory and name */
+	if (!dst || (!fstatat(fdcwd,dst,&st,0) && S_ISDIR(st.st_mode))) {
+		if (slbt_snprintf(dirname,sizeof(dirname),
+				"%s",dst ? dst : inst->dstdir) < 0)
+			return SLBT_BUFFER_ERROR(dctx);
+
+		base = (slash = strrchr(src,'/')) ? &slash[1] : src;
+
+	} else if ((slash = strrchr(dst,'/'))) {
+		if ((size_t)(slash - dst) >= sizeof(dirname))
+			return SLBT_BUFFER_ERROR(dctx);
+
+		memcpy(dirname,dst,slash - dst);
+		dirname[slash - dst] = '\0';
+
+		if (!dirname[0])
+			strcpy(dirname,"/");
+
+		base = &slash[1];
+	} else {
+		strcpy(dirname,".");
+		base = dst;
+	}
+
+	if (slbt_snprintf(tmpname,sizeof(tmpname),
+			".%s.slibtool.%d",base,getpid()) < 0)
+		return slbt_installer_spawn(dctx,ectx,"destination name too long");
+
+	/* source */
+	if ((fdsrc = openat(fdcwd,src,O_RDONLY|O_CLOEXEC,0)) < 0)
+		return SLBT_SYSTEM_ERROR(dctx,src);
+
+	if (fstat(fdsrc,&st) < 0) {
+		close(fdsrc);
+		return SLBT_SYSTEM_ERROR(dctx,src);
+	}
+
+	if (!S_ISREG(st.st_mode)) {
+		close(fdsrc);
+		return slbt_installer_spawn(dctx,ectx,"source is not a regular file");
+	}
+
+	/* temporary destination */
+	if ((fddir = openat(fdcwd,dirname,O_DIRECTORY|O_CLOEXEC,0)) < 0) {
+		close(fdsrc);
+		return SLBT_SYSTEM_ERROR(dctx,dirname);
+	}
+
+	unlinkat(fddir,tmpname,0);
+
+	if ((fddst = openat(fddir,tmpname,O_WRONLY|O_CREAT|O_EXCL|O_CLOEXEC,0600)) < 0) {
+		close(fdsrc);
+		close(fddir);
+		return SLBT_SYSTEM_ERROR(dctx,dirname);
+	}
+
+	/* copy, ownership, mode, timestamps */
+	if (slbt_installer_copy_bytes(fdsrc,fddst,st.st_size) < 0)
+		goto fail;
+
+	if (slbt_installer_finalize(inst,fddst,&st) < 0)
+		goto fail;
+
+	close(fdsrc);
+	fdsrc = -1;
+
+	if (close(fddst) < 0) {
+		fddst = -1;
+		goto fail;
+	}
+
+	/* atomic replacement */
+	if (renameat(fddir,tmpname,fddir,base) < 0) {
+		fddst = -1;
+		goto fail;
+	}
+
+	close(fddir);
+
+	return 0;
+
+fail:
+	SLBT_SYSTEM_ERROR(dctx,dirname);
+
+	if (fdsrc >= 0)
+		close(fdsrc);
+
+	if (fddst >= 0)
+		close(fddst);
+
+	unlinkat(fddir,tmpname,0);
+	close(fddir);
+
+	return SLBT_NESTED_ERROR(dctx);
+}
+
+static int slbt_installer_mkdir(
+	const struct slbt_driver_ctx *	dctx,
+	const struct slbt_installer *	inst,
+	const char *			path)
+{
+	int		fdcwd;
+	char *		ch;
+	struct stat	st;
+	char		dirname[PATH_MAX];
+
+	fdcwd = slbt_driver_fdcwd(dctx);
+
+	if (slbt_snprintf(dirname,sizeof(dirname),"%s",path) < 0)
+		return SLBT_BUFFER_ERROR(dctx);
+
+	/* leading directories */
+	for (ch=&dirname[1]; *ch; ch++) {
+		if ((*ch == '/') && (ch[-1] != '/')) {
+			*ch = '\0';
+
+			if (mkdirat(fdcwd,dirname,0755) < 0)
+				if (errno != EEXIST)
+					return SLBT_SYSTEM_ERROR(dctx,dirname);
+
+			*ch = '/';
+		}
+	}
+
+	/* the directory itself */
+	if (mkdirat(fdcwd,dirname,0755) < 0)
+		if (errno != EEXIST)
+			return SLBT_SYSTEM_ERROR(dctx,dirname);
+
+	if (fstatat(fdcwd,dirname,&st,0) < 0)
+		return SLBT_SYSTEM_ERROR(dctx,dirname);
+
+	if (!S_ISDIR(st.st_mode)) {
+		errno = ENOTDIR;
+		return SLBT_SYSTEM_ERROR(dctx,dirname);
+	}
+
+	if (inst->fuid || inst->fgid)
+		if (fchownat(fdcwd,dirname,
+				inst->fuid ? inst->uid : (uid_t)-1,
+				inst->fgid ? inst->gid : (gid_t)-1,0) < 0)
+			return SLBT_SYSTEM_ERROR(dctx,dirname);
+
+	if (fchmodat(fdcwd,dirname,inst->mode,0) < 0)
+		return SLBT_SYSTEM_ERROR(dctx,dirname);
+
+	return 0;
+}
+
+slbt_hidden int slbt_installer_install_dirs(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_exec_ctx *		ectx,
+	const struct slbt_installer *	inst,
+	struct argv_meta *		meta)
+{
+	struct argv_entry *	entry;
+
+	if (inst->fallback[0])
+		return slbt_installer_spawn(dctx,ectx,inst->fallback);
+
+	for (entry=meta->entries; entry->fopt || entry->arg; entry++)
+		if (!entry->fopt)
+			if (slbt_installer_mkdir(dctx,inst,entry->arg) < 0)
+				return SLBT_NESTED_ERROR(dctx);
+
+	return 0;
+}
@@ -0,0 +1,40 @@
+#ifndef SLIBTOOL_INSTALLER_IMPL_H
+#define SLIBTOOL_INSTALLER_IMPL_H
+
+#include <stdbool.h>
+#include <sys/types.h>
+#include <slibtool/slibtool.h>
+#include "argv/argv.h"
+
+/* in-process install(1): the understood subset of the install */
+/* program's options, or else the reason for spawning it.      */
+struct slbt_installer {
+	char			fallback[128];
+	const char *		dstdir;
+	mode_t			mode;
+	uid_t			uid;
+	gid_t			gid;
+	bool			fuid;
+	bool			fgid;
+	bool			fpreserve;
+};
+
+void slbt_installer_init(
+	const char *			program,
+	struct argv_meta *		meta,
+	struct slbt_installer *		inst);
+
+int slbt_installer_install_file(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_exec_ctx *		ectx,
+	const struct slbt_installer *	inst,
+	const char *			src,
+	const char *			dst);
+
+int slbt_installer_install_dirs(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_exec_ctx *		ectx,
+	const struct slbt_installer *	inst,
+	struct argv_meta *		meta);
+
+#endif
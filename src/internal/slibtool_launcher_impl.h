@@ -0,0 +1,23 @@
+#ifndef SLIBTOOL_LAUNCHER_IMPL_H
+#define SLIBTOOL_LAUNCHER_IMPL_H
+
+/* the launcher file, created at link time next to the executable */
+/* program (.libs/foo.exe.launcher), carries the same information */
+/* as the executable wrapper script, one record per line:         */
+/*                                                                */
+/* slibtool launcher, version 1                                   */
+/* env <name of the dynamic library path environment variable>    */
+/* cwd <absolute path of the directory in which linking was done> */
+/* exe <absolute path of the executable program>                  */
+/* dlpath <library directory, absolute or relative to cwd>        */
+/* ...                                                            */
+
+#define SLBT_LAUNCHER_SUFFIX		".exe.launcher"
+#define SLBT_LAUNCHER_SIGNATURE		"slibtool launcher, version 1"
+
+#define SLBT_LAUNCHER_ENV		"env "
+#define SLBT_LAUNCHER_CWD		"cwd "
+#define SLBT_LAUNCHER_EXE		"exe "
+#define SLBT_LAUNCHER_DLPATH		"dlpath "
+
+#endif
@@ -10,7 +10,6 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <unistd.h>
-#include <sys/mman.h>
 #include <sys/stat.h>
 
 #include "slibtool_lconf_impl.h"
@@ -19,6 +18,7 @@
 #include "slibtool_symlink_impl.h"
 #include "slibtool_readlink_impl.h"
 #include "slibtool_realpath_impl.h"
+#include "slibtool_toolchain_impl.h"
 #include "slibtool_visibility_impl.h"
 
 enum slbt_lconf_opt {
@@ -762,8 +762,6 @@ slbt_hidden int slbt_get_lconf_flags(
 	struct slbt_driver_ctx_impl *   ctx;
 	struct slbt_txtfile_ctx *       confctx;
 	int				fdlconf;
-	struct stat			st;
-	void *				addr;
 	uint64_t			optshared;
 	uint64_t			optstatic;
 	char                            val[PATH_MAX];
@@ -776,26 +774,16 @@ slbt_hidden int slbt_get_lconf_flags(
 		return (dctx->cctx->drvflags & SLBT_DRIVER_OUTPUT_MASK)
 			? (-1) : SLBT_NESTED_ERROR(dctx);
 
-	/* cache the configuration in library friendly form) */
-	if (slbt_lib_get_txtfile_ctx(dctx,val,&ctx->lconfctx) < 0)
+	/* cache the configuration in library friendly form (shared) */
+	if (slbt_toolchain_get_lconf(dctx,fdlconf,val,&ctx->toolchain) < 0) {
+		close(fdlconf);
 		return SLBT_NESTED_ERROR(dctx);
-
-	confctx = ctx->lconfctx;
-
-	/* map relative libtool script */
-	if (fstat(fdlconf,&st) < 0)
-		return SLBT_SYSTEM_ERROR(dctx,0);
-
-	addr = mmap(
-		0,st.st_size,
-		PROT_READ,MAP_SHARED,
-		fdlconf,0);
+	}
 
 	close(fdlconf);
 
-	if (addr == MAP_FAILED)
-		return SLBT_CUSTOM_ERROR(
-			dctx,SLBT_ERR_LCONF_MAP);
+	confctx = ctx->toolchain->lconfctx;
+	ctx->lconfctx = confctx;
 
 	/* scan */
 	optshared = 0;
@@ -913,8 +901,5 @@ slbt_hidden int slbt_get_lconf_flags(
 
 
 	/* all done */
-	ctx->lconf.addr = addr;
-	ctx->lconf.size = st.st_size;
-
 	return 0;
 }
@@ -1,6 +1,8 @@
 #ifndef SLIBTOOL_LINKCMD_IMPL_H
 #define SLIBTOOL_LINKCMD_IMPL_H
 
+#include <sys/types.h>
+
 struct slbt_deps_meta {
 	char ** altv;
 	char *	args;
@@ -8,8 +10,31 @@ struct slbt_deps_meta {
 	int	infolen;
 };
 
+struct slbt_deps_node {
+	struct slbt_deps_node *	next;
+	char *			path;
+	char *			deps;
+	char *			depsbuf;
+	size_t			depssize;
+	int			depscnt;
+	int			depserr;
+	char *			rpath;
+	int			rpatherr;
+	dev_t			dev;
+	ino_t			ino;
+};
+
+int slbt_get_deps_node(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_exec_ctx *		ectx,
+	const char *			libfilename,
+	struct slbt_deps_node **	pnode);
+
+void slbt_free_deps_nodes(struct slbt_deps_node * nodes);
+
 int slbt_get_deps_meta(
 	const struct slbt_driver_ctx *	dctx,
+	struct slbt_exec_ctx *		ectx,
 	char *				libfilename,
 	int				fexternal,
 	struct slbt_deps_meta *		depsmeta);
@@ -34,6 +59,7 @@ bool slbt_adjust_wrapper_argument(
 
 int slbt_adjust_linker_argument(
 	const struct slbt_driver_ctx *	dctx,
+	struct slbt_exec_ctx *		ectx,
 	char *				arg,
 	char **				xarg,
 	bool				fpic,
@@ -52,6 +78,15 @@ int slbt_exec_link_finalize_argument_vector(
 	const struct slbt_driver_ctx *	dctx,
 	struct slbt_exec_ctx *		ectx);
 
+int slbt_exec_link_create_dlsyms_source(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_exec_ctx *		ectx);
+
+int slbt_exec_link_compile_dlsyms_object(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_exec_ctx *		ectx,
+	char **				dlargv);
+
 int slbt_exec_link_create_host_tag(
 	const struct slbt_driver_ctx *	dctx,
 	struct slbt_exec_ctx *		ectx,
@@ -69,7 +104,8 @@ int slbt_exec_link_create_archive(
 	struct slbt_exec_ctx *		ectx,
 	const char *			arfilename,
 	bool				fpic,
-	bool                            fdep);
+	bool                            fdep,
+	bool				fthin);
 
 int slbt_exec_link_create_library(
 	const struct slbt_driver_ctx *	dctx,
@@ -0,0 +1,1055 @@
+/*******************************************************************/
+/*  slibtool: a strong libtool implementation, written in C        */
+/*  Copyright (C) 2016--2024  SysDeer Technologies, LLC            */
+/*  Released under the Standard MIT License; see COPYING.SLIBTOOL. */
+/*******************************************************************/
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <errno.h>
+#include <dirent.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+#endif
+
+#include <slibtool/slibtool.h>
+#include "slibtool_driver_impl.h"
+#include "slibtool_dprintf_impl.h"
+#include "slibtool_objcache_impl.h"
+#include "slibtool_realpath_impl.h"
+#include "slibtool_snprintf_impl.h"
+#include "slibtool_sha256_impl.h"
+#include "slibtool_spawn_impl.h"
+#include "slibtool_which_impl.h"
+#include "slibtool_visibility_impl.h"
+
+/***************************************************************/
+/* object cache layout: <cachedir>/<xx>/<yyy...>.o, where xx   */
+/* and yyy... are the leading two and remaining characters of  */
+/* the key's hex digest; an accompanying <yyy...>.d file holds */
+/* the dependency output (-MF) of the compilation.             */
+/*                                                             */
+/* the size limit applies to the cache as a whole: the stats   */
+/* file keeps a running total, and once a store pushes it past */
+/* the limit, all buckets are scanned, the true total is taken */
+/* from the scan, and the least recently used entries (by      */
+/* mtime, which every hit refreshes) are evicted, each with    */
+/* its .o and .d together, until the total falls below the     */
+/* low watermark. the entry just stored is never evicted.      */
+/***************************************************************/
+
+#ifndef O_DIRECTORY
+#define O_DIRECTORY 0
+#endif
+
+#define SLBT_OBJCACHE_SIGNATURE "slibtool object cache, version 1"
+#define SLBT_OBJCACHE_BUCKETS   256
+#define SLBT_OBJCACHE_BUFSIZE   65536
+
+/* evict down to 90% of the limit, so as to amortize full scans */
+#define SLBT_OBJCACHE_WATERMARK(max) ((max) - (max) / 10)
+
+static const char slbt_objcache_stats_file[] = "stats";
+
+struct slbt_objcache_entry {
+	char *		name;
+	char		bucket[3];
+	bool		fobj;
+	bool		fdep;
+	uint64_t	size;
+	time_t		mtime;
+};
+
+static int slbt_objcache_open(const struct slbt_driver_ctx * dctx, bool fcreate)
+{
+	int		fdcwd;
+	int		fdcache;
+	const char *	path;
+
+	fdcwd = slbt_driver_fdcwd(dctx);
+	path  = dctx->cctx->objcache;
+
+	if ((fdcache = openat(fdcwd,path,O_DIRECTORY|O_CLOEXEC,0)) >= 0)
+		return fdcache;
+
+	if (!fcreate || (errno != ENOENT))
+		return -1;
+
+	if (mkdirat(fdcwd,path,0755) && (errno != EEXIST))
+		return -1;
+
+	return openat(fdcwd,path,O_DIRECTORY|O_CLOEXEC,0);
+}
+
+static int slbt_objcache_open_bucket(
+	int				fdcache,
+	const struct slbt_objcache_key *key,
+	bool				fcreate)
+{
+	int	fdbucket;
+	char	bucket[3];
+
+	bucket[0] = key->digest[0];
+	bucket[1] = key->digest[1];
+	bucket[2] = 0;
+
+	if ((fdbucket = openat(fdcache,bucket,O_DIRECTORY|O_CLOEXEC,0)) >= 0)
+		return fdbucket;
+
+	if (!fcreate || (errno != ENOENT))
+		return -1;
+
+	if (mkdirat(fdcache,bucket,0755) && (errno != EEXIST))
+		return -1;
+
+	return openat(fdcache,bucket,O_DIRECTORY|O_CLOEXEC,0);
+}
+
+static uint64_t slbt_objcache_max_size(const char * arg)
+{
+	char *		mark;
+	uint64_t	size;
+
+	if (!arg)
+		return 0;
+
+	size = strtoull(arg,&mark,10);
+
+	switch (*mark) {
+		case 'k':
+		case 'K':
+			return size << 10;
+
+		case 'm':
+		case 'M':
+			return size << 20;
+
+		case 'g':
+		case 'G':
+			return size << 30;
+
+		default:
+			return size;
+	}
+}
+
+static int slbt_objcache_read_stats(int fd, struct slbt_objcache_stats * stats)
+{
+	ssize_t	nbytes;
+	char	buf[256];
+
+	memset(stats,0,sizeof(*stats));
+
+	if ((nbytes = pread(fd,buf,sizeof(buf)-1,0)) < 0)
+		return -1;
+
+	buf[nbytes] = 0;
+
+	sscanf(buf,
+		"hits %"SCNu64"\n"
+		"misses %"SCNu64"\n"
+		"stores %"SCNu64"\n"
+		"evictions %"SCNu64"\n"
+		"size %"SCNu64"\n",
+		&stats->hits,
+		&stats->misses,
+		&stats->stores,
+		&stats->evictions,
+		&stats->size);
+
+	return 0;
+}
+
+/* the stats file's lock also serializes eviction */
+static int slbt_objcache_lock_stats(
+	int				fdcache,
+	struct slbt_objcache_stats *	stats)
+{
+	int		fd;
+	struct flock	lock;
+
+	if ((fd = openat(fdcache,slbt_objcache_stats_file,O_RDWR|O_CREAT|O_CLOEXEC,0644)) < 0)
+		return -1;
+
+	memset(&lock,0,sizeof(lock));
+	lock.l_type   = F_WRLCK;
+	lock.l_whence = SEEK_SET;
+
+	if (fcntl(fd,F_SETLKW,&lock) < 0) {
+		close(fd);
+		return -1;
+	}
+
+	if (slbt_objcache_read_stats(fd,stats) < 0) {
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+static void slbt_objcache_unlock_stats(
+	int					fd,
+	const struct slbt_objcache_stats *	stats)
+{
+	int	len;
+	char	buf[256];
+
+	len = slbt_snprintf(buf,sizeof(buf),
+		"hits %"PRIu64"\n"
+		"misses %"PRIu64"\n"
+		"stores %"PRIu64"\n"
+		"evictions %"PRIu64"\n"
+		"size %"PRIu64"\n",
+		stats->hits,
+		stats->misses,
+		stats->stores,
+		stats->evictions,
+		stats->size);
+
+	if (len > 0)
+		if (pwrite(fd,buf,len,0) == len)
+			if (ftruncate(fd,len) < 0)
+				(void)0;
+
+	close(fd);
+}
+
+static void slbt_objcache_update_stats(
+	int		fdcache,
+	uint64_t	hits,
+	uint64_t	misses)
+{
+	int				fd;
+	struct slbt_objcache_stats	stats;
+
+	if ((fd = slbt_objcache_lock_stats(fdcache,&stats)) < 0)
+		return;
+
+	stats.hits   += hits;
+	stats.misses += misses;
+
+	slbt_objcache_unlock_stats(fd,&stats);
+}
+
+/* ectx->csrc is only set in the absence of -o, hence the scan */
+static bool slbt_objcache_source_is_cacheable(char ** argv)
+{
+	char **		parg;
+	const char *	dot;
+
+	for (parg=argv; *parg; parg++) {
+		if ((*parg)[0] == '-')
+			continue;
+
+		if (!(dot = strrchr(*parg,'.')))
+			continue;
+
+		if (!strcmp(dot,".s") || !strcmp(dot,".asm"))
+			return false;
+
+		if (!strcmp(dot,".c") || !strcmp(dot,".cc")
+				|| !strcmp(dot,".cpp") || !strcmp(dot,".cxx")
+				|| !strcmp(dot,".S"))
+			return true;
+	}
+
+	return false;
+}
+
+slbt_hidden int slbt_objcache_hash_program(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_sha256_ctx *	sha,
+	const char *			program)
+{
+	struct stat	st;
+	char		path[PATH_MAX];
+	char		idbuf[128];
+
+	if (slbt_which(dctx,program,path,sizeof(path),&st) < 0)
+		return -1;
+
+	if (slbt_snprintf(idbuf,sizeof(idbuf),
+			"%jd:%jd.%ld",
+			(intmax_t)st.st_size,
+			(intmax_t)st.st_mtim.tv_sec,
+			(long)st.st_mtim.tv_nsec) < 0)
+		return -1;
+
+	slbt_sha256_update(sha,path,strlen(path)+1);
+	slbt_sha256_update(sha,idbuf,strlen(idbuf)+1);
+
+	return 0;
+}
+
+static void slbt_objcache_preprocess_child(
+	const char *	program,
+	char **		argv,
+	int		fd[2])
+{
+	int fdnull;
+
+	close(fd[0]);
+
+	if ((fdnull = openat(AT_FDCWD,"/dev/null",O_RDWR,0)) >= 0)
+		if (dup2(fdnull,0) == 0)
+			if (dup2(fdnull,2) == 2)
+				if (dup2(fd[1],1) == 1)
+					execvp(program,argv);
+
+	_exit(EXIT_FAILURE);
+}
+
+static int slbt_objcache_hash_preprocessed(
+	struct slbt_exec_ctx *		ectx,
+	struct slbt_sha256_ctx *	sha)
+{
+	int		fd[2];
+	int		ecode;
+	pid_t		pid;
+	pid_t		rpid;
+	ssize_t		nbytes;
+	size_t		ntotal;
+	char **		parg;
+	char **		pvec;
+	char **		vector;
+	char *		buf;
+
+	for (parg=ectx->argv; *parg; )
+		parg++;
+
+	if (!(vector = calloc(parg - ectx->argv + 2,sizeof(char *))))
+		return -1;
+
+	if (!(buf = malloc(SLBT_OBJCACHE_BUFSIZE))) {
+		free(vector);
+		return -1;
+	}
+
+	/* same vector, preprocessing only, no output or dependency files */
+	for (parg=ectx->argv, pvec=vector; *parg; parg++) {
+		if ((parg == ectx->lout[0]) || (parg == ectx->lout[1]))
+			(void)0;
+
+		else if (!strcmp(*parg,"-c"))
+			(void)0;
+
+		else if (!strcmp(*parg,"-MD") || !strcmp(*parg,"-MMD"))
+			(void)0;
+
+		else if (!strcmp(*parg,"-MP") || !strcmp(*parg,"-MG"))
+			(void)0;
+
+		else if (!strcmp(*parg,"-MF") || !strcmp(*parg,"-MT") || !strcmp(*parg,"-MQ"))
+			parg += !!parg[1];
+
+		else if (!strncmp(*parg,"-MF",3) || !strncmp(*parg,"-MT",3) || !strncmp(*parg,"-MQ",3))
+			(void)0;
+
+		else if (!strncmp(*parg,"-Wp,-M",6))
+			(void)0;
+
+		else
+			*pvec++ = *parg;
+	}
+
+	*pvec++ = "-E";
+	*pvec   = 0;
+
+	if (pipe(fd)) {
+		free(buf);
+		free(vector);
+		return -1;
+	}
+
+	if ((pid = slbt_fork()) < 0) {
+		close(fd[0]);
+		close(fd[1]);
+		free(buf);
+		free(vector);
+		return -1;
+	}
+
+	if (pid == 0)
+		slbt_objcache_preprocess_child(
+			ectx->program,
+			vector,fd);
+
+	close(fd[1]);
+
+	for (ntotal=0; (nbytes = read(fd[0],buf,SLBT_OBJCACHE_BUFSIZE)); ) {
+		if (nbytes > 0) {
+			slbt_sha256_update(sha,buf,nbytes);
+			ntotal += nbytes;
+		} else if (errno != EINTR) {
+			break;
+		}
+	}
+
+	close(fd[0]);
+	free(buf);
+	free(vector);
+
+	rpid = waitpid(pid,&ecode,0);
+
+	return ((rpid == pid) && !ecode && ntotal) ? 0 : -1;
+}
+
+slbt_hidden int slbt_objcache_get_key(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_exec_ctx *		ectx,
+	struct slbt_objcache_key *	key)
+{
+	int				fdcwd;
+	bool				fcompile;
+	bool				fdepgen;
+	bool				fdebug;
+	char **				parg;
+	const struct slbt_common_ctx *	cctx;
+	struct slbt_sha256_ctx		sha;
+	char				cwd[PATH_MAX];
+
+	key->fvalid  = false;
+	key->depfile = 0;
+	cctx         = dctx->cctx;
+
+	/* enabled? */
+	if (!cctx->objcache)
+		return 0;
+
+	/* preprocessed languages only */
+	switch (cctx->tag) {
+		case SLBT_TAG_CC:
+		case SLBT_TAG_CXX:
+			break;
+
+		default:
+			return 0;
+	}
+
+	if (!slbt_objcache_source_is_cacheable(ectx->argv))
+		return 0;
+
+	/* compilation proper, dependency file, debug information */
+	fcompile = false;
+	fdepgen  = false;
+	fdebug   = false;
+
+	for (parg=ectx->argv; *parg; parg++) {
+		if (!strcmp(*parg,"-c"))
+			fcompile = true;
+
+		else if (!strcmp(*parg,"-E") || !strcmp(*parg,"-S"))
+			return 0;
+
+		else if (!strcmp(*parg,"-M") || !strcmp(*parg,"-MM"))
+			return 0;
+
+		else if (!strncmp(*parg,"-save-temps",11))
+			return 0;
+
+		else if (!strncmp(*parg,"-Wp,-M",6))
+			return 0;
+
+		else if (!strcmp(*parg,"-MD") || !strcmp(*parg,"-MMD"))
+			fdepgen = true;
+
+		else if (!strcmp(*parg,"-MF") && parg[1])
+			key->depfile = *++parg;
+
+		else if (!strncmp(*parg,"-MF",3))
+			key->depfile = &(*parg)[3];
+
+		else if (!strncmp(*parg,"-g",2))
+			fdebug = true;
+	}
+
+	if (!fcompile)
+		return 0;
+
+	/* implicitly named dependency files are not tracked */
+	if (fdepgen && !key->depfile)
+		return 0;
+
+	/* compiler identity, wrapper, and final argument vector */
+	slbt_sha256_init(&sha);
+	slbt_sha256_update(&sha,SLBT_OBJCACHE_SIGNATURE,sizeof(SLBT_OBJCACHE_SIGNATURE));
+
+	if (slbt_objcache_hash_program(dctx,&sha,ectx->compiler) < 0)
+		return 0;
+
+	if (cctx->ccwrap)
+		slbt_sha256_update(&sha,cctx->ccwrap,strlen(cctx->ccwrap)+1);
+
+	for (parg=ectx->argv; *parg; parg++)
+		if ((parg != ectx->lout[0]) && (parg != ectx->lout[1]))
+			slbt_sha256_update(&sha,*parg,strlen(*parg)+1);
+
+	/* debug information records the compilation directory */
+	if (fdebug) {
+		fdcwd = slbt_driver_fdcwd(dctx);
+
+		if (slbt_realpath(fdcwd,".",0,cwd,sizeof(cwd)) < 0)
+			return 0;
+
+		slbt_sha256_update(&sha,cwd,strlen(cwd)+1);
+	}
+
+	/* preprocessed translation unit */
+	if (slbt_objcache_hash_preprocessed(ectx,&sha) < 0)
+		return 0;
+
+	slbt_sha256_hexdigest(&sha,key->digest);
+	key->fvalid = true;
+
+	return 0;
+}
+
+static int slbt_objcache_copy_bytes(int fdsrc, int fddst)
+{
+	ssize_t		nbytes;
+	ssize_t		nwritten;
+	char *		ch;
+	char		buf[SLBT_OBJCACHE_BUFSIZE];
+
+	for (nbytes=1; nbytes; ) {
+		nbytes = read(fdsrc,buf,sizeof(buf));
+
+		while ((nbytes < 0) && (errno == EINTR))
+			nbytes = read(fdsrc,buf,sizeof(buf));
+
+		if (nbytes < 0)
+			return -1;
+
+		for (ch=buf; nbytes>0; ch+=nwritten, nbytes-=nwritten) {
+			nwritten = write(fddst,ch,nbytes);
+
+			while ((nwritten < 0) && (errno == EINTR))
+				nwritten = write(fddst,ch,nbytes);
+
+			if (nwritten < 0)
+				return -1;
+		}
+
+		nbytes = (ch > buf);
+	}
+
+	return 0;
+}
+
+static int slbt_objcache_copy(
+	int		fdsrcdir,
+	const char *	src,
+	int		fddstdir,
+	const char *	dst,
+	bool		flink)
+{
+	int		fdsrc;
+	int		fddst;
+
+	if ((fdsrc = openat(fdsrcdir,src,O_RDONLY|O_CLOEXEC,0)) < 0)
+		return -1;
+
+	if ((fddst = openat(fddstdir,dst,O_WRONLY|O_CREAT|O_EXCL|O_CLOEXEC,0666)) < 0) {
+		close(fdsrc);
+		return -1;
+	}
+
+	/* reflink, hardlink, copy */
+#ifdef FICLONE
+	if (!ioctl(fddst,FICLONE,fdsrc)) {
+		close(fdsrc);
+		close(fddst);
+		return 0;
+	}
+#endif
+
+	if (flink) {
+		close(fddst);
+		unlinkat(fddstdir,dst,0);
+
+		if (!linkat(fdsrcdir,src,fddstdir,dst,0)) {
+			close(fdsrc);
+			return 0;
+		}
+
+		if ((fddst = openat(fddstdir,dst,O_WRONLY|O_CREAT|O_EXCL|O_CLOEXEC,0666)) < 0) {
+			close(fdsrc);
+			return -1;
+		}
+	}
+
+	if (slbt_objcache_copy_bytes(fdsrc,fddst) < 0) {
+		close(fdsrc);
+		close(fddst);
+		unlinkat(fddstdir,dst,0);
+		return -1;
+	}
+
+	close(fdsrc);
+	close(fddst);
+
+	return 0;
+}
+
+static int slbt_objcache_import(
+	int		fdbucket,
+	const char *	entry,
+	int		fdcwd,
+	const char *	path)
+{
+	int	len;
+	char	tmpname[NAME_MAX];
+
+	len = slbt_snprintf(
+		tmpname,sizeof(tmpname),
+		"%s.tmp.%d",entry,getpid());
+
+	if (len < 0)
+		return -1;
+
+	if (slbt_objcache_copy(fdcwd,path,fdbucket,tmpname,true) < 0)
+		return -1;
+
+	if (renameat(fdbucket,tmpname,fdbucket,entry) < 0) {
+		unlinkat(fdbucket,tmpname,0);
+		return -1;
+	}
+
+	return 0;
+}
+
+static int slbt_objcache_export(
+	int		fdbucket,
+	const char *	entry,
+	int		fdcwd,
+	const char *	path)
+{
+	if (slbt_objcache_copy(fdbucket,entry,fdcwd,path,true) < 0)
+		return -1;
+
+	/* refresh both the lru stamp and the target's mtime */
+	utimensat(fdbucket,entry,0,0);
+	utimensat(fdcwd,path,0,0);
+
+	return 0;
+}
+
+static int slbt_objcache_entry_cmp(const void * a, const void * b)
+{
+	const struct slbt_objcache_entry * ea = a;
+	const struct slbt_objcache_entry * eb = b;
+
+	return (ea->mtime > eb->mtime) - (ea->mtime < eb->mtime);
+}
+
+static int slbt_objcache_entry_name_cmp(const void * a, const void * b)
+{
+	const struct slbt_objcache_entry * ea = a;
+	const struct slbt_objcache_entry * eb = b;
+
+	int ret;
+
+	if ((ret = strcmp(ea->bucket,eb->bucket)))
+		return ret;
+
+	return strcmp(ea->name,eb->name);
+}
+
+static void slbt_objcache_free_entries(
+	struct slbt_objcache_entry *	entv,
+	size_t				nents)
+{
+	struct slbt_objcache_entry *	entp;
+
+	for (entp=entv; entp<&entv[nents]; entp++)
+		free(entp->name);
+
+	free(entv);
+}
+
+/* one vector element per file: <yyy...>, .o or .d */
+static int slbt_objcache_scan_bucket(
+	int				fdcache,
+	const char *			bucket,
+	struct slbt_objcache_entry **	pentv,
+	size_t *			pnents,
+	size_t *			pnalloc)
+{
+	int				fd;
+	DIR *				dir;
+	struct dirent *			dent;
+	struct stat			st;
+	struct slbt_objcache_entry *	entp;
+	const char *			dot;
+
+	if ((fd = openat(fdcache,bucket,O_DIRECTORY|O_CLOEXEC,0)) < 0)
+		return (errno == ENOENT) ? 0 : -1;
+
+	if (!(dir = fdopendir(fd))) {
+		close(fd);
+		return -1;
+	}
+
+	while ((dent = readdir(dir))) {
+		if (dent->d_name[0] == '.')
+			continue;
+
+		if (strstr(dent->d_name,".tmp."))
+			continue;
+
+		if (!(dot = strrchr(dent->d_name,'.')))
+			continue;
+
+		if (strcmp(dot,".o") && strcmp(dot,".d"))
+			continue;
+
+		if (fstatat(fd,dent->d_name,&st,AT_SYMLINK_NOFOLLOW) < 0)
+			continue;
+
+		if (*pnents == *pnalloc) {
+			*pnalloc = *pnalloc ? 2 * *pnalloc : 256;
+
+			if (!(entp = realloc(*pentv,*pnalloc * sizeof(*entp)))) {
+				closedir(dir);
+				return -1;
+			}
+
+			*pentv = entp;
+		}
+
+		entp = &(*pentv)[*pnents];
+
+		if (!(entp->name = strndup(dent->d_name,dot - dent->d_name))) {
+			closedir(dir);
+			return -1;
+		}
+
+		strcpy(entp->bucket,bucket);
+
+		entp->fobj   = (dot[1] == 'o');
+		entp->fdep   = (dot[1] == 'd');
+		entp->size   = st.st_size;
+		entp->mtime  = st.st_mtim.tv_sec;
+
+		(*pnents)++;
+	}
+
+	closedir(dir);
+
+	return 0;
+}
+
+static void slbt_objcache_unlink_entry(
+	int					fdcache,
+	const struct slbt_objcache_entry *	entp,
+	uint64_t *				pnevicted)
+{
+	bool	fevicted;
+	char	path[PATH_MAX];
+
+	fevicted = false;
+
+	/* object first, so that a present object implies a complete entry */
+	if (entp->fobj)
+		if (slbt_snprintf(path,sizeof(path),"%s/%s.o",entp->bucket,entp->name) >= 0)
+			fevicted |= !unlinkat(fdcache,path,0);
+
+	if (entp->fdep)
+		if (slbt_snprintf(path,sizeof(path),"%s/%s.d",entp->bucket,entp->name) >= 0)
+			fevicted |= !unlinkat(fdcache,path,0);
+
+	if (fevicted)
+		(*pnevicted)++;
+}
+
+/* called with the stats lock held; updates the running total */
+static uint64_t slbt_objcache_evict(
+	const struct slbt_driver_ctx *	dctx,
+	int				fdcache,
+	const struct slbt_objcache_key *key,
+	uint64_t			maxsize,
+	uint64_t *			psize)
+{
+	int				idx;
+	uint64_t			total;
+	uint64_t			lowmark;
+	uint64_t			nevicted;
+	size_t				nents;
+	size_t				nalloc;
+	struct slbt_objcache_entry *	entv;
+	struct slbt_objcache_entry *	entp;
+	struct slbt_objcache_entry *	entcap;
+	char				bucket[3];
+	static const char		hexchars[] = "0123456789abcdef";
+
+	entv   = 0;
+	nents  = 0;
+	nalloc = 0;
+
+	for (idx=0; idx<SLBT_OBJCACHE_BUCKETS; idx++) {
+		bucket[0] = hexchars[idx >> 4];
+		bucket[1] = hexchars[idx & 0xf];
+		bucket[2] = 0;
+
+		if (slbt_objcache_scan_bucket(fdcache,bucket,&entv,&nents,&nalloc) < 0) {
+			slbt_objcache_free_entries(entv,nents);
+			return 0;
+		}
+	}
+
+	/* fold each entry's .o and .d files into a single element */
+	if (nents)
+		qsort(entv,nents,sizeof(*entv),slbt_objcache_entry_name_cmp);
+
+	for (entp=entv, entcap=entv; entp<&entv[nents]; entp++) {
+		if ((entcap > entv) && !slbt_objcache_entry_name_cmp(&entcap[-1],entp)) {
+			entcap[-1].fobj |= entp->fobj;
+			entcap[-1].fdep |= entp->fdep;
+			entcap[-1].size += entp->size;
+
+			if (entcap[-1].mtime < entp->mtime)
+				entcap[-1].mtime = entp->mtime;
+
+			free(entp->name);
+		} else {
+			*entcap++ = *entp;
+		}
+	}
+
+	nents = entcap - entv;
+
+	for (total=0, entp=entv; entp<entcap; entp++)
+		total += entp->size;
+
+	/* least recently used entries first */
+	lowmark  = SLBT_OBJCACHE_WATERMARK(maxsize);
+	nevicted = 0;
+
+	if (total > maxsize) {
+		qsort(entv,nents,sizeof(*entv),slbt_objcache_entry_cmp);
+
+		for (entp=entv; (total > lowmark) && (entp<entcap); entp++) {
+			if (!strncmp(entp->bucket,key->digest,2) && !strcmp(entp->name,&key->digest[2]))
+				continue;
+
+			slbt_objcache_unlink_entry(fdcache,entp,&nevicted);
+			total -= entp->size;
+		}
+	}
+
+	slbt_objcache_free_entries(entv,nents);
+
+	*psize = total;
+
+	if (nevicted && (dctx->cctx->drvflags & SLBT_DRIVER_DEBUG))
+		slbt_dprintf(slbt_driver_fderr(dctx),
+			"%s: object cache: evicted %"PRIu64" entries.\n",
+			dctx->program,nevicted);
+
+	return nevicted;
+}
+
+static uint64_t slbt_objcache_entry_size(
+	int		fdbucket,
+	const char *	objentry,
+	const char *	depentry)
+{
+	struct stat	st;
+	uint64_t	size;
+
+	size = 0;
+
+	if (!fstatat(fdbucket,objentry,&st,AT_SYMLINK_NOFOLLOW))
+		size += st.st_size;
+
+	if (!fstatat(fdbucket,depentry,&st,AT_SYMLINK_NOFOLLOW))
+		size += st.st_size;
+
+	return size;
+}
+
+static void slbt_objcache_entry_names(
+	const struct slbt_objcache_key *key,
+	char *				objentry,
+	char *				depentry)
+{
+	sprintf(objentry,"%s.o",&key->digest[2]);
+	sprintf(depentry,"%s.d",&key->digest[2]);
+}
+
+slbt_hidden int slbt_objcache_restore(
+	const struct slbt_driver_ctx *	dctx,
+	const struct slbt_objcache_key *key,
+	const char *			objname)
+{
+	int	fdcwd;
+	int	fdcache;
+	int	fdbucket;
+	bool	fhit;
+	char	objentry[SLBT_SHA256_HEXDIGEST_SIZE + 2];
+	char	depentry[SLBT_SHA256_HEXDIGEST_SIZE + 2];
+
+	fdcwd = slbt_driver_fdcwd(dctx);
+
+	/* cached entries may be hardlinked: always replace the inode */
+	if (dctx->cctx->objcache) {
+		unlinkat(fdcwd,objname,0);
+
+		if (key->depfile)
+			unlinkat(fdcwd,key->depfile,0);
+	}
+
+	if (!key->fvalid)
+		return 0;
+
+	if ((fdcache = slbt_objcache_open(dctx,true)) < 0)
+		return 0;
+
+	slbt_objcache_entry_names(key,objentry,depentry);
+
+	fhit = false;
+
+	if ((fdbucket = slbt_objcache_open_bucket(fdcache,key,false)) >= 0) {
+		fhit = !faccessat(fdbucket,objentry,F_OK,0);
+
+		if (fhit && key->depfile)
+			fhit = !faccessat(fdbucket,depentry,F_OK,0);
+
+		if (fhit)
+			fhit = !slbt_objcache_export(fdbucket,objentry,fdcwd,objname);
+
+		if (fhit && key->depfile)
+			fhit = !slbt_objcache_export(fdbucket,depentry,fdcwd,key->depfile);
+
+		if (!fhit) {
+			unlinkat(fdcwd,objname,0);
+
+			if (key->depfile)
+				unlinkat(fdcwd,key->depfile,0);
+		}
+
+		close(fdbucket);
+	}
+
+	slbt_objcache_update_stats(fdcache,fhit,!fhit);
+	close(fdcache);
+
+	if (dctx->cctx->drvflags & SLBT_DRIVER_DEBUG)
+		slbt_dprintf(slbt_driver_fderr(dctx),
+			"%s: object cache: %s: %s [%s].\n",
+			dctx->program,
+			fhit ? "hit" : "miss",
+			objname,key->digest);
+
+	return fhit ? 1 : 0;
+}
+
+slbt_hidden int slbt_objcache_store(
+	const struct slbt_driver_ctx *	dctx,
+	const struct slbt_objcache_key *key,
+	const char *			objname)
+{
+	int				fd;
+	int				fdcwd;
+	int				fdcache;
+	int				fdbucket;
+	int				ret;
+	uint64_t			maxsize;
+	uint64_t			oldsize;
+	uint64_t			newsize;
+	struct slbt_objcache_stats	stats;
+	char				objentry[SLBT_SHA256_HEXDIGEST_SIZE + 2];
+	char				depentry[SLBT_SHA256_HEXDIGEST_SIZE + 2];
+
+	if (!key->fvalid)
+		return 0;
+
+	fdcwd = slbt_driver_fdcwd(dctx);
+
+	if ((fdcache = slbt_objcache_open(dctx,true)) < 0)
+		return 0;
+
+	if ((fdbucket = slbt_objcache_open_bucket(fdcache,key,true)) < 0) {
+		close(fdcache);
+		return 0;
+	}
+
+	slbt_objcache_entry_names(key,objentry,depentry);
+
+	/* an existing entry (if any) is replaced */
+	oldsize = slbt_objcache_entry_size(fdbucket,objentry,depentry);
+
+	/* dependency file first, so that a present object implies a complete entry */
+	ret = 0;
+
+	if (key->depfile)
+		ret = slbt_objcache_import(fdbucket,depentry,fdcwd,key->depfile);
+
+	if (ret == 0)
+		ret = slbt_objcache_import(fdbucket,objentry,fdcwd,objname);
+
+	newsize = slbt_objcache_entry_size(fdbucket,objentry,depentry);
+
+	close(fdbucket);
+
+	/* running total, and eviction over the whole cache */
+	if ((fd = slbt_objcache_lock_stats(fdcache,&stats)) >= 0) {
+		stats.stores += (ret == 0);
+		stats.size   -= (oldsize < stats.size) ? oldsize : stats.size;
+		stats.size   += newsize;
+
+		maxsize = slbt_objcache_max_size(dctx->cctx->objcachemax);
+
+		if ((ret == 0) && maxsize && (stats.size > maxsize))
+			stats.evictions += slbt_objcache_evict(
+				dctx,fdcache,key,
+				maxsize,&stats.size);
+
+		slbt_objcache_unlock_stats(fd,&stats);
+	}
+
+	close(fdcache);
+
+	return 0;
+}
+
+slbt_hidden int slbt_objcache_get_stats(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_objcache_stats *	stats)
+{
+	int		fd;
+	int		fdcache;
+	struct flock	lock;
+
+	memset(stats,0,sizeof(*stats));
+
+	if ((fdcache = slbt_objcache_open(dctx,false)) < 0)
+		return (errno == ENOENT) ? 0 : -1;
+
+	if ((fd = openat(fdcache,slbt_objcache_stats_file,O_RDONLY|O_CLOEXEC,0)) < 0) {
+		close(fdcache);
+		return (errno == ENOENT) ? 0 : -1;
+	}
+
+	memset(&lock,0,sizeof(lock));
+	lock.l_type   = F_RDLCK;
+	lock.l_whence = SEEK_SET;
+
+	fcntl(fd,F_SETLKW,&lock);
+	slbt_objcache_read_stats(fd,stats);
+
+	close(fd);
+	close(fdcache);
+
+	return 0;
+}
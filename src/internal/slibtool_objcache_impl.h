@@ -0,0 +1,47 @@
+#ifndef SLIBTOOL_OBJCACHE_IMPL_H
+#define SLIBTOOL_OBJCACHE_IMPL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <slibtool/slibtool.h>
+#include "slibtool_sha256_impl.h"
+
+struct slbt_objcache_key {
+	bool		fvalid;
+	const char *	depfile;
+	char		digest[SLBT_SHA256_HEXDIGEST_SIZE];
+};
+
+struct slbt_objcache_stats {
+	uint64_t	hits;
+	uint64_t	misses;
+	uint64_t	stores;
+	uint64_t	evictions;
+	uint64_t	size;
+};
+
+int slbt_objcache_get_key(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_exec_ctx *		ectx,
+	struct slbt_objcache_key *	key);
+
+int slbt_objcache_hash_program(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_sha256_ctx *	sha,
+	const char *			program);
+
+int slbt_objcache_restore(
+	const struct slbt_driver_ctx *	dctx,
+	const struct slbt_objcache_key *key,
+	const char *			objname);
+
+int slbt_objcache_store(
+	const struct slbt_driver_ctx *	dctx,
+	const struct slbt_objcache_key *key,
+	const char *			objname);
+
+int slbt_objcache_get_stats(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_objcache_stats *	stats);
+
+#endif
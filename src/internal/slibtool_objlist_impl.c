@@ -8,6 +8,7 @@
 #include <errno.h>
 #include <unistd.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/mman.h>
@@ -19,9 +20,10 @@
 #include "slibtool_objlist_impl.h"
 #include "slibtool_visibility_impl.h"
 
-slbt_hidden int slbt_objlist_read(
+static int slbt_objlist_read_impl(
 	int                     fdcwd,
-	struct slbt_obj_list *  objlist)
+	struct slbt_obj_list *  objlist,
+	bool                    fquote)
 {
 	struct slbt_map_info *	mapinfo;
 	int			objc;
@@ -30,6 +32,7 @@ slbt_hidden int slbt_objlist_read(
 	char *			dst;
 	char *			mark;
 	int			skip;
+	char			quote;
 
 	/* temporarily map the object list */
 	if (!(mapinfo = slbt_map_file(fdcwd,objlist->name,SLBT_MAP_INPUT)))
@@ -46,11 +49,31 @@ slbt_hidden int slbt_objlist_read(
 	}
 
 	/* object list file to normalized object strings */
-	objc = 0;
-	skip = true;
+	objc  = 0;
+	skip  = true;
+	quote = 0;
 
 	for (src=mapinfo->addr,dst=objlist->addr; src<mapinfo->cap; src++) {
-		if (!*src || (*src==' ') || (*src=='\n') || (*src=='\r')) {
+		if (fquote && (*src == '\\') && (src+1 < mapinfo->cap)) {
+			*dst++ = *++src;
+
+			objc += !!skip;
+			skip  = false;
+
+		} else if (fquote && quote) {
+			if (*src == quote)
+				quote = 0;
+			else
+				*dst++ = *src;
+
+		} else if (fquote && ((*src == '\'') || (*src == '"'))) {
+			quote = *src;
+
+			objc += !!skip;
+			skip  = false;
+
+		} else if (!*src || (*src==' ') || (*src=='\n') || (*src=='\r')
+				|| (fquote && (*src=='\t'))) {
 			if (!skip)
 				*dst++ = 0;
 
@@ -66,13 +89,14 @@ slbt_hidden int slbt_objlist_read(
 	/* object vector */
 	objlist->objc = objc;
 
-	if (!(objlist->objv = calloc(++objc,sizeof(char *)))) {
+	if (!(objlist->objv = calloc(objc+1,sizeof(char *)))) {
 		free(objlist->addr);
 		slbt_unmap_file(mapinfo);
 		return -1;
 	}
 
-	for (objv=objlist->objv,mark=objlist->addr; *mark; objv++) {
+	/* (quoted) empty strings are valid response file arguments */
+	for (objv=objlist->objv,mark=objlist->addr; objc; objc--, objv++) {
 		*objv = mark;
 		mark += strlen(mark) + 1;
 	}
@@ -81,3 +105,19 @@ slbt_hidden int slbt_objlist_read(
 
 	return 0;
 }
+
+slbt_hidden int slbt_objlist_read(
+	int                     fdcwd,
+	struct slbt_obj_list *  objlist)
+{
+	return slbt_objlist_read_impl(fdcwd,objlist,false);
+}
+
+/* response file (@file): whitespace separated arguments, single */
+/* and double quotes, and backslash escapes, as in gcc and ld.   */
+slbt_hidden int slbt_rsplist_read(
+	int                     fdcwd,
+	struct slbt_obj_list *  rsplist)
+{
+	return slbt_objlist_read_impl(fdcwd,rsplist,true);
+}
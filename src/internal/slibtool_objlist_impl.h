@@ -7,4 +7,8 @@ int slbt_objlist_read(
 	int                    fdcwd,
 	struct slbt_obj_list * objlist);
 
+int slbt_rsplist_read(
+	int                    fdcwd,
+	struct slbt_obj_list * rsplist);
+
 #endif
@@ -0,0 +1,173 @@
+/*******************************************************************/
+/*  slibtool: a strong libtool implementation, written in C        */
+/*  Copyright (C) 2016--2024  SysDeer Technologies, LLC            */
+/*  Released under the Standard MIT License; see COPYING.SLIBTOOL. */
+/*******************************************************************/
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdbool.h>
+
+#include "slibtool_rspfile_impl.h"
+#include "slibtool_visibility_impl.h"
+
+extern int mkstemp(char *);
+
+/* tools known to expand @file arguments, possibly */
+/* carrying a <triple>- prefix or a -<version> suffix */
+static const char * slbt_rspfile_tools[] = {
+	"cc","c++","gcc","g++","gfortran",
+	"clang","clang++",
+	"ld","ld.bfd","ld.gold","ld.lld",
+	"ar","gcc-ar","llvm-ar","ranlib",
+	"dlltool","llvm-dlltool",
+	0
+};
+
+static bool slbt_rspfile_tool_supported(const char * program)
+{
+	const char **	ptool;
+	const char *	base;
+	const char *	dash;
+	const char *	ch;
+	size_t		len;
+	size_t		tlen;
+
+	base = strrchr(program,'/');
+	base = base ? &base[1] : program;
+	len  = strlen(base);
+
+	/* -<version> suffix */
+	if ((dash = strrchr(base,'-')) && dash[1]) {
+		for (ch=&dash[1]; (*ch >= '0' && *ch <= '9') || (*ch == '.'); )
+			ch++;
+
+		if (!*ch)
+			len = dash - base;
+	}
+
+	for (ptool=slbt_rspfile_tools; *ptool; ptool++) {
+		if ((tlen = strlen(*ptool)) > len)
+			continue;
+
+		if (strncmp(&base[len-tlen],*ptool,tlen))
+			continue;
+
+		if ((tlen == len) || (base[len-tlen-1] == '-'))
+			return true;
+	}
+
+	return false;
+}
+
+static char * slbt_rspfile_quote(char * dst, const char * arg)
+{
+	if (!*arg) {
+		*dst++ = '\'';
+		*dst++ = '\'';
+	}
+
+	for (; *arg; arg++) {
+		switch (*arg) {
+			case ' ':
+			case '\t':
+			case '\n':
+			case '\r':
+			case '\f':
+			case '\v':
+			case '\'':
+			case '"':
+			case '\\':
+				*dst++ = '\\';
+				break;
+		}
+
+		*dst++ = *arg;
+	}
+
+	*dst++ = '\n';
+
+	return dst;
+}
+
+/* returns 1 when argv[1..] was written to a response file, in which */
+/* case (*rspargv) is the vector to spawn, (*rspname) holds '@' and  */
+/* the file's name, and the caller removes the file once done; 0    */
+/* when no response file is needed; and -1 on error.                 */
+slbt_hidden int slbt_rspfile_create(
+	char **		argv,
+	char		(*rspname)[PATH_MAX],
+	char *		(*rspargv)[3])
+{
+	int		fd;
+	char **		parg;
+	size_t		size;
+	ssize_t		nwritten;
+	const char *	tmpdir;
+	char *		buf;
+	char *		ch;
+
+	/* combined length */
+	for (size=0, parg=argv; *parg; parg++)
+		size += strlen(*parg) + 1;
+
+	if (size < SLBT_RSPFILE_THRESHOLD)
+		return 0;
+
+	if (!argv[1] || !slbt_rspfile_tool_supported(argv[0]))
+		return 0;
+
+	/* quoted arguments, one per line */
+	if (!(buf = malloc(2*size + 2*(parg - argv))))
+		return -1;
+
+	for (ch=buf, parg=&argv[1]; *parg; parg++)
+		ch = slbt_rspfile_quote(ch,*parg);
+
+	/* private response file */
+	if (!(tmpdir = getenv("TMPDIR")) || !*tmpdir)
+		tmpdir = "/tmp";
+
+	if ((size_t)snprintf(*rspname,sizeof(*rspname),
+			"@%s/.slibtool.rspfile.pid.%d.XXXXXX",
+			tmpdir,getpid()) >= sizeof(*rspname)) {
+		free(buf);
+		return -1;
+	}
+
+	if ((fd = mkstemp(&(*rspname)[1])) < 0) {
+		free(buf);
+		return -1;
+	}
+
+	for (size=ch-buf, ch=buf; size; ) {
+		nwritten = write(fd,ch,size);
+
+		while ((nwritten < 0) && (errno == EINTR))
+			nwritten = write(fd,ch,size);
+
+		if (nwritten < 0) {
+			close(fd);
+			unlinkat(AT_FDCWD,&(*rspname)[1],0);
+			free(buf);
+			return -1;
+		}
+
+		ch   += nwritten;
+		size -= nwritten;
+	}
+
+	close(fd);
+	free(buf);
+
+	(*rspargv)[0] = argv[0];
+	(*rspargv)[1] = *rspname;
+	(*rspargv)[2] = 0;
+
+	return 1;
+}
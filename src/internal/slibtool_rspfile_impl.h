@@ -0,0 +1,15 @@
+#ifndef SLIBTOOL_RSPFILE_IMPL_H
+#define SLIBTOOL_RSPFILE_IMPL_H
+
+#include <limits.h>
+
+/* argument vectors whose combined length exceeds the threshold */
+/* are passed to tools that understand @file via a response file */
+#define SLBT_RSPFILE_THRESHOLD	(64 * 1024)
+
+int slbt_rspfile_create(
+	char **		argv,
+	char		(*rspname)[PATH_MAX],
+	char *		(*rspargv)[3]);
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef SLIBTOOL_SERVER_IMPL_H
+#define SLIBTOOL_SERVER_IMPL_H
+
+#include <stdint.h>
+#include <slibtool/slibtool.h>
+
+/* client/server protocol over a local (AF_UNIX) stream socket */
+#define SLBT_SERVER_MAGIC		0x54624c73	/* sLbT */
+#define SLBT_SERVER_ENV			"SLIBTOOL_SERVER"
+#define SLBT_SERVER_FLUSH_ARG		"--flush-server-cache"
+
+#define SLBT_SERVER_MAX_PAYLOAD		(64 * 1024 * 1024)
+
+enum slbt_server_op {
+	SLBT_SERVER_OP_EXEC	= 1,
+	SLBT_SERVER_OP_FLUSH	= 2,
+};
+
+/* followed by argc argv strings, then envc envp strings; */
+/* the exec request carries fdcwd, fdout, and fderr      */
+/* as SCM_RIGHTS ancillary data.                         */
+struct slbt_server_request {
+	uint32_t	magic;
+	uint32_t	op;
+	uint32_t	argc;
+	uint32_t	envc;
+	uint64_t	size;
+};
+
+struct slbt_server_reply {
+	uint32_t	magic;
+	int32_t		status;
+};
+
+int slbt_server_client_main(
+	char **				argv,
+	char **				envp,
+	const struct slbt_fd_ctx *	fdctx);
+
+#endif
@@ -0,0 +1,192 @@
+/*******************************************************************/
+/*  slibtool: a strong libtool implementation, written in C        */
+/*  Copyright (C) 2016--2024  SysDeer Technologies, LLC            */
+/*  Released under the Standard MIT License; see COPYING.SLIBTOOL. */
+/*******************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "slibtool_sha256_impl.h"
+#include "slibtool_visibility_impl.h"
+
+/*****************************************************************/
+/* a minimal, self-contained sha-256 (FIPS 180-4) implementation */
+/* that is used for fingerprinting cached compilation results   */
+/* and other intermediate build artifacts.                     */
+/**************************************************************/
+
+#define SLBT_ROR32(x,n)	(((x) >> (n)) | ((x) << (32 - (n))))
+
+static const uint32_t slbt_sha256_k[64] = {
+	0x428a2f98,0x71374491,0xb5c0fbcf,0xe9b5dba5,
+	0x3956c25b,0x59f111f1,0x923f82a4,0xab1c5ed5,
+	0xd807aa98,0x12835b01,0x243185be,0x550c7dc3,
+	0x72be5d74,0x80deb1fe,0x9bdc06a7,0xc19bf174,
+	0xe49b69c1,0xefbe4786,0x0fc19dc6,0x240ca1cc,
+	0x2de92c6f,0x4a7484aa,0x5cb0a9dc,0x76f988da,
+	0x983e5152,0xa831c66d,0xb00327c8,0xbf597fc7,
+	0xc6e00bf3,0xd5a79147,0x06ca6351,0x14292967,
+	0x27b70a85,0x2e1b2138,0x4d2c6dfc,0x53380d13,
+	0x650a7354,0x766a0abb,0x81c2c92e,0x92722c85,
+	0xa2bfe8a1,0xa81a664b,0xc24b8b70,0xc76c51a3,
+	0xd192e819,0xd6990624,0xf40e3585,0x106aa070,
+	0x19a4c116,0x1e376c08,0x2748774c,0x34b0bcb5,
+	0x391c0cb3,0x4ed8aa4a,0x5b9cca4f,0x682e6ff3,
+	0x748f82ee,0x78a5636f,0x84c87814,0x8cc70208,
+	0x90befffa,0xa4506ceb,0xbef9a3f7,0xc67178f2,
+};
+
+static void slbt_sha256_block(struct slbt_sha256_ctx * ctx, const unsigned char * blk)
+{
+	int		i;
+	uint32_t	w[64];
+	uint32_t	a,b,c,d,e,f,g,h;
+	uint32_t	s0,s1,t1,t2;
+
+	for (i=0; i<16; i++, blk+=4)
+		w[i] = ((uint32_t)blk[0] << 24)
+			| ((uint32_t)blk[1] << 16)
+			| ((uint32_t)blk[2] << 8)
+			| ((uint32_t)blk[3]);
+
+	for (; i<64; i++) {
+		s0   = SLBT_ROR32(w[i-15],7) ^ SLBT_ROR32(w[i-15],18) ^ (w[i-15] >> 3);
+		s1   = SLBT_ROR32(w[i-2],17) ^ SLBT_ROR32(w[i-2],19)  ^ (w[i-2] >> 10);
+		w[i] = w[i-16] + s0 + w[i-7] + s1;
+	}
+
+	a = ctx->state[0];
+	b = ctx->state[1];
+	c = ctx->state[2];
+	d = ctx->state[3];
+	e = ctx->state[4];
+	f = ctx->state[5];
+	g = ctx->state[6];
+	h = ctx->state[7];
+
+	for (i=0; i<64; i++) {
+		s1 = SLBT_ROR32(e,6) ^ SLBT_ROR32(e,11) ^ SLBT_ROR32(e,25);
+		t1 = h + s1 + ((e & f) ^ (~e & g)) + slbt_sha256_k[i] + w[i];
+		s0 = SLBT_ROR32(a,2) ^ SLBT_ROR32(a,13) ^ SLBT_ROR32(a,22);
+		t2 = s0 + ((a & b) ^ (a & c) ^ (b & c));
+
+		h = g;
+		g = f;
+		f = e;
+		e = d + t1;
+		d = c;
+		c = b;
+		b = a;
+		a = t1 + t2;
+	}
+
+	ctx->state[0] += a;
+	ctx->state[1] += b;
+	ctx->state[2] += c;
+	ctx->state[3] += d;
+	ctx->state[4] += e;
+	ctx->state[5] += f;
+	ctx->state[6] += g;
+	ctx->state[7] += h;
+}
+
+slbt_hidden void slbt_sha256_init(struct slbt_sha256_ctx * ctx)
+{
+	ctx->state[0] = 0x6a09e667;
+	ctx->state[1] = 0xbb67ae85;
+	ctx->state[2] = 0x3c6ef372;
+	ctx->state[3] = 0xa54ff53a;
+	ctx->state[4] = 0x510e527f;
+	ctx->state[5] = 0x9b05688c;
+	ctx->state[6] = 0x1f83d9ab;
+	ctx->state[7] = 0x5be0cd19;
+	ctx->count    = 0;
+}
+
+slbt_hidden void slbt_sha256_update(
+	struct slbt_sha256_ctx *	ctx,
+	const void *			buf,
+	size_t				len)
+{
+	const unsigned char *	ch;
+	size_t			pos;
+	size_t			cnt;
+
+	ch  = buf;
+	pos = ctx->count & 63;
+
+	ctx->count += len;
+
+	if (pos) {
+		cnt = 64 - pos;
+		cnt = (cnt < len) ? cnt : len;
+
+		memcpy(&ctx->block[pos],ch,cnt);
+
+		ch  += cnt;
+		len -= cnt;
+
+		if (pos + cnt < 64)
+			return;
+
+		slbt_sha256_block(ctx,ctx->block);
+	}
+
+	for (; len >= 64; ch+=64, len-=64)
+		slbt_sha256_block(ctx,ch);
+
+	memcpy(ctx->block,ch,len);
+}
+
+slbt_hidden void slbt_sha256_final(
+	struct slbt_sha256_ctx *	ctx,
+	unsigned char *			digest)
+{
+	int		i;
+	size_t		pos;
+	uint64_t	nbits;
+
+	nbits = ctx->count << 3;
+	pos   = ctx->count & 63;
+
+	ctx->block[pos++] = 0x80;
+
+	if (pos > 56) {
+		memset(&ctx->block[pos],0,64-pos);
+		slbt_sha256_block(ctx,ctx->block);
+		pos = 0;
+	}
+
+	memset(&ctx->block[pos],0,56-pos);
+
+	for (i=0; i<8; i++)
+		ctx->block[56+i] = (unsigned char)(nbits >> (56 - 8*i));
+
+	slbt_sha256_block(ctx,ctx->block);
+
+	for (i=0; i<8; i++) {
+		digest[4*i+0] = (unsigned char)(ctx->state[i] >> 24);
+		digest[4*i+1] = (unsigned char)(ctx->state[i] >> 16);
+		digest[4*i+2] = (unsigned char)(ctx->state[i] >> 8);
+		digest[4*i+3] = (unsigned char)(ctx->state[i]);
+	}
+}
+
+slbt_hidden void slbt_sha256_hexdigest(
+	struct slbt_sha256_ctx *	ctx,
+	char *				hexdigest)
+{
+	int			i;
+	unsigned char		digest[SLBT_SHA256_DIGEST_SIZE];
+	static const char	hexchars[] = "0123456789abcdef";
+
+	slbt_sha256_final(ctx,digest);
+
+	for (i=0; i<SLBT_SHA256_DIGEST_SIZE; i++) {
+		*hexdigest++ = hexchars[digest[i] >> 4];
+		*hexdigest++ = hexchars[digest[i] & 0xf];
+	}
+
+	*hexdigest = 0;
+}
@@ -0,0 +1,24 @@
+#ifndef SLIBTOOL_SHA256_IMPL_H
+#define SLIBTOOL_SHA256_IMPL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define SLBT_SHA256_DIGEST_SIZE 32
+#define SLBT_SHA256_HEXDIGEST_SIZE (2*SLBT_SHA256_DIGEST_SIZE + 1)
+
+struct slbt_sha256_ctx {
+	uint32_t	state[8];
+	uint64_t	count;
+	unsigned char	block[64];
+};
+
+void slbt_sha256_init(struct slbt_sha256_ctx *);
+
+void slbt_sha256_update(struct slbt_sha256_ctx *, const void *, size_t);
+
+void slbt_sha256_final(struct slbt_sha256_ctx *, unsigned char *);
+
+void slbt_sha256_hexdigest(struct slbt_sha256_ctx *, char *);
+
+#endif
@@ -14,6 +14,9 @@
 #include <errno.h>
 #include <sys/wait.h>
 
+#include "slibtool_driver_impl.h"
+#include "slibtool_rspfile_impl.h"
+
 #ifndef PATH_MAX
 #define PATH_MAX (_XOPEN_PATH_MAX < 4096) ? 4096 : _XOPEN_PATH_MAX
 #endif
@@ -41,17 +44,58 @@ static inline int slbt_spawn(
 	bool			fwait)
 {
 	pid_t	pid;
+	int	fdout;
+	int	fderr;
+	int	ret;
+	bool	frsp;
+	char **	argv;
+	char *	rspargv[3];
+	char	rspname[PATH_MAX];
+
+#ifdef SLBT_USE_POSIX_SPAWN
+	posix_spawn_file_actions_t	actions;
+	posix_spawn_file_actions_t *	pactions;
+#endif
+
+	/* output of the exec context redirected (e.g. buffered)? */
+	fdout = slbt_get_exec_ictx(ectx)->fdout;
+	fderr = slbt_get_exec_ictx(ectx)->fderr;
+
+	/* long command line? pass the arguments via a response file */
+	frsp = fwait && (slbt_rspfile_create(ectx->argv,&rspname,&rspargv) > 0);
+	argv = frsp ? rspargv : ectx->argv;
 
 #ifdef SLBT_USE_POSIX_SPAWN
 
+	pactions = 0;
+
+	if ((fdout >= 0) || (fderr >= 0)) {
+		if (posix_spawn_file_actions_init(&actions)) {
+			ectx->pid      = -1;
+			ectx->exitcode = errno;
+			return -1;
+		}
+
+		pactions = &actions;
+
+		if (fdout >= 0)
+			posix_spawn_file_actions_adddup2(pactions,fdout,1);
+
+		if (fderr >= 0)
+			posix_spawn_file_actions_adddup2(pactions,fderr,2);
+	}
+
 	if (posix_spawnp(
 			&pid,
 			ectx->program,
-			0,0,
-			ectx->argv,
+			pactions,0,
+			argv,
 			ectx->envp))
 		pid = -1;
 
+	if (pactions)
+		posix_spawn_file_actions_destroy(pactions);
+
 #else
 
 #ifdef SLBT_USE_FORK
@@ -67,26 +111,41 @@ static inline int slbt_spawn(
 	if (pid < 0) {
 		ectx->pid      = pid;
 		ectx->exitcode = errno;
+
+		if (frsp)
+			unlink(&rspname[1]);
+
 		return -1;
 	}
 
 	if (pid == 0) {
+		if (fdout >= 0)
+			dup2(fdout,1);
+
+		if (fderr >= 0)
+			dup2(fderr,2);
+
 		execvp(
 			ectx->program,
-			ectx->argv);
+			argv);
 		_exit(errno);
 	}
 
 	errno     = 0;
 	ectx->pid = pid;
 
-	if (fwait)
-		return waitpid(
-			pid,
-			&ectx->exitcode,
-			0);
+	if (!fwait)
+		return 0;
+
+	ret = waitpid(
+		pid,
+		&ectx->exitcode,
+		0);
+
+	if (frsp)
+		unlink(&rspname[1]);
 
-	return 0;
+	return ret;
 }
 
 #endif
@@ -13,6 +13,8 @@
 #include <string.h>
 #include <stdio.h>
 #include <inttypes.h>
+#include <errno.h>
+#include <sys/types.h>
 
 #include "slibtool_visibility_impl.h"
 
@@ -88,3 +90,51 @@ slbt_hidden int slbt_tmpfile(void)
 
 	return slbt_mkostemp(tmplate);
 }
+
+/* write a region of a (worker's) tmpfile to fddst, e.g. when */
+/* replaying buffered output in a deterministic order.        */
+slbt_hidden int slbt_tmpfile_replay(
+	int	fdtmp,
+	off_t	offset,
+	off_t	size,
+	int	fddst)
+{
+	ssize_t	nread;
+	ssize_t	nwritten;
+	char *	ch;
+	char	buf[4096];
+
+	while (size) {
+		nread = pread(
+			fdtmp,buf,
+			(size < (off_t)sizeof(buf)) ? size : (off_t)sizeof(buf),
+			offset);
+
+		while ((nread < 0) && (errno == EINTR))
+			nread = pread(
+				fdtmp,buf,
+				(size < (off_t)sizeof(buf)) ? size : (off_t)sizeof(buf),
+				offset);
+
+		if (nread <= 0)
+			return -1;
+
+		offset += nread;
+		size   -= nread;
+
+		for (ch=buf; nread; ) {
+			nwritten = write(fddst,ch,nread);
+
+			while ((nwritten < 0) && (errno == EINTR))
+				nwritten = write(fddst,ch,nread);
+
+			if (nwritten < 0)
+				return -1;
+
+			ch    += nwritten;
+			nread -= nwritten;
+		}
+	}
+
+	return 0;
+}
@@ -1,6 +1,10 @@
 #ifndef SLIBTOOL_TMPFILE_IMPL_H
 #define SLIBTOOL_TMPFILE_IMPL_H
 
+#include <sys/types.h>
+
 int slbt_tmpfile(void);
 
+int slbt_tmpfile_replay(int fdtmp, off_t offset, off_t size, int fddst);
+
 #endif
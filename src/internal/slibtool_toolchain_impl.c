@@ -0,0 +1,215 @@
+/*******************************************************************/
+/*  slibtool: a strong libtool implementation, written in C        */
+/*  Copyright (C) 2016--2024  SysDeer Technologies, LLC            */
+/*  Released under the Standard MIT License; see COPYING.SLIBTOOL. */
+/*******************************************************************/
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <slibtool/slibtool.h>
+#include "slibtool_driver_impl.h"
+#include "slibtool_errinfo_impl.h"
+#include "slibtool_toolchain_impl.h"
+#include "slibtool_visibility_impl.h"
+
+/* toolchain contexts are shared by all driver contexts of the current   */
+/* process; a context is keyed on the identity of the libtool script,    */
+/* and is freed once unreferenced. within a caching scope (batch and     */
+/* server mode), unreferenced contexts are instead kept for reuse until  */
+/* that script changes, or until the last caching scope has ended.       */
+static struct slbt_toolchain_ctx *	slbt_toolchains;
+static int				slbt_toolchain_ncache;
+static pthread_mutex_t			slbt_toolchain_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void slbt_toolchain_free(struct slbt_toolchain_ctx * tctx)
+{
+	if (tctx->lconf.addr)
+		munmap(
+			tctx->lconf.addr,
+			tctx->lconf.size);
+
+	if (tctx->lconfctx)
+		slbt_lib_free_txtfile_ctx(tctx->lconfctx);
+
+	free(tctx);
+}
+
+static bool slbt_toolchain_is_current(
+	const struct slbt_toolchain_ctx *	tctx,
+	const struct stat *			st)
+{
+	return (tctx->size == st->st_size)
+		&& (tctx->mtim.tv_sec  == st->st_mtim.tv_sec)
+		&& (tctx->mtim.tv_nsec == st->st_mtim.tv_nsec);
+}
+
+static struct slbt_toolchain_ctx * slbt_toolchain_find(const struct stat * st)
+{
+	struct slbt_toolchain_ctx **	ptctx;
+	struct slbt_toolchain_ctx *	tctx;
+
+	for (ptctx=&slbt_toolchains; (tctx = *ptctx); ) {
+		if ((tctx->dev != st->st_dev) || (tctx->ino != st->st_ino)) {
+			ptctx = &tctx->next;
+
+		} else if (slbt_toolchain_is_current(tctx,st)) {
+			return tctx;
+
+		} else if (tctx->refcnt) {
+			ptctx = &tctx->next;
+
+		} else {
+			*ptctx = tctx->next;
+			slbt_toolchain_free(tctx);
+		}
+	}
+
+	return 0;
+}
+
+slbt_hidden int slbt_toolchain_get_lconf(
+	const struct slbt_driver_ctx *	dctx,
+	int				fdlconf,
+	const char *			path,
+	struct slbt_toolchain_ctx **	ptctx)
+{
+	struct slbt_toolchain_ctx *	tctx;
+	struct slbt_toolchain_ctx *	cached;
+	struct slbt_txtfile_ctx_impl *	ictx;
+	struct stat			st;
+	uintptr_t			addr;
+
+	if (fstat(fdlconf,&st) < 0)
+		return SLBT_SYSTEM_ERROR(dctx,path);
+
+	/* reuse */
+	pthread_mutex_lock(&slbt_toolchain_lock);
+
+	if ((tctx = slbt_toolchain_find(&st)))
+		tctx->refcnt++;
+
+	pthread_mutex_unlock(&slbt_toolchain_lock);
+
+	if ((*ptctx = tctx))
+		return 0;
+
+	/* create */
+	if (!(tctx = calloc(1,sizeof(*tctx))))
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	tctx->dev  = st.st_dev;
+	tctx->ino  = st.st_ino;
+	tctx->size = st.st_size;
+	tctx->mtim = st.st_mtim;
+
+	if (slbt_impl_get_txtfile_ctx(dctx,path,fdlconf,&tctx->lconfctx) < 0) {
+		slbt_toolchain_free(tctx);
+		return SLBT_NESTED_ERROR(dctx);
+	}
+
+	tctx->lconf.size = st.st_size;
+	tctx->lconf.addr = mmap(
+		0,st.st_size,
+		PROT_READ,MAP_SHARED,
+		fdlconf,0);
+
+	if (tctx->lconf.addr == MAP_FAILED) {
+		tctx->lconf.addr = 0;
+		slbt_toolchain_free(tctx);
+		return SLBT_CUSTOM_ERROR(
+			dctx,SLBT_ERR_LCONF_MAP);
+	}
+
+	/* the line vector outlives the creating driver context */
+	addr = (uintptr_t)tctx->lconfctx - offsetof(struct slbt_txtfile_ctx_impl,tctx);
+	ictx = (struct slbt_txtfile_ctx_impl *)addr;
+	ictx->dctx = 0;
+
+	/* publish, unless another thread has done so in the meantime */
+	pthread_mutex_lock(&slbt_toolchain_lock);
+
+	if ((cached = slbt_toolchain_find(&st))) {
+		cached->refcnt++;
+	} else {
+		tctx->refcnt    = 1;
+		tctx->next      = slbt_toolchains;
+		slbt_toolchains = tctx;
+	}
+
+	pthread_mutex_unlock(&slbt_toolchain_lock);
+
+	if (cached)
+		slbt_toolchain_free(tctx);
+
+	*ptctx = cached ? cached : tctx;
+
+	return 0;
+}
+
+slbt_hidden void slbt_toolchain_release(struct slbt_toolchain_ctx * tctx)
+{
+	struct slbt_toolchain_ctx **	ptctx;
+	bool				fdrop;
+
+	if (!tctx)
+		return;
+
+	pthread_mutex_lock(&slbt_toolchain_lock);
+
+	if ((fdrop = !--tctx->refcnt && !slbt_toolchain_ncache)) {
+		for (ptctx=&slbt_toolchains; *ptctx != tctx; )
+			ptctx = &(*ptctx)->next;
+
+		*ptctx = tctx->next;
+	}
+
+	pthread_mutex_unlock(&slbt_toolchain_lock);
+
+	if (fdrop)
+		slbt_toolchain_free(tctx);
+}
+
+static void slbt_toolchain_flush_locked(void)
+{
+	struct slbt_toolchain_ctx **	ptctx;
+	struct slbt_toolchain_ctx *	tctx;
+
+	for (ptctx=&slbt_toolchains; (tctx = *ptctx); ) {
+		if (tctx->refcnt) {
+			ptctx = &tctx->next;
+		} else {
+			*ptctx = tctx->next;
+			slbt_toolchain_free(tctx);
+		}
+	}
+}
+
+slbt_hidden void slbt_toolchain_flush(void)
+{
+	pthread_mutex_lock(&slbt_toolchain_lock);
+	slbt_toolchain_flush_locked();
+	pthread_mutex_unlock(&slbt_toolchain_lock);
+}
+
+slbt_hidden void slbt_toolchain_cache_begin(void)
+{
+	pthread_mutex_lock(&slbt_toolchain_lock);
+	slbt_toolchain_ncache++;
+	pthread_mutex_unlock(&slbt_toolchain_lock);
+}
+
+slbt_hidden void slbt_toolchain_cache_end(void)
+{
+	pthread_mutex_lock(&slbt_toolchain_lock);
+
+	if (!--slbt_toolchain_ncache)
+		slbt_toolchain_flush_locked();
+
+	pthread_mutex_unlock(&slbt_toolchain_lock);
+}
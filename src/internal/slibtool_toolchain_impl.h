@@ -0,0 +1,38 @@
+#ifndef SLIBTOOL_TOOLCHAIN_IMPL_H
+#define SLIBTOOL_TOOLCHAIN_IMPL_H
+
+#include <time.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <slibtool/slibtool.h>
+#include "slibtool_mapfile_impl.h"
+
+/* immutable, reference-counted state that is shared by all */
+/* driver contexts which refer to the same libtool script.  */
+struct slbt_toolchain_ctx {
+	struct slbt_toolchain_ctx *	next;
+	int				refcnt;
+	dev_t				dev;
+	ino_t				ino;
+	off_t				size;
+	struct timespec			mtim;
+	struct slbt_map_info		lconf;
+	struct slbt_txtfile_ctx *	lconfctx;
+};
+
+int slbt_toolchain_get_lconf(
+	const struct slbt_driver_ctx *	dctx,
+	int				fdlconf,
+	const char *			path,
+	struct slbt_toolchain_ctx **	ptctx);
+
+void slbt_toolchain_release(struct slbt_toolchain_ctx *);
+
+void slbt_toolchain_flush(void);
+
+void slbt_toolchain_cache_begin(void);
+
+void slbt_toolchain_cache_end(void);
+
+#endif
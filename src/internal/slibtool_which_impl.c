@@ -0,0 +1,70 @@
+/*******************************************************************/
+/*  slibtool: a strong libtool implementation, written in C        */
+/*  Copyright (C) 2016--2024  SysDeer Technologies, LLC            */
+/*  Released under the Standard MIT License; see COPYING.SLIBTOOL. */
+/*******************************************************************/
+
+#include <fcntl.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <slibtool/slibtool.h>
+
+#include "slibtool_driver_impl.h"
+#include "slibtool_snprintf_impl.h"
+#include "slibtool_which_impl.h"
+#include "slibtool_visibility_impl.h"
+
+/* explicit path, or the first executable match in the driver's $PATH */
+slbt_hidden int slbt_which(
+	const struct slbt_driver_ctx *	dctx,
+	const char *			program,
+	char *				pathbuf,
+	size_t				buflen,
+	struct stat *			st)
+{
+	int		fdcwd;
+	int		len;
+	char **		penv;
+	const char *	mark;
+	const char *	dirs;
+
+	fdcwd = slbt_driver_fdcwd(dctx);
+
+	if (strchr(program,'/')) {
+		if (fstatat(fdcwd,program,st,0) < 0)
+			return -1;
+
+		return slbt_snprintf(pathbuf,buflen,"%s",program) < 0
+			? -1 : 0;
+	}
+
+	for (dirs=0, penv=slbt_driver_envp(dctx); !dirs && penv && *penv; penv++)
+		if (!strncmp(*penv,"PATH=",5))
+			dirs = &(*penv)[5];
+
+	if (!dirs && !(dirs = getenv("PATH")))
+		dirs = "/usr/bin:/bin";
+
+	for (; dirs; dirs=mark ? ++mark : 0) {
+		if (!(mark = strchr(dirs,':')))
+			len = strlen(dirs);
+		else
+			len = mark - dirs;
+
+		if (slbt_snprintf(pathbuf,buflen,
+				"%.*s/%s",
+				len ? len : 1,
+				len ? dirs : ".",
+				program) < 0)
+			continue;
+
+		if (!fstatat(fdcwd,pathbuf,st,0))
+			if (S_ISREG(st->st_mode) && (st->st_mode & 0111))
+				return 0;
+	}
+
+	errno = ENOENT;
+	return -1;
+}
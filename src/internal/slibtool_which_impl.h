@@ -0,0 +1,15 @@
+#ifndef SLIBTOOL_WHICH_IMPL_H
+#define SLIBTOOL_WHICH_IMPL_H
+
+#include <stddef.h>
+#include <sys/stat.h>
+#include <slibtool/slibtool.h>
+
+int slbt_which(
+	const struct slbt_driver_ctx *	dctx,
+	const char *			program,
+	char *				pathbuf,
+	size_t				buflen,
+	struct stat *			st);
+
+#endif
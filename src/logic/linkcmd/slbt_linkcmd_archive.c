@@ -9,9 +9,13 @@
 #include <string.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 
 #include <slibtool/slibtool.h>
+#include <slibtool/slibtool_arbits.h>
+#include "slibtool_ar_impl.h"
 #include "slibtool_driver_impl.h"
 #include "slibtool_errinfo_impl.h"
 #include "slibtool_linkcmd_impl.h"
@@ -70,17 +74,311 @@ static bool slbt_archive_is_convenience_library(int fdcwd, const char * arpath)
 }
 
 
+static bool slbt_archive_is_thin(int fdcwd, const char * arpath)
+{
+	int     fd;
+	ssize_t nread;
+	char    signature[sizeof(struct ar_raw_signature)];
+
+	if ((fd = openat(fdcwd,arpath,O_RDONLY,0)) < 0)
+		return false;
+
+	nread = read(fd,signature,sizeof(signature));
+	close(fd);
+
+	return (nread == sizeof(signature))
+		&& !memcmp(signature,AR_THIN_SIGNATURE,sizeof(signature));
+}
+
+
+/* a thin archive may only import thin convenience libraries */
+static bool slbt_exec_link_thin_inputs(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_exec_ctx *		ectx)
+{
+	int	fdcwd;
+	char ** parg;
+	char	arpath[PATH_MAX];
+
+	fdcwd = slbt_driver_fdcwd(dctx);
+
+	for (parg=ectx->cargv; *parg; parg++) {
+		if (slbt_snprintf(arpath,sizeof(arpath),"%s",*parg) < 0)
+			return false;
+
+		if (!slbt_adjust_wrapper_argument(
+				arpath,true,
+				dctx->cctx->settings.arsuffix))
+			continue;
+
+		if (!slbt_archive_is_convenience_library(fdcwd,arpath))
+			continue;
+
+		if (slbt_symlink_is_a_placeholder(fdcwd,arpath))
+			continue;
+
+		if (!slbt_archive_is_thin(fdcwd,arpath))
+			return false;
+	}
+
+	return true;
+}
+
+
+static int slbt_exec_link_cmp_names(const void * a, const void * b)
+{
+	return strcmp(*(const char **)a,*(const char **)b);
+}
+
+
+static bool slbt_exec_link_member_is_current(
+	const struct slbt_driver_ctx *		dctx,
+	const struct ar_meta_member_info *	meminfo,
+	const char *				objname)
+{
+	int			fdcwd;
+	bool			fcurrent;
+	struct stat		st;
+	struct slbt_input	mapinfo;
+
+	fdcwd = slbt_driver_fdcwd(dctx);
+
+	if (fstatat(fdcwd,objname,&st,0) < 0)
+		return false;
+
+	if ((uint64_t)st.st_size != meminfo->ar_object_size)
+		return false;
+
+	if (st.st_size == 0)
+		return true;
+
+	if (slbt_fs_map_input(dctx,-1,objname,PROT_READ,&mapinfo) < 0)
+		return false;
+
+	fcurrent = !memcmp(
+		mapinfo.addr,
+		meminfo->ar_object_data,
+		mapinfo.size);
+
+	slbt_fs_unmap_input(&mapinfo);
+
+	return fcurrent;
+}
+
+
+/* replace only the changed members of an existing archive; returns */
+/* zero when the archive cannot be updated in place, in which case  */
+/* the caller should create it from scratch.                        */
+static int slbt_exec_link_update_archive(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_exec_ctx *		ectx,
+	const char *			output,
+	char **				objv)
+{
+	int				fdcwd;
+	int				ret;
+	size_t				nobjs;
+	size_t				idx;
+	char **				parg;
+	char **				pchanged;
+	const char *			base;
+	const char **			namev;
+	struct stat			st;
+	struct slbt_error_info **	errmark;
+	struct slbt_archive_ctx *	arctx;
+	struct slbt_archive_ctx *	upctx;
+	struct slbt_archive_ctx *	newctx;
+	struct ar_meta_member_info **	memberp;
+	struct ar_meta_member_info **	objmemberv;
+	const struct ar_meta_armap_info * armap;
+	char				update[PATH_MAX];
+
+	/* convenience libraries are imported after the fact */
+	for (parg=ectx->cargv; *parg; parg++)
+		if ((base = strrchr(*parg,'.')) && !strcmp(base,".la"))
+			return 0;
+
+	/* existing archive */
+	fdcwd = slbt_driver_fdcwd(dctx);
+
+	if (fstatat(fdcwd,output,&st,0) < 0)
+		return 0;
+
+	if (!S_ISREG(st.st_mode))
+		return 0;
+
+	errmark = slbt_error_info_mark(dctx);
+
+	if (slbt_ar_get_archive_ctx(dctx,output,&arctx) < 0) {
+		slbt_error_info_discard(dctx,errmark);
+		return 0;
+	}
+
+	/* sysv archive with a sysv armap (if any) */
+	armap = &arctx->meta->a_armap_primary;
+
+	if (armap->ar_armap_common_32 || armap->ar_armap_common_64) {
+		if (!((armap->ar_armap_common_32
+				? armap->ar_armap_common_32->ar_armap_attr
+				: armap->ar_armap_common_64->ar_armap_attr)
+				& AR_ARMAP_ATTR_SYSV)) {
+			slbt_ar_free_archive_ctx(arctx);
+			return 0;
+		}
+	}
+
+	/* members must match the input objects, in order */
+	for (nobjs=0, parg=objv; *parg; parg++)
+		nobjs++;
+
+	if (!(objmemberv = calloc(2*nobjs + 1,sizeof(*objmemberv)))) {
+		slbt_ar_free_archive_ctx(arctx);
+		return SLBT_SYSTEM_ERROR(dctx,0);
+	}
+
+	namev = (const char **)&objmemberv[nobjs];
+
+	for (idx=0, memberp=arctx->meta->a_memberv; memberp && *memberp; memberp++) {
+		switch ((*memberp)->ar_member_attr) {
+			case AR_MEMBER_ATTR_ARMAP:
+			case AR_MEMBER_ATTR_NAMESTRS:
+				break;
+
+			default:
+				if (idx == nobjs)
+					ret = -1;
+
+				else if ((*memberp)->ar_member_attr == AR_MEMBER_ATTR_THIN)
+					ret = -1;
+
+				else if ((*memberp)->ar_member_attr == AR_MEMBER_ATTR_LINKINFO)
+					ret = -1;
+
+				else if (!((*memberp)->ar_file_header.ar_header_attr & AR_HEADER_ATTR_SYSV))
+					ret = -1;
+
+				else if ((base = strrchr(objv[idx],'/')))
+					ret = strcmp(++base,(*memberp)->ar_file_header.ar_member_name);
+
+				else
+					ret = strcmp(objv[idx],(*memberp)->ar_file_header.ar_member_name);
+
+				if (ret) {
+					free(objmemberv);
+					slbt_ar_free_archive_ctx(arctx);
+					return 0;
+				}
+
+				objmemberv[idx] = *memberp;
+				namev[idx]      = (*memberp)->ar_file_header.ar_member_name;
+				idx++;
+
+				break;
+		}
+	}
+
+	/* duplicate member names cannot be told apart */
+	qsort(namev,idx,sizeof(*namev),slbt_exec_link_cmp_names);
+
+	for (ret=(idx < nobjs), idx=1; !ret && (idx < nobjs); idx++)
+		ret = !strcmp(namev[idx-1],namev[idx]);
+
+	if (ret) {
+		free(objmemberv);
+		slbt_ar_free_archive_ctx(arctx);
+		return 0;
+	}
+
+	/* changed objects */
+	for (idx=0, pchanged=objv; idx<nobjs; idx++)
+		if (!slbt_exec_link_member_is_current(dctx,objmemberv[idx],objv[idx]))
+			*pchanged++ = objv[idx];
+
+	*pchanged = 0;
+
+	free(objmemberv);
+
+	/* up to date? */
+	if (pchanged == objv) {
+		slbt_ar_free_archive_ctx(arctx);
+
+		if (utimensat(fdcwd,output,0,0) < 0)
+			return SLBT_SYSTEM_ERROR(dctx,output);
+
+		return 1;
+	}
+
+	/* archive of changed members */
+	if (slbt_snprintf(update,sizeof(update),
+			"%s.slibtool.update",output) < 0) {
+		slbt_ar_free_archive_ctx(arctx);
+		return SLBT_BUFFER_ERROR(dctx);
+	}
+
+	objv[-1] = update;
+
+	if (unlinkat(fdcwd,update,0) && (errno != ENOENT)) {
+		slbt_ar_free_archive_ctx(arctx);
+		return SLBT_SYSTEM_ERROR(dctx,update);
+	}
+
+	if (!(dctx->cctx->drvflags & SLBT_DRIVER_SILENT)) {
+		if (slbt_output_link(ectx)) {
+			slbt_ar_free_archive_ctx(arctx);
+			return SLBT_NESTED_ERROR(dctx);
+		}
+	}
+
+	if ((slbt_spawn(ectx,true) < 0) && (ectx->pid < 0)) {
+		slbt_ar_free_archive_ctx(arctx);
+		return SLBT_SPAWN_ERROR(dctx);
+
+	} else if (ectx->exitcode) {
+		slbt_ar_free_archive_ctx(arctx);
+		unlinkat(fdcwd,update,0);
+		return SLBT_CUSTOM_ERROR(
+			dctx,
+			SLBT_ERR_AR_ERROR);
+	}
+
+	/* splice */
+	if (slbt_ar_get_archive_ctx(dctx,update,&upctx) < 0) {
+		slbt_ar_free_archive_ctx(arctx);
+		unlinkat(fdcwd,update,0);
+		return SLBT_NESTED_ERROR(dctx);
+	}
+
+	ret = slbt_ar_update_archive(arctx,upctx,&newctx);
+
+	slbt_ar_free_archive_ctx(upctx);
+	slbt_ar_free_archive_ctx(arctx);
+	unlinkat(fdcwd,update,0);
+
+	if (ret < 0)
+		return SLBT_NESTED_ERROR(dctx);
+
+	ret = slbt_ar_store_archive(newctx,output,st.st_mode & 0777);
+
+	slbt_ar_free_archive_ctx(newctx);
+
+	return (ret < 0) ? SLBT_NESTED_ERROR(dctx) : 1;
+}
+
+
 slbt_hidden int slbt_exec_link_create_archive(
 	const struct slbt_driver_ctx *	dctx,
 	struct slbt_exec_ctx *		ectx,
 	const char *			arfilename,
 	bool				fpic,
-	bool                            fdep)
+	bool                            fdep,
+	bool				fthin)
 {
 	int		fdcwd;
+	int		ret;
 	char **         argv;
 	char ** 	aarg;
 	char ** 	parg;
+	char ** 	objv;
 	char		program[PATH_MAX];
 	char		output [PATH_MAX];
 	char		namebuf[PATH_MAX];
@@ -126,9 +424,15 @@ slbt_hidden int slbt_exec_link_create_archive(
 		*aarg++ = program;
 	}
 
-	*aarg++ = "-crs";
+	/* thin archive: all imported convenience libraries must be thin */
+	if (fthin)
+		fthin = slbt_exec_link_thin_inputs(dctx,ectx);
+
+	*aarg++ = fthin ? "-crsT" : "-crs";
 	*aarg++ = output;
 
+	objv = aarg;
+
 	for (parg=ectx->cargv; *parg; parg++)
 		if (slbt_adjust_object_argument(*parg,fpic,!fpic,fdcwd))
 			*aarg++ = *parg;
@@ -150,13 +454,21 @@ slbt_hidden int slbt_exec_link_create_archive(
 		ectx->program = program;
 	}
 
+	/* incremental update of an existing archive */
+	ret = 0;
+
+	if (dctx->cctx->drvflags & SLBT_DRIVER_INCREMENTAL_ARCHIVE)
+		if (!(dctx->cctx->drvflags & SLBT_DRIVER_DRY_RUN) && !fthin)
+			if ((ret = slbt_exec_link_update_archive(dctx,ectx,output,objv)) < 0)
+				return SLBT_NESTED_ERROR(dctx);
+
 	/* step output */
-	if (!(dctx->cctx->drvflags & SLBT_DRIVER_SILENT))
+	if (!ret && !(dctx->cctx->drvflags & SLBT_DRIVER_SILENT))
 		if (slbt_output_link(ectx))
 			return SLBT_NESTED_ERROR(dctx);
 
 	/* remove old archive as needed */
-	if (slbt_exec_link_remove_file(dctx,ectx,output))
+	if (!ret && slbt_exec_link_remove_file(dctx,ectx,output))
 		return SLBT_NESTED_ERROR(dctx);
 
 	/* .deps */
@@ -167,7 +479,10 @@ slbt_hidden int slbt_exec_link_create_archive(
 			return SLBT_NESTED_ERROR(dctx);
 
 	/* ar spawn */
-	if ((slbt_spawn(ectx,true) < 0) && (ectx->pid < 0)) {
+	if (ret) {
+		(void)0;
+
+	} else if ((slbt_spawn(ectx,true) < 0) && (ectx->pid < 0)) {
 		return SLBT_SPAWN_ERROR(dctx);
 
 	} else if (ectx->exitcode) {
@@ -177,12 +492,22 @@ slbt_hidden int slbt_exec_link_create_archive(
 	}
 
 	/* input objects associated with .la archives */
-	for (parg=ectx->cargv; *parg; parg++)
-		if (slbt_adjust_wrapper_argument(
+	for (parg=ectx->cargv; *parg; parg++) {
+		if (!slbt_adjust_wrapper_argument(
 				*parg,true,
 				dctx->cctx->settings.arsuffix))
-			if (slbt_archive_is_convenience_library(fdcwd,*parg))
-				if (slbt_util_import_archive(ectx,output,*parg))
-					return SLBT_NESTED_ERROR(dctx);
+			continue;
+
+		if (!slbt_archive_is_convenience_library(fdcwd,*parg))
+			continue;
+
+		ret = fthin
+			? slbt_util_import_thin_archive(ectx,output,*parg)
+			: slbt_util_import_archive(ectx,output,*parg);
+
+		if (ret < 0)
+			return SLBT_NESTED_ERROR(dctx);
+	}
+
 	return 0;
 }
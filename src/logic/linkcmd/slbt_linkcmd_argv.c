@@ -16,6 +16,7 @@
 #include "slibtool_driver_impl.h"
 #include "slibtool_errinfo_impl.h"
 #include "slibtool_spawn_impl.h"
+#include "slibtool_launcher_impl.h"
 #include "slibtool_linkcmd_impl.h"
 #include "slibtool_mapfile_impl.h"
 #include "slibtool_metafile_impl.h"
@@ -54,6 +55,7 @@ static int slbt_emit_fdwrap_amend_dl_path(
 	int		cnt;
 	char		dlpathbuf[2048];
 	int		fdwrap;
+	int		fdlaunch;
 	const char *	fdwrap_fmt;
 	int		size;
 
@@ -98,6 +100,17 @@ static int slbt_emit_fdwrap_amend_dl_path(
 		}
 	}
 
+	if ((fdlaunch = slbt_exec_get_fdlauncher(ectx)) >= 0) {
+		if (slbt_dprintf(fdlaunch,"%s%s\n",SLBT_LAUNCHER_DLPATH,buf) < 0) {
+			return slbt_linkcmd_exit(
+				depsmeta,
+				SLBT_SYSTEM_ERROR(dctx,0));
+		}
+	}
+
+	if (buf != dlpathbuf)
+		free(buf);
+
 	return 0;
 }
 
@@ -208,6 +221,7 @@ slbt_hidden bool slbt_adjust_wrapper_argument(
 
 slbt_hidden int slbt_adjust_linker_argument(
 	const struct slbt_driver_ctx *	dctx,
+	struct slbt_exec_ctx *		ectx,
 	char *				arg,
 	char **				xarg,
 	bool				fpic,
@@ -231,12 +245,12 @@ slbt_hidden int slbt_adjust_linker_argument(
 	/* explicit .a input argument? */
 	if (!(strcmp(dot,arsuffix))) {
 		*xarg = arg;
-		return slbt_get_deps_meta(dctx,arg,1,depsmeta);
+		return slbt_get_deps_meta(dctx,ectx,arg,1,depsmeta);
 	}
 
 	/* explicit .so input argument? */
 	if (!(strcmp(dot,dsosuffix)))
-		return slbt_get_deps_meta(dctx,arg,1,depsmeta);
+		return slbt_get_deps_meta(dctx,ectx,arg,1,depsmeta);
 
 	/* not an .la library? */
 	if (strcmp(dot,".la"))
@@ -279,12 +293,12 @@ slbt_hidden int slbt_adjust_linker_argument(
 			sprintf(dot,"%s",arsuffix);
 		}
 
-		return slbt_get_deps_meta(dctx,arg,0,depsmeta);
+		return slbt_get_deps_meta(dctx,ectx,arg,0,depsmeta);
 	}
 
 	/* input archive */
 	sprintf(dot,"%s",arsuffix);
-	return slbt_get_deps_meta(dctx,arg,0,depsmeta);
+	return slbt_get_deps_meta(dctx,ectx,arg,0,depsmeta);
 }
 
 
@@ -309,12 +323,11 @@ slbt_hidden int slbt_exec_link_adjust_argument_vector(
 	char			arg[PATH_MAX];
 	char			lib[PATH_MAX];
 	char			depdir  [PATH_MAX];
-	char			rpathdir[PATH_MAX];
 	char			rpathlnk[PATH_MAX];
-	struct stat		st;
 	size_t			size;
 	size_t			dlen;
-	struct slbt_map_info *	mapinfo = 0;
+	struct slbt_deps_node *	depnode;
+	struct slbt_map_info	depsmap;
 	bool			fwholearchive = false;
 	int			ret;
 
@@ -340,7 +353,8 @@ slbt_hidden int slbt_exec_link_adjust_argument_vector(
 	size = depsmeta->infolen;
 
 	for (; *carg; ) {
-		dpath = 0;
+		dpath   = 0;
+		depnode = 0;
 
 		if (!strcmp(*carg,"-Wl,--whole-archive"))
 			fwholearchive = true;
@@ -385,6 +399,11 @@ slbt_hidden int slbt_exec_link_adjust_argument_vector(
 					*aarg++ = "-Wl,--whole-archive";
 			}
 
+			if (slbt_get_deps_node(dctx,ectx,*carg,&depnode) < 0)
+				return slbt_linkcmd_exit(
+					depsmeta,
+					SLBT_NESTED_ERROR(dctx));
+
 			dpath = lib;
 			sprintf(lib,"%s.slibtool.deps",*carg);
 			*aarg++ = *carg++;
@@ -405,19 +424,22 @@ slbt_hidden int slbt_exec_link_adjust_argument_vector(
 			*aarg++ = *carg++;
 		} else {
 			/* -rpath */
-			sprintf(rpathlnk,"%s.slibtool.rpath",*carg);
-
-			if (!fstatat(fdcwd,rpathlnk,&st,AT_SYMLINK_NOFOLLOW)) {
-				if (slbt_readlinkat(
-						fdcwd,
-						rpathlnk,
-						rpathdir,
-						sizeof(rpathdir)))
-					return slbt_linkcmd_exit(
-						depsmeta,
-						SLBT_SYSTEM_ERROR(dctx,rpathlnk));
+			if (slbt_get_deps_node(dctx,ectx,*carg,&depnode) < 0)
+				return slbt_linkcmd_exit(
+					depsmeta,
+					SLBT_NESTED_ERROR(dctx));
+
+			if (!depnode->rpath && (depnode->rpatherr != ENOENT)) {
+				sprintf(rpathlnk,"%s.slibtool.rpath",*carg);
+				errno = depnode->rpatherr;
 
-				sprintf(darg,"-Wl,%s",rpathdir);
+				return slbt_linkcmd_exit(
+					depsmeta,
+					SLBT_SYSTEM_ERROR(dctx,rpathlnk));
+			}
+
+			if (depnode->rpath) {
+				sprintf(darg,"-Wl,%s",depnode->rpath);
 				*aarg++ = "-Wl,-rpath";
 				*aarg++ = darg;
 				darg   += strlen(darg);
@@ -473,13 +495,19 @@ slbt_hidden int slbt_exec_link_adjust_argument_vector(
 			}
 		}
 
-		if (dpath && !fstatat(fdcwd,dpath,&st,0)) {
-			if (!(mapinfo = slbt_map_file(
-					fdcwd,dpath,
-					SLBT_MAP_INPUT)))
-				return slbt_linkcmd_exit(
-					depsmeta,
-					SLBT_SYSTEM_ERROR(dctx,dpath));
+		if (depnode && !depnode->deps && (depnode->depserr != ENOENT)) {
+			errno = depnode->depserr;
+
+			return slbt_linkcmd_exit(
+				depsmeta,
+				SLBT_SYSTEM_ERROR(dctx,dpath));
+		}
+
+		if (dpath && depnode->deps) {
+			depsmap.addr = depnode->deps;
+			depsmap.size = depnode->depssize;
+			depsmap.mark = depnode->deps;
+			depsmap.cap  = &depnode->deps[depnode->depssize];
 
 			if (!(strncmp(lib,".libs/",6))) {
 				*aarg++ = "-L.libs";
@@ -500,8 +528,8 @@ slbt_hidden int slbt_exec_link_adjust_argument_vector(
 				lib[1] = 0;
 			}
 
-			while (mapinfo->mark < mapinfo->cap) {
-				if (slbt_mapped_readline(dctx,mapinfo,darg,size))
+			while (depsmap.mark < depsmap.cap) {
+				if (slbt_mapped_readline(dctx,&depsmap,darg,size))
 					return slbt_linkcmd_exit(
 						depsmeta,
 						SLBT_NESTED_ERROR(dctx));
@@ -561,11 +589,6 @@ slbt_hidden int slbt_exec_link_adjust_argument_vector(
 				}
 			}
 		}
-
-		if (mapinfo) {
-			slbt_unmap_file(mapinfo);
-			mapinfo = 0;
-		}
 	}
 
 	if (dctx->cctx->drvflags & SLBT_DRIVER_EXPORT_DYNAMIC)
@@ -980,11 +1003,7 @@ slbt_hidden int slbt_exec_link_finalize_argument_vector(
 			return SLBT_NESTED_ERROR(dctx);
 
 		/* regenerate the dlsyms vtable source */
-		if (slbt_ar_create_dlsyms(
-				ictx->dlactxv,
-				ectx->dlunit,
-				ectx->dlopensrc,
-				0644) < 0)
+		if (slbt_exec_link_create_dlsyms_source(dctx,ectx) < 0)
 			return SLBT_NESTED_ERROR(dctx);
 	}
 
@@ -1098,22 +1117,11 @@ slbt_hidden int slbt_exec_link_finalize_argument_vector(
 
 		*dst++ = 0;
 
-		/* nested compile step */
-		program       = ectx->program;
-		ectx->argv    = dlargv;
-		ectx->program = dlargv[0];
-
-		if (!(dctx->cctx->drvflags & SLBT_DRIVER_SILENT))
-			if (slbt_output_compile(ectx))
-				return SLBT_NESTED_ERROR(dctx);
+		/* nested compile step, unless the object is current */
+		program = ectx->program;
 
-		if ((slbt_spawn(ectx,true) < 0) && (ectx->pid < 0))
-			return SLBT_SYSTEM_ERROR(dctx,0);
-
-		if (ectx->exitcode)
-			return SLBT_CUSTOM_ERROR(
-				dctx,
-				SLBT_ERR_COMPILE_ERROR);
+		if (slbt_exec_link_compile_dlsyms_object(dctx,ectx,dlargv) < 0)
+			return SLBT_NESTED_ERROR(dctx);
 
 		ectx->argv    = base;
 		ectx->program = program;
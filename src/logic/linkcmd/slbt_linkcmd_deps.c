@@ -9,6 +9,7 @@
 #include <string.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <unistd.h>
 #include <sys/stat.h>
 
 #include <slibtool/slibtool.h>
@@ -17,72 +18,215 @@
 #include "slibtool_linkcmd_impl.h"
 #include "slibtool_mapfile_impl.h"
 #include "slibtool_metafile_impl.h"
+#include "slibtool_readlink_impl.h"
 #include "slibtool_realpath_impl.h"
 #include "slibtool_snprintf_impl.h"
 #include "slibtool_visibility_impl.h"
 
-slbt_hidden int slbt_get_deps_meta(
+/* every .slibtool.deps and .slibtool.rpath file that a link invocation  */
+/* refers to is read once, and then shared by the dependency file logic, */
+/* the size estimate of the alternate argument vector, and the vector    */
+/* itself; nodes are keyed by path, and deduplicated by device & inode. */
+static int slbt_load_deps_node(
 	const struct slbt_driver_ctx *	dctx,
-	char *				libfilename,
-	int				fexternal,
-	struct slbt_deps_meta *		depsmeta)
+	struct slbt_deps_node *		nodes,
+	struct slbt_deps_node *		node)
 {
+	int			fd;
 	int			fdcwd;
 	char *			ch;
 	char *			cap;
-	char *			base;
-	size_t			libexlen;
+	char *			dot;
+	ssize_t			nread;
+	size_t			nleft;
 	struct stat		st;
-	struct slbt_map_info *	mapinfo;
-	char			depfile[PATH_MAX];
+	struct slbt_deps_node *	dup;
+	char			rpathlnk[PATH_MAX];
+	char			rpathbuf[PATH_MAX];
 
 	/* fdcwd */
 	fdcwd = slbt_driver_fdcwd(dctx);
 
-	/* -rpath */
+	/* .rpath */
+	strcpy(rpathlnk,node->path);
+	dot = strrchr(rpathlnk,'.');
+	strcpy(dot,".rpath");
+
+	if (slbt_readlinkat(fdcwd,rpathlnk,rpathbuf,sizeof(rpathbuf)) < 0) {
+		node->rpatherr = errno;
+
+	} else if (!(node->rpath = strdup(rpathbuf))) {
+		return SLBT_SYSTEM_ERROR(dctx,0);
+	}
+
+	/* .deps */
+	if ((fd = openat(fdcwd,node->path,O_RDONLY|O_CLOEXEC,0)) < 0) {
+		node->depserr = errno;
+		return 0;
+	}
+
+	if (fstat(fd,&st) < 0) {
+		node->depserr = errno;
+		close(fd);
+		return 0;
+	}
+
+	node->dev = st.st_dev;
+	node->ino = st.st_ino;
+
+	/* same file, different path? */
+	for (dup=nodes; dup; dup=dup->next) {
+		if (dup->deps && (dup->dev == st.st_dev) && (dup->ino == st.st_ino)) {
+			node->deps     = dup->deps;
+			node->depssize = dup->depssize;
+			node->depscnt  = dup->depscnt;
+			close(fd);
+			return 0;
+		}
+	}
+
+	if (!(node->depsbuf = malloc(st.st_size + 1))) {
+		close(fd);
+		return SLBT_SYSTEM_ERROR(dctx,0);
+	}
+
+	ch    = node->depsbuf;
+	nleft = st.st_size;
+
+	for (; nleft; ) {
+		if ((nread = read(fd,ch,nleft)) < 0) {
+			if (errno == EINTR)
+				continue;
+
+			close(fd);
+			return SLBT_SYSTEM_ERROR(dctx,node->path);
+		}
+
+		ch    += nread;
+		nleft  = nread ? nleft - nread : 0;
+	}
+
+	close(fd);
+
+	node->deps     = node->depsbuf;
+	node->depssize = ch - node->depsbuf;
+
+	/* line count */
+	cap = &node->deps[node->depssize];
+
+	for (ch=node->deps; (ch = memchr(ch,'\n',cap-ch)); ch++)
+		node->depscnt++;
+
+	return 0;
+}
+
+
+slbt_hidden int slbt_get_deps_node(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_exec_ctx *		ectx,
+	const char *			libfilename,
+	struct slbt_deps_node **	pnode)
+{
+	struct slbt_exec_ctx_impl *	ictx;
+	struct slbt_deps_node *		node;
+	char				depfile[PATH_MAX];
+
+	/* .deps */
 	if (slbt_snprintf(depfile,sizeof(depfile),
-				"%s.slibtool.rpath",
+				"%s.slibtool.deps",
 				libfilename) < 0)
 		return SLBT_BUFFER_ERROR(dctx);
 
+	/* already loaded? */
+	ictx = slbt_get_exec_ictx(ectx);
+
+	for (node=ictx->depnodes; node; node=node->next) {
+		if (!strcmp(node->path,depfile)) {
+			*pnode = node;
+			return 0;
+		}
+	}
+
+	/* new node */
+	if (!(node = calloc(1,sizeof(*node))))
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	if (!(node->path = strdup(depfile))) {
+		free(node);
+		return SLBT_SYSTEM_ERROR(dctx,0);
+	}
+
+	if (slbt_load_deps_node(dctx,ictx->depnodes,node) < 0) {
+		slbt_free_deps_nodes(node);
+		return SLBT_NESTED_ERROR(dctx);
+	}
+
+	node->next     = ictx->depnodes;
+	ictx->depnodes = node;
+
+	*pnode = node;
+
+	return 0;
+}
+
+
+slbt_hidden void slbt_free_deps_nodes(struct slbt_deps_node * nodes)
+{
+	struct slbt_deps_node * node;
+	struct slbt_deps_node * next;
+
+	for (node=nodes; node; node=next) {
+		next = node->next;
+
+		free(node->depsbuf);
+		free(node->rpath);
+		free(node->path);
+		free(node);
+	}
+}
+
+
+slbt_hidden int slbt_get_deps_meta(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_exec_ctx *		ectx,
+	char *				libfilename,
+	int				fexternal,
+	struct slbt_deps_meta *		depsmeta)
+{
+	char *			base;
+	size_t			libexlen;
+	struct slbt_deps_node *	node;
+
+	/* node */
+	if (slbt_get_deps_node(dctx,ectx,libfilename,&node) < 0)
+		return SLBT_NESTED_ERROR(dctx);
+
 	/* -Wl,%s */
-	if (!fstatat(fdcwd,depfile,&st,AT_SYMLINK_NOFOLLOW)) {
-		depsmeta->infolen += st.st_size + 4;
+	if (node->rpath) {
+		depsmeta->infolen += strlen(node->rpath) + 4;
 		depsmeta->infolen++;
 	}
 
 	/* .deps */
-	if (slbt_snprintf(depfile,sizeof(depfile),
-				"%s.slibtool.deps",
-				libfilename) < 0)
-		return SLBT_BUFFER_ERROR(dctx);
+	if (!node->deps) {
+		errno = node->depserr;
 
-	/* mapinfo */
-	if (!(mapinfo = slbt_map_file(fdcwd,depfile,SLBT_MAP_INPUT)))
 		return (fexternal && (errno == ENOENT))
-			? 0 : SLBT_SYSTEM_ERROR(dctx,depfile);
+			? 0 : SLBT_SYSTEM_ERROR(dctx,node->path);
+	}
 
 	/* copied length */
-	depsmeta->infolen += mapinfo->size;
+	depsmeta->infolen += node->depssize;
 	depsmeta->infolen++;
 
 	/* libexlen */
 	libexlen = (base = strrchr(libfilename,'/'))
-		? strlen(depfile) + 2 + (base - libfilename)
-		: strlen(depfile) + 2;
-
-	/* iterate */
-	ch  = mapinfo->addr;
-	cap = mapinfo->cap;
-
-	for (; ch<cap; ) {
-		if (*ch++ == '\n') {
-			depsmeta->infolen += libexlen;
-			depsmeta->depscnt++;
-		}
-	}
+		? strlen(node->path) + 2 + (base - libfilename)
+		: strlen(node->path) + 2;
 
-	slbt_unmap_file(mapinfo);
+	/* lines */
+	depsmeta->infolen += libexlen * node->depscnt;
+	depsmeta->depscnt += node->depscnt;
 
 	return 0;
 }
@@ -413,7 +557,8 @@ slbt_hidden int slbt_exec_link_create_dep_file(
 	int			ldepth;
 	int			fardep;
 	int			fdyndep;
-	struct slbt_map_info *  mapinfo;
+	struct slbt_deps_node * depnode;
+	struct slbt_map_info    depsmap;
 	bool			is_reladir;
 
 	/* fdcwd */
@@ -502,7 +647,6 @@ slbt_hidden int slbt_exec_link_create_dep_file(
 		popt    = 0;
 		plib    = 0;
 		path    = 0;
-		mapinfo = 0;
 
 		if (!strncmp(*parg,"-l",2)) {
 			if (fdep) {
@@ -677,45 +821,50 @@ slbt_hidden int slbt_exec_link_create_dep_file(
 				return SLBT_BUFFER_ERROR(dctx);
 			}
 
-			mapinfo = 0;
+			depnode = 0;
 
 			mark = strrchr(mark,'.');
 			size = sizeof(depfile) - (mark - depfile);
 
 			if (!fardep) {
 				slen = slbt_snprintf(mark,size,
-					"%s.slibtool.deps",
-					dctx->cctx->settings.dsosuffix);
+					"%s",dctx->cctx->settings.dsosuffix);
 
 				if (slen < 0) {
 					close(deps);
 					return SLBT_BUFFER_ERROR(dctx);
 				}
 
-				mapinfo = slbt_map_file(
-					fdcwd,depfile,
-					SLBT_MAP_INPUT);
+				if (slbt_get_deps_node(dctx,ectx,depfile,&depnode) < 0) {
+					close(deps);
+					return SLBT_NESTED_ERROR(dctx);
+				}
 
-				if (!mapinfo && (errno != ENOENT)) {
+				if (!depnode->deps && (depnode->depserr != ENOENT)) {
 					close(deps);
+					errno = depnode->depserr;
 					return SLBT_SYSTEM_ERROR(dctx,0);
 				}
+
+				if (!depnode->deps)
+					depnode = 0;
 			}
 
-			if (!mapinfo) {
-				slen = slbt_snprintf(mark,size,
-					".a.slibtool.deps");
+			if (!depnode) {
+				slen = slbt_snprintf(mark,size,".a");
 
 				if (slen < 0) {
 					close(deps);
 					return SLBT_BUFFER_ERROR(dctx);
 				}
 
-				mapinfo = slbt_map_file(
-					fdcwd,depfile,
-					SLBT_MAP_INPUT);
+				if (slbt_get_deps_node(dctx,ectx,depfile,&depnode) < 0) {
+					close(deps);
+					return SLBT_NESTED_ERROR(dctx);
+				}
 
-				if (!mapinfo) {
+				if (!depnode->deps) {
+					depnode = 0;
 					strcpy(mark,".a.disabled");
 
 					if (fstatat(fdcwd,depfile,&st,AT_SYMLINK_NOFOLLOW)) {
@@ -725,10 +874,17 @@ slbt_hidden int slbt_exec_link_create_dep_file(
 				}
 			}
 
+			if (depnode) {
+				depsmap.addr = depnode->deps;
+				depsmap.size = depnode->depssize;
+				depsmap.mark = depnode->deps;
+				depsmap.cap  = &depnode->deps[depnode->depssize];
+			}
+
 			/* [-l... as needed] */
-			while (mapinfo && (mapinfo->mark < mapinfo->cap)) {
+			while (depnode && (depsmap.mark < depsmap.cap)) {
 				ret = slbt_mapped_readline(
-					dctx,mapinfo,
+					dctx,&depsmap,
 					deplib,sizeof(deplib));
 
 				if (ret) {
@@ -757,9 +913,6 @@ slbt_hidden int slbt_exec_link_create_dep_file(
 					return SLBT_SYSTEM_ERROR(dctx,0);
 				}
 			}
-
-			if (mapinfo)
-				slbt_unmap_file(mapinfo);
 		}
 
 		if (plib && (slbt_dprintf(deps,"-l%s\n",plib) < 0)) {
@@ -0,0 +1,255 @@
+/*******************************************************************/
+/*  slibtool: a strong libtool implementation, written in C        */
+/*  Copyright (C) 2016--2024  SysDeer Technologies, LLC            */
+/*  Released under the Standard MIT License; see COPYING.SLIBTOOL. */
+/*******************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/stat.h>
+
+#include <slibtool/slibtool.h>
+#include "slibtool_driver_impl.h"
+#include "slibtool_errinfo_impl.h"
+#include "slibtool_spawn_impl.h"
+#include "slibtool_linkcmd_impl.h"
+#include "slibtool_objcache_impl.h"
+#include "slibtool_realpath_impl.h"
+#include "slibtool_sha256_impl.h"
+#include "slibtool_snprintf_impl.h"
+#include "slibtool_visibility_impl.h"
+#include "slibtool_ar_impl.h"
+
+#define SLBT_DLSYMS_KEY_SUFFIX		".key"
+#define SLBT_DLSYMS_OBJ_SIGNATURE	"slibtool dlsyms object, version 1"
+
+/* the key file next to the vtable object records the digest of the */
+/* vtable source (line 1) and that of the object compiled from it,  */
+/* which also covers the compiler and its arguments (line 2).       */
+struct slbt_dlsyms_key {
+	char	srcdigest[SLBT_SHA256_HEXDIGEST_SIZE];
+	char	objdigest[SLBT_SHA256_HEXDIGEST_SIZE];
+};
+
+static int slbt_exec_link_dlsyms_key_name(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_exec_ctx *		ectx,
+	char				(*keyname)[PATH_MAX])
+{
+	if (slbt_snprintf(*keyname,sizeof(*keyname),
+			"%s%s",ectx->dlopenobj,
+			SLBT_DLSYMS_KEY_SUFFIX) < 0)
+		return SLBT_BUFFER_ERROR(dctx);
+
+	return 0;
+}
+
+static void slbt_exec_link_read_dlsyms_key(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_exec_ctx *		ectx,
+	struct slbt_dlsyms_key *	key)
+{
+	int	fd;
+	ssize_t	nread;
+	size_t	hexlen;
+	char	keyname[PATH_MAX];
+	char	buf[2*SLBT_SHA256_HEXDIGEST_SIZE + 1];
+
+	key->srcdigest[0] = '\0';
+	key->objdigest[0] = '\0';
+
+	if (slbt_exec_link_dlsyms_key_name(dctx,ectx,&keyname) < 0)
+		return;
+
+	if ((fd = openat(slbt_driver_fdcwd(dctx),keyname,O_RDONLY,0)) < 0)
+		return;
+
+	nread = read(fd,buf,sizeof(buf));
+	close(fd);
+
+	/* <srcdigest>\n<objdigest>\n */
+	hexlen = SLBT_SHA256_HEXDIGEST_SIZE - 1;
+
+	if (nread != 2*SLBT_SHA256_HEXDIGEST_SIZE)
+		return;
+
+	if ((buf[hexlen] != '\n') || (buf[2*hexlen+1] != '\n'))
+		return;
+
+	memcpy(key->srcdigest,buf,hexlen);
+	memcpy(key->objdigest,&buf[hexlen+1],hexlen);
+
+	key->srcdigest[hexlen] = '\0';
+	key->objdigest[hexlen] = '\0';
+}
+
+static int slbt_exec_link_write_dlsyms_key(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_exec_ctx *		ectx,
+	const struct slbt_dlsyms_key *	key)
+{
+	int	fd;
+	int	ret;
+	char	keyname[PATH_MAX];
+
+	if (slbt_exec_link_dlsyms_key_name(dctx,ectx,&keyname) < 0)
+		return SLBT_NESTED_ERROR(dctx);
+
+	if ((fd = openat(
+			slbt_driver_fdcwd(dctx),keyname,
+			O_WRONLY|O_CREAT|O_TRUNC,0644)) < 0)
+		return SLBT_SYSTEM_ERROR(dctx,keyname);
+
+	ret = slbt_dprintf(fd,"%s\n%s\n",key->srcdigest,key->objdigest);
+
+	close(fd);
+
+	return (ret < 0) ? SLBT_SYSTEM_ERROR(dctx,keyname) : 0;
+}
+
+static int slbt_exec_link_remove_dlsyms_key(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_exec_ctx *		ectx)
+{
+	char	keyname[PATH_MAX];
+
+	if (slbt_exec_link_dlsyms_key_name(dctx,ectx,&keyname) < 0)
+		return SLBT_NESTED_ERROR(dctx);
+
+	if (unlinkat(slbt_driver_fdcwd(dctx),keyname,0) < 0)
+		if (errno != ENOENT)
+			return SLBT_SYSTEM_ERROR(dctx,keyname);
+
+	return 0;
+}
+
+static bool slbt_exec_link_dlsyms_file_exists(
+	const struct slbt_driver_ctx *	dctx,
+	const char *			path)
+{
+	return !faccessat(slbt_driver_fdcwd(dctx),path,F_OK,0);
+}
+
+slbt_hidden int slbt_exec_link_create_dlsyms_source(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_exec_ctx *		ectx)
+{
+	struct slbt_exec_ctx_impl *	ictx;
+	struct slbt_dlsyms_key		key;
+
+	ictx = slbt_get_exec_ictx(ectx);
+
+	if (slbt_ar_get_dlsyms_digest(
+			ictx->dlactxv,ectx->dlunit,
+			&ictx->dlsymsdigest) < 0)
+		return SLBT_NESTED_ERROR(dctx);
+
+	/* same symbols, dlunit, and generator as in the previous link? */
+	slbt_exec_link_read_dlsyms_key(dctx,ectx,&key);
+
+	if (!strcmp(key.srcdigest,ictx->dlsymsdigest))
+		if (slbt_exec_link_dlsyms_file_exists(dctx,ectx->dlopensrc))
+			return 0;
+
+	if (slbt_ar_create_dlsyms(
+			ictx->dlactxv,
+			ectx->dlunit,
+			ectx->dlopensrc,
+			0644) < 0)
+		return SLBT_NESTED_ERROR(dctx);
+
+	return 0;
+}
+
+static int slbt_exec_link_get_dlsyms_objdigest(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_exec_ctx *		ectx,
+	char **				dlargv,
+	char				(*digest)[SLBT_SHA256_HEXDIGEST_SIZE])
+{
+	char **				parg;
+	struct slbt_exec_ctx_impl *	ictx;
+	struct slbt_sha256_ctx		sha;
+	char				cwd[PATH_MAX];
+
+	ictx = slbt_get_exec_ictx(ectx);
+
+	/* vtable source, compiler identity, compilation directory, argv */
+	slbt_sha256_init(&sha);
+	slbt_sha256_update(&sha,SLBT_DLSYMS_OBJ_SIGNATURE,sizeof(SLBT_DLSYMS_OBJ_SIGNATURE));
+	slbt_sha256_update(&sha,ictx->dlsymsdigest,sizeof(ictx->dlsymsdigest));
+
+	if (slbt_objcache_hash_program(dctx,&sha,dlargv[0]) < 0)
+		return -1;
+
+	if (slbt_realpath(slbt_driver_fdcwd(dctx),".",0,cwd,sizeof(cwd)) < 0)
+		return -1;
+
+	slbt_sha256_update(&sha,cwd,strlen(cwd)+1);
+
+	for (parg=dlargv; *parg; parg++)
+		slbt_sha256_update(&sha,*parg,strlen(*parg)+1);
+
+	slbt_sha256_hexdigest(&sha,*digest);
+
+	return 0;
+}
+
+slbt_hidden int slbt_exec_link_compile_dlsyms_object(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_exec_ctx *		ectx,
+	char **				dlargv)
+{
+	bool				fkey;
+	struct slbt_exec_ctx_impl *	ictx;
+	struct slbt_dlsyms_key		key;
+	struct slbt_dlsyms_key		prev;
+
+	ictx = slbt_get_exec_ictx(ectx);
+
+	/* vtable object from a previous link still current? */
+	fkey = ictx->dlsymsdigest[0] && !slbt_exec_link_get_dlsyms_objdigest(
+		dctx,ectx,dlargv,&key.objdigest);
+
+	if (fkey) {
+		slbt_exec_link_read_dlsyms_key(dctx,ectx,&prev);
+
+		if (!strcmp(prev.srcdigest,ictx->dlsymsdigest))
+			if (!strcmp(prev.objdigest,key.objdigest))
+				if (slbt_exec_link_dlsyms_file_exists(dctx,ectx->dlopenobj))
+					return 0;
+	}
+
+	/* a failed compilation must not leave a matching key behind */
+	if (slbt_exec_link_remove_dlsyms_key(dctx,ectx) < 0)
+		return SLBT_NESTED_ERROR(dctx);
+
+	/* nested compile step (the caller restores argv and program) */
+	ectx->argv    = dlargv;
+	ectx->program = dlargv[0];
+
+	if (!(dctx->cctx->drvflags & SLBT_DRIVER_SILENT))
+		if (slbt_output_compile(ectx))
+			return SLBT_NESTED_ERROR(dctx);
+
+	if ((slbt_spawn(ectx,true) < 0) && (ectx->pid < 0))
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	if (ectx->exitcode)
+		return SLBT_CUSTOM_ERROR(
+			dctx,
+			SLBT_ERR_COMPILE_ERROR);
+
+	/* record the key */
+	if (!fkey || (dctx->cctx->drvflags & SLBT_DRIVER_DRY_RUN))
+		return 0;
+
+	memcpy(key.srcdigest,ictx->dlsymsdigest,sizeof(key.srcdigest));
+
+	return slbt_exec_link_write_dlsyms_key(dctx,ectx,&key);
+}
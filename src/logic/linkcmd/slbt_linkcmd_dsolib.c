@@ -133,7 +133,7 @@ slbt_hidden int slbt_exec_link_create_library(
 	/* linker argument adjustment */
 	for (parg=ectx->cargv, xarg=ectx->xargv; *parg; parg++, xarg++)
 		if (slbt_adjust_linker_argument(
-				dctx,
+				dctx,ectx,
 				*parg,xarg,true,
 				dctx->cctx->settings.dsosuffix,
 				dctx->cctx->settings.arsuffix,
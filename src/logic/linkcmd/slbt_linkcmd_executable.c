@@ -14,6 +14,7 @@
 #include <slibtool/slibtool.h>
 #include "slibtool_driver_impl.h"
 #include "slibtool_errinfo_impl.h"
+#include "slibtool_launcher_impl.h"
 #include "slibtool_linkcmd_impl.h"
 #include "slibtool_mapfile_impl.h"
 #include "slibtool_metafile_impl.h"
@@ -75,6 +76,7 @@ slbt_hidden int slbt_exec_link_create_executable(
 {
 	int	fdcwd;
 	int	fdwrap;
+	int	fdlaunch;
 	char ** parg;
 	char ** xarg;
 	char *	base;
@@ -84,6 +86,8 @@ slbt_hidden int slbt_exec_link_create_executable(
 	char	output [PATH_MAX];
 	char	wrapper[PATH_MAX];
 	char	wraplnk[PATH_MAX];
+	char	launcher[PATH_MAX];
+	char	lnchtmp[PATH_MAX];
 	bool	fabspath;
 	bool	fpic;
 	const struct slbt_source_version * verinfo;
@@ -110,7 +114,7 @@ slbt_hidden int slbt_exec_link_create_executable(
 	/* linker argument adjustment */
 	for (parg=ectx->cargv, xarg=ectx->xargv; *parg; parg++, xarg++)
 		if (slbt_adjust_linker_argument(
-				dctx,
+				dctx,ectx,
 				*parg,xarg,fpic,
 				dctx->cctx->settings.dsosuffix,
 				dctx->cctx->settings.arsuffix,
@@ -169,6 +173,37 @@ slbt_hidden int slbt_exec_link_create_executable(
 			dpfixup) < 0)
 		return SLBT_SYSTEM_ERROR(dctx,0);
 
+	/* launcher: same content, for use by slbt_exec_execute() */
+	if (slbt_snprintf(launcher,sizeof(launcher),
+				"%s%s",exefilename,
+				SLBT_LAUNCHER_SUFFIX) < 0)
+		return SLBT_BUFFER_ERROR(dctx);
+
+	if (slbt_snprintf(lnchtmp,sizeof(lnchtmp),
+				"%s.tmp",launcher) < 0)
+		return SLBT_BUFFER_ERROR(dctx);
+
+	if ((fdlaunch = openat(fdcwd,lnchtmp,O_RDWR|O_CREAT|O_TRUNC,0644)) < 0)
+		return SLBT_SYSTEM_ERROR(dctx,lnchtmp);
+
+	slbt_exec_set_fdlauncher(ectx,fdlaunch);
+
+	fabspath = (exefilename[0] == '/');
+
+	if (slbt_dprintf(fdlaunch,
+			"%s\n"
+			"%s%s\n"
+			"%s%s\n"
+			"%s%s%s%s\n",
+			SLBT_LAUNCHER_SIGNATURE,
+			SLBT_LAUNCHER_ENV,dctx->cctx->settings.ldpathenv,
+			SLBT_LAUNCHER_CWD,cwd,
+			SLBT_LAUNCHER_EXE,
+			fabspath ? "" : cwd,
+			fabspath ? "" : "/",
+			exefilename) < 0)
+		return SLBT_SYSTEM_ERROR(dctx,lnchtmp);
+
 	/* output */
 	if (slbt_snprintf(output,sizeof(output),
 			"%s",exefilename) < 0)
@@ -204,8 +239,6 @@ slbt_hidden int slbt_exec_link_create_executable(
 	base++;
 
 	/* executable wrapper: footer */
-	fabspath = (exefilename[0] == '/');
-
 	if (slbt_dprintf(fdwrap,
 			"DL_PATH=\"${DL_PATH}${LCOLON}${%s}\"\n\n"
 			"export %s=\"$DL_PATH\"\n\n"
@@ -248,6 +281,14 @@ slbt_hidden int slbt_exec_link_create_executable(
 				SLBT_ERR_LINK_ERROR));
 	}
 
+	/* launcher: finalize */
+	slbt_exec_close_fdlauncher(ectx);
+
+	if (renameat(fdcwd,lnchtmp,fdcwd,launcher))
+		return slbt_linkcmd_exit(
+			&depsmeta,
+			SLBT_SYSTEM_ERROR(dctx,launcher));
+
 	/* executable wrapper: finalize */
 	slbt_exec_close_fdwrapper(ectx);
 
@@ -12,6 +12,7 @@
 #include <sys/stat.h>
 
 #include <slibtool/slibtool.h>
+#include "slibtool_ar_impl.h"
 #include "slibtool_driver_impl.h"
 #include "slibtool_errinfo_impl.h"
 #include "slibtool_linkcmd_impl.h"
@@ -143,6 +144,14 @@ slbt_hidden int slbt_exec_link_create_import_library(
 		if (slbt_output_link(ectx))
 			return SLBT_NESTED_ERROR(dctx);
 
+	/* legacy import library: write it ourselves unless told otherwise */
+	if (!fmdso && !(dctx->cctx->drvflags & SLBT_DRIVER_IMPLIB_DLLTOOL))
+		if (slbt_ar_implib_supported(dctx))
+			return slbt_ar_create_implib(
+				dctx,deffilename,soname,
+				impfilename,0644)
+				? SLBT_NESTED_ERROR(dctx) : 0;
+
 	/* dlltool/mdso spawn */
 	if ((slbt_spawn(ectx,true) < 0) && (ectx->pid < 0)) {
 		return SLBT_SPAWN_ERROR(dctx);
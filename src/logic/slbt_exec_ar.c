@@ -4,11 +4,19 @@
 /*  Released under the Standard MIT License; see COPYING.SLIBTOOL. */
 /*******************************************************************/
 
+#include <stdlib.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <errno.h>
+#include <pthread.h>
+
 #include <slibtool/slibtool.h>
 #include <slibtool/slibtool_output.h>
 #include "slibtool_driver_impl.h"
 #include "slibtool_ar_impl.h"
+#include "slibtool_dprintf_impl.h"
 #include "slibtool_errinfo_impl.h"
+#include "slibtool_tmpfile_impl.h"
 #include "argv/argv.h"
 
 #define SLBT_DRIVER_MODE_AR_ACTIONS     (SLBT_DRIVER_MODE_AR_CHECK \
@@ -73,58 +81,313 @@ static int slbt_exec_ar_fail(
 	return ret;
 }
 
-static int slbt_exec_ar_perform_archive_actions(
+/*****************************************************************/
+/* -Wjobs: archive contexts are created, and the output of each  */
+/* archive is generated, by a pool of worker threads. every      */
+/* worker writes to a private temporary file and records the     */
+/* extent of each archive's output; once all workers are done,   */
+/* the recorded output is replayed in command-line order.        */
+/*****************************************************************/
+
+struct slbt_ar_job {
+	const char *                    unit;
+	struct slbt_archive_ctx **      parctx;
+	int                             fdbuf;
+	off_t                           offset;
+	off_t                           size;
+	int                             status;
+};
+
+struct slbt_ar_pool {
+	const struct slbt_driver_ctx *  dctx;
+	struct slbt_ar_job *            jobv;
+	size_t                          njobs;
+	size_t                          next;
+	bool                            farname;
+	bool                            fabort;
+	pthread_mutex_t                 lock;
+};
+
+struct slbt_ar_worker {
+	struct slbt_ar_pool *           pool;
+	pthread_t                       tid;
+	int                             fdbuf;
+	bool                            fthread;
+};
+
+static bool slbt_exec_ar_farname(
 	const struct slbt_driver_ctx *  dctx,
-	struct slbt_archive_ctx **      arctxv)
+	size_t                          nunits)
 {
-	struct slbt_archive_ctx **      arctxp;
-	struct slbt_archive_ctx *       arctx;
-	bool                            farname;
-
 	switch (dctx->cctx->fmtflags & SLBT_PRETTY_FLAGS) {
 		case SLBT_PRETTY_POSIX:
-			farname = (arctxv[0] && arctxv[1]);
-			break;
+			return (nunits > 1);
 
 		default:
-			farname = true;
-			break;
+			return true;
 	}
+}
 
-	for (arctxp=arctxv; *arctxp; arctxp++) {
-		if (dctx->cctx->fmtflags & SLBT_DRIVER_MODE_AR_OUTPUTS)
-			if (farname && (slbt_au_output_arname(*arctxp) < 0))
-				return SLBT_NESTED_ERROR(dctx);
+static int slbt_exec_ar_output_archive(
+	const struct slbt_driver_ctx *  dctx,
+	struct slbt_archive_ctx *       arctx,
+	bool                            farname,
+	int                             fdout)
+{
+	if (dctx->cctx->fmtflags & SLBT_DRIVER_MODE_AR_OUTPUTS)
+		if (farname && (slbt_au_output_arname_fdout(arctx,fdout) < 0))
+			return SLBT_NESTED_ERROR(dctx);
 
-		if (dctx->cctx->fmtflags & SLBT_OUTPUT_ARCHIVE_MEMBERS)
-			if (slbt_au_output_members((*arctxp)->meta) < 0)
-				return SLBT_NESTED_ERROR(dctx);
+	if (dctx->cctx->fmtflags & SLBT_OUTPUT_ARCHIVE_MEMBERS)
+		if (slbt_au_output_members_fdout(arctx->meta,fdout) < 0)
+			return SLBT_NESTED_ERROR(dctx);
 
-		if (dctx->cctx->fmtflags & SLBT_OUTPUT_ARCHIVE_SYMBOLS)
-			if (slbt_au_output_symbols((*arctxp)->meta) < 0)
-				return SLBT_NESTED_ERROR(dctx);
+	if (dctx->cctx->fmtflags & SLBT_OUTPUT_ARCHIVE_SYMBOLS)
+		if (slbt_au_output_symbols_fdout(arctx->meta,fdout) < 0)
+			return SLBT_NESTED_ERROR(dctx);
 
-		if (dctx->cctx->fmtflags & SLBT_OUTPUT_ARCHIVE_MAPFILE)
-			if (slbt_au_output_mapfile((*arctxp)->meta) < 0)
-				return SLBT_NESTED_ERROR(dctx);
-	}
+	if (dctx->cctx->fmtflags & SLBT_OUTPUT_ARCHIVE_MAPFILE)
+		if (slbt_au_output_mapfile_fdout(arctx->meta,fdout) < 0)
+			return SLBT_NESTED_ERROR(dctx);
+
+	return 0;
+}
+
+static int slbt_exec_ar_perform_collective_actions(
+	const struct slbt_driver_ctx *  dctx,
+	struct slbt_archive_ctx **      arctxv)
+{
+	int                             ret;
+	struct slbt_archive_ctx *       arctx;
 
 	if (dctx->cctx->fmtflags & SLBT_OUTPUT_ARCHIVE_DLSYMS)
 		if (slbt_au_output_dlsyms(arctxv,dctx->cctx->dlunit) < 0)
 			return SLBT_NESTED_ERROR(dctx);
 
 	if (dctx->cctx->drvflags & SLBT_DRIVER_MODE_AR_MERGE) {
-		if (slbt_ar_merge_archives(arctxv,&arctx) < 0)
+		if (dctx->cctx->drvflags & SLBT_DRIVER_THIN_ARCHIVE) {
+			if (slbt_ar_merge_thin(arctxv,dctx->cctx->output,&arctx) < 0)
+				return SLBT_NESTED_ERROR(dctx);
+
+		} else if (slbt_ar_merge_archives(arctxv,&arctx) < 0) {
 			return SLBT_NESTED_ERROR(dctx);
+		}
 
 		/* (defer mode to umask) */
-		if (slbt_ar_store_archive(arctx,dctx->cctx->output,0666) < 0)
+		ret = slbt_ar_store_archive(arctx,dctx->cctx->output,0666);
+
+		slbt_ar_free_archive_ctx(arctx);
+
+		if (ret < 0)
 			return SLBT_NESTED_ERROR(dctx);
 	}
 
 	return 0;
 }
 
+static int slbt_exec_ar_perform_archive_actions(
+	const struct slbt_driver_ctx *  dctx,
+	struct slbt_archive_ctx **      arctxv)
+{
+	struct slbt_archive_ctx **      arctxp;
+	bool                            farname;
+	int                             fdout;
+
+	farname = slbt_exec_ar_farname(dctx,(arctxv[0] && arctxv[1]) ? 2 : 1);
+	fdout   = slbt_driver_fdout(dctx);
+
+	for (arctxp=arctxv; *arctxp; arctxp++)
+		if (slbt_exec_ar_output_archive(dctx,*arctxp,farname,fdout) < 0)
+			return SLBT_NESTED_ERROR(dctx);
+
+	return slbt_exec_ar_perform_collective_actions(dctx,arctxv);
+}
+
+static long slbt_exec_ar_get_jobs(
+	const struct slbt_driver_ctx *  dctx,
+	const char *                    jobs)
+{
+	long    njobs;
+	char *  mark;
+
+	if (jobs && *jobs) {
+		njobs = strtol(jobs,&mark,10);
+
+		if ((njobs <= 0) || *mark) {
+			if (dctx->cctx->drvflags & SLBT_DRIVER_VERBOSITY_ERRORS)
+				slbt_dprintf(
+					slbt_driver_fderr(dctx),
+					"%s: error: invalid -Wjobs argument: %s.\n",
+					dctx->program,jobs);
+			return -1;
+		}
+
+		return njobs;
+	}
+
+	if ((njobs = sysconf(_SC_NPROCESSORS_ONLN)) <= 0)
+		njobs = 1;
+
+	return njobs;
+}
+
+static void * slbt_exec_ar_worker(void * arg)
+{
+	struct slbt_ar_worker *         worker;
+	struct slbt_ar_pool *           pool;
+	struct slbt_ar_job *            job;
+	const struct slbt_driver_ctx *  dctx;
+
+	worker = arg;
+	pool   = worker->pool;
+	dctx   = pool->dctx;
+
+	for (;;) {
+		pthread_mutex_lock(&pool->lock);
+
+		job = (pool->fabort || (pool->next == pool->njobs))
+			? 0 : &pool->jobv[pool->next++];
+
+		pthread_mutex_unlock(&pool->lock);
+
+		if (!job)
+			return 0;
+
+		/* any failure to open an archive suppresses all output */
+		if (slbt_ar_get_archive_ctx(dctx,job->unit,job->parctx) < 0) {
+			job->status = -1;
+
+			pthread_mutex_lock(&pool->lock);
+			pool->fabort = true;
+			pthread_mutex_unlock(&pool->lock);
+
+			continue;
+		}
+
+		job->fdbuf = worker->fdbuf;
+
+		if ((job->offset = lseek(job->fdbuf,0,SEEK_CUR)) < 0) {
+			job->status = SLBT_SYSTEM_ERROR(dctx,0);
+			continue;
+		}
+
+		job->status = slbt_exec_ar_output_archive(
+			dctx,*job->parctx,
+			pool->farname,
+			job->fdbuf);
+
+		if ((job->size = lseek(job->fdbuf,0,SEEK_CUR) - job->offset) < 0)
+			job->status = SLBT_SYSTEM_ERROR(dctx,0);
+	}
+}
+
+static int slbt_exec_ar_perform_concurrent_actions(
+	const struct slbt_driver_ctx *  dctx,
+	const char **                   unitv,
+	struct slbt_archive_ctx **      arctxv,
+	size_t                          nunits,
+	long                            njobs)
+{
+	int                             ret;
+	int                             fdout;
+	size_t                          idx;
+	long                            nworkers;
+	struct slbt_ar_pool             pool;
+	struct slbt_ar_job *            job;
+	struct slbt_ar_worker *         workerv;
+	struct slbt_ar_worker *         worker;
+
+	if ((size_t)njobs > nunits)
+		njobs = nunits;
+
+	/* pool */
+	if (!(pool.jobv = calloc(nunits,sizeof(*pool.jobv))))
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	if (!(workerv = calloc(njobs,sizeof(*workerv)))) {
+		free(pool.jobv);
+		return SLBT_SYSTEM_ERROR(dctx,0);
+	}
+
+	pool.dctx    = dctx;
+	pool.njobs   = nunits;
+	pool.next    = 0;
+	pool.farname = slbt_exec_ar_farname(dctx,nunits);
+	pool.fabort  = false;
+
+	for (idx=0; idx<nunits; idx++) {
+		pool.jobv[idx].unit   = unitv[idx];
+		pool.jobv[idx].parctx = &arctxv[idx];
+		pool.jobv[idx].fdbuf  = -1;
+	}
+
+	/* per-worker output buffers */
+	for (nworkers=0; nworkers<njobs; nworkers++) {
+		workerv[nworkers].pool = &pool;
+
+		if ((workerv[nworkers].fdbuf = slbt_tmpfile()) < 0) {
+			for (worker=workerv; worker<&workerv[nworkers]; worker++)
+				close(worker->fdbuf);
+
+			free(workerv);
+			free(pool.jobv);
+
+			return SLBT_SYSTEM_ERROR(dctx,0);
+		}
+	}
+
+	pthread_mutex_init(&pool.lock,0);
+
+	/* the calling thread is the first worker */
+	for (worker=&workerv[1]; worker<&workerv[njobs]; worker++)
+		worker->fthread = !pthread_create(
+			&worker->tid,0,
+			slbt_exec_ar_worker,
+			worker);
+
+	slbt_exec_ar_worker(workerv);
+
+	for (worker=&workerv[1]; worker<&workerv[njobs]; worker++)
+		if (worker->fthread)
+			pthread_join(worker->tid,0);
+
+	pthread_mutex_destroy(&pool.lock);
+
+	/* replay in command-line order, up to the first failure */
+	ret   = 0;
+	fdout = slbt_driver_fdout(dctx);
+
+	if (pool.fabort) {
+		ret = SLBT_NESTED_ERROR(dctx);
+
+		for (idx=0; idx<nunits; idx++) {
+			if (arctxv[idx]) {
+				slbt_ar_free_archive_ctx(arctxv[idx]);
+				arctxv[idx] = 0;
+			}
+		}
+	}
+
+	for (job=pool.jobv; !ret && (job<&pool.jobv[nunits]); job++) {
+		if (slbt_tmpfile_replay(job->fdbuf,job->offset,job->size,fdout) < 0)
+			ret = SLBT_SYSTEM_ERROR(dctx,0);
+
+		else if (job->status < 0)
+			ret = SLBT_NESTED_ERROR(dctx);
+	}
+
+	for (worker=workerv; worker<&workerv[njobs]; worker++)
+		close(worker->fdbuf);
+
+	free(workerv);
+	free(pool.jobv);
+
+	if (ret < 0)
+		return ret;
+
+	return slbt_exec_ar_perform_collective_actions(dctx,arctxv);
+}
+
 int slbt_exec_ar(const struct slbt_driver_ctx * dctx)
 {
 	int				ret;
@@ -140,6 +403,8 @@ int slbt_exec_ar(const struct slbt_driver_ctx * dctx)
 	const char **			unitv;
 	const char **			unitp;
 	size_t				nunits;
+	long				njobs;
+	const char *			jobs;
 	struct argv_meta *		meta;
 	struct argv_entry *		entry;
 	const struct argv_option *	optv[SLBT_OPTV_ELEMENTS];
@@ -184,6 +449,8 @@ int slbt_exec_ar(const struct slbt_driver_ctx * dctx)
 	argv    = ectx->altv;
 	*argv++ = iargv[0];
 	nunits  = 0;
+	njobs   = 1;
+	jobs    = 0;
 
 	for (entry=meta->entries; entry->fopt || entry->arg; entry++) {
 		if (entry->fopt) {
@@ -215,6 +482,10 @@ int slbt_exec_ar(const struct slbt_driver_ctx * dctx)
 					ictx->cctx.drvflags |= SLBT_DRIVER_MODE_AR_MERGE;
 					break;
 
+				case TAG_AR_THIN:
+					ictx->cctx.drvflags |= SLBT_DRIVER_THIN_ARCHIVE;
+					break;
+
 				case TAG_AR_OUTPUT:
 					ictx->cctx.output = entry->arg;
 					break;
@@ -282,6 +553,10 @@ int slbt_exec_ar(const struct slbt_driver_ctx * dctx)
 				case TAG_AR_VERBOSE:
 					ictx->cctx.fmtflags |= SLBT_PRETTY_VERBOSE;
 					break;
+
+				case TAG_AR_JOBS:
+					jobs = entry->arg ? entry->arg : "";
+					break;
 			}
 
 			if (entry->fval) {
@@ -379,6 +654,12 @@ int slbt_exec_ar(const struct slbt_driver_ctx * dctx)
 				SLBT_ERR_AR_NO_INPUT_SPECIFIED));
 	}
 
+	/* -Wjobs: number of concurrent workers */
+	if (jobs && ((njobs = slbt_exec_ar_get_jobs(dctx,jobs)) < 0))
+		return slbt_exec_ar_fail(
+			ectx,meta,
+			SLBT_CUSTOM_ERROR(dctx,SLBT_ERR_AR_FAIL));
+
 	/* archive vector allocation */
 	if (!(arctxv = calloc(nunits+1,sizeof(struct slbt_archive_ctx *))))
 		return slbt_exec_ar_fail(
@@ -399,23 +680,29 @@ int slbt_exec_ar(const struct slbt_driver_ctx * dctx)
 		if (!entry->fopt)
 			*unitp++ = entry->arg;
 
-	/* archive context vector initialization */
-	for (unitp=unitv,arctxp=arctxv; *unitp; unitp++,arctxp++) {
-		if (slbt_ar_get_archive_ctx(dctx,*unitp,arctxp) < 0) {
-			for (arctxp=arctxv; *arctxp; arctxp++)
-				slbt_ar_free_archive_ctx(*arctxp);
+	/* archive contexts and archive operations, concurrently */
+	if ((njobs > 1) && (nunits > 1)) {
+		ret = slbt_exec_ar_perform_concurrent_actions(
+			dctx,unitv,arctxv,nunits,njobs);
 
-			free(unitv);
-			free(arctxv);
+	/* archive contexts, then archive operations */
+	} else {
+		for (unitp=unitv,arctxp=arctxv; *unitp; unitp++,arctxp++) {
+			if (slbt_ar_get_archive_ctx(dctx,*unitp,arctxp) < 0) {
+				for (arctxp=arctxv; *arctxp; arctxp++)
+					slbt_ar_free_archive_ctx(*arctxp);
 
-			return slbt_exec_ar_fail(
-				ectx,meta,
-				SLBT_NESTED_ERROR(dctx));
+				free(unitv);
+				free(arctxv);
+
+				return slbt_exec_ar_fail(
+					ectx,meta,
+					SLBT_NESTED_ERROR(dctx));
+			}
 		}
-	}
 
-	/* archive operations */
-	ret = slbt_exec_ar_perform_archive_actions(dctx,arctxv);
+		ret = slbt_exec_ar_perform_archive_actions(dctx,arctxv);
+	}
 
 	/* all done */
 	for (arctxp=arctxv; *arctxp; arctxp++)
@@ -0,0 +1,656 @@
+/*******************************************************************/
+/*  slibtool: a strong libtool implementation, written in C        */
+/*  Copyright (C) 2016--2024  SysDeer Technologies, LLC            */
+/*  Released under the Standard MIT License; see COPYING.SLIBTOOL. */
+/*******************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/wait.h>
+
+#include <slibtool/slibtool.h>
+#include "slibtool_driver_impl.h"
+#include "slibtool_dprintf_impl.h"
+#include "slibtool_errinfo_impl.h"
+#include "slibtool_tmpfile_impl.h"
+#include "slibtool_toolchain_impl.h"
+
+/*****************************************************************/
+/* batch mode: each command is parsed into a driver context by   */
+/* the batch process itself, so that host probing results are    */
+/* shared by all commands; the requested actions are performed   */
+/* by a forked worker, whose standard output and standard error  */
+/* are captured in private temporary files and replayed in input */
+/* order. compile commands run concurrently, whereas any other   */
+/* command waits for all preceding commands, and runs on its own.*/
+/*****************************************************************/
+
+struct slbt_batch_cmd {
+	char **				argv;
+	size_t				argidx;
+	size_t				recno;
+	struct slbt_driver_ctx *	cdctx;
+	pid_t				pid;
+	int				fdout;
+	int				fderr;
+	int				status;
+	bool				fbarrier;
+	bool				fdone;
+};
+
+static int slbt_batch_read_input(
+	const struct slbt_driver_ctx *	dctx,
+	char **				pbuf,
+	size_t *			psize)
+{
+	int		fd;
+	ssize_t		ret;
+	char *		buf;
+	char *		nbuf;
+	size_t		size;
+	size_t		nalloc;
+
+	if (!strcmp(dctx->cctx->batch,"-")) {
+		fd = slbt_driver_fdin(dctx);
+
+	} else if ((fd = openat(
+			slbt_driver_fdcwd(dctx),
+			dctx->cctx->batch,
+			O_RDONLY|O_CLOEXEC,0)) < 0) {
+		return SLBT_SYSTEM_ERROR(dctx,dctx->cctx->batch);
+	}
+
+	buf    = 0;
+	size   = 0;
+	nalloc = 0;
+
+	for (ret=1; ret; ) {
+		if (size + 1 >= nalloc) {
+			nalloc = nalloc ? 2 * nalloc : 4096;
+
+			if (!(nbuf = realloc(buf,nalloc))) {
+				free(buf);
+
+				if (fd != slbt_driver_fdin(dctx))
+					close(fd);
+
+				return SLBT_SYSTEM_ERROR(dctx,0);
+			}
+
+			buf = nbuf;
+		}
+
+		ret = read(fd,&buf[size],nalloc - size - 1);
+
+		while ((ret < 0) && (errno == EINTR))
+			ret = read(fd,&buf[size],nalloc - size - 1);
+
+		if (ret < 0) {
+			free(buf);
+
+			if (fd != slbt_driver_fdin(dctx))
+				close(fd);
+
+			return SLBT_SYSTEM_ERROR(dctx,dctx->cctx->batch);
+		}
+
+		size += ret;
+	}
+
+	if (fd != slbt_driver_fdin(dctx))
+		close(fd);
+
+	buf[size] = 0;
+
+	*pbuf  = buf;
+	*psize = size;
+
+	return 0;
+}
+
+static char * slbt_batch_next_word(char ** pch)
+{
+	char *	ch;
+	char *	dst;
+	char *	word;
+	char	quote;
+
+	for (ch=*pch; (*ch == ' ') || (*ch == '\t') || (*ch == '\r'); )
+		ch++;
+
+	if (!*ch) {
+		*pch = ch;
+		return 0;
+	}
+
+	word  = ch;
+	dst   = ch;
+	quote = 0;
+
+	for (; *ch; ch++) {
+		if (quote == '\'') {
+			if (*ch == '\'')
+				quote = 0;
+			else
+				*dst++ = *ch;
+
+		} else if ((*ch == '\\') && ch[1]) {
+			*dst++ = *++ch;
+
+		} else if (quote == '"') {
+			if (*ch == '"')
+				quote = 0;
+			else
+				*dst++ = *ch;
+
+		} else if ((*ch == '\'') || (*ch == '"')) {
+			quote = *ch;
+
+		} else if ((*ch == ' ') || (*ch == '\t') || (*ch == '\r')) {
+			ch++;
+			break;
+
+		} else {
+			*dst++ = *ch;
+		}
+	}
+
+	*dst = 0;
+	*pch = ch;
+
+	return word;
+}
+
+static int slbt_batch_parse_input(
+	const struct slbt_driver_ctx *	dctx,
+	char *				buf,
+	size_t				size,
+	char ***			pargvv,
+	struct slbt_batch_cmd **	pcmdv,
+	size_t *			pncmds)
+{
+	char **			argvv;
+	char **			nargvv;
+	struct slbt_batch_cmd *	cmdv;
+	struct slbt_batch_cmd *	ncmdv;
+	size_t			nargs;
+	size_t			nalloc;
+	size_t			ncmds;
+	size_t			ncmdalloc;
+	size_t			recno;
+	size_t			start;
+	char *			ch;
+	char *			eol;
+	char *			cap;
+	char *			arg;
+	bool			fnul;
+
+	argvv     = 0;
+	cmdv      = 0;
+	nargs     = 0;
+	nalloc    = 0;
+	ncmds     = 0;
+	ncmdalloc = 0;
+	recno     = 0;
+
+	/* nul-terminated arguments, or one command per line? */
+	fnul = !!memchr(buf,0,size);
+	cap  = &buf[size];
+
+	for (ch=buf; ch<cap; ) {
+		recno++;
+		start = nargs;
+
+		if (!fnul) {
+			if ((eol = memchr(ch,'\n',cap-ch)))
+				*eol = 0;
+			else
+				eol = cap;
+		}
+
+		/* obtain the next command's argument vector */
+		for (arg=0; ch<cap; ) {
+			if (fnul) {
+				arg = *ch ? ch : 0;
+				ch += strlen(ch) + 1;
+
+			} else if (!(arg = slbt_batch_next_word(&ch))) {
+				ch = eol + 1;
+			}
+
+			if (!arg)
+				break;
+
+			if (nargs + 2 >= nalloc) {
+				nalloc = nalloc ? 2 * nalloc : 256;
+
+				if (!(nargvv = realloc(argvv,nalloc*sizeof(char *)))) {
+					free(argvv);
+					free(cmdv);
+					return SLBT_SYSTEM_ERROR(dctx,0);
+				}
+
+				argvv = nargvv;
+			}
+
+			argvv[nargs++] = arg;
+		}
+
+		/* empty line, or a comment */
+		if ((nargs == start) || (!fnul && (argvv[start][0] == '#'))) {
+			nargs = start;
+			continue;
+		}
+
+		argvv[nargs++] = 0;
+
+		if (ncmds == ncmdalloc) {
+			ncmdalloc = ncmdalloc ? 2 * ncmdalloc : 64;
+
+			if (!(ncmdv = realloc(cmdv,ncmdalloc*sizeof(*cmdv)))) {
+				free(argvv);
+				free(cmdv);
+				return SLBT_SYSTEM_ERROR(dctx,0);
+			}
+
+			cmdv = ncmdv;
+		}
+
+		memset(&cmdv[ncmds],0,sizeof(*cmdv));
+
+		cmdv[ncmds].argidx = start;
+		cmdv[ncmds].recno  = recno;
+		cmdv[ncmds].fdout  = -1;
+		cmdv[ncmds].fderr  = -1;
+		ncmds++;
+	}
+
+	/* argument vectors, now that argvv is final */
+	for (start=0; start<ncmds; start++)
+		cmdv[start].argv = &argvv[cmdv[start].argidx];
+
+	*pargvv = argvv;
+	*pcmdv  = cmdv;
+	*pncmds = ncmds;
+
+	return 0;
+}
+
+static long slbt_batch_get_jobs(const struct slbt_driver_ctx * dctx)
+{
+	long	njobs;
+	char *	mark;
+
+	if (dctx->cctx->batchjobs) {
+		njobs = strtol(dctx->cctx->batchjobs,&mark,10);
+
+		if ((njobs <= 0) || *mark) {
+			slbt_dprintf(
+				slbt_driver_fderr(dctx),
+				"%s: error: invalid --batch-jobs argument: %s.\n",
+				dctx->program,dctx->cctx->batchjobs);
+			return -1;
+		}
+
+		return njobs;
+	}
+
+	if ((njobs = sysconf(_SC_NPROCESSORS_ONLN)) <= 0)
+		njobs = 1;
+
+	return njobs;
+}
+
+static void slbt_batch_child(
+	struct slbt_driver_ctx *	cdctx,
+	struct slbt_batch_cmd *		cmd)
+{
+	int	fdnull;
+
+	if ((fdnull = openat(AT_FDCWD,"/dev/null",O_RDONLY,0)) >= 0)
+		if (dup2(fdnull,0) == 0)
+			if (dup2(cmd->fdout,1) == 1)
+				if (dup2(cmd->fderr,2) == 2)
+					_exit(slbt_main_driver_actions(cdctx,cmd->fdout));
+
+	_exit(SLBT_ERROR);
+}
+
+static int slbt_batch_prepare(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_batch_cmd *		cmd)
+{
+	int				ret;
+	uint64_t			flags;
+	struct slbt_fd_ctx		fdctx;
+
+	if (slbt_lib_get_driver_fdctx(dctx,&fdctx) < 0)
+		return SLBT_NESTED_ERROR(dctx);
+
+	if (cmd->fdout < 0)
+		if ((cmd->fdout = slbt_tmpfile()) < 0)
+			return SLBT_SYSTEM_ERROR(dctx,0);
+
+	if (cmd->fderr < 0)
+		if ((cmd->fderr = slbt_tmpfile()) < 0)
+			return SLBT_SYSTEM_ERROR(dctx,0);
+
+	fdctx.fdout = cmd->fdout;
+	fdctx.fderr = cmd->fderr;
+
+	flags  = slbt_main_driver_flags(cmd->argv[0]);
+	flags |= getenv("NO_COLOR") ? SLBT_DRIVER_ANNOTATE_NEVER : 0;
+
+	/* driver context (any errors are written to the command's fderr) */
+	if ((ret = slbt_lib_get_driver_ctx(
+			cmd->argv,slbt_driver_envp(dctx),
+			flags,&fdctx,&cmd->cdctx))) {
+		cmd->status = (ret == SLBT_USAGE)
+			? !cmd->argv[1] || !cmd->argv[2]
+			: SLBT_ERROR;
+
+		cmd->cdctx = 0;
+		cmd->fdone = true;
+		return 0;
+	}
+
+	/* nested batch mode is not supported */
+	if (cmd->cdctx->cctx->mode == SLBT_MODE_BATCH) {
+		slbt_dprintf(cmd->fderr,
+			"%s: error: --batch may not be used "
+			"within a batch command.\n",
+			cmd->cdctx->program);
+
+		slbt_lib_free_driver_ctx(cmd->cdctx);
+
+		cmd->cdctx  = 0;
+		cmd->status = SLBT_ERROR;
+		cmd->fdone  = true;
+		return 0;
+	}
+
+	/* only compile commands may run alongside other commands */
+	cmd->fbarrier = (cmd->cdctx->cctx->mode != SLBT_MODE_COMPILE);
+
+	return 0;
+}
+
+static int slbt_batch_defer(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_batch_cmd *		cmd)
+{
+	slbt_lib_free_driver_ctx(cmd->cdctx);
+	cmd->cdctx = 0;
+
+	/* discard output from the driver context's creation */
+	if (ftruncate(cmd->fdout,0) || ftruncate(cmd->fderr,0))
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	if ((lseek(cmd->fdout,0,SEEK_SET) < 0) || (lseek(cmd->fderr,0,SEEK_SET) < 0))
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	return 0;
+}
+
+static int slbt_batch_launch(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_batch_cmd *		cmd)
+{
+	if ((cmd->pid = fork()) < 0)
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	if (cmd->pid == 0)
+		slbt_batch_child(cmd->cdctx,cmd);
+
+	slbt_lib_free_driver_ctx(cmd->cdctx);
+	cmd->cdctx = 0;
+
+	return 0;
+}
+
+static int slbt_batch_replay(int fdsrc, int fddst)
+{
+	ssize_t	nread;
+	ssize_t	nwritten;
+	char *	ch;
+	char	buf[4096];
+
+	if (lseek(fdsrc,0,SEEK_SET) < 0)
+		return -1;
+
+	for (;;) {
+		nread = read(fdsrc,buf,sizeof(buf));
+
+		while ((nread < 0) && (errno == EINTR))
+			nread = read(fdsrc,buf,sizeof(buf));
+
+		if (nread < 0)
+			return -1;
+
+		if (nread == 0)
+			return 0;
+
+		for (ch=buf; nread; ) {
+			nwritten = write(fddst,ch,nread);
+
+			while ((nwritten < 0) && (errno == EINTR))
+				nwritten = write(fddst,ch,nread);
+
+			if (nwritten < 0)
+				return -1;
+
+			ch    += nwritten;
+			nread -= nwritten;
+		}
+	}
+}
+
+static int slbt_batch_report(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_batch_cmd *		cmd)
+{
+	int	ret;
+
+	ret = 0;
+
+	if (cmd->fdout >= 0)
+		if (slbt_batch_replay(cmd->fdout,slbt_driver_fdout(dctx)) < 0)
+			ret = SLBT_SYSTEM_ERROR(dctx,0);
+
+	if (cmd->fderr >= 0)
+		if (slbt_batch_replay(cmd->fderr,slbt_driver_fderr(dctx)) < 0)
+			ret = SLBT_SYSTEM_ERROR(dctx,0);
+
+	if (cmd->status && !(dctx->cctx->drvflags & SLBT_DRIVER_SILENT))
+		slbt_dprintf(
+			slbt_driver_fderr(dctx),
+			"%s: batch record %zu: command failed, "
+			"exit status %d.\n",
+			dctx->program,cmd->recno,cmd->status);
+
+	if (cmd->fdout >= 0)
+		close(cmd->fdout);
+
+	if (cmd->fderr >= 0)
+		close(cmd->fderr);
+
+	cmd->fdout = -1;
+	cmd->fderr = -1;
+
+	return ret;
+}
+
+static void slbt_batch_free(
+	char *			buf,
+	char **			argvv,
+	struct slbt_batch_cmd *	cmdv,
+	size_t			ncmds)
+{
+	size_t	idx;
+
+	for (idx=0; idx<ncmds; idx++) {
+		if (cmdv[idx].cdctx)
+			slbt_lib_free_driver_ctx(cmdv[idx].cdctx);
+
+		if (cmdv[idx].fdout >= 0)
+			close(cmdv[idx].fdout);
+
+		if (cmdv[idx].fderr >= 0)
+			close(cmdv[idx].fderr);
+	}
+
+	free(cmdv);
+	free(argvv);
+	free(buf);
+}
+
+int slbt_exec_batch(const struct slbt_driver_ctx * dctx)
+{
+	int			ret;
+	int			estatus;
+	long			njobs;
+	long			nrunning;
+	size_t			ncmds;
+	size_t			nspawned;
+	size_t			nreported;
+	size_t			idx;
+	pid_t			pid;
+	bool			fabort;
+	bool			fserial;
+	bool			ffailed;
+	char *			buf;
+	size_t			size;
+	char **			argvv;
+	struct slbt_batch_cmd *	cmdv;
+	struct slbt_batch_cmd *	cmd;
+
+	/* dry run */
+	if (dctx->cctx->drvflags & SLBT_DRIVER_DRY_RUN)
+		return 0;
+
+	/* worker pool size */
+	if ((njobs = slbt_batch_get_jobs(dctx)) < 0)
+		return SLBT_CUSTOM_ERROR(
+			dctx,
+			SLBT_ERR_BATCH_ERROR);
+
+	/* input */
+	buf   = 0;
+	size  = 0;
+	argvv = 0;
+	cmdv  = 0;
+	ncmds = 0;
+
+	if (slbt_batch_read_input(dctx,&buf,&size) < 0)
+		return SLBT_NESTED_ERROR(dctx);
+
+	if (slbt_batch_parse_input(dctx,buf,size,&argvv,&cmdv,&ncmds) < 0) {
+		free(buf);
+		return SLBT_NESTED_ERROR(dctx);
+	}
+
+	/* run (command contexts share the toolchain contexts) */
+	slbt_toolchain_cache_begin();
+
+	ret       = 0;
+	nrunning  = 0;
+	nspawned  = 0;
+	nreported = 0;
+	fabort    = false;
+	fserial   = false;
+	ffailed   = false;
+
+	while (nreported < ncmds) {
+		/* fill the worker pool; non-compile commands run on their own */
+		for (; !fabort && (nspawned < ncmds) && (nrunning < njobs); ) {
+			cmd = &cmdv[nspawned];
+
+			if (nrunning && (fserial || cmd->fbarrier))
+				break;
+
+			if (slbt_batch_prepare(dctx,cmd) < 0) {
+				ret    = SLBT_NESTED_ERROR(dctx);
+				fabort = true;
+				break;
+			}
+
+			if (cmd->fdone) {
+				nspawned++;
+				continue;
+			}
+
+			if (nrunning && cmd->fbarrier) {
+				if (slbt_batch_defer(dctx,cmd) < 0) {
+					ret    = SLBT_NESTED_ERROR(dctx);
+					fabort = true;
+				}
+
+				break;
+			}
+
+			if (slbt_batch_launch(dctx,cmd) < 0) {
+				ret    = SLBT_NESTED_ERROR(dctx);
+				fabort = true;
+				break;
+			}
+
+			fserial = cmd->fbarrier;
+			nrunning++;
+			nspawned++;
+		}
+
+		/* report completed commands in input order */
+		for (; (nreported < nspawned) && cmdv[nreported].fdone; nreported++) {
+			if (slbt_batch_report(dctx,&cmdv[nreported]) < 0)
+				ret = SLBT_NESTED_ERROR(dctx);
+
+			if (cmdv[nreported].status)
+				ffailed = true;
+		}
+
+		if (fabort && !nrunning)
+			break;
+
+		if (!nrunning)
+			continue;
+
+		/* wait for the next worker */
+		pid = waitpid(-1,&estatus,0);
+
+		while ((pid < 0) && (errno == EINTR))
+			pid = waitpid(-1,&estatus,0);
+
+		if (pid < 0) {
+			ret = SLBT_SYSTEM_ERROR(dctx,0);
+			break;
+		}
+
+		for (idx=nreported; idx<nspawned; idx++) {
+			if (cmdv[idx].pid == pid) {
+				cmdv[idx].status = WIFEXITED(estatus)
+					? WEXITSTATUS(estatus)
+					: SLBT_ERROR;
+
+				cmdv[idx].fdone = true;
+				nrunning--;
+			}
+		}
+	}
+
+	slbt_batch_free(buf,argvv,cmdv,ncmds);
+	slbt_toolchain_cache_end();
+
+	if (ret < 0)
+		return ret;
+
+	return ffailed
+		? SLBT_CUSTOM_ERROR(
+			dctx,
+			SLBT_ERR_BATCH_ERROR)
+		: 0;
+}
@@ -0,0 +1,1188 @@
+/*******************************************************************/
+/*  slibtool: a strong libtool implementation, written in C        */
+/*  Copyright (C) 2016--2024  SysDeer Technologies, LLC            */
+/*  Released under the Standard MIT License; see COPYING.SLIBTOOL. */
+/*******************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#include <slibtool/slibtool.h>
+#include "slibtool_driver_impl.h"
+#include "slibtool_uninstall_impl.h"
+#include "slibtool_launcher_impl.h"
+#include "slibtool_snprintf_impl.h"
+#include "slibtool_dprintf_impl.h"
+#include "slibtool_errinfo_impl.h"
+#include "argv/argv.h"
+
+#ifndef O_DIRECTORY
+#define O_DIRECTORY 0
+#endif
+
+#define SLBT_CLEAN_OBJDIR		".libs"
+
+static int slbt_clean_usage(
+	int				fdout,
+	const char *			program,
+	const char *			arg,
+	const struct argv_option **	optv,
+	struct argv_meta *		meta,
+	int				noclr)
+{
+	char header[512];
+
+	snprintf(header,sizeof(header),
+		"Usage: %s --mode=clean <rm> [options] [FILE]...\n"
+		"Options:\n",
+		program);
+
+	switch (noclr) {
+		case 0:
+			slbt_argv_usage(fdout,header,optv,arg);
+			break;
+
+		default:
+			slbt_argv_usage_plain(fdout,header,optv,arg);
+			break;
+	}
+
+	slbt_argv_free(meta);
+
+	return SLBT_USAGE;
+}
+
+static int slbt_exec_clean_fail(
+	struct slbt_exec_ctx *	ectx,
+	struct argv_meta *	meta,
+	int			ret)
+{
+	slbt_argv_free(meta);
+	slbt_ectx_free_exec_ctx(ectx);
+	return ret;
+}
+
+/*****************************************************************/
+/* clean mode removes the artifacts that compile and link mode   */
+/* derive from each argument: the objects named by a .lo wrapper */
+/* (or their default names); the archive, shared library, and    */
+/* all of their versioned names, symlinks, and by-products that  */
+/* are found in .libs next to a .la wrapper; and the executable  */
+/* image, wrapper, and launcher of a program.                    */
+/*                                                               */
+/* every directory is opened and enumerated once, and the names  */
+/* of its entries kept in a sorted vector, so that all entries   */
+/* that share a prefix (libfoo.so, libfoo.so.1, ...) are found   */
+/* in a single range. once all arguments have been resolved, the */
+/* marked entries are removed relative to each directory's fd;   */
+/* directories are handed out to a pool of worker threads, since */
+/* removals within a single directory are serialized by the      */
+/* system regardless. lastly, a .libs directory is removed once  */
+/* it has become empty.                                          */
+/*****************************************************************/
+
+struct slbt_clean_name {
+	char *				name;
+	bool				fdir;
+	bool				fremove;
+};
+
+struct slbt_clean_dir {
+	struct slbt_clean_dir *		next;
+	struct slbt_clean_dir *		parent;
+	char *				path;
+	const char *			base;
+	int				fd;
+	bool				fgone;
+	bool				fobjdir;
+	size_t				nnames;
+	size_t				nremove;
+	struct slbt_clean_name *	namev;
+	const char *			errname;
+	int				errnum;
+};
+
+struct slbt_clean_ctx {
+	const struct slbt_driver_ctx *	dctx;
+	struct slbt_clean_dir *		dirs;
+	struct slbt_clean_dir **	dirv;
+	size_t				ndirs;
+	size_t				next;
+	uint32_t			flags;
+	char **				outv;
+	size_t				nout;
+	size_t				outcap;
+	size_t				nopts;
+	pthread_mutex_t			lock;
+};
+
+static int slbt_clean_name_cmp(const void * a, const void * b)
+{
+	const struct slbt_clean_name * na = a;
+	const struct slbt_clean_name * nb = b;
+
+	return strcmp(na->name,nb->name);
+}
+
+static struct slbt_clean_name * slbt_clean_dir_lookup(
+	const struct slbt_clean_dir *	dir,
+	const char *			name)
+{
+	struct slbt_clean_name		key;
+
+	if (!dir->nnames)
+		return 0;
+
+	key.name = (char *)name;
+
+	return bsearch(
+		&key,dir->namev,dir->nnames,
+		sizeof(*dir->namev),
+		slbt_clean_name_cmp);
+}
+
+/* first entry whose name is not less than prefix */
+static struct slbt_clean_name * slbt_clean_dir_lower_bound(
+	const struct slbt_clean_dir *	dir,
+	const char *			prefix)
+{
+	size_t				lo;
+	size_t				hi;
+	size_t				mid;
+
+	for (lo=0, hi=dir->nnames; lo<hi; ) {
+		mid = lo + (hi - lo) / 2;
+
+		if (strcmp(dir->namev[mid].name,prefix) < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return &dir->namev[lo];
+}
+
+static void slbt_clean_free_dirs(struct slbt_clean_ctx * cctx)
+{
+	struct slbt_clean_dir *		dir;
+	struct slbt_clean_dir *		next;
+	size_t				idx;
+
+	for (dir=cctx->dirs; dir; dir=next) {
+		next = dir->next;
+
+		for (idx=0; idx<dir->nnames; idx++)
+			free(dir->namev[idx].name);
+
+		if (dir->fd >= 0)
+			close(dir->fd);
+
+		free(dir->namev);
+		free(dir->path);
+		free(dir);
+	}
+
+	for (idx=cctx->nopts; idx<cctx->nout; idx++)
+		free(cctx->outv[idx]);
+
+	free(cctx->outv);
+	free(cctx->dirv);
+
+	cctx->dirs = 0;
+	cctx->dirv = 0;
+	cctx->outv = 0;
+}
+
+static int slbt_clean_split_path(
+	const char *	path,
+	char		(*dirname)[PATH_MAX],
+	const char **	base)
+{
+	const char *	slash;
+
+	if (!(slash = strrchr(path,'/'))) {
+		strcpy(*dirname,".");
+		*base = path;
+		return 0;
+	}
+
+	if ((size_t)(slash - path) >= sizeof(*dirname))
+		return -1;
+
+	memcpy(*dirname,path,slash - path);
+	(*dirname)[slash - path] = 0;
+
+	if (!(*dirname)[0])
+		strcpy(*dirname,"/");
+
+	*base = &slash[1];
+
+	return 0;
+}
+
+/* dirname/name, or name when dirname is the current directory */
+static int slbt_clean_join_path(
+	char		(*path)[PATH_MAX],
+	const char *	dirname,
+	const char *	name)
+{
+	if (!strcmp(dirname,"."))
+		return slbt_snprintf(*path,sizeof(*path),"%s",name);
+
+	if (!strcmp(dirname,"/"))
+		return slbt_snprintf(*path,sizeof(*path),"/%s",name);
+
+	return slbt_snprintf(*path,sizeof(*path),"%s/%s",dirname,name);
+}
+
+static int slbt_clean_scan_dir(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_clean_dir *		dir)
+{
+	int				fd;
+	DIR *				dirp;
+	struct dirent *			dent;
+	struct slbt_clean_name *	namev;
+	size_t				ncap;
+	struct stat			st;
+
+	/* readdir (getdents) on a private copy of the directory fd */
+	if ((fd = openat(dir->fd,".",O_RDONLY|O_DIRECTORY|O_CLOEXEC,0)) < 0)
+		return SLBT_SYSTEM_ERROR(dctx,dir->path);
+
+	if (!(dirp = fdopendir(fd))) {
+		close(fd);
+		return SLBT_SYSTEM_ERROR(dctx,dir->path);
+	}
+
+	for (ncap=0; (dent = readdir(dirp)); ) {
+		if (!strcmp(dent->d_name,".") || !strcmp(dent->d_name,".."))
+			continue;
+
+		if (dir->nnames == ncap) {
+			ncap = ncap ? 2*ncap : 64;
+
+			if (!(namev = realloc(dir->namev,ncap*sizeof(*namev)))) {
+				closedir(dirp);
+				return SLBT_SYSTEM_ERROR(dctx,0);
+			}
+
+			dir->namev = namev;
+		}
+
+		namev = &dir->namev[dir->nnames];
+
+		if (!(namev->name = strdup(dent->d_name))) {
+			closedir(dirp);
+			return SLBT_SYSTEM_ERROR(dctx,0);
+		}
+
+		dir->nnames++;
+
+		namev->fremove = false;
+		namev->fdir    = false;
+
+#ifdef DT_DIR
+		if (dent->d_type != DT_UNKNOWN) {
+			namev->fdir = (dent->d_type == DT_DIR);
+			continue;
+		}
+#endif
+		if (!fstatat(dir->fd,namev->name,&st,AT_SYMLINK_NOFOLLOW))
+			namev->fdir = S_ISDIR(st.st_mode);
+	}
+
+	closedir(dirp);
+
+	if (dir->nnames)
+		qsort(dir->namev,dir->nnames,
+			sizeof(*dir->namev),
+			slbt_clean_name_cmp);
+
+	return 0;
+}
+
+static struct slbt_clean_dir * slbt_clean_get_dir(
+	struct slbt_clean_ctx *		cctx,
+	const char *			dirname)
+{
+	struct slbt_clean_dir *		dir;
+	struct slbt_clean_dir **	pdir;
+	const struct slbt_driver_ctx *	dctx;
+	const char *			base;
+	char				parent[PATH_MAX];
+
+	dctx = cctx->dctx;
+
+	for (pdir=&cctx->dirs; *pdir; pdir=&(*pdir)->next)
+		if (!strcmp((*pdir)->path,dirname))
+			return *pdir;
+
+	if (!(dir = calloc(1,sizeof(*dir)))) {
+		SLBT_SYSTEM_ERROR(dctx,0);
+		return 0;
+	}
+
+	if (!(dir->path = strdup(dirname))) {
+		SLBT_SYSTEM_ERROR(dctx,0);
+		free(dir);
+		return 0;
+	}
+
+	/* a missing directory has no entries */
+	dir->fd = openat(
+		slbt_driver_fdcwd(dctx),dirname,
+		O_RDONLY|O_DIRECTORY|O_CLOEXEC,0);
+
+	if ((dir->fd < 0) && (errno != ENOENT) && (errno != ENOTDIR)) {
+		SLBT_SYSTEM_ERROR(dctx,dirname);
+		free(dir->path);
+		free(dir);
+		return 0;
+	}
+
+	dir->fgone = (dir->fd < 0);
+
+	/* command-line order */
+	*pdir = dir;
+
+	if (!dir->fgone && (slbt_clean_scan_dir(dctx,dir) < 0))
+		return 0;
+
+	/* an object directory, removed once it has become empty */
+	if (!slbt_clean_split_path(dirname,&parent,&base)) {
+		if (!strcmp(base,SLBT_CLEAN_OBJDIR)) {
+			dir->fobjdir = true;
+			dir->base    = &dir->path[base - dirname];
+
+			if (!(dir->parent = slbt_clean_get_dir(cctx,parent)))
+				return 0;
+		}
+	}
+
+	return dir;
+}
+
+static struct slbt_clean_dir * slbt_clean_get_objdir(
+	struct slbt_clean_ctx *		cctx,
+	const char *			dirname)
+{
+	char				objdir[PATH_MAX];
+
+	if (slbt_clean_join_path(&objdir,dirname,SLBT_CLEAN_OBJDIR) < 0)
+		return 0;
+
+	return slbt_clean_get_dir(cctx,objdir);
+}
+
+/* the output vector of the current argument */
+static int slbt_clean_add_output(
+	struct slbt_clean_ctx *		cctx,
+	const struct slbt_clean_dir *	dir,
+	const char *			name)
+{
+	char **				outv;
+	char				path[PATH_MAX];
+
+	if (slbt_clean_join_path(&path,dir->path,name) < 0)
+		return -1;
+
+	if (cctx->nout + 1 >= cctx->outcap) {
+		if (!(outv = realloc(cctx->outv,2*cctx->outcap*sizeof(char *))))
+			return -1;
+
+		cctx->outv    = outv;
+		cctx->outcap *= 2;
+	}
+
+	if (!(cctx->outv[cctx->nout] = strdup(path)))
+		return -1;
+
+	cctx->outv[++cctx->nout] = 0;
+
+	return 0;
+}
+
+static int slbt_clean_mark_entry(
+	struct slbt_clean_ctx *		cctx,
+	struct slbt_clean_dir *		dir,
+	struct slbt_clean_name *	slot)
+{
+	if (slot->fremove)
+		return 0;
+
+	slot->fremove = true;
+	dir->nremove++;
+
+	if (slbt_clean_add_output(cctx,dir,slot->name) < 0)
+		return SLBT_SYSTEM_ERROR(cctx->dctx,0);
+
+	return 0;
+}
+
+/* path: relative to the current directory; fexplicit: a command-line argument */
+static int slbt_clean_mark_path(
+	struct slbt_clean_ctx *		cctx,
+	const char *			path,
+	bool				fexplicit)
+{
+	struct slbt_clean_dir *		dir;
+	struct slbt_clean_name *	slot;
+	const char *			base;
+	char				dirname[PATH_MAX];
+
+	if (slbt_clean_split_path(path,&dirname,&base) < 0)
+		return SLBT_BUFFER_ERROR(cctx->dctx);
+
+	if (!(dir = slbt_clean_get_dir(cctx,dirname)))
+		return SLBT_NESTED_ERROR(cctx->dctx);
+
+	if (!(slot = slbt_clean_dir_lookup(dir,base)))
+		return 0;
+
+	/* only an explicit argument may name a directory */
+	if (slot->fdir && !fexplicit)
+		return 0;
+
+	return slbt_clean_mark_entry(cctx,dir,slot);
+}
+
+static int slbt_clean_mark_dir_entry(
+	struct slbt_clean_ctx *		cctx,
+	struct slbt_clean_dir *		dir,
+	const char *			name)
+{
+	struct slbt_clean_name *	slot;
+
+	if (!(slot = slbt_clean_dir_lookup(dir,name)))
+		return 0;
+
+	if (slot->fdir)
+		return 0;
+
+	return slbt_clean_mark_entry(cctx,dir,slot);
+}
+
+/* value of a key='value' line of a libtool wrapper */
+static const char * slbt_clean_wrapper_value(
+	const char *	line,
+	const char *	key,
+	char		(*buf)[PATH_MAX])
+{
+	size_t		klen;
+	const char *	mark;
+	const char *	cap;
+
+	klen = strlen(key);
+
+	if (strncmp(line,key,klen) || (line[klen] != '='))
+		return 0;
+
+	mark = &line[klen+1];
+
+	if (*mark == '\'') {
+		if (!(cap = strchr(++mark,'\'')))
+			return 0;
+	} else {
+		cap = &mark[strlen(mark)];
+	}
+
+	if ((size_t)(cap - mark) >= sizeof(*buf))
+		return 0;
+
+	memcpy(*buf,mark,cap - mark);
+	(*buf)[cap - mark] = 0;
+
+	return (*buf)[0] && strcmp(*buf,"none") ? *buf : 0;
+}
+
+static int slbt_clean_object(
+	struct slbt_clean_ctx *		cctx,
+	const char *			path,
+	const char *			dirname,
+	const char *			base)
+{
+	const struct slbt_driver_ctx *	dctx;
+	struct slbt_txtfile_ctx *	tctx;
+	struct slbt_clean_dir *		ddir;
+	struct slbt_clean_name *	slot;
+	const char **			pline;
+	const char *			value;
+	const char *			dot;
+	size_t				dlen;
+	bool				fwrapper;
+	char				buf [PATH_MAX];
+	char				opath[PATH_MAX];
+	char				oname[PATH_MAX];
+
+	dctx     = cctx->dctx;
+	fwrapper = false;
+
+	if (!(ddir = slbt_clean_get_dir(cctx,dirname)))
+		return SLBT_NESTED_ERROR(dctx);
+
+	/* pic_object, non_pic_object: relative to the wrapper */
+	if ((slot = slbt_clean_dir_lookup(ddir,base)) && !slot->fdir) {
+		if (slbt_lib_get_txtfile_ctx(dctx,path,&tctx) < 0)
+			return SLBT_NESTED_ERROR(dctx);
+
+		for (pline=tctx->txtlinev; *pline; pline++) {
+			if (!(value = slbt_clean_wrapper_value(*pline,"pic_object",&buf)))
+				if (!(value = slbt_clean_wrapper_value(*pline,"non_pic_object",&buf)))
+					continue;
+
+			fwrapper = true;
+			dlen     = strlen(dirname);
+
+			/* libtool: relative to the wrapper; slibtool: to the cwd of compilation */
+			if (value[0] == '/') {
+				strcpy(opath,value);
+
+			} else if (!strncmp(value,dirname,dlen) && (value[dlen] == '/')) {
+				strcpy(opath,value);
+
+			} else if (slbt_clean_join_path(&opath,dirname,value) < 0) {
+				slbt_lib_free_txtfile_ctx(tctx);
+				return SLBT_BUFFER_ERROR(dctx);
+			}
+
+			if (slbt_clean_mark_path(cctx,opath,false) < 0) {
+				slbt_lib_free_txtfile_ctx(tctx);
+				return SLBT_NESTED_ERROR(dctx);
+			}
+		}
+
+		slbt_lib_free_txtfile_ctx(tctx);
+	}
+
+	if (fwrapper)
+		return 0;
+
+	/* default object names */
+	dot = strrchr(base,'.');
+
+	if (slbt_snprintf(oname,sizeof(oname),"%.*s.o",(int)(dot - base),base) < 0)
+		return SLBT_BUFFER_ERROR(dctx);
+
+	if (slbt_clean_join_path(&opath,dirname,oname) < 0)
+		return SLBT_BUFFER_ERROR(dctx);
+
+	if (slbt_clean_mark_path(cctx,opath,false) < 0)
+		return SLBT_NESTED_ERROR(dctx);
+
+	if (slbt_clean_join_path(&buf,dirname,SLBT_CLEAN_OBJDIR) < 0)
+		return SLBT_BUFFER_ERROR(dctx);
+
+	if (slbt_clean_join_path(&opath,buf,oname) < 0)
+		return SLBT_BUFFER_ERROR(dctx);
+
+	return slbt_clean_mark_path(cctx,opath,false);
+}
+
+/* an entry that belongs to a library of a longer name (libfoo.bar.la)? */
+static bool slbt_clean_entry_is_foreign(
+	const struct slbt_clean_dir *	dir,
+	const struct slbt_clean_dir *	ddir,
+	const char *			name,
+	size_t				stemlen)
+{
+	const char *			dot;
+	const char *			suffix;
+	char				laname[PATH_MAX];
+
+	/* object files are removed via their .lo wrapper */
+	if ((suffix = strrchr(name,'.')) && !strcmp(suffix,".o"))
+		if ((suffix - name < 7) || strncmp(&suffix[-7],".dlopen",7))
+			return true;
+
+	for (dot=strchr(&name[stemlen+1],'.'); dot; dot=strchr(&dot[1],'.')) {
+		if ((size_t)(dot - name) + 4 > sizeof(laname))
+			return false;
+
+		memcpy(laname,name,dot - name);
+		strcpy(&laname[dot - name],".la");
+
+		if (slbt_clean_dir_lookup(dir,laname))
+			return true;
+
+		if (ddir && slbt_clean_dir_lookup(ddir,laname))
+			return true;
+	}
+
+	return false;
+}
+
+/* all entries of objdir whose name begins with stem followed by a dot */
+static int slbt_clean_library_stem(
+	struct slbt_clean_ctx *		cctx,
+	struct slbt_clean_dir *		objdir,
+	struct slbt_clean_dir *		ddir,
+	const char *			stem,
+	size_t				stemlen)
+{
+	struct slbt_clean_name *	slot;
+	struct slbt_clean_name *	cap;
+	char				prefix[PATH_MAX];
+
+	if (stemlen + 2 > sizeof(prefix))
+		return SLBT_BUFFER_ERROR(cctx->dctx);
+
+	memcpy(prefix,stem,stemlen);
+	prefix[stemlen]   = '.';
+	prefix[stemlen+1] = 0;
+
+	slot = slbt_clean_dir_lower_bound(objdir,prefix);
+	cap  = &objdir->namev[objdir->nnames];
+
+	for (; (slot<cap) && !strncmp(slot->name,prefix,stemlen+1); slot++) {
+		if (slot->fdir || slot->fremove)
+			continue;
+
+		if (slbt_clean_entry_is_foreign(objdir,ddir,slot->name,stemlen))
+			continue;
+
+		if (slbt_clean_mark_entry(cctx,objdir,slot) < 0)
+			return SLBT_NESTED_ERROR(cctx->dctx);
+	}
+
+	return 0;
+}
+
+/* library file name: stem, followed by the dso or archive suffix */
+static size_t slbt_clean_library_stemlen(
+	const struct slbt_driver_ctx *	dctx,
+	const char *			libname)
+{
+	const char *			suffix;
+	const char *			mark;
+	size_t				namelen;
+	size_t				slen;
+
+	if ((mark = strrchr(libname,'/')))
+		libname = ++mark;
+
+	namelen = strlen(libname);
+	suffix  = dctx->cctx->settings.arsuffix;
+	slen    = suffix ? strlen(suffix) : 0;
+
+	if (slen && (namelen > slen) && !strcmp(&libname[namelen-slen],suffix))
+		return namelen - slen;
+
+	suffix = dctx->cctx->settings.dsosuffix;
+
+	if (suffix && suffix[0] && (mark = strstr(libname,suffix)))
+		return mark - libname;
+
+	if ((mark = strchr(libname,'.')))
+		return mark - libname;
+
+	return strlen(libname);
+}
+
+static int slbt_clean_library(
+	struct slbt_clean_ctx *		cctx,
+	const char *			path,
+	const char *			dirname,
+	const char *			base)
+{
+	const struct slbt_driver_ctx *	dctx;
+	struct slbt_txtfile_ctx *	tctx;
+	struct slbt_clean_dir *		objdir;
+	struct slbt_clean_dir *		ddir;
+	struct slbt_clean_name *	slot;
+	const char **			pline;
+	const char *			value;
+	const char *			name;
+	const char *			mark;
+	char				buf[PATH_MAX];
+
+	dctx = cctx->dctx;
+
+	if (!(ddir = slbt_clean_get_dir(cctx,dirname)))
+		return SLBT_NESTED_ERROR(dctx);
+
+	if (!(objdir = slbt_clean_get_objdir(cctx,dirname)))
+		return SLBT_NESTED_ERROR(dctx);
+
+	/* libfoo.* */
+	if (slbt_clean_library_stem(
+			cctx,objdir,ddir,base,
+			strrchr(base,'.') - base) < 0)
+		return SLBT_NESTED_ERROR(dctx);
+
+	/* library names of the wrapper, e.g. libfoo-1.2.so */
+	if (!(slot = slbt_clean_dir_lookup(ddir,base)) || slot->fdir)
+		return 0;
+
+	if (slbt_lib_get_txtfile_ctx(dctx,path,&tctx) < 0)
+		return SLBT_NESTED_ERROR(dctx);
+
+	for (pline=tctx->txtlinev; *pline; pline++) {
+		if (!(value = slbt_clean_wrapper_value(*pline,"dlname",&buf)))
+			if (!(value = slbt_clean_wrapper_value(*pline,"library_names",&buf)))
+				if (!(value = slbt_clean_wrapper_value(*pline,"old_library",&buf)))
+					continue;
+
+		for (name=value; *name; name=mark) {
+			for (; *name==' '; )
+				name++;
+
+			for (mark=name; *mark && (*mark != ' '); )
+				mark++;
+
+			if ((mark > name) && (slbt_clean_library_stem(
+					cctx,objdir,ddir,name,
+					slbt_clean_library_stemlen(dctx,name)) < 0)) {
+				slbt_lib_free_txtfile_ctx(tctx);
+				return SLBT_NESTED_ERROR(dctx);
+			}
+		}
+	}
+
+	slbt_lib_free_txtfile_ctx(tctx);
+
+	return 0;
+}
+
+static int slbt_clean_program(
+	struct slbt_clean_ctx *		cctx,
+	const char *			dirname,
+	const char *			base)
+{
+	const struct slbt_driver_ctx *	dctx;
+	struct slbt_clean_dir *		objdir;
+	struct slbt_clean_dir *		ddir;
+	const char **			psuffix;
+	char				name[PATH_MAX];
+	bool				fprogram;
+
+	static const char * suffixv[] = {
+		"",
+		".exe.wrapper",
+		SLBT_LAUNCHER_SUFFIX,
+		SLBT_LAUNCHER_SUFFIX ".tmp",
+		".dlopen.c",
+		".dlopen.o",
+		".dlopen.o.key",
+		".dlpreopen.a",
+		0};
+
+	dctx = cctx->dctx;
+
+	if (!(ddir = slbt_clean_get_dir(cctx,dirname)))
+		return SLBT_NESTED_ERROR(dctx);
+
+	if (!(objdir = slbt_clean_get_objdir(cctx,dirname)))
+		return SLBT_NESTED_ERROR(dctx);
+
+	/* a program that was linked by slibtool? */
+	fprogram = false;
+
+	for (psuffix=&suffixv[1]; !fprogram && (psuffix<&suffixv[4]); psuffix++) {
+		if (slbt_snprintf(name,sizeof(name),"%s%s",base,*psuffix) < 0)
+			return SLBT_BUFFER_ERROR(dctx);
+
+		fprogram = !!slbt_clean_dir_lookup(objdir,name);
+	}
+
+	if (slbt_snprintf(name,sizeof(name),"%s.wrapper.tmp",base) < 0)
+		return SLBT_BUFFER_ERROR(dctx);
+
+	if (!fprogram && !slbt_clean_dir_lookup(ddir,name))
+		return 0;
+
+	if (slbt_clean_mark_dir_entry(cctx,ddir,name) < 0)
+		return SLBT_NESTED_ERROR(dctx);
+
+	/* executable image, wrapper, launcher, dlsyms by-products */
+	for (psuffix=suffixv; *psuffix; psuffix++) {
+		if (slbt_snprintf(name,sizeof(name),"%s%s",base,*psuffix) < 0)
+			return SLBT_BUFFER_ERROR(dctx);
+
+		if (slbt_clean_mark_dir_entry(cctx,objdir,name) < 0)
+			return SLBT_NESTED_ERROR(dctx);
+	}
+
+	if (slbt_snprintf(name,sizeof(name),"%s%s",
+			base,dctx->cctx->settings.mapsuffix) < 0)
+		return SLBT_BUFFER_ERROR(dctx);
+
+	return slbt_clean_mark_dir_entry(cctx,objdir,name);
+}
+
+static int slbt_exec_clean_entry(
+	struct slbt_clean_ctx *		cctx,
+	struct slbt_exec_ctx *		ectx,
+	const char *			path)
+{
+	const struct slbt_driver_ctx *	dctx;
+	const char *			base;
+	const char *			dot;
+	int				ret;
+	char				dirname[PATH_MAX];
+
+	dctx = cctx->dctx;
+
+	if (slbt_clean_split_path(path,&dirname,&base) < 0)
+		return SLBT_BUFFER_ERROR(dctx);
+
+	/* the argument itself */
+	if (slbt_clean_mark_path(cctx,path,true) < 0)
+		return SLBT_NESTED_ERROR(dctx);
+
+	/* derived artifacts */
+	dot = strrchr(base,'.');
+
+	if (dot && !strcmp(dot,".lo"))
+		ret = slbt_clean_object(cctx,path,dirname,base);
+
+	else if (dot && !strcmp(dot,".la"))
+		ret = slbt_clean_library(cctx,path,dirname,base);
+
+	else if (dot && !strcmp(dot,".o"))
+		ret = 0;
+
+	else if (base[0])
+		ret = slbt_clean_program(cctx,dirname,base);
+
+	else
+		ret = 0;
+
+	if (ret < 0)
+		return SLBT_NESTED_ERROR(dctx);
+
+	/* output */
+	ectx->argv    = cctx->outv;
+	ectx->program = cctx->outv[0];
+
+	if (cctx->nout > cctx->nopts)
+		if (!(dctx->cctx->drvflags & SLBT_DRIVER_SILENT))
+			if (slbt_output_clean(ectx))
+				return SLBT_NESTED_ERROR(dctx);
+
+	for (; cctx->nout > cctx->nopts; cctx->nout--)
+		free(cctx->outv[cctx->nout - 1]);
+
+	cctx->outv[cctx->nout] = 0;
+
+	return 0;
+}
+
+static void slbt_clean_remove_dir(
+	struct slbt_clean_ctx *		cctx,
+	struct slbt_clean_dir *		dir)
+{
+	struct slbt_clean_name *	slot;
+	struct slbt_clean_name *	cap;
+	int				ret;
+
+	slot = dir->namev;
+	cap  = &slot[dir->nnames];
+
+	for (; slot<cap; slot++) {
+		if (!slot->fremove)
+			continue;
+
+		if (slot->fdir && (cctx->flags & SLBT_UNINSTALL_RMDIR))
+			ret = unlinkat(dir->fd,slot->name,AT_REMOVEDIR);
+		else
+			ret = unlinkat(dir->fd,slot->name,0);
+
+		if (ret == 0)
+			continue;
+
+		/* already gone, or a directory that is not empty */
+		if (errno == ENOENT)
+			continue;
+
+		if (slot->fdir && (cctx->flags & SLBT_UNINSTALL_RMDIR))
+			if ((errno == EEXIST) || (errno == ENOTEMPTY))
+				continue;
+
+		if (!dir->errname) {
+			dir->errname = slot->name;
+			dir->errnum  = errno;
+		}
+	}
+}
+
+static void * slbt_clean_worker(void * arg)
+{
+	struct slbt_clean_ctx *		cctx;
+	struct slbt_clean_dir *		dir;
+
+	cctx = arg;
+
+	for (;;) {
+		pthread_mutex_lock(&cctx->lock);
+
+		dir = (cctx->next < cctx->ndirs)
+			? cctx->dirv[cctx->next++] : 0;
+
+		pthread_mutex_unlock(&cctx->lock);
+
+		if (!dir)
+			return 0;
+
+		slbt_clean_remove_dir(cctx,dir);
+	}
+}
+
+static long slbt_exec_clean_get_jobs(const struct slbt_driver_ctx * dctx)
+{
+	long	njobs;
+	char *	mark;
+
+	if (dctx->cctx->cleanjobs) {
+		njobs = strtol(dctx->cctx->cleanjobs,&mark,10);
+
+		if ((njobs <= 0) || *mark) {
+			slbt_dprintf(
+				slbt_driver_fderr(dctx),
+				"%s: error: invalid --clean-jobs argument: %s.\n",
+				dctx->program,dctx->cctx->cleanjobs);
+			return -1;
+		}
+
+		return njobs;
+	}
+
+	if ((njobs = sysconf(_SC_NPROCESSORS_ONLN)) <= 0)
+		njobs = 1;
+
+	return njobs;
+}
+
+static int slbt_exec_clean_remove(
+	struct slbt_clean_ctx *		cctx,
+	long				njobs)
+{
+	const struct slbt_driver_ctx *	dctx;
+	struct slbt_clean_dir *		dir;
+	pthread_t *			tidv;
+	bool *				fthreadv;
+	long				idx;
+	char				path[PATH_MAX];
+
+	dctx = cctx->dctx;
+
+	/* directories with entries to remove, in command-line order */
+	for (dir=cctx->dirs; dir; dir=dir->next)
+		cctx->ndirs += !!dir->nremove;
+
+	if (!cctx->ndirs)
+		return 0;
+
+	if (!(cctx->dirv = calloc(cctx->ndirs,sizeof(*cctx->dirv))))
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	for (idx=0, dir=cctx->dirs; dir; dir=dir->next)
+		if (dir->nremove)
+			cctx->dirv[idx++] = dir;
+
+	/* the calling thread is the first worker */
+	if ((size_t)njobs > cctx->ndirs)
+		njobs = cctx->ndirs;
+
+	tidv     = 0;
+	fthreadv = 0;
+
+	if (njobs > 1) {
+		tidv     = calloc(njobs,sizeof(*tidv));
+		fthreadv = calloc(njobs,sizeof(*fthreadv));
+	}
+
+	pthread_mutex_init(&cctx->lock,0);
+
+	for (idx=1; tidv && fthreadv && (idx<njobs); idx++)
+		fthreadv[idx] = !pthread_create(
+			&tidv[idx],0,
+			slbt_clean_worker,
+			cctx);
+
+	slbt_clean_worker(cctx);
+
+	for (idx=1; tidv && fthreadv && (idx<njobs); idx++)
+		if (fthreadv[idx])
+			pthread_join(tidv[idx],0);
+
+	pthread_mutex_destroy(&cctx->lock);
+
+	free(tidv);
+	free(fthreadv);
+
+	/* first failure, in command-line order */
+	for (idx=0; (size_t)idx<cctx->ndirs; idx++) {
+		if ((dir = cctx->dirv[idx])->errname) {
+			slbt_clean_join_path(&path,dir->path,dir->errname);
+			errno = dir->errnum;
+			return SLBT_SYSTEM_ERROR(dctx,path);
+		}
+	}
+
+	/* object directories that are now empty */
+	for (idx=0; (size_t)idx<cctx->ndirs; idx++) {
+		dir = cctx->dirv[idx];
+
+		if (dir->fobjdir && (dir->nremove == dir->nnames))
+			if (!dir->parent->fgone)
+				unlinkat(dir->parent->fd,dir->base,AT_REMOVEDIR);
+	}
+
+	return 0;
+}
+
+int slbt_exec_clean(const struct slbt_driver_ctx * dctx)
+{
+	int				fdout;
+	long				njobs;
+	char **				iargv;
+	uint32_t			flags;
+	struct slbt_exec_ctx *		ectx;
+	struct argv_meta *		meta;
+	struct argv_entry *		entry;
+	struct slbt_clean_ctx		cctx;
+	const struct argv_option *	optv[SLBT_OPTV_ELEMENTS];
+
+	/* dry run */
+	if (dctx->cctx->drvflags & SLBT_DRIVER_DRY_RUN)
+		return 0;
+
+	/* context */
+	if (slbt_ectx_get_exec_ctx(dctx,&ectx) < 0)
+		return  SLBT_NESTED_ERROR(dctx);
+
+	/* initial state, clean mode skin (rm options, as in uninstall mode) */
+	slbt_ectx_reset_arguments(ectx);
+	slbt_disable_placeholders(ectx);
+	iargv = ectx->cargv;
+	fdout = slbt_driver_fdout(dctx);
+
+	/* missing arguments? */
+	slbt_optv_init(slbt_uninstall_options,optv);
+
+	if (!iargv[1] && (dctx->cctx->drvflags & SLBT_DRIVER_VERBOSITY_USAGE))
+		return slbt_clean_usage(
+			fdout,
+			dctx->program,
+			0,optv,0,
+			dctx->cctx->drvflags & SLBT_DRIVER_ANNOTATE_NEVER);
+
+	/* <clean> argv meta */
+	if (!(meta = slbt_argv_get(
+			iargv,optv,
+			dctx->cctx->drvflags & SLBT_DRIVER_VERBOSITY_ERRORS
+				? ARGV_VERBOSITY_ERRORS
+				: ARGV_VERBOSITY_NONE,
+			fdout)))
+		return slbt_exec_clean_fail(
+			ectx,meta,
+			SLBT_CUSTOM_ERROR(dctx,SLBT_ERR_CLEAN_FAIL));
+
+	/* output vector: the rm program and options, then the files */
+	memset(&cctx,0,sizeof(cctx));
+	cctx.dctx   = dctx;
+	cctx.outcap = 16;
+
+	for (entry=meta->entries; entry->fopt || entry->arg; entry++)
+		cctx.outcap++;
+
+	if (!(cctx.outv = calloc(cctx.outcap,sizeof(char *))))
+		return slbt_exec_clean_fail(
+			ectx,meta,
+			SLBT_SYSTEM_ERROR(dctx,0));
+
+	cctx.outv[cctx.nout++] = iargv[0];
+	flags = 0;
+
+	for (entry=meta->entries; entry->fopt || entry->arg; entry++) {
+		if (entry->fopt) {
+			switch (entry->tag) {
+				case TAG_UNINSTALL_SYSROOT:
+					break;
+
+				case TAG_UNINSTALL_HELP:
+					flags |= SLBT_UNINSTALL_HELP;
+					break;
+
+				case TAG_UNINSTALL_VERSION:
+					flags |= SLBT_UNINSTALL_VERSION;
+					break;
+
+				case TAG_UNINSTALL_FORCE:
+					cctx.outv[cctx.nout++] = "-f";
+					flags |= SLBT_UNINSTALL_FORCE;
+					break;
+
+				case TAG_UNINSTALL_RMDIR:
+					cctx.outv[cctx.nout++] = "-d";
+					flags |= SLBT_UNINSTALL_RMDIR;
+					break;
+
+				case TAG_UNINSTALL_VERBOSE:
+					cctx.outv[cctx.nout++] = "-v";
+					flags |= SLBT_UNINSTALL_VERBOSE;
+					break;
+			}
+		}
+	}
+
+	cctx.nopts = cctx.nout;
+	cctx.flags = flags;
+
+	/* --help */
+	if (flags & SLBT_UNINSTALL_HELP) {
+		slbt_clean_free_dirs(&cctx);
+		slbt_clean_usage(
+			fdout,
+			dctx->program,
+			0,optv,meta,
+			dctx->cctx->drvflags & SLBT_DRIVER_ANNOTATE_NEVER);
+		slbt_ectx_free_exec_ctx(ectx);
+		return 0;
+	}
+
+	/* jobs */
+	if ((njobs = slbt_exec_clean_get_jobs(dctx)) < 0) {
+		slbt_clean_free_dirs(&cctx);
+		return slbt_exec_clean_fail(
+			ectx,meta,
+			SLBT_CUSTOM_ERROR(dctx,SLBT_ERR_CLEAN_FAIL));
+	}
+
+	/* resolve all entries, then remove */
+	for (entry=meta->entries; entry->fopt || entry->arg; entry++) {
+		if (!entry->fopt) {
+			if (slbt_exec_clean_entry(&cctx,ectx,entry->arg) < 0) {
+				ectx->argv = ectx->altv;
+				slbt_clean_free_dirs(&cctx);
+				return slbt_exec_clean_fail(
+					ectx,meta,
+					SLBT_NESTED_ERROR(dctx));
+			}
+		}
+	}
+
+	ectx->argv = ectx->altv;
+
+	if (slbt_exec_clean_remove(&cctx,njobs) < 0) {
+		slbt_clean_free_dirs(&cctx);
+		return slbt_exec_clean_fail(
+			ectx,meta,
+			SLBT_NESTED_ERROR(dctx));
+	}
+
+	slbt_clean_free_dirs(&cctx);
+	slbt_argv_free(meta);
+	slbt_ectx_free_exec_ctx(ectx);
+
+	return 0;
+}
@@ -15,6 +15,7 @@
 #include "slibtool_mkdir_impl.h"
 #include "slibtool_errinfo_impl.h"
 #include "slibtool_metafile_impl.h"
+#include "slibtool_objcache_impl.h"
 
 static int slbt_exec_compile_remove_file(
 	const struct slbt_driver_ctx *	dctx,
@@ -170,6 +171,33 @@ static int slbt_exec_compile_finalize_argument_vector(
 	return 0;
 }
 
+static int slbt_exec_compile_object(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_exec_ctx *		ectx,
+	const char *			objname)
+{
+	struct slbt_objcache_key	key;
+
+	/* object cache lookup */
+	if (slbt_objcache_get_key(dctx,ectx,&key) < 0)
+		return SLBT_NESTED_ERROR(dctx);
+
+	if (slbt_objcache_restore(dctx,&key,objname) > 0)
+		return 0;
+
+	/* compile */
+	if ((slbt_spawn(ectx,true) < 0) && (ectx->pid < 0))
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	else if (ectx->exitcode)
+		return SLBT_CUSTOM_ERROR(dctx,SLBT_ERR_COMPILE_ERROR);
+
+	/* object cache store */
+	return slbt_objcache_store(dctx,&key,objname)
+		? SLBT_NESTED_ERROR(dctx)
+		: 0;
+}
+
 int  slbt_exec_compile(const struct slbt_driver_ctx * dctx)
 {
 	int				ret;
@@ -244,13 +272,9 @@ int  slbt_exec_compile(const struct slbt_driver_ctx * dctx)
 			}
 		}
 
-		if ((slbt_spawn(ectx,true) < 0) && (ectx->pid < 0)) {
-			slbt_ectx_free_exec_ctx(ectx);
-			return SLBT_SYSTEM_ERROR(dctx,0);
-
-		} else if (ectx->exitcode) {
+		if ((ret = slbt_exec_compile_object(dctx,ectx,ectx->lobjname))) {
 			slbt_ectx_free_exec_ctx(ectx);
-			return SLBT_CUSTOM_ERROR(dctx,SLBT_ERR_COMPILE_ERROR);
+			return ret;
 		}
 
 		if (fstatic)
@@ -279,13 +303,9 @@ int  slbt_exec_compile(const struct slbt_driver_ctx * dctx)
 			}
 		}
 
-		if ((slbt_spawn(ectx,true) < 0) && (ectx->pid < 0)) {
-			slbt_ectx_free_exec_ctx(ectx);
-			return SLBT_SYSTEM_ERROR(dctx,0);
-
-		} else if (ectx->exitcode) {
+		if ((ret = slbt_exec_compile_object(dctx,ectx,ectx->aobjname))) {
 			slbt_ectx_free_exec_ctx(ectx);
-			return SLBT_CUSTOM_ERROR(dctx,SLBT_ERR_COMPILE_ERROR);
+			return ret;
 		}
 	}
 
@@ -37,6 +37,26 @@ static size_t slbt_parse_comma_separated_flags(
 }
 
 
+/* in-place transformations (foo.lo --> .libs/foo.o, libfoo.la --> */
+/* .libs/libfoo.so --> -L.libs -lfoo, etc.) only ever apply to     */
+/* non-switch arguments that have a suffix; only those arguments   */
+/* are followed by extension space in the argument string buffer. */
+/* execute mode is the exception: a wrapper script argument has no */
+/* suffix, yet is rewritten in place (prog --> .libs/prog).        */
+static bool slbt_exec_ctx_arg_extensible(
+	const struct slbt_driver_ctx *  dctx,
+	const char *                    arg)
+{
+	if (arg[0] == '-')
+		return false;
+
+	if (dctx->cctx->mode == SLBT_MODE_EXECUTE)
+		return true;
+
+	return strrchr(arg,'.');
+}
+
+
 static char * slbt_source_file(char ** argv)
 {
 	char **	parg;
@@ -89,33 +109,38 @@ static struct slbt_exec_ctx_impl * slbt_exec_ctx_alloc(
 	/* internal driver context for host-specific tool arguments */
 	ctx = slbt_get_driver_ictx(dctx);
 
-	/* initial buffer size (cargv, -Wc), .libs/.exe.wrapper */
+	/* per-argument extension space, .libs/.exe.wrapper */
 	argc = 0;
 	csrc = 0;
 	size = 0;
 	exts = 20;
 
+	if (dctx->cctx->shrext) {
+		exts += strlen(dctx->cctx->shrext);
+	}
+
+	if (dctx->cctx->settings.dsosuffix) {
+		exts += strlen(dctx->cctx->settings.dsosuffix);
+	}
+
+	/* initial buffer size (cargv, -Wc), extension space as needed */
 	for (parg=dctx->cctx->cargv; *parg; parg++, argc++) {
 		if (!(strncmp("-Wc,",*parg,4))) {
 			size += slbt_parse_comma_separated_flags(
 				&(*parg)[4],&argc) + 1;
 		} else {
 			size += strlen(*parg) + 1;
-		}
-	}
 
-	/* argument transformation: assume for each argv member */
-	if (dctx->cctx->shrext) {
-		exts += argc * (strlen(dctx->cctx->shrext));
+			if (slbt_exec_ctx_arg_extensible(dctx,*parg))
+				size += exts;
+		}
 	}
 
-	if (dctx->cctx->settings.dsosuffix) {
-		exts += argc * (strlen(dctx->cctx->settings.dsosuffix));
+	/* buffer size (csrc, ldirname, lbasename, lobjname, aobjname, etc.) */
+	if (dctx->cctx->release) {
+		size += strlen(dctx->cctx->release) * SLBT_ECTX_LIB_EXTRAS;
 	}
 
-	size += argc * exts;
-
-	/* buffer size (csrc, ldirname, lbasename, lobjname, aobjname, etc.) */
 	if (dctx->cctx->libname) {
 		slen  = strlen(dctx->cctx->libname);
 		size += (strlen(".slibtool.expsyms.extension") + slen + exts + 1) * SLBT_ECTX_LIB_EXTRAS;
@@ -190,10 +215,13 @@ static struct slbt_exec_ctx_impl * slbt_exec_ctx_alloc(
 	ictx->exts   = exts;
 	ictx->shadow = shadow;
 
-	ictx->ctx.csrc  = csrc;
-	ictx->fdwrapper = (-1);
+	ictx->ctx.csrc   = csrc;
+	ictx->fdwrapper  = (-1);
+	ictx->fdlauncher = (-1);
+	ictx->fdout      = (-1);
+	ictx->fderr      = (-1);
 
-	ictx->ctx.envp  = slbt_driver_envp(dctx);
+	ictx->ctx.envp   = slbt_driver_envp(dctx);
 
 	return ictx;
 }
@@ -321,7 +349,9 @@ int  slbt_ectx_get_exec_ctx(
 		} else {
 			ictx->ctx.argv[i++] = ch;
 			ch += sprintf(ch,"%s",*parg);
-			ch += ictx->exts;
+
+			if (slbt_exec_ctx_arg_extensible(dctx,*parg))
+				ch += ictx->exts;
 		}
 	}
 
@@ -703,11 +733,9 @@ int  slbt_ectx_get_exec_ctx(
 					dctx,
 					ictx->ctx.ldirname));
 
-		if (slbt_ar_create_dlsyms(
-					ictx->dlactxv,
-					ictx->ctx.dlunit,
-					ictx->ctx.dlopensrc,
-					0644) < 0)
+		/* with -dlpreopen self, the source is generated during linking */
+		if (!(dctx->cctx->drvflags & SLBT_DRIVER_DLPREOPEN_SELF))
+			if (slbt_exec_link_create_dlsyms_source(dctx,&ictx->ctx) < 0)
 				return slbt_ectx_free_exec_ctx_impl(
 					ictx,
 					SLBT_NESTED_ERROR(dctx));
@@ -763,6 +791,9 @@ static int slbt_ectx_free_exec_ctx_impl(
 	if (ictx->fdwrapper >= 0)
 		close(ictx->fdwrapper);
 
+	if (ictx->fdlauncher >= 0)
+		close(ictx->fdlauncher);
+
 	if (ictx->dlactxv) {
 		for (dlactxv=ictx->dlactxv; *dlactxv; dlactxv++)
 			slbt_ar_free_archive_ctx(*dlactxv);
@@ -770,6 +801,8 @@ static int slbt_ectx_free_exec_ctx_impl(
 		free(ictx->dlactxv);
 	}
 
+	slbt_free_deps_nodes(ictx->depnodes);
+
 	free(ictx->args);
 	free(ictx->shadow);
 	free(ictx->vbuffer);
@@ -4,8 +4,10 @@
 /*  Released under the Standard MIT License; see COPYING.SLIBTOOL. */
 /*******************************************************************/
 
+#include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
 #include <sys/stat.h>
@@ -13,9 +15,12 @@
 #include <slibtool/slibtool.h>
 #include "slibtool_spawn_impl.h"
 #include "slibtool_driver_impl.h"
+#include "slibtool_launcher_impl.h"
 #include "slibtool_snprintf_impl.h"
 #include "slibtool_errinfo_impl.h"
 
+extern char ** environ;
+
 
 /*******************************************************************/
 /* --mode=execute: wrapper script and execution argument vector    */
@@ -68,6 +73,12 @@
 /* created at link time for _all_ executable programs, including   */
 /* those programs which appear to have system libraries as their   */
 /* sole dynamic library dependencies.                              */
+/*                                                                 */
+/* In the second case, and provided that the launcher file which   */
+/* was created alongside the wrapper script is present and refers  */
+/* to the same program, slibtool would do the wrapper script's job */
+/* itself: set the load environment variable as the script would,  */
+/* and then directly exec the program, without a shell in between. */
 /*******************************************************************/
 
 
@@ -113,6 +124,153 @@ static int slbt_argument_is_an_executable_wrapper_script(
 }
 
 
+static char * slbt_exec_launcher_record(
+	char *		mark,
+	char *		cap,
+	const char *	key,
+	char **		pnext)
+{
+	char *	eol;
+	size_t	keylen;
+
+	if (!(eol = memchr(mark,'\n',cap - mark)))
+		return 0;
+
+	*eol   = '\0';
+	*pnext = ++eol;
+
+	keylen = strlen(key);
+
+	return strncmp(mark,key,keylen) ? 0 : &mark[keylen];
+}
+
+/* environment vector of the wrapper script, based on the launcher; */
+/* returns zero if the wrapper script should be used after all.      */
+static char ** slbt_exec_launcher_envp(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_exec_ctx *		ectx,
+	const char *			exeprog)
+{
+	int		fdcwd;
+	int		fd;
+	ssize_t		nread;
+	size_t		nbytes;
+	size_t		envlen;
+	size_t		nenv;
+	size_t		ndlpath;
+	char *		buf;
+	char *		mark;
+	char *		cap;
+	char *		next;
+	char *		env;
+	char *		cwd;
+	char *		exe;
+	char *		dlpath;
+	char *		dst;
+	char *		dlval;
+	const char *	curval;
+	char **		penv;
+	char **		envp;
+	char **		envv;
+	struct stat	st;
+	struct stat	exest;
+	char		launcher[PATH_MAX];
+
+	fdcwd = slbt_driver_fdcwd(dctx);
+
+	if (slbt_snprintf(launcher,sizeof(launcher),
+			"%s%s",exeprog,
+			SLBT_LAUNCHER_SUFFIX) < 0)
+		return 0;
+
+	if ((fd = openat(fdcwd,launcher,O_RDONLY|O_CLOEXEC,0)) < 0)
+		return 0;
+
+	if ((fstat(fd,&st) < 0) || !(buf = malloc(st.st_size + 1))) {
+		close(fd);
+		return 0;
+	}
+
+	for (nbytes=0; nbytes<(size_t)st.st_size; nbytes+=nread)
+		if ((nread = read(fd,&buf[nbytes],st.st_size - nbytes)) <= 0)
+			break;
+
+	close(fd);
+
+	/* header */
+	mark = buf;
+	cap  = &buf[nbytes];
+	env  = 0;
+	cwd  = 0;
+	exe  = 0;
+
+	if (slbt_exec_launcher_record(mark,cap,SLBT_LAUNCHER_SIGNATURE,&next))
+		if ((env = slbt_exec_launcher_record(next,cap,SLBT_LAUNCHER_ENV,&next)))
+			if ((cwd = slbt_exec_launcher_record(next,cap,SLBT_LAUNCHER_CWD,&next)))
+				exe = slbt_exec_launcher_record(next,cap,SLBT_LAUNCHER_EXE,&next);
+
+	/* same program? */
+	if (!exe || !*env || (fstatat(fdcwd,exeprog,&st,0) < 0) || (stat(exe,&exest) < 0)
+			|| (st.st_dev != exest.st_dev) || (st.st_ino != exest.st_ino)) {
+		free(buf);
+		return 0;
+	}
+
+	/* current value of the load environment variable */
+	envlen = strlen(env);
+
+	for (penv=ectx->envp, curval=0, nenv=0; penv && *penv; penv++, nenv++)
+		if (!strncmp(*penv,env,envlen) && ((*penv)[envlen] == '='))
+			curval = &(*penv)[envlen + 1];
+
+	/* DL_PATH, as in the wrapper script */
+	for (mark=next, ndlpath=0; mark<cap; mark++)
+		if (*mark == '\n')
+			ndlpath++;
+
+	nbytes  = envlen + (cap - next) + 4;
+	nbytes += ndlpath * (strlen(cwd) + 2);
+	nbytes += curval ? strlen(curval) : 0;
+
+	if (!(dlval = malloc(nbytes))) {
+		free(buf);
+		return 0;
+	}
+
+	dst  = dlval;
+	dst += sprintf(dst,"%s=",env);
+
+	for (mark=next; (dlpath = slbt_exec_launcher_record(
+			mark,cap,SLBT_LAUNCHER_DLPATH,&next)); mark=next) {
+		if (dst[-1] != '=')
+			*dst++ = ':';
+
+		dst += (dlpath[0] == '/')
+			? sprintf(dst,"%s",dlpath)
+			: sprintf(dst,"%s/%s",cwd,dlpath);
+	}
+
+	if (curval && *curval)
+		dst += sprintf(dst,":%s",curval);
+
+	/* environment vector */
+	if (!(envv = calloc(nenv + 2,sizeof(char *)))) {
+		free(dlval);
+		free(buf);
+		return 0;
+	}
+
+	for (penv=ectx->envp, envp=envv; penv && *penv; penv++)
+		if (strncmp(*penv,env,envlen) || ((*penv)[envlen] != '='))
+			*envp++ = *penv;
+
+	*envp = dlval;
+
+	free(buf);
+
+	return envv;
+}
+
 int slbt_exec_execute(const struct slbt_driver_ctx * dctx)
 {
 	int			ret;
@@ -120,6 +278,7 @@ int slbt_exec_execute(const struct slbt_driver_ctx * dctx)
 	char **                 aarg;
 	char *			program;
 	char *                  exeref;
+	char **                 envp;
 	char			wrapper[PATH_MAX];
 	char			exeprog[PATH_MAX];
 	char			argbuf [PATH_MAX];
@@ -182,9 +341,12 @@ int slbt_exec_execute(const struct slbt_driver_ctx * dctx)
 
 	*aarg = 0;
 
+	/* launcher: the wrapper script's environment, without the script */
+	envp = exeref ? slbt_exec_launcher_envp(dctx,ectx,exeprog) : 0;
+
 	/* execute mode */
-	ectx->program = ectx->altv[0];
-	ectx->argv    = ectx->altv;
+	ectx->program = envp ? ectx->altv[1] : ectx->altv[0];
+	ectx->argv    = envp ? &ectx->altv[1] : ectx->altv;
 
 	/* step output */
 	if (!(dctx->cctx->drvflags & SLBT_DRIVER_SILENT)) {
@@ -194,7 +356,16 @@ int slbt_exec_execute(const struct slbt_driver_ctx * dctx)
 		}
 	}
 
-	execvp(ectx->altv[0],ectx->altv);
+	if (!envp) {
+		execvp(ectx->program,ectx->argv);
+
+	} else if (strchr(ectx->program,'/')) {
+		execve(ectx->program,ectx->argv,envp);
+
+	} else {
+		environ = envp;
+		execvp(ectx->program,ectx->argv);
+	}
 
 	slbt_ectx_free_exec_ctx(ectx);
 	return SLBT_SYSTEM_ERROR(dctx,0);
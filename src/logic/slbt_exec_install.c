@@ -10,19 +10,25 @@
 #include <stdbool.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
 #include <sys/stat.h>
 
 #include <slibtool/slibtool.h>
 #include "slibtool_driver_impl.h"
 #include "slibtool_install_impl.h"
+#include "slibtool_installer_impl.h"
 #include "slibtool_mapfile_impl.h"
 #include "slibtool_readlink_impl.h"
-#include "slibtool_spawn_impl.h"
 #include "slibtool_symlink_impl.h"
 #include "slibtool_errinfo_impl.h"
 #include "slibtool_snprintf_impl.h"
+#include "slibtool_tmpfile_impl.h"
 #include "argv/argv.h"
 
+static pthread_mutex_t slbt_install_host_lock = PTHREAD_MUTEX_INITIALIZER;
+
 static int slbt_install_usage(
 	int				fdout,
 	const char *			program,
@@ -319,6 +325,7 @@ static int slbt_exec_install_library_wrapper(
 static int slbt_exec_install_entry(
 	const struct slbt_driver_ctx *	dctx,
 	struct slbt_exec_ctx *		ectx,
+	const struct slbt_installer *	inst,
 	struct argv_entry *		entry,
 	struct argv_entry *		last,
 	struct argv_entry *		dest,
@@ -398,14 +405,8 @@ static int slbt_exec_install_entry(
 			if (slbt_output_install(ectx))
 				return SLBT_NESTED_ERROR(dctx);
 
-		if ((slbt_spawn(ectx,true) < 0) && (ectx->pid < 0)) {
-			return SLBT_SPAWN_ERROR(dctx);
-
-		} else if (ectx->exitcode) {
-			return SLBT_CUSTOM_ERROR(
-				dctx,
-				SLBT_ERR_INSTALL_ERROR);
-		}
+		if (slbt_installer_install_file(dctx,ectx,inst,*src,*dst) < 0)
+			return SLBT_NESTED_ERROR(dctx);
 
 		return 0;
 	}
@@ -534,12 +535,18 @@ static int slbt_exec_install_entry(
 		host++;
 	}
 
-	/* symlink-based alternate host */
-	if (slbt_host_set_althost(dctx,host,host))
+	/* symlink-based alternate host (entries may be installed concurrently) */
+	pthread_mutex_lock(&slbt_install_host_lock);
+
+	if (slbt_host_set_althost(dctx,host,host)) {
+		pthread_mutex_unlock(&slbt_install_host_lock);
 		return SLBT_NESTED_ERROR(dctx);
+	}
 
 	fpe = !strcmp(dctx->cctx->asettings.imagefmt,"pe");
 
+	pthread_mutex_unlock(&slbt_install_host_lock);
+
 	/* libfoo.a --> libfoo.so */
 	strcpy(dot,dsosuffix);
 
@@ -568,14 +575,8 @@ static int slbt_exec_install_entry(
 			if (slbt_output_install(ectx))
 				return SLBT_NESTED_ERROR(dctx);
 
-		if ((slbt_spawn(ectx,true) < 0) && (ectx->pid < 0)) {
-			return SLBT_SPAWN_ERROR(dctx);
-
-		} else if (ectx->exitcode) {
-			return SLBT_CUSTOM_ERROR(
-				dctx,
-				SLBT_ERR_INSTALL_ERROR);
-		}
+		if (slbt_installer_install_file(dctx,ectx,inst,*src,*dst) < 0)
+			return SLBT_NESTED_ERROR(dctx);
 
 		return 0;
 	}
@@ -598,14 +599,8 @@ static int slbt_exec_install_entry(
 		if (slbt_output_install(ectx))
 			return SLBT_NESTED_ERROR(dctx);
 
-	if ((slbt_spawn(ectx,true) < 0) && (ectx->pid < 0)) {
-		return SLBT_SPAWN_ERROR(dctx);
-
-	} else if (ectx->exitcode) {
-		return SLBT_CUSTOM_ERROR(
-			dctx,
-			SLBT_ERR_INSTALL_ERROR);
-	}
+	if (slbt_installer_install_file(dctx,ectx,inst,*src,*dst) < 0)
+		return SLBT_NESTED_ERROR(dctx);
 
 	/* destination symlink: dstdir/libfoo.so */
 	if (slbt_snprintf(dlnkname,sizeof(dlnkname),
@@ -685,6 +680,326 @@ static int slbt_exec_install_entry(
 	return 0;
 }
 
+/*****************************************************************/
+/* --install-jobs: independent entries are installed by a pool   */
+/* of worker threads, each with its own exec context. an entry's */
+/* symlinks are created by the same worker once its copy has     */
+/* completed. the output of every worker, including that of the */
+/* tools which it spawns, goes to private temporary files, which */
+/* are then replayed in command-line order up to the first       */
+/* failing entry; the error vector is likewise that of the first */
+/* failing entry, just as in a sequential run.                   */
+/*****************************************************************/
+
+struct slbt_install_buf {
+	int                             fd;
+	off_t                           offset;
+	off_t                           size;
+};
+
+struct slbt_install_job {
+	struct argv_entry *             entry;
+	struct slbt_install_buf         out;
+	struct slbt_install_buf         err;
+	pthread_t                       tid;
+	int                             status;
+};
+
+struct slbt_install_pool {
+	const struct slbt_driver_ctx *  dctx;
+	const struct slbt_installer *   inst;
+	struct argv_entry *             last;
+	struct argv_entry *             dest;
+	char *                          dstdir;
+	struct slbt_install_job *       jobv;
+	size_t                          njobs;
+	size_t                          next;
+	bool                            fabort;
+	pthread_mutex_t                 lock;
+};
+
+struct slbt_install_worker {
+	struct slbt_install_pool *      pool;
+	struct slbt_exec_ctx *          ectx;
+	char **                         src;
+	char **                         dst;
+	pthread_t                       tid;
+	int                             fdout;
+	int                             fderr;
+	bool                            fthread;
+};
+
+static long slbt_exec_install_get_jobs(const struct slbt_driver_ctx * dctx)
+{
+	long	njobs;
+	char *	mark;
+
+	if (dctx->cctx->installjobs) {
+		njobs = strtol(dctx->cctx->installjobs,&mark,10);
+
+		if ((njobs <= 0) || *mark) {
+			slbt_dprintf(
+				slbt_driver_fderr(dctx),
+				"%s: error: invalid --install-jobs argument: %s.\n",
+				dctx->program,dctx->cctx->installjobs);
+			return -1;
+		}
+
+		return njobs;
+	}
+
+	/* sequential unless requested */
+	return 1;
+}
+
+/* entries are independent unless two of them share a base name */
+static bool slbt_exec_install_entries_are_independent(
+	struct argv_entry **    entryv,
+	size_t                  nentries)
+{
+	size_t          idx;
+	size_t          cmp;
+	const char *    base;
+	const char *    mark;
+
+	for (idx=1; idx<nentries; idx++) {
+		base = strrchr(entryv[idx]->arg,'/');
+		base = base ? &base[1] : entryv[idx]->arg;
+
+		for (cmp=0; cmp<idx; cmp++) {
+			mark = strrchr(entryv[cmp]->arg,'/');
+			mark = mark ? &mark[1] : entryv[cmp]->arg;
+
+			if (!strcmp(base,mark))
+				return false;
+		}
+	}
+
+	return true;
+}
+
+static int slbt_exec_install_buf_begin(struct slbt_install_buf * buf)
+{
+	return ((buf->offset = lseek(buf->fd,0,SEEK_CUR)) < 0) ? -1 : 0;
+}
+
+static int slbt_exec_install_buf_end(struct slbt_install_buf * buf)
+{
+	return ((buf->size = lseek(buf->fd,0,SEEK_CUR) - buf->offset) < 0) ? -1 : 0;
+}
+
+static int slbt_exec_install_buf_replay(
+	const struct slbt_install_buf * buf,
+	int                             fddst)
+{
+	return slbt_tmpfile_replay(buf->fd,buf->offset,buf->size,fddst);
+}
+
+static void * slbt_exec_install_worker(void * arg)
+{
+	struct slbt_install_worker *    worker;
+	struct slbt_install_pool *      pool;
+	struct slbt_install_job *       job;
+	const struct slbt_driver_ctx *  dctx;
+
+	worker = arg;
+	pool   = worker->pool;
+	dctx   = pool->dctx;
+
+	for (;;) {
+		pthread_mutex_lock(&pool->lock);
+
+		job = (pool->fabort || (pool->next == pool->njobs))
+			? 0 : &pool->jobv[pool->next++];
+
+		pthread_mutex_unlock(&pool->lock);
+
+		if (!job)
+			return 0;
+
+		job->out.fd = worker->fdout;
+		job->err.fd = worker->fderr;
+		job->tid    = pthread_self();
+
+		if (slbt_exec_install_buf_begin(&job->out) < 0) {
+			job->status = SLBT_SYSTEM_ERROR(dctx,0);
+
+		} else if (slbt_exec_install_buf_begin(&job->err) < 0) {
+			job->status = SLBT_SYSTEM_ERROR(dctx,0);
+
+		} else {
+			job->status = slbt_exec_install_entry(
+				dctx,worker->ectx,pool->inst,
+				job->entry,pool->last,
+				pool->dest,pool->dstdir,
+				worker->src,worker->dst);
+
+			if (slbt_exec_install_buf_end(&job->out) < 0)
+				job->status = SLBT_SYSTEM_ERROR(dctx,0);
+
+			if (slbt_exec_install_buf_end(&job->err) < 0)
+				job->status = SLBT_SYSTEM_ERROR(dctx,0);
+		}
+
+		/* stop handing out entries once an entry has failed */
+		if (job->status < 0) {
+			pthread_mutex_lock(&pool->lock);
+			pool->fabort = true;
+			pthread_mutex_unlock(&pool->lock);
+		}
+	}
+}
+
+static int slbt_exec_install_entries_concurrently(
+	const struct slbt_driver_ctx *  dctx,
+	struct slbt_exec_ctx *          ectx,
+	const struct slbt_installer *   inst,
+	struct argv_entry **            entryv,
+	size_t                          nentries,
+	long                            njobs,
+	struct argv_entry *             last,
+	struct argv_entry *             dest,
+	char *                          dstdir,
+	char **                         src)
+{
+	int                             ret;
+	int                             fdout;
+	int                             fderr;
+	size_t                          idx;
+	size_t                          nargs;
+	struct slbt_install_pool        pool;
+	struct slbt_install_job *       job;
+	struct slbt_install_worker *    workerv;
+	struct slbt_install_worker *    worker;
+	struct slbt_error_info **       errmark;
+
+	if ((size_t)njobs > nentries)
+		njobs = nentries;
+
+	/* pool */
+	if (!(pool.jobv = calloc(nentries,sizeof(*pool.jobv))))
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	if (!(workerv = calloc(njobs,sizeof(*workerv)))) {
+		free(pool.jobv);
+		return SLBT_SYSTEM_ERROR(dctx,0);
+	}
+
+	pool.dctx   = dctx;
+	pool.inst   = inst;
+	pool.last   = last;
+	pool.dest   = dest;
+	pool.dstdir = dstdir;
+	pool.njobs  = nentries;
+	pool.next   = 0;
+	pool.fabort = false;
+
+	for (idx=0; idx<nentries; idx++) {
+		pool.jobv[idx].entry  = entryv[idx];
+		pool.jobv[idx].out.fd = -1;
+		pool.jobv[idx].err.fd = -1;
+	}
+
+	/* per-worker exec contexts and output buffers */
+	nargs = src - ectx->altv;
+	ret   = 0;
+
+	for (worker=workerv; !ret && (worker<&workerv[njobs]); worker++) {
+		worker->pool  = &pool;
+		worker->fdout = -1;
+		worker->fderr = -1;
+
+		if (worker == workerv) {
+			worker->ectx = ectx;
+
+		} else if (slbt_ectx_get_exec_ctx(dctx,&worker->ectx) < 0) {
+			ret = SLBT_NESTED_ERROR(dctx);
+			continue;
+
+		} else {
+			for (idx=0; idx<nargs; idx++)
+				worker->ectx->altv[idx] = ectx->altv[idx];
+
+			worker->ectx->altv[nargs+2] = 0;
+			worker->ectx->argv    = worker->ectx->altv;
+			worker->ectx->program = worker->ectx->altv[0];
+		}
+
+		worker->src = &worker->ectx->altv[nargs];
+		worker->dst = &worker->ectx->altv[nargs+1];
+
+		if ((worker->fdout = slbt_tmpfile()) < 0)
+			ret = SLBT_SYSTEM_ERROR(dctx,0);
+
+		else if ((worker->fderr = slbt_tmpfile()) < 0)
+			ret = SLBT_SYSTEM_ERROR(dctx,0);
+
+		slbt_exec_set_fdout(worker->ectx,worker->fdout);
+		slbt_exec_set_fderr(worker->ectx,worker->fderr);
+	}
+
+	/* the calling thread is the first worker */
+	if (!ret) {
+		errmark = slbt_error_info_mark(dctx);
+
+		pthread_mutex_init(&pool.lock,0);
+
+		for (worker=&workerv[1]; worker<&workerv[njobs]; worker++)
+			worker->fthread = !pthread_create(
+				&worker->tid,0,
+				slbt_exec_install_worker,
+				worker);
+
+		slbt_exec_install_worker(workerv);
+
+		for (worker=&workerv[1]; worker<&workerv[njobs]; worker++)
+			if (worker->fthread)
+				pthread_join(worker->tid,0);
+
+		pthread_mutex_destroy(&pool.lock);
+
+		/* replay in command-line order, up to the first failure */
+		fdout = slbt_driver_fdout(dctx);
+		fderr = slbt_driver_fderr(dctx);
+
+		for (job=pool.jobv; !ret && (job<&pool.jobv[nentries]); job++) {
+			if (job->out.fd < 0)
+				break;
+
+			if (slbt_exec_install_buf_replay(&job->out,fdout) < 0) {
+				ret = SLBT_SYSTEM_ERROR(dctx,0);
+
+			} else if (slbt_exec_install_buf_replay(&job->err,fderr) < 0) {
+				ret = SLBT_SYSTEM_ERROR(dctx,0);
+
+			} else if (job->status < 0) {
+				slbt_error_info_select(dctx,errmark,job->tid);
+				ret = SLBT_NESTED_ERROR(dctx);
+			}
+		}
+	}
+
+	/* cleanup */
+	for (worker=workerv; worker<&workerv[njobs]; worker++) {
+		if (worker->fdout >= 0)
+			close(worker->fdout);
+
+		if (worker->fderr >= 0)
+			close(worker->fderr);
+
+		if (worker->ectx && (worker != workerv))
+			slbt_ectx_free_exec_ctx(worker->ectx);
+	}
+
+	slbt_exec_set_fdout(ectx,-1);
+	slbt_exec_set_fderr(ectx,-1);
+
+	free(workerv);
+	free(pool.jobv);
+
+	return ret;
+}
+
 int slbt_exec_install(const struct slbt_driver_ctx * dctx)
 {
 	int				fdout;
@@ -692,6 +1007,8 @@ int slbt_exec_install(const struct slbt_driver_ctx * dctx)
 	char **				iargv;
 	char **				src;
 	char **				dst;
+	long				njobs;
+	size_t				nentries;
 	char *				slash;
 	char *				optsh;
 	char *				script;
@@ -702,7 +1019,9 @@ int slbt_exec_install(const struct slbt_driver_ctx * dctx)
 	struct argv_entry *		copy;
 	struct argv_entry *		dest;
 	struct argv_entry *		last;
+	struct argv_entry **		entryv;
 	const struct argv_option *	optv[SLBT_OPTV_ELEMENTS];
+	struct slbt_installer		inst;
 	char				dstdir[PATH_MAX];
 
 	/* dry run */
@@ -764,6 +1083,9 @@ int slbt_exec_install(const struct slbt_driver_ctx * dctx)
 			ectx,meta,
 			SLBT_CUSTOM_ERROR(dctx,SLBT_ERR_INSTALL_FAIL));
 
+	/* in-process installation, or else the reason for spawning */
+	slbt_installer_init(iargv[0],meta,&inst);
+
 	/* dest, alternate argument vector options */
 	argv = ectx->altv;
 	copy = meta->entries;
@@ -855,11 +1177,49 @@ int slbt_exec_install(const struct slbt_driver_ctx * dctx)
 				ectx,meta,
 				SLBT_NESTED_ERROR(dctx));
 
+		/* concurrent installation? */
+		if ((njobs = slbt_exec_install_get_jobs(dctx)) < 0)
+			return slbt_exec_install_fail(
+				ectx,meta,
+				SLBT_CUSTOM_ERROR(dctx,SLBT_ERR_INSTALL_FAIL));
+
+		for (nentries=0, entry=meta->entries; entry->fopt || entry->arg; entry++)
+			if (!entry->fopt && (dest || (entry != last)))
+				nentries++;
+
+		if ((njobs > 1) && (nentries > 1)) {
+			if (!(entryv = calloc(nentries,sizeof(*entryv))))
+				return slbt_exec_install_fail(
+					ectx,meta,
+					SLBT_SYSTEM_ERROR(dctx,0));
+
+			for (nentries=0, entry=meta->entries; entry->fopt || entry->arg; entry++)
+				if (!entry->fopt && (dest || (entry != last)))
+					entryv[nentries++] = entry;
+
+			if (slbt_exec_install_entries_are_independent(entryv,nentries)) {
+				if (slbt_exec_install_entries_concurrently(
+						dctx,ectx,&inst,
+						entryv,nentries,njobs,
+						last,dest,dstdir,
+						src) < 0) {
+					free(entryv);
+					return slbt_exec_install_fail(
+						ectx,meta,
+						SLBT_NESTED_ERROR(dctx));
+				}
+
+				nentries = 0;
+			}
+
+			free(entryv);
+		}
+
 		/* install entries one at a time */
-		for (entry=meta->entries; entry->fopt || entry->arg; entry++)
+		for (entry=meta->entries; nentries && (entry->fopt || entry->arg); entry++)
 			if (!entry->fopt && (dest || (entry != last)))
 				if (slbt_exec_install_entry(
-						dctx,ectx,
+						dctx,ectx,&inst,
 						entry,last,
 						dest,dstdir,
 						src,dst))
@@ -871,23 +1231,15 @@ int slbt_exec_install(const struct slbt_driver_ctx * dctx)
 		ectx->argv    = ectx->cargv;
 		ectx->program = ectx->cargv[0];
 
-		/* spawn */
+		/* install -d */
 		if (!(dctx->cctx->drvflags & SLBT_DRIVER_SILENT))
 			if (slbt_output_install(ectx))
 				return SLBT_NESTED_ERROR(dctx);
 
-		if ((slbt_spawn(ectx,true) < 0) && (ectx->pid < 0)) {
+		if (slbt_installer_install_dirs(dctx,ectx,&inst,meta) < 0)
 			return slbt_exec_install_fail(
 				ectx,meta,
-				SLBT_SPAWN_ERROR(dctx));
-
-		} else if (ectx->exitcode) {
-			return slbt_exec_install_fail(
-				ectx,meta,
-				SLBT_CUSTOM_ERROR(
-					dctx,
-					SLBT_ERR_INSTALL_ERROR));
-		}
+				SLBT_NESTED_ERROR(dctx));
 	}
 
 	slbt_argv_free(meta);
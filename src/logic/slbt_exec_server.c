@@ -0,0 +1,691 @@
+/*******************************************************************/
+/*  slibtool: a strong libtool implementation, written in C        */
+/*  Copyright (C) 2016--2024  SysDeer Technologies, LLC            */
+/*  Released under the Standard MIT License; see COPYING.SLIBTOOL. */
+/*******************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/wait.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <slibtool/slibtool.h>
+#include "slibtool_driver_impl.h"
+#include "slibtool_dprintf_impl.h"
+#include "slibtool_errinfo_impl.h"
+#include "slibtool_server_impl.h"
+#include "slibtool_snprintf_impl.h"
+#include "slibtool_toolchain_impl.h"
+#include "slibtool_visibility_impl.h"
+
+/*****************************************************************/
+/* server mode: requests (argv, envp, and the client's working   */
+/* directory, stdin, stdout, and stderr) arrive over a local     */
+/* socket. the server creates each request's driver context by   */
+/* itself, so that host probing results remain warm across       */
+/* requests, and then forks a worker that performs the requested */
+/* actions and reports the exit status back to the client.       */
+/*                                                               */
+/* cached probe results are validated against the identity of    */
+/* the probed program (compiler, archiver) upon every use; the   */
+/* project's libtool script is re-read for every request; and    */
+/* an explicit flush request discards all cached state.          */
+/*                                                               */
+/* since a request may ask for any action, --mode=execute        */
+/* included, the socket is created under a umask of 077, and     */
+/* requests from peers other than the server's user are refused. */
+/*****************************************************************/
+
+#define SLBT_SERVER_NFDS 4
+
+extern char ** environ;
+
+static int slbt_server_read_all(int fd, void * buf, size_t len)
+{
+	ssize_t	ret;
+	char *	ch;
+
+	for (ch=buf; len; ) {
+		ret = read(fd,ch,len);
+
+		while ((ret < 0) && (errno == EINTR))
+			ret = read(fd,ch,len);
+
+		if (ret <= 0)
+			return -1;
+
+		ch  += ret;
+		len -= ret;
+	}
+
+	return 0;
+}
+
+static int slbt_server_write_all(int fd, const void * buf, size_t len)
+{
+	ssize_t		ret;
+	const char *	ch;
+
+	for (ch=buf; len; ) {
+		ret = write(fd,ch,len);
+
+		while ((ret < 0) && (errno == EINTR))
+			ret = write(fd,ch,len);
+
+		if (ret < 0)
+			return -1;
+
+		ch  += ret;
+		len -= ret;
+	}
+
+	return 0;
+}
+
+static int slbt_server_send_request(
+	int					sock,
+	const struct slbt_server_request *	req,
+	const int				fdv[SLBT_SERVER_NFDS])
+{
+	ssize_t		ret;
+	struct msghdr	msg;
+	struct iovec	iov;
+	struct cmsghdr*	cmsg;
+	union {
+		struct cmsghdr	align;
+		char		buf[CMSG_SPACE(SLBT_SERVER_NFDS * sizeof(int))];
+	} ctl;
+
+	memset(&msg,0,sizeof(msg));
+	memset(&ctl,0,sizeof(ctl));
+
+	iov.iov_base = (void *)req;
+	iov.iov_len  = sizeof(*req);
+
+	msg.msg_iov        = &iov;
+	msg.msg_iovlen     = 1;
+	msg.msg_control    = ctl.buf;
+	msg.msg_controllen = sizeof(ctl.buf);
+
+	cmsg             = CMSG_FIRSTHDR(&msg);
+	cmsg->cmsg_level = SOL_SOCKET;
+	cmsg->cmsg_type  = SCM_RIGHTS;
+	cmsg->cmsg_len   = CMSG_LEN(SLBT_SERVER_NFDS * sizeof(int));
+
+	memcpy(CMSG_DATA(cmsg),fdv,SLBT_SERVER_NFDS * sizeof(int));
+
+	ret = sendmsg(sock,&msg,0);
+
+	while ((ret < 0) && (errno == EINTR))
+		ret = sendmsg(sock,&msg,0);
+
+	return (ret == sizeof(*req)) ? 0 : -1;
+}
+
+static int slbt_server_recv_request(
+	int				sock,
+	struct slbt_server_request *	req,
+	int				fdv[SLBT_SERVER_NFDS])
+{
+	int		fd;
+	int		idx;
+	int		nfds;
+	int *		cfds;
+	ssize_t		ret;
+	struct msghdr	msg;
+	struct iovec	iov;
+	struct cmsghdr*	cmsg;
+	union {
+		struct cmsghdr	align;
+		char		buf[CMSG_SPACE(SLBT_SERVER_NFDS * sizeof(int))];
+	} ctl;
+
+	for (idx=0; idx<SLBT_SERVER_NFDS; idx++)
+		fdv[idx] = -1;
+
+	memset(&msg,0,sizeof(msg));
+	memset(&ctl,0,sizeof(ctl));
+
+	iov.iov_base = req;
+	iov.iov_len  = sizeof(*req);
+
+	msg.msg_iov        = &iov;
+	msg.msg_iovlen     = 1;
+	msg.msg_control    = ctl.buf;
+	msg.msg_controllen = sizeof(ctl.buf);
+
+	ret = recvmsg(sock,&msg,0);
+
+	while ((ret < 0) && (errno == EINTR))
+		ret = recvmsg(sock,&msg,0);
+
+	if (ret <= 0)
+		return -1;
+
+	for (cmsg=CMSG_FIRSTHDR(&msg); cmsg; cmsg=CMSG_NXTHDR(&msg,cmsg)) {
+		if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SCM_RIGHTS)) {
+			nfds = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+			cfds = (int *)CMSG_DATA(cmsg);
+
+			for (idx=0; idx<nfds; idx++) {
+				if (idx < SLBT_SERVER_NFDS) {
+					memcpy(&fdv[idx],&cfds[idx],sizeof(int));
+					fcntl(fdv[idx],F_SETFD,FD_CLOEXEC);
+				} else {
+					memcpy(&fd,&cfds[idx],sizeof(int));
+					close(fd);
+				}
+			}
+		}
+	}
+
+	if ((ret != sizeof(*req)) || (msg.msg_flags & MSG_CTRUNC))
+		return -1;
+
+	return (req->magic == SLBT_SERVER_MAGIC) ? 0 : -1;
+}
+
+static void slbt_server_close_fds(int fdv[SLBT_SERVER_NFDS])
+{
+	int	idx;
+
+	for (idx=0; idx<SLBT_SERVER_NFDS; idx++)
+		if (fdv[idx] >= 0)
+			close(fdv[idx]);
+}
+
+static void slbt_server_reply(int sock, int status)
+{
+	struct slbt_server_reply reply;
+
+	reply.magic  = SLBT_SERVER_MAGIC;
+	reply.status = status;
+
+	slbt_server_write_all(sock,&reply,sizeof(reply));
+}
+
+static bool slbt_server_peer_is_owner(int conn)
+{
+#ifdef __linux__
+	struct ucred	cred;
+	socklen_t	len;
+
+	len = sizeof(cred);
+
+	if (getsockopt(conn,SOL_SOCKET,SO_PEERCRED,&cred,&len) < 0)
+		return false;
+
+	return (cred.uid == geteuid());
+#else
+	uid_t		uid;
+	gid_t		gid;
+
+	if (getpeereid(conn,&uid,&gid) < 0)
+		return false;
+
+	return (uid == geteuid());
+#endif
+}
+
+static int slbt_server_bind(int sock, const struct sockaddr_un * sun)
+{
+	int	ret;
+	mode_t	mask;
+
+	mask = umask(077);
+	ret  = bind(sock,(const struct sockaddr *)sun,sizeof(*sun));
+	umask(mask);
+
+	return ret;
+}
+
+static int slbt_server_listen(const struct slbt_driver_ctx * dctx)
+{
+	int			sock;
+	int			probe;
+	struct sockaddr_un	sun;
+
+	memset(&sun,0,sizeof(sun));
+	sun.sun_family = AF_UNIX;
+
+	if (slbt_snprintf(sun.sun_path,sizeof(sun.sun_path),
+			"%s",dctx->cctx->server) < 0)
+		return SLBT_BUFFER_ERROR(dctx);
+
+	if ((sock = socket(AF_UNIX,SOCK_STREAM|SOCK_CLOEXEC,0)) < 0)
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	/* stale socket from a previous server instance? */
+	if (slbt_server_bind(sock,&sun) < 0) {
+		if (errno != EADDRINUSE) {
+			close(sock);
+			return SLBT_SYSTEM_ERROR(dctx,dctx->cctx->server);
+		}
+
+		if ((probe = socket(AF_UNIX,SOCK_STREAM|SOCK_CLOEXEC,0)) < 0) {
+			close(sock);
+			return SLBT_SYSTEM_ERROR(dctx,0);
+		}
+
+		if (!connect(probe,(struct sockaddr *)&sun,sizeof(sun))) {
+			close(probe);
+			close(sock);
+			errno = EADDRINUSE;
+			return SLBT_SYSTEM_ERROR(dctx,dctx->cctx->server);
+		}
+
+		close(probe);
+		unlink(sun.sun_path);
+
+		if (slbt_server_bind(sock,&sun) < 0) {
+			close(sock);
+			return SLBT_SYSTEM_ERROR(dctx,dctx->cctx->server);
+		}
+	}
+
+	if (listen(sock,SOMAXCONN) < 0) {
+		close(sock);
+		return SLBT_SYSTEM_ERROR(dctx,dctx->cctx->server);
+	}
+
+	return sock;
+}
+
+static void slbt_server_reap(void)
+{
+	int	estatus;
+
+	while (waitpid(-1,&estatus,WNOHANG) > 0)
+		(void)0;
+}
+
+static bool slbt_server_envp_has(char ** envp, const char * var)
+{
+	size_t	len;
+
+	for (len=strlen(var); envp && *envp; envp++)
+		if (!strncmp(*envp,var,len) && ((*envp)[len] == '='))
+			return true;
+
+	return false;
+}
+
+static void slbt_server_child(
+	struct slbt_driver_ctx *	cdctx,
+	int				conn,
+	int				fdv[SLBT_SERVER_NFDS],
+	char **				envp)
+{
+	int	status;
+
+	signal(SIGPIPE,SIG_DFL);
+	signal(SIGCHLD,SIG_DFL);
+
+	status = SLBT_ERROR;
+
+	if (dup2(fdv[1],0) == 0)
+		if (dup2(fdv[2],1) == 1)
+			if (dup2(fdv[3],2) == 2) {
+				environ = envp;
+				status  = slbt_main_driver_actions(cdctx,fdv[2]);
+			}
+
+	slbt_server_reply(conn,status);
+
+	_exit(status);
+}
+
+static void slbt_server_exec(
+	const struct slbt_driver_ctx *	dctx,
+	int				conn,
+	int				fdv[SLBT_SERVER_NFDS],
+	char **				argv,
+	char **				envp)
+{
+	int				ret;
+	pid_t				pid;
+	uint64_t			flags;
+	struct slbt_driver_ctx *	cdctx;
+	struct slbt_fd_ctx		fdctx;
+
+	if (slbt_lib_get_driver_fdctx(dctx,&fdctx) < 0) {
+		slbt_server_reply(conn,SLBT_ERROR);
+		return;
+	}
+
+	/* the client's working directory */
+	if (fchdir(fdv[0]) < 0) {
+		slbt_server_reply(conn,SLBT_ERROR);
+		return;
+	}
+
+	fdctx.fdin  = fdv[1];
+	fdctx.fdout = fdv[2];
+	fdctx.fderr = fdv[3];
+	fdctx.fdcwd = fdv[0];
+	fdctx.fddst = fdv[0];
+	fdctx.fdlog = -1;
+
+	flags  = slbt_main_driver_flags(argv[0]);
+	flags |= slbt_server_envp_has(envp,"NO_COLOR") ? SLBT_DRIVER_ANNOTATE_NEVER : 0;
+
+	/* driver context (any errors are written to the client's fderr) */
+	if ((ret = slbt_lib_get_driver_ctx(argv,envp,flags,&fdctx,&cdctx))) {
+		slbt_server_reply(conn,(ret == SLBT_USAGE)
+			? !argv[1] || !argv[2]
+			: SLBT_ERROR);
+		return;
+	}
+
+	/* nested server mode is not supported */
+	if (cdctx->cctx->mode == SLBT_MODE_SERVER) {
+		slbt_dprintf(fdv[3],
+			"%s: error: --server may not be "
+			"used in a client request.\n",
+			cdctx->program);
+
+		slbt_lib_free_driver_ctx(cdctx);
+		slbt_server_reply(conn,SLBT_ERROR);
+		return;
+	}
+
+	/* worker (a failed fork only fails the current request) */
+	if ((pid = fork()) < 0) {
+		slbt_dprintf(fdv[3],
+			"%s: error: could not fork a server "
+			"worker (%s).\n",
+			cdctx->program,strerror(errno));
+
+		slbt_lib_free_driver_ctx(cdctx);
+		slbt_server_reply(conn,SLBT_ERROR);
+		return;
+	}
+
+	if (pid == 0)
+		slbt_server_child(cdctx,conn,fdv,envp);
+
+	slbt_lib_free_driver_ctx(cdctx);
+}
+
+static void slbt_server_handle(
+	const struct slbt_driver_ctx *	dctx,
+	int				conn)
+{
+	uint32_t			idx;
+	int				fdv[SLBT_SERVER_NFDS];
+	struct slbt_server_request	req;
+	char *				payload;
+	char *				ch;
+	char *				cap;
+	char **				strv;
+
+	if (slbt_server_recv_request(conn,&req,fdv) < 0) {
+		slbt_server_close_fds(fdv);
+		return;
+	}
+
+	/* flush */
+	if (req.op == SLBT_SERVER_OP_FLUSH) {
+		slbt_host_flush_probes();
+		slbt_toolchain_flush();
+		slbt_server_close_fds(fdv);
+		slbt_server_reply(conn,SLBT_OK);
+		return;
+	}
+
+	/* exec: validate (each string takes at least one byte) */
+	if ((req.op != SLBT_SERVER_OP_EXEC) || (req.argc == 0)
+			|| (req.size > SLBT_SERVER_MAX_PAYLOAD)
+			|| ((uint64_t)req.argc > req.size)
+			|| ((uint64_t)req.envc > req.size - req.argc)
+			|| (fdv[SLBT_SERVER_NFDS - 1] < 0)) {
+		slbt_server_close_fds(fdv);
+		return;
+	}
+
+	/* allocation failures only fail the current request */
+	if (!(payload = malloc((size_t)req.size + 1))) {
+		slbt_server_close_fds(fdv);
+		slbt_server_reply(conn,SLBT_ERROR);
+		return;
+	}
+
+	if (!(strv = calloc((size_t)req.argc + req.envc + 2,sizeof(char *)))) {
+		free(payload);
+		slbt_server_close_fds(fdv);
+		slbt_server_reply(conn,SLBT_ERROR);
+		return;
+	}
+
+	if (slbt_server_read_all(conn,payload,req.size) < 0) {
+		free(strv);
+		free(payload);
+		slbt_server_close_fds(fdv);
+		return;
+	}
+
+	/* argv (null-terminated), followed by envp (null-terminated) */
+	payload[req.size] = 0;
+	cap = &payload[req.size];
+
+	for (idx=0, ch=payload; (idx < req.argc + req.envc) && (ch < cap); idx++) {
+		strv[idx + (idx >= req.argc)] = ch;
+		ch += strlen(ch) + 1;
+	}
+
+	if (idx < req.argc + req.envc) {
+		free(strv);
+		free(payload);
+		slbt_server_close_fds(fdv);
+		return;
+	}
+
+	slbt_server_exec(
+		dctx,conn,fdv,
+		strv,&strv[req.argc + 1]);
+
+	free(strv);
+	free(payload);
+	slbt_server_close_fds(fdv);
+}
+
+int slbt_exec_server(const struct slbt_driver_ctx * dctx)
+{
+	int	sock;
+	int	conn;
+
+	/* dry run */
+	if (dctx->cctx->drvflags & SLBT_DRIVER_DRY_RUN)
+		return 0;
+
+	/* listen */
+	if ((sock = slbt_server_listen(dctx)) < 0)
+		return SLBT_NESTED_ERROR(dctx);
+
+	signal(SIGPIPE,SIG_IGN);
+
+	/* toolchain contexts remain warm across requests */
+	slbt_toolchain_cache_begin();
+
+	if (dctx->cctx->drvflags & SLBT_DRIVER_VERBOSE)
+		slbt_dprintf(
+			slbt_driver_fderr(dctx),
+			"%s: server: listening on %s.\n",
+			dctx->program,dctx->cctx->server);
+
+	/* serve */
+	for (;;) {
+		slbt_server_reap();
+
+		conn = accept(sock,0,0);
+
+		if ((conn < 0) && (errno == EINTR))
+			continue;
+
+		if ((conn < 0) && (errno == ECONNABORTED))
+			continue;
+
+		if (conn < 0) {
+			slbt_toolchain_cache_end();
+			close(sock);
+			return SLBT_SYSTEM_ERROR(dctx,0);
+		}
+
+		fcntl(conn,F_SETFD,FD_CLOEXEC);
+
+		/* requests are only accepted from the server's own user */
+		if (slbt_server_peer_is_owner(conn))
+			slbt_server_handle(dctx,conn);
+
+		close(conn);
+	}
+}
+
+slbt_hidden int slbt_server_client_main(
+	char **				argv,
+	char **				envp,
+	const struct slbt_fd_ctx *	fdctx)
+{
+	int				ret;
+	int				sock;
+	int				fdcwd;
+	int				fdv[SLBT_SERVER_NFDS];
+	size_t				size;
+	size_t				len;
+	char **				parg;
+	char *				payload;
+	char *				ch;
+	char *				dash;
+	char *				argv0;
+	const char *			sockpath;
+	struct sockaddr_un		sun;
+	struct slbt_server_request	req;
+	struct slbt_server_reply	reply;
+	char				program[PATH_MAX];
+
+	/* the server-side program name, sans the -client suffix */
+	if (slbt_snprintf(program,sizeof(program),"%s",argv[0]) < 0)
+		return SLBT_ERROR;
+
+	if ((dash = strrchr(program,'-')) && !strcmp(dash,"-client"))
+		*dash = 0;
+
+	argv0   = argv[0];
+	argv[0] = program;
+
+	/* server */
+	for (sockpath=0, parg=envp; !sockpath && parg && *parg; parg++)
+		if (!strncmp(*parg,SLBT_SERVER_ENV "=",sizeof(SLBT_SERVER_ENV)))
+			sockpath = &(*parg)[sizeof(SLBT_SERVER_ENV)];
+
+	memset(&sun,0,sizeof(sun));
+	sun.sun_family = AF_UNIX;
+	sock = -1;
+
+	if (sockpath && *sockpath)
+		if (slbt_snprintf(sun.sun_path,sizeof(sun.sun_path),"%s",sockpath) >= 0)
+			sock = socket(AF_UNIX,SOCK_STREAM|SOCK_CLOEXEC,0);
+
+	if ((sock >= 0) && connect(sock,(struct sockaddr *)&sun,sizeof(sun)) < 0) {
+		close(sock);
+		sock = -1;
+	}
+
+	/* no server: run locally */
+	if (sock < 0) {
+		if (argv[1] && !argv[2] && !strcmp(argv[1],SLBT_SERVER_FLUSH_ARG))
+			ret = SLBT_OK;
+		else
+			ret = slbt_main(argv,envp,fdctx);
+
+		argv[0] = argv0;
+		return ret;
+	}
+
+	/* request header and descriptors */
+	memset(&req,0,sizeof(req));
+	req.magic = SLBT_SERVER_MAGIC;
+
+	fdv[0] = fdctx ? fdctx->fdcwd : AT_FDCWD;
+	fdv[1] = fdctx ? fdctx->fdin  : STDIN_FILENO;
+	fdv[2] = fdctx ? fdctx->fdout : STDOUT_FILENO;
+	fdv[3] = fdctx ? fdctx->fderr : STDERR_FILENO;
+
+	if (argv[1] && !argv[2] && !strcmp(argv[1],SLBT_SERVER_FLUSH_ARG)) {
+		req.op  = SLBT_SERVER_OP_FLUSH;
+		fdv[0]  = fdv[3];
+		fdcwd   = -1;
+		payload = 0;
+		size    = 0;
+
+	} else {
+		req.op = SLBT_SERVER_OP_EXEC;
+
+		for (size=0, parg=argv; *parg; parg++, req.argc++)
+			size += strlen(*parg) + 1;
+
+		for (parg=envp; parg && *parg; parg++, req.envc++)
+			size += strlen(*parg) + 1;
+
+		if (!(payload = malloc(size))) {
+			close(sock);
+			argv[0] = argv0;
+			return SLBT_ERROR;
+		}
+
+		for (ch=payload, parg=argv; *parg; parg++, ch+=len)
+			memcpy(ch,*parg,(len = strlen(*parg) + 1));
+
+		for (parg=envp; parg && *parg; parg++, ch+=len)
+			memcpy(ch,*parg,(len = strlen(*parg) + 1));
+
+		req.size = size;
+
+		/* the client's working directory */
+		fdcwd = (fdv[0] == AT_FDCWD)
+			? open(".",O_RDONLY|O_DIRECTORY|O_CLOEXEC)
+			: -1;
+
+		if (fdcwd >= 0)
+			fdv[0] = fdcwd;
+	}
+
+	argv[0] = argv0;
+
+	/* request */
+	if (slbt_server_send_request(sock,&req,fdv) < 0)
+		ret = -1;
+	else
+		ret = slbt_server_write_all(sock,payload,size);
+
+	if (fdcwd >= 0)
+		close(fdcwd);
+
+	free(payload);
+
+	/* reply */
+	if ((ret < 0) || slbt_server_read_all(sock,&reply,sizeof(reply))
+			|| (reply.magic != SLBT_SERVER_MAGIC)) {
+		slbt_dprintf(fdv[3],
+			"%s: error: lost connection to the "
+			"slibtool server (%s).\n",
+			program,sockpath);
+
+		close(sock);
+		return SLBT_ERROR;
+	}
+
+	close(sock);
+
+	return reply.status;
+}
@@ -4,19 +4,30 @@
 /*  Released under the Standard MIT License; see COPYING.SLIBTOOL. */
 /*******************************************************************/
 
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
 #include <sys/stat.h>
 #include <slibtool/slibtool.h>
 #include <slibtool/slibtool_output.h>
 #include "slibtool_driver_impl.h"
+#include "slibtool_dprintf_impl.h"
 #include "slibtool_stoolie_impl.h"
 #include "slibtool_errinfo_impl.h"
 #include "slibtool_realpath_impl.h"
 #include "slibtool_snprintf_impl.h"
 #include "slibtool_symlink_impl.h"
+#include "slibtool_tmpfile_impl.h"
 #include "argv/argv.h"
 
 static const char slbt_this_dir[2] = {'.',0};
 
+struct slbt_stoolie_srcs {
+	char                            slibm4[PATH_MAX];
+	char                            ltmain[PATH_MAX];
+	char                            arlib [PATH_MAX];
+};
+
 static int slbt_stoolie_usage(
 	int				fdout,
 	const char *			program,
@@ -77,42 +88,54 @@ static int slbt_exec_stoolie_remove_file(
 	return SLBT_SYSTEM_ERROR(dctx,0);
 }
 
-static int slbt_exec_stoolie_perform_actions(
+static int slbt_exec_stoolie_init_srcs(
 	const struct slbt_driver_ctx *  dctx,
-	struct slbt_exec_ctx *          ectx,
-	struct slbt_stoolie_ctx *       stctx)
+	struct slbt_stoolie_srcs *      srcs)
 {
-	struct slbt_stoolie_ctx_impl *  ictx;
-	struct stat                     st;
-	char                            m4dir [PATH_MAX];
-	char                            auxdir[PATH_MAX];
-	char                            slibm4[PATH_MAX];
-	char                            ltmain[PATH_MAX];
-	char                            arlib [PATH_MAX];
-	bool                            fslibm4;
-	bool                            fltmain;
-
-	ictx = slbt_get_stoolie_ictx(stctx);
-
-	/* source files */
 	if (slbt_snprintf(
-			slibm4,sizeof(slibm4),"%s/%s",
+			srcs->slibm4,sizeof(srcs->slibm4),"%s/%s",
 			SLBT_PACKAGE_DATADIR,
 			"slibtool.m4") < 0)
 		return SLBT_BUFFER_ERROR(dctx);
 
 	if (slbt_snprintf(
-			ltmain,sizeof(ltmain),"%s/%s",
+			srcs->ltmain,sizeof(srcs->ltmain),"%s/%s",
 			SLBT_PACKAGE_DATADIR,
 			"ltmain.sh") < 0)
 		return SLBT_BUFFER_ERROR(dctx);
 
 	if (slbt_snprintf(
-			arlib,sizeof(arlib),"%s/%s",
+			srcs->arlib,sizeof(srcs->arlib),"%s/%s",
 			SLBT_PACKAGE_DATADIR,
 			"ar-lib") < 0)
 		return SLBT_BUFFER_ERROR(dctx);
 
+	return 0;
+}
+
+static int slbt_exec_stoolie_perform_actions(
+	const struct slbt_driver_ctx *  dctx,
+	struct slbt_exec_ctx *          ectx,
+	const struct slbt_stoolie_srcs *srcs,
+	struct slbt_stoolie_ctx *       stctx)
+{
+	struct slbt_stoolie_ctx_impl *  ictx;
+	struct stat                     st;
+	char                            m4dir [PATH_MAX];
+	char                            auxdir[PATH_MAX];
+	const char *                    slibm4;
+	const char *                    ltmain;
+	const char *                    arlib;
+	bool                            fslibm4;
+	bool                            fltmain;
+
+	ictx = slbt_get_stoolie_ictx(stctx);
+
+	/* source files */
+	slibm4 = srcs->slibm4;
+	ltmain = srcs->ltmain;
+	arlib  = srcs->arlib;
+
 	/* --force? */
 	if (dctx->cctx->drvflags & SLBT_DRIVER_STOOLIE_FORCE) {
 		if (ictx->fdm4 >= 0)
@@ -205,6 +228,306 @@ static int slbt_exec_stoolie_perform_actions(
 	return 0;
 }
 
+/*****************************************************************/
+/* --jobs: target directories are handled by a pool of worker    */
+/* threads, each with its own exec context, in two passes: all  */
+/* slibtoolize contexts are first parsed, and only then are the */
+/* actions of any directory performed. the output of every      */
+/* worker goes to private temporary files, which are replayed  */
+/* in command-line order up to the first failing directory;   */
+/* the error vector is likewise that of the first failing     */
+/* directory, just as in a sequential run.                    */
+/*****************************************************************/
+
+struct slbt_stoolie_buf {
+	int                             fd;
+	off_t                           offset;
+	off_t                           size;
+};
+
+struct slbt_stoolie_job {
+	const char *                    unit;
+	struct slbt_stoolie_ctx **      stctx;
+	struct slbt_stoolie_buf         out;
+	struct slbt_stoolie_buf         err;
+	pthread_t                       tid;
+	int                             status;
+};
+
+struct slbt_stoolie_pool {
+	const struct slbt_driver_ctx *  dctx;
+	const struct slbt_stoolie_srcs *srcs;
+	struct slbt_stoolie_job *       jobv;
+	size_t                          njobs;
+	size_t                          next;
+	bool                            fapply;
+	bool                            fabort;
+	pthread_mutex_t                 lock;
+};
+
+struct slbt_stoolie_worker {
+	struct slbt_stoolie_pool *      pool;
+	struct slbt_exec_ctx *          ectx;
+	pthread_t                       tid;
+	int                             fdout;
+	int                             fderr;
+	bool                            fthread;
+};
+
+static long slbt_exec_stoolie_get_jobs(
+	const struct slbt_driver_ctx *  dctx,
+	const char *                    jobs)
+{
+	long	njobs;
+	char *	mark;
+
+	if (jobs) {
+		njobs = strtol(jobs,&mark,10);
+
+		if ((njobs <= 0) || *mark) {
+			slbt_dprintf(
+				slbt_driver_fderr(dctx),
+				"%s: error: invalid --jobs argument: %s.\n",
+				dctx->program,jobs);
+			return -1;
+		}
+
+		return njobs;
+	}
+
+	/* sequential unless requested */
+	return 1;
+}
+
+static int slbt_exec_stoolie_buf_begin(struct slbt_stoolie_buf * buf)
+{
+	return ((buf->offset = lseek(buf->fd,0,SEEK_CUR)) < 0) ? -1 : 0;
+}
+
+static int slbt_exec_stoolie_buf_end(struct slbt_stoolie_buf * buf)
+{
+	return ((buf->size = lseek(buf->fd,0,SEEK_CUR) - buf->offset) < 0) ? -1 : 0;
+}
+
+static void * slbt_exec_stoolie_worker(void * arg)
+{
+	struct slbt_stoolie_worker *    worker;
+	struct slbt_stoolie_pool *      pool;
+	struct slbt_stoolie_job *       job;
+	const struct slbt_driver_ctx *  dctx;
+
+	worker = arg;
+	pool   = worker->pool;
+	dctx   = pool->dctx;
+
+	for (;;) {
+		pthread_mutex_lock(&pool->lock);
+
+		job = (pool->fabort || (pool->next == pool->njobs))
+			? 0 : &pool->jobv[pool->next++];
+
+		pthread_mutex_unlock(&pool->lock);
+
+		if (!job)
+			return 0;
+
+		job->out.fd = worker->fdout;
+		job->err.fd = worker->fderr;
+		job->tid    = pthread_self();
+
+		if (slbt_exec_stoolie_buf_begin(&job->out) < 0) {
+			job->status = SLBT_SYSTEM_ERROR(dctx,0);
+
+		} else if (slbt_exec_stoolie_buf_begin(&job->err) < 0) {
+			job->status = SLBT_SYSTEM_ERROR(dctx,0);
+
+		} else {
+			job->status = pool->fapply
+				? slbt_exec_stoolie_perform_actions(
+					dctx,worker->ectx,
+					pool->srcs,*job->stctx)
+				: slbt_st_get_stoolie_ctx(
+					dctx,job->unit,
+					job->stctx);
+
+			if (slbt_exec_stoolie_buf_end(&job->out) < 0)
+				job->status = SLBT_SYSTEM_ERROR(dctx,0);
+
+			if (slbt_exec_stoolie_buf_end(&job->err) < 0)
+				job->status = SLBT_SYSTEM_ERROR(dctx,0);
+		}
+
+		/* stop handing out directories once one has failed */
+		if (job->status < 0) {
+			pthread_mutex_lock(&pool->lock);
+			pool->fabort = true;
+			pthread_mutex_unlock(&pool->lock);
+		}
+	}
+}
+
+static int slbt_exec_stoolie_run_pool(
+	struct slbt_stoolie_pool *      pool,
+	struct slbt_stoolie_worker *    workerv,
+	long                            njobs)
+{
+	int                             ret;
+	int                             fdout;
+	int                             fderr;
+	const struct slbt_driver_ctx *  dctx;
+	struct slbt_stoolie_job *       job;
+	struct slbt_stoolie_worker *    worker;
+	struct slbt_error_info **       errmark;
+
+	dctx = pool->dctx;
+
+	for (job=pool->jobv; job<&pool->jobv[pool->njobs]; job++) {
+		job->out.fd = -1;
+		job->err.fd = -1;
+		job->status = 0;
+	}
+
+	pool->next   = 0;
+	pool->fabort = false;
+
+	/* the calling thread is the first worker */
+	errmark = slbt_error_info_mark(dctx);
+
+	pthread_mutex_init(&pool->lock,0);
+
+	for (worker=&workerv[1]; worker<&workerv[njobs]; worker++)
+		worker->fthread = !pthread_create(
+			&worker->tid,0,
+			slbt_exec_stoolie_worker,
+			worker);
+
+	slbt_exec_stoolie_worker(workerv);
+
+	for (worker=&workerv[1]; worker<&workerv[njobs]; worker++)
+		if (worker->fthread)
+			pthread_join(worker->tid,0);
+
+	pthread_mutex_destroy(&pool->lock);
+
+	/* replay in command-line order, up to the first failure */
+	fdout = slbt_driver_fdout(dctx);
+	fderr = slbt_driver_fderr(dctx);
+
+	for (ret=0,job=pool->jobv; !ret && (job<&pool->jobv[pool->njobs]); job++) {
+		if (job->out.fd < 0)
+			break;
+
+		if (slbt_tmpfile_replay(job->out.fd,job->out.offset,job->out.size,fdout) < 0) {
+			ret = SLBT_SYSTEM_ERROR(dctx,0);
+
+		} else if (slbt_tmpfile_replay(job->err.fd,job->err.offset,job->err.size,fderr) < 0) {
+			ret = SLBT_SYSTEM_ERROR(dctx,0);
+
+		} else if (job->status < 0) {
+			slbt_error_info_select(dctx,errmark,job->tid);
+			ret = SLBT_NESTED_ERROR(dctx);
+		}
+	}
+
+	return ret;
+}
+
+static int slbt_exec_stoolie_concurrently(
+	const struct slbt_driver_ctx *  dctx,
+	struct slbt_exec_ctx *          ectx,
+	const struct slbt_stoolie_srcs *srcs,
+	const char **                   unitv,
+	struct slbt_stoolie_ctx **      stctxv,
+	size_t                          nunits,
+	long                            njobs)
+{
+	int                             ret;
+	size_t                          idx;
+	struct slbt_stoolie_pool        pool;
+	struct slbt_stoolie_worker *    workerv;
+	struct slbt_stoolie_worker *    worker;
+
+	if ((size_t)njobs > nunits)
+		njobs = nunits;
+
+	/* pool */
+	if (!(pool.jobv = calloc(nunits,sizeof(*pool.jobv))))
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	if (!(workerv = calloc(njobs,sizeof(*workerv)))) {
+		free(pool.jobv);
+		return SLBT_SYSTEM_ERROR(dctx,0);
+	}
+
+	pool.dctx   = dctx;
+	pool.srcs   = srcs;
+	pool.njobs  = nunits;
+
+	for (idx=0; idx<nunits; idx++) {
+		pool.jobv[idx].unit  = unitv[idx];
+		pool.jobv[idx].stctx = &stctxv[idx];
+	}
+
+	/* per-worker exec contexts and output buffers */
+	for (ret=0,worker=workerv; !ret && (worker<&workerv[njobs]); worker++) {
+		worker->pool  = &pool;
+		worker->fdout = -1;
+		worker->fderr = -1;
+
+		if (worker == workerv) {
+			worker->ectx = ectx;
+
+		} else if (slbt_ectx_get_exec_ctx(dctx,&worker->ectx) < 0) {
+			ret = SLBT_NESTED_ERROR(dctx);
+			continue;
+
+		} else {
+			slbt_ectx_reset_arguments(worker->ectx);
+			slbt_disable_placeholders(worker->ectx);
+		}
+
+		if ((worker->fdout = slbt_tmpfile()) < 0)
+			ret = SLBT_SYSTEM_ERROR(dctx,0);
+
+		else if ((worker->fderr = slbt_tmpfile()) < 0)
+			ret = SLBT_SYSTEM_ERROR(dctx,0);
+
+		slbt_exec_set_fdout(worker->ectx,worker->fdout);
+		slbt_exec_set_fderr(worker->ectx,worker->fderr);
+	}
+
+	/* parse all contexts, then perform all actions */
+	if (!ret) {
+		pool.fapply = false;
+		ret = slbt_exec_stoolie_run_pool(&pool,workerv,njobs);
+	}
+
+	if (!ret) {
+		pool.fapply = true;
+		ret = slbt_exec_stoolie_run_pool(&pool,workerv,njobs);
+	}
+
+	/* cleanup */
+	for (worker=workerv; worker<&workerv[njobs]; worker++) {
+		if (worker->fdout >= 0)
+			close(worker->fdout);
+
+		if (worker->fderr >= 0)
+			close(worker->fderr);
+
+		if (worker->ectx && (worker != workerv))
+			slbt_ectx_free_exec_ctx(worker->ectx);
+	}
+
+	slbt_exec_set_fdout(ectx,-1);
+	slbt_exec_set_fderr(ectx,-1);
+
+	free(workerv);
+	free(pool.jobv);
+
+	return ret;
+}
+
 int slbt_exec_stoolie(const struct slbt_driver_ctx * dctx)
 {
 	int				ret;
@@ -217,12 +540,16 @@ int slbt_exec_stoolie(const struct slbt_driver_ctx * dctx)
 	const struct slbt_common_ctx *	cctx;
 	struct argv_meta *		meta;
 	struct argv_entry *		entry;
+	long				njobs;
 	size_t				nunits;
 	size_t                          cunits;
+	size_t                          idx;
+	const char *                    jobs;
 	const char **                   unitv;
 	const char **                   unitp;
 	struct slbt_stoolie_ctx **      stctxv;
 	struct slbt_stoolie_ctx **      stctxp;
+	struct slbt_stoolie_srcs        srcs;
 	const struct argv_option *	optv[SLBT_OPTV_ELEMENTS];
 
 	/* context */
@@ -259,6 +586,7 @@ int slbt_exec_stoolie(const struct slbt_driver_ctx * dctx)
 	argv    = ectx->altv;
 	*argv++ = iargv[0];
 	nunits  = 0;
+	jobs    = 0;
 
 	for (entry=meta->entries; entry->fopt || entry->arg; entry++) {
 		if (entry->fopt) {
@@ -311,6 +639,10 @@ int slbt_exec_stoolie(const struct slbt_driver_ctx * dctx)
 					ictx->cctx.drvflags &= ~(uint64_t)SLBT_DRIVER_SILENT;
 					ictx->cctx.drvflags |= SLBT_DRIVER_VERBOSE;
 					break;
+
+				case TAG_STLE_JOBS:
+					jobs = entry->arg;
+					break;
 			}
 
 			if (entry->fval) {
@@ -328,6 +660,18 @@ int slbt_exec_stoolie(const struct slbt_driver_ctx * dctx)
 		return SLBT_OK;
 	}
 
+	/* source files, shared by all target directories */
+	if (slbt_exec_stoolie_init_srcs(dctx,&srcs) < 0)
+		return slbt_exec_stoolie_fail(
+			ectx,meta,
+			SLBT_NESTED_ERROR(dctx));
+
+	/* concurrent slibtoolize? */
+	if ((njobs = slbt_exec_stoolie_get_jobs(dctx,jobs)) < 0)
+		return slbt_exec_stoolie_fail(
+			ectx,meta,
+			SLBT_CUSTOM_ERROR(dctx,SLBT_ERR_FLOW_ERROR));
+
 	/* default to this-dir as needed */
 	if (!(cunits = nunits))
 		nunits++;
@@ -355,6 +699,27 @@ int slbt_exec_stoolie(const struct slbt_driver_ctx * dctx)
 	if (!cunits)
 		unitp[0] = slbt_this_dir;
 
+	/* concurrent slibtoolize */
+	if ((njobs > 1) && (nunits > 1)) {
+		ret = slbt_exec_stoolie_concurrently(
+			dctx,ectx,&srcs,
+			unitv,stctxv,nunits,njobs);
+
+		if (ret < 0)
+			ret = SLBT_NESTED_ERROR(dctx);
+
+		for (idx=0; idx<nunits; idx++)
+			slbt_st_free_stoolie_ctx(stctxv[idx]);
+
+		free(unitv);
+		free(stctxv);
+
+		slbt_argv_free(meta);
+		slbt_ectx_free_exec_ctx(ectx);
+
+		return ret;
+	}
+
 	/* slibtoolize target directory vector initialization */
 	for (unitp=unitv,stctxp=stctxv; *unitp; unitp++,stctxp++) {
 		if (slbt_st_get_stoolie_ctx(dctx,*unitp,stctxp) < 0) {
@@ -372,7 +737,7 @@ int slbt_exec_stoolie(const struct slbt_driver_ctx * dctx)
 
 	/* slibtoolize operations */
 	for (ret=0,stctxp=stctxv; !ret && *stctxp; stctxp++)
-		ret = slbt_exec_stoolie_perform_actions(dctx,ectx,*stctxp);
+		ret = slbt_exec_stoolie_perform_actions(dctx,ectx,&srcs,*stctxp);
 
 	/* all done */
 	for (stctxp=stctxv; *stctxp; stctxp++)
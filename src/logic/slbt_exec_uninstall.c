@@ -6,7 +6,11 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
 #include <stdbool.h>
+#include <unistd.h>
+#include <dirent.h>
 #include <fcntl.h>
 #include <errno.h>
 #include <sys/stat.h>
@@ -19,6 +23,10 @@
 #include "slibtool_errinfo_impl.h"
 #include "argv/argv.h"
 
+#ifndef O_DIRECTORY
+#define O_DIRECTORY 0
+#endif
+
 static int slbt_uninstall_usage(
 	int				fdout,
 	const char *			program,
@@ -59,26 +67,345 @@ static int slbt_exec_uninstall_fail(
 	return ret;
 }
 
+/*****************************************************************/
+/* every destination directory is opened once, and all lookups,  */
+/* reads of symlinks, and removals are relative to its fd. once  */
+/* a directory is named by SLBT_UNINSTALL_SCAN_MIN arguments or   */
+/* more, it is enumerated a single time, and the existence of    */
+/* each candidate (.so, .so.x, .a, .dll, ...) is then determined */
+/* by way of an in-memory set of that directory's entries.       */
+/*****************************************************************/
+
+#define SLBT_UNINSTALL_SCAN_MIN		16
+
+struct slbt_uninstall_name {
+	char *				name;
+	bool				ftype;
+	bool				fdir;
+	bool				fremoved;
+};
+
+struct slbt_uninstall_dir {
+	struct slbt_uninstall_dir *	next;
+	char *				path;
+	int				fd;
+	size_t				nargs;
+	bool				fscan;
+	bool				fgone;
+	size_t				nnames;
+	size_t				nslots;
+	struct slbt_uninstall_name *	slotv;
+};
+
+struct slbt_uninstall_ctx {
+	const struct slbt_driver_ctx *	dctx;
+	struct slbt_uninstall_dir *	dirs;
+};
+
+static uint32_t slbt_uninstall_hash(const char * name)
+{
+	uint32_t	hash;
+
+	for (hash=2166136261u; *name; name++)
+		hash = (hash ^ (unsigned char)*name) * 16777619u;
+
+	return hash;
+}
+
+static struct slbt_uninstall_name * slbt_uninstall_dir_slot(
+	const struct slbt_uninstall_dir *	dir,
+	const char *				name)
+{
+	size_t				idx;
+	struct slbt_uninstall_name *	slot;
+
+	idx = slbt_uninstall_hash(name) & (dir->nslots - 1);
+
+	for (slot=&dir->slotv[idx]; slot->name; slot=&dir->slotv[idx]) {
+		if (!strcmp(slot->name,name))
+			return slot;
+
+		idx = (idx + 1) & (dir->nslots - 1);
+	}
+
+	return slot;
+}
+
+static void slbt_uninstall_free_dirs(struct slbt_uninstall_ctx * uctx)
+{
+	struct slbt_uninstall_dir *	dir;
+	struct slbt_uninstall_dir *	next;
+	size_t				idx;
+
+	for (dir=uctx->dirs; dir; dir=next) {
+		next = dir->next;
+
+		for (idx=0; idx<dir->nslots; idx++)
+			free(dir->slotv[idx].name);
+
+		if (dir->fd >= 0)
+			close(dir->fd);
+
+		free(dir->slotv);
+		free(dir->path);
+		free(dir);
+	}
+
+	uctx->dirs = 0;
+}
+
+static int slbt_uninstall_split_path(
+	const char *	path,
+	char		(*dirname)[PATH_MAX],
+	const char **	base)
+{
+	const char *	slash;
+
+	if (!(slash = strrchr(path,'/'))) {
+		strcpy(*dirname,".");
+		*base = path;
+		return 0;
+	}
+
+	if ((size_t)(slash - path) >= sizeof(*dirname))
+		return -1;
+
+	memcpy(*dirname,path,slash - path);
+	(*dirname)[slash - path] = 0;
+
+	if (!(*dirname)[0])
+		strcpy(*dirname,"/");
+
+	*base = &slash[1];
+
+	return 0;
+}
+
+static struct slbt_uninstall_dir * slbt_uninstall_get_dir(
+	struct slbt_uninstall_ctx *	uctx,
+	const char *			dirname)
+{
+	struct slbt_uninstall_dir *	dir;
+	const struct slbt_driver_ctx *	dctx;
+
+	dctx = uctx->dctx;
+
+	for (dir=uctx->dirs; dir; dir=dir->next)
+		if (!strcmp(dir->path,dirname))
+			return dir;
+
+	if (!(dir = calloc(1,sizeof(*dir))))
+		return 0;
+
+	if (!(dir->path = strdup(dirname))) {
+		free(dir);
+		return 0;
+	}
+
+	/* a missing directory has no entries */
+	dir->fd = openat(
+		slbt_driver_fdcwd(dctx),dirname,
+		O_RDONLY|O_DIRECTORY|O_CLOEXEC,0);
+
+	if ((dir->fd < 0) && (errno != ENOENT) && (errno != ENOTDIR)) {
+		SLBT_SYSTEM_ERROR(dctx,dirname);
+		free(dir->path);
+		free(dir);
+		return 0;
+	}
+
+	dir->fgone = (dir->fd < 0);
+	dir->next  = uctx->dirs;
+	uctx->dirs = dir;
+
+	return dir;
+}
+
+static int slbt_uninstall_dir_grow(struct slbt_uninstall_dir * dir)
+{
+	struct slbt_uninstall_name *	slotv;
+	struct slbt_uninstall_name *	slot;
+	struct slbt_uninstall_name *	cap;
+	size_t				nslots;
+
+	nslots = dir->nslots ? 2*dir->nslots : 256;
+
+	if (!(slotv = calloc(nslots,sizeof(*slotv))))
+		return -1;
+
+	slot = dir->slotv;
+	cap  = &slot[dir->nslots];
+
+	dir->slotv  = slotv;
+	dir->nslots = nslots;
+
+	for (slotv=slot; slotv && (slotv<cap); slotv++)
+		if (slotv->name)
+			*slbt_uninstall_dir_slot(dir,slotv->name) = *slotv;
+
+	free(slot);
+
+	return 0;
+}
+
+static int slbt_uninstall_scan_dir(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_uninstall_dir *	dir)
+{
+	int				fd;
+	DIR *				dirp;
+	struct dirent *			dent;
+	struct slbt_uninstall_name *	slot;
+
+	dir->fscan = true;
+
+	if (dir->fgone)
+		return 0;
+
+	/* readdir (getdents) on a private copy of the directory fd */
+	if ((fd = openat(dir->fd,".",O_RDONLY|O_DIRECTORY|O_CLOEXEC,0)) < 0)
+		return SLBT_SYSTEM_ERROR(dctx,dir->path);
+
+	if (!(dirp = fdopendir(fd))) {
+		close(fd);
+		return SLBT_SYSTEM_ERROR(dctx,dir->path);
+	}
+
+	if (slbt_uninstall_dir_grow(dir) < 0) {
+		closedir(dirp);
+		return SLBT_SYSTEM_ERROR(dctx,0);
+	}
+
+	while ((dent = readdir(dirp))) {
+		if (!strcmp(dent->d_name,".") || !strcmp(dent->d_name,".."))
+			continue;
+
+		if (2*(dir->nnames + 1) > dir->nslots) {
+			if (slbt_uninstall_dir_grow(dir) < 0) {
+				closedir(dirp);
+				return SLBT_SYSTEM_ERROR(dctx,0);
+			}
+		}
+
+		slot = slbt_uninstall_dir_slot(dir,dent->d_name);
+
+		if (!(slot->name = strdup(dent->d_name))) {
+			closedir(dirp);
+			return SLBT_SYSTEM_ERROR(dctx,0);
+		}
+
+		dir->nnames++;
+
+#ifdef DT_DIR
+		slot->ftype = (dent->d_type != DT_UNKNOWN);
+		slot->fdir  = (dent->d_type == DT_DIR);
+#endif
+	}
+
+	closedir(dirp);
+
+	return 0;
+}
+
+/* lstat semantics: does name exist, and is it a directory? */
+static int slbt_uninstall_lookup(
+	const struct slbt_driver_ctx *	dctx,
+	struct slbt_uninstall_dir *	dir,
+	const char *			name,
+	bool *				fdir)
+{
+	struct stat			st;
+	struct slbt_uninstall_name *	slot;
+
+	if (dir->fgone)
+		return 0;
+
+	if (!dir->fscan && (dir->nargs >= SLBT_UNINSTALL_SCAN_MIN))
+		if (slbt_uninstall_scan_dir(dctx,dir) < 0)
+			return SLBT_NESTED_ERROR(dctx);
+
+	if (dir->slotv) {
+		slot = slbt_uninstall_dir_slot(dir,name);
+
+		if (!slot->name || slot->fremoved)
+			return 0;
+
+		if ((*fdir = slot->fdir) || slot->ftype)
+			return 1;
+	}
+
+	if (fstatat(dir->fd,name,&st,AT_SYMLINK_NOFOLLOW))
+		return 0;
+
+	*fdir = S_ISDIR(st.st_mode);
+
+	return 1;
+}
+
+static void slbt_uninstall_mark_removed(
+	struct slbt_uninstall_dir *	dir,
+	const char *			name)
+{
+	struct slbt_uninstall_name *	slot;
+
+	if (dir->slotv)
+		if ((slot = slbt_uninstall_dir_slot(dir,name))->name)
+			slot->fremoved = true;
+}
+
+static int slbt_uninstall_readlink(
+	struct slbt_uninstall_ctx *	uctx,
+	const char *			path,
+	char *				buf,
+	size_t				bufsize)
+{
+	const char *			base;
+	struct slbt_uninstall_dir *	dir;
+	char				dpath[PATH_MAX];
+
+	if (slbt_uninstall_split_path(path,&dpath,&base) < 0)
+		return -1;
+
+	if (!(dir = slbt_uninstall_get_dir(uctx,dpath)))
+		return -1;
+
+	if (dir->fgone)
+		return -1;
+
+	return slbt_readlinkat(dir->fd,base,buf,bufsize);
+}
+
 static int slbt_exec_uninstall_fs_entry(
 	const struct slbt_driver_ctx *	dctx,
 	struct slbt_exec_ctx *		ectx,
+	struct slbt_uninstall_ctx *	uctx,
 	char **				parg,
 	char *				path,
 	uint32_t			flags)
 {
-	struct stat	st;
-	int		fdcwd;
-	char *		slash;
-	char		dpath[PATH_MAX];
+	int				ret;
+	bool				fdir;
+	const char *			base;
+	struct slbt_uninstall_dir *	dir;
+	struct slbt_uninstall_dir *	cdir;
+	char				dpath[PATH_MAX];
+	char				ppath[PATH_MAX];
+
+	/* containing directory */
+	fdir = false;
+
+	if (slbt_uninstall_split_path(path,&dpath,&base) < 0)
+		return SLBT_BUFFER_ERROR(dctx);
 
-	/* fdcwd */
-	fdcwd = slbt_driver_fdcwd(dctx);
+	if (!(dir = slbt_uninstall_get_dir(uctx,dpath)))
+		return SLBT_NESTED_ERROR(dctx);
 
 	/* needed? */
-	if (fstatat(fdcwd,path,&st,0) && (errno == ENOENT))
-		if (fstatat(fdcwd,path,&st,AT_SYMLINK_NOFOLLOW))
-			if (errno == ENOENT)
-				return 0;
+	if ((ret = slbt_uninstall_lookup(dctx,dir,base,&fdir)) < 0)
+		return SLBT_NESTED_ERROR(dctx);
+
+	else if (ret == 0)
+		return 0;
 
 	/* output */
 	*parg = path;
@@ -88,33 +415,41 @@ static int slbt_exec_uninstall_fs_entry(
 			return SLBT_NESTED_ERROR(dctx);
 
 	/* directory? */
-	if (S_ISDIR(st.st_mode)) {
-		if (!unlinkat(fdcwd,path,AT_REMOVEDIR))
+	if (fdir) {
+		if (!unlinkat(dir->fd,base,AT_REMOVEDIR)) {
+			slbt_uninstall_mark_removed(dir,base);
 			return 0;
 
-		else if ((errno == EEXIST) || (errno == ENOTEMPTY))
+		} else if ((errno == EEXIST) || (errno == ENOTEMPTY)) {
 			return 0;
 
-		else
+		} else {
 			return SLBT_SYSTEM_ERROR(dctx,path);
+		}
 	}
 
 	/* remove file or symlink entry */
-	if (unlinkat(fdcwd,path,0))
+	if (unlinkat(dir->fd,base,0))
 		return SLBT_SYSTEM_ERROR(dctx,path);
 
+	slbt_uninstall_mark_removed(dir,base);
+
 	/* remove empty containing directory? */
 	if (flags & SLBT_UNINSTALL_RMDIR) {
-		strcpy(dpath,path);
-
 		/* invalid (current) directory? */
-		if (!(slash = strrchr(dpath,'/')))
+		if (!strchr(path,'/'))
 			return 0;
 
-		*slash = 0;
-
-		if (unlinkat(fdcwd,dpath,AT_REMOVEDIR))
+		if (unlinkat(slbt_driver_fdcwd(dctx),dpath,AT_REMOVEDIR))
 			return SLBT_SYSTEM_ERROR(dctx,dpath);
+
+		dir->fgone = true;
+
+		/* the directory's entry in its parent, as needed */
+		if (!slbt_uninstall_split_path(dpath,&ppath,&base))
+			for (cdir=uctx->dirs; cdir; cdir=cdir->next)
+				if (!strcmp(cdir->path,ppath))
+					slbt_uninstall_mark_removed(cdir,base);
 	}
 
 	return 0;
@@ -123,6 +458,7 @@ static int slbt_exec_uninstall_fs_entry(
 static int slbt_exec_uninstall_versioned_library(
 	const struct slbt_driver_ctx *	dctx,
 	struct slbt_exec_ctx *		ectx,
+	struct slbt_uninstall_ctx *	uctx,
 	char **				parg,
 	char *				rpath,
 	char *				lpath,
@@ -149,7 +485,7 @@ static int slbt_exec_uninstall_versioned_library(
 
 	/* delete associated version files */
 	while ((dot = strrchr(path,'.')) && (strcmp(dot,suffix))) {
-		if (slbt_exec_uninstall_fs_entry(dctx,ectx,parg,path,flags))
+		if (slbt_exec_uninstall_fs_entry(dctx,ectx,uctx,parg,path,flags))
 			return SLBT_NESTED_ERROR(dctx);
 
 		*dot = 0;
@@ -161,11 +497,11 @@ static int slbt_exec_uninstall_versioned_library(
 static int slbt_exec_uninstall_entry(
 	const struct slbt_driver_ctx *	dctx,
 	struct slbt_exec_ctx *		ectx,
+	struct slbt_uninstall_ctx *	uctx,
 	struct argv_entry *		entry,
 	char **				parg,
 	uint32_t			flags)
 {
-	int		fdcwd;
 	const char *	dsosuffix;
 	char *		dot;
 	char		path [PATH_MAX];
@@ -178,11 +514,8 @@ static int slbt_exec_uninstall_entry(
 
 	*parg = (char *)entry->arg;
 
-	/* fdcwd */
-	fdcwd = slbt_driver_fdcwd(dctx);
-
 	/* remove explicit argument */
-	if (slbt_exec_uninstall_fs_entry(dctx,ectx,parg,path,flags))
+	if (slbt_exec_uninstall_fs_entry(dctx,ectx,uctx,parg,path,flags))
 		return SLBT_NESTED_ERROR(dctx);
 
 	/* non-.la-wrapper argument? */
@@ -195,7 +528,7 @@ static int slbt_exec_uninstall_entry(
 	/* remove .a archive as needed */
 	strcpy(dot,".a");
 
-	if (slbt_exec_uninstall_fs_entry(dctx,ectx,parg,path,flags))
+	if (slbt_exec_uninstall_fs_entry(dctx,ectx,uctx,parg,path,flags))
 		return SLBT_NESTED_ERROR(dctx);
 
 	/* dsosuffix */
@@ -204,9 +537,9 @@ static int slbt_exec_uninstall_entry(
 	/* .so symlink? */
 	strcpy(dot,dsosuffix);
 
-	if (!(slbt_readlinkat(fdcwd,path,lpath,sizeof(lpath))))
+	if (!(slbt_uninstall_readlink(uctx,path,lpath,sizeof(lpath))))
 		if (slbt_exec_uninstall_versioned_library(
-				dctx,ectx,parg,
+				dctx,ectx,uctx,parg,
 				path,lpath,
 				dsosuffix,flags))
 			return SLBT_NESTED_ERROR(dctx);
@@ -214,9 +547,9 @@ static int slbt_exec_uninstall_entry(
 	/* .lib.a symlink? */
 	strcpy(dot,".lib.a");
 
-	if (!(slbt_readlinkat(fdcwd,path,lpath,sizeof(lpath))))
+	if (!(slbt_uninstall_readlink(uctx,path,lpath,sizeof(lpath))))
 		if (slbt_exec_uninstall_versioned_library(
-				dctx,ectx,parg,
+				dctx,ectx,uctx,parg,
 				path,lpath,
 				".lib.a",flags))
 			return SLBT_NESTED_ERROR(dctx);
@@ -224,9 +557,9 @@ static int slbt_exec_uninstall_entry(
 	/* .dll symlink? */
 	strcpy(dot,".dll");
 
-	if (!(slbt_readlinkat(fdcwd,path,lpath,sizeof(lpath))))
+	if (!(slbt_uninstall_readlink(uctx,path,lpath,sizeof(lpath))))
 		if (slbt_exec_uninstall_versioned_library(
-				dctx,ectx,parg,
+				dctx,ectx,uctx,parg,
 				path,lpath,
 				".dll",flags))
 			return SLBT_NESTED_ERROR(dctx);
@@ -234,31 +567,31 @@ static int slbt_exec_uninstall_entry(
 	/* remove .so library as needed */
 	strcpy(dot,dsosuffix);
 
-	if (slbt_exec_uninstall_fs_entry(dctx,ectx,parg,path,flags))
+	if (slbt_exec_uninstall_fs_entry(dctx,ectx,uctx,parg,path,flags))
 		return SLBT_NESTED_ERROR(dctx);
 
 	/* remove .lib.a import library as needed */
 	strcpy(dot,".lib.a");
 
-	if (slbt_exec_uninstall_fs_entry(dctx,ectx,parg,path,flags))
+	if (slbt_exec_uninstall_fs_entry(dctx,ectx,uctx,parg,path,flags))
 		return SLBT_NESTED_ERROR(dctx);
 
 	/* remove .dll library as needed */
 	strcpy(dot,".dll");
 
-	if (slbt_exec_uninstall_fs_entry(dctx,ectx,parg,path,flags))
+	if (slbt_exec_uninstall_fs_entry(dctx,ectx,uctx,parg,path,flags))
 		return SLBT_NESTED_ERROR(dctx);
 
 	/* remove .exe image as needed */
 	strcpy(dot,".exe");
 
-	if (slbt_exec_uninstall_fs_entry(dctx,ectx,parg,path,flags))
+	if (slbt_exec_uninstall_fs_entry(dctx,ectx,uctx,parg,path,flags))
 		return SLBT_NESTED_ERROR(dctx);
 
 	/* remove binary image as needed */
 	*dot = 0;
 
-	if (slbt_exec_uninstall_fs_entry(dctx,ectx,parg,path,flags))
+	if (slbt_exec_uninstall_fs_entry(dctx,ectx,uctx,parg,path,flags))
 		return SLBT_NESTED_ERROR(dctx);
 
 	return 0;
@@ -270,10 +603,14 @@ int slbt_exec_uninstall(const struct slbt_driver_ctx * dctx)
 	char **				argv;
 	char **				iargv;
 	uint32_t			flags;
+	const char *			base;
 	struct slbt_exec_ctx *		ectx;
 	struct argv_meta *		meta;
 	struct argv_entry *		entry;
+	struct slbt_uninstall_ctx	uctx;
+	struct slbt_uninstall_dir *	dir;
 	const struct argv_option *	optv[SLBT_OPTV_ELEMENTS];
+	char				dpath[PATH_MAX];
 
 	/* dry run */
 	if (dctx->cctx->drvflags & SLBT_DRIVER_DRY_RUN)
@@ -362,14 +699,43 @@ int slbt_exec_uninstall(const struct slbt_driver_ctx * dctx)
 	ectx->argv    = ectx->altv;
 	ectx->program = ectx->altv[0];
 
+	/* destination directories, by number of arguments */
+	uctx.dctx = dctx;
+	uctx.dirs = 0;
+
+	for (entry=meta->entries; entry->fopt || entry->arg; entry++) {
+		if (!entry->fopt) {
+			if (slbt_uninstall_split_path(entry->arg,&dpath,&base) < 0) {
+				slbt_uninstall_free_dirs(&uctx);
+				return slbt_exec_uninstall_fail(
+					ectx,meta,
+					SLBT_BUFFER_ERROR(dctx));
+			}
+
+			if (!(dir = slbt_uninstall_get_dir(&uctx,dpath))) {
+				slbt_uninstall_free_dirs(&uctx);
+				return slbt_exec_uninstall_fail(
+					ectx,meta,
+					SLBT_NESTED_ERROR(dctx));
+			}
+
+			dir->nargs++;
+		}
+	}
+
 	/* uninstall entries one at a time */
-	for (entry=meta->entries; entry->fopt || entry->arg; entry++)
-		if (!entry->fopt)
-			if (slbt_exec_uninstall_entry(dctx,ectx,entry,argv,flags))
+	for (entry=meta->entries; entry->fopt || entry->arg; entry++) {
+		if (!entry->fopt) {
+			if (slbt_exec_uninstall_entry(dctx,ectx,&uctx,entry,argv,flags)) {
+				slbt_uninstall_free_dirs(&uctx);
 				return slbt_exec_uninstall_fail(
 					ectx,meta,
 					SLBT_NESTED_ERROR(dctx));
+			}
+		}
+	}
 
+	slbt_uninstall_free_dirs(&uctx);
 	slbt_argv_free(meta);
 	slbt_ectx_free_exec_ctx(ectx);
 
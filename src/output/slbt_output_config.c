@@ -12,6 +12,7 @@
 #include "slibtool_driver_impl.h"
 #include "slibtool_dprintf_impl.h"
 #include "slibtool_errinfo_impl.h"
+#include "slibtool_toolchain_impl.h"
 
 static const char enable[]  = "yes";
 static const char disable[] = "no";
@@ -177,9 +178,9 @@ int slbt_output_config(const struct slbt_driver_ctx * dctx)
 	const struct slbt_map_info *    lconf;
 
 	ictx  = slbt_get_driver_ictx(dctx);
-	lconf = &ictx->lconf;
+	lconf = ictx->toolchain ? &ictx->toolchain->lconf : 0;
 
-	if (lconf->addr)
+	if (lconf && lconf->addr)
 		return slbt_output_config_lconf(
 			dctx,lconf);
 
@@ -32,7 +32,7 @@ static int slbt_output_exec_annotated(
 	const char * aclr_unset;
 
 	fdout = (strcmp(step,"execute"))
-		? slbt_driver_fdout(dctx)
+		? slbt_exec_get_fdout(ectx)
 		: slbt_driver_fderr(dctx);
 
 	if (slbt_dprintf(
@@ -77,7 +77,7 @@ static int slbt_output_exec_plain(
 	char ** parg;
 
 	fdout = (strcmp(step,"execute"))
-		? slbt_driver_fdout(dctx)
+		? slbt_exec_get_fdout(ectx)
 		: slbt_driver_fderr(dctx);
 
 	if (slbt_dprintf(fdout,"%s: %s:",dctx->program,step) < 0)
@@ -119,6 +119,11 @@ int slbt_output_exec(
 		return slbt_output_exec_plain(dctx,ectx,step);
 }
 
+int slbt_output_clean(const struct slbt_exec_ctx * ectx)
+{
+	return slbt_output_exec(ectx,"clean");
+}
+
 int slbt_output_compile(const struct slbt_exec_ctx * ectx)
 {
 	return slbt_output_exec(ectx,"compile");
@@ -7,11 +7,13 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdbool.h>
+#include <inttypes.h>
 
 #include <slibtool/slibtool.h>
 #include "slibtool_driver_impl.h"
 #include "slibtool_dprintf_impl.h"
 #include "slibtool_errinfo_impl.h"
+#include "slibtool_objcache_impl.h"
 
 #ifndef SLBT_TAB_WIDTH
 #define SLBT_TAB_WIDTH 8
@@ -35,6 +37,46 @@ static bool slbt_output_info_line(
 		? true : false;
 }
 
+static int slbt_output_info_objcache(
+	const struct slbt_driver_ctx *	dctx,
+	int				fdout,
+	int				midwidth)
+{
+	struct slbt_objcache_stats	stats;
+	char				hits[32];
+	char				misses[32];
+	char				stores[32];
+	char				evictions[32];
+
+	if (slbt_objcache_get_stats(dctx,&stats) < 0)
+		return SLBT_SYSTEM_ERROR(dctx,dctx->cctx->objcache);
+
+	snprintf(hits,sizeof(hits),"%"PRIu64,stats.hits);
+	snprintf(misses,sizeof(misses),"%"PRIu64,stats.misses);
+	snprintf(stores,sizeof(stores),"%"PRIu64,stats.stores);
+	snprintf(evictions,sizeof(evictions),"%"PRIu64,stats.evictions);
+
+	if (slbt_output_info_line(fdout,"objcache",dctx->cctx->objcache,"",midwidth))
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	if (slbt_output_info_line(fdout,"objcache-size",dctx->cctx->objcachemax,"",midwidth))
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	if (slbt_output_info_line(fdout,"objcache-hits",hits,"",midwidth))
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	if (slbt_output_info_line(fdout,"objcache-misses",misses,"",midwidth))
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	if (slbt_output_info_line(fdout,"objcache-stores",stores,"",midwidth))
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	if (slbt_output_info_line(fdout,"objcache-evicts",evictions,"",midwidth))
+		return SLBT_SYSTEM_ERROR(dctx,0);
+
+	return 0;
+}
+
 int slbt_output_info(const struct slbt_driver_ctx * dctx)
 {
 	const struct slbt_common_ctx *	cctx;
@@ -80,6 +122,9 @@ int slbt_output_info(const struct slbt_driver_ctx * dctx)
 	if ((len = strlen(cctx->host.mdso)) > midwidth)
 		midwidth = len;
 
+	if (cctx->objcache && ((len = strlen(cctx->objcache)) > midwidth))
+		midwidth = len;
+
 	midwidth += SLBT_TAB_WIDTH;
 	midwidth &= (~(SLBT_TAB_WIDTH-1));
 
@@ -122,5 +167,8 @@ int slbt_output_info(const struct slbt_driver_ctx * dctx)
 	if (slbt_output_info_line(fdout,"mdso",cctx->host.mdso,cctx->cfgmeta.mdso,midwidth))
 		return SLBT_SYSTEM_ERROR(dctx,0);
 
+	if (cctx->objcache)
+		return slbt_output_info_objcache(dctx,fdout,midwidth);
+
 	return 0;
 }
@@ -31,6 +31,13 @@ const slbt_hidden struct argv_option slbt_ar_options[] = {
 			"specify the name of the archive to be created "
 			"(or replaced) as a result of a -Wmerge operation."},
 
+	{"Wthin",	0,TAG_AR_THIN,ARGV_OPTARG_NONE,
+			ARGV_OPTION_HYBRID_ONLY,0,0,
+			"create a thin archive as a result of a -Wmerge "
+			"operation; all input archives must be thin, and "
+			"member paths are adjusted to be relative to the "
+			"location of the new archive."},
+
 	{"Wprint",	0,TAG_AR_PRINT,ARGV_OPTARG_OPTIONAL,
 			ARGV_OPTION_HYBRID_EQUAL|ARGV_OPTION_HYBRID_COMMA,
 			"members|symbols",0,
@@ -93,5 +100,14 @@ const slbt_hidden struct argv_option slbt_ar_options[] = {
 			"in combination with -Wpretty=posix, this will result "
 			"in `ar(1) -tv` compatible output."},
 
+	{"Wjobs",	0,TAG_AR_JOBS,ARGV_OPTARG_OPTIONAL,
+			ARGV_OPTION_HYBRID_EQUAL,
+			0,"<count>",
+			"open, parse, and print out the specified archives "
+			"using at most %s concurrent threads, the default "
+			"being the number of online processors; output is "
+			"buffered per archive and written in command-line "
+			"order."},
+
 	{0,0,0,0,0,0,0,0}
 };
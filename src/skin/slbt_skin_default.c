@@ -29,9 +29,7 @@ const slbt_hidden struct argv_option slbt_default_options[] = {
 				"set the execution mode, where <mode> "
 				"is one of {%s}. of the above modes, "
 				"'finish' is not needed and is therefore "
-				"a no-op; 'clean' is currently not implemented, "
-				"however its addition is expected before the "
-				"next major release."},
+				"a no-op."},
 
 	{"print-aux-dir",	0,TAG_PRINT_AUX_DIR,ARGV_OPTARG_NONE,
 				ARGV_OPTION_HYBRID_ONLY,0,0,
@@ -59,6 +57,38 @@ const slbt_hidden struct argv_option slbt_default_options[] = {
 	{"finish",		0,TAG_FINISH,ARGV_OPTARG_NONE,0,0,0,
 				"same as --mode=finish"},
 
+	{"batch",		0,TAG_BATCH,ARGV_OPTARG_REQUIRED,0,0,"<file>",
+				"read complete slibtool command lines from %s "
+				"(or from standard input when the argument is '-'), one "
+				"command per line, or alternatively as a sequence "
+				"of nul-terminated arguments with an empty argument "
+				"terminating each command; execute the commands "
+				"concurrently, and report their output and exit "
+				"status in input order."},
+
+	{"batch-jobs",		0,TAG_BATCH_JOBS,ARGV_OPTARG_REQUIRED,0,0,"<count>",
+				"batch mode: execute at most %s commands "
+				"at a time; the default is the number of "
+				"online processors."},
+
+	{"server",		0,TAG_SERVER,ARGV_OPTARG_REQUIRED,0,0,"<socket>",
+				"run as a persistent local server that listens on "
+				"the unix domain %s, and which executes the requests "
+				"of slibtool-client; the client locates the server "
+				"via the SLIBTOOL_SERVER environment variable, "
+				"and otherwise executes the command by itself."},
+
+	{"install-jobs",	0,TAG_INSTALL_JOBS,ARGV_OPTARG_REQUIRED,0,0,"<count>",
+				"install mode: install at most %s files or "
+				"libraries at a time; the default is one at "
+				"a time. output and errors are reported in "
+				"command-line order."},
+
+	{"clean-jobs",		0,TAG_CLEAN_JOBS,ARGV_OPTARG_REQUIRED,0,0,"<count>",
+				"clean mode: remove the artifacts of at most %s "
+				"directories at a time; the default is the number "
+				"of online processors."},
+
 	{"dry-run",		'n',TAG_DRY_RUN,ARGV_OPTARG_NONE,0,0,0,
 				"do not spawn any processes, "
 				"do not make any changes to the file system."},
@@ -108,6 +138,37 @@ const slbt_hidden struct argv_option slbt_default_options[] = {
 				"and purify) when immediately followed "
 				"by the compiler argument."},
 
+	{"object-cache",	0,TAG_OBJECT_CACHE,ARGV_OPTARG_REQUIRED,0,0,
+				"<dir>",
+				"compile mode: look up and store compiled objects "
+				"in the local, content-addressed object cache "
+				"located in %s; cache entries are keyed by the "
+				"compiler's identity, the final argument vector, "
+				"and the preprocessed translation unit."},
+
+	{"object-cache-size",	0,TAG_OBJECT_CACHE_SIZE,ARGV_OPTARG_REQUIRED,0,0,
+				"<size>[K|M|G]",
+				"limit the size of the object cache to %s, "
+				"evicting least recently used entries as needed."},
+
+	{"incremental-archive",	0,TAG_INCREMENTAL_ARCHIVE,ARGV_OPTARG_NONE,0,0,0,
+				"link mode: when the static archive "
+				"already exists, replace only those members whose "
+				"input objects have changed, rather than recreating "
+				"the archive from scratch."},
+
+	{"thin-archive",	0,TAG_THIN_ARCHIVE,ARGV_OPTARG_NONE,0,0,0,
+				"link mode: create convenience libraries "
+				"(libtool archives that are not installed) as "
+				"thin archives, which refer to their member objects "
+				"rather than contain copies of them."},
+
+	{"sort-symbols",	0,TAG_SORT_SYMBOLS,ARGV_OPTARG_NONE,0,0,0,
+				"link mode: list the symbols of an -export-symbols "
+				"file in sorted order when generating the linker's "
+				"version script, export list, or module-definition "
+				"file, rather than in order of first appearance."},
+
 	{"no-warnings",		0,TAG_WARNINGS,ARGV_OPTARG_NONE,0,0,0,""},
 
 	{"preserve-dup-deps",	0,TAG_DEPS,ARGV_OPTARG_NONE,0,0,0,
@@ -153,7 +214,8 @@ const slbt_hidden struct argv_option slbt_default_options[] = {
 
 	{"dlltool",		0,TAG_DLLTOOL,ARGV_OPTARG_REQUIRED,0,0,"<dlltool>",
 				"explicitly specify the PE import library generator "
-				"to be used."},
+				"to be used (legacy import libraries are otherwise "
+				"written by slibtool itself)."},
 
 	{"mdso",		0,TAG_MDSO,ARGV_OPTARG_REQUIRED,0,0,"<mdso>",
 				"explicitly specify the PE custom import library "
@@ -54,5 +54,9 @@ const slbt_hidden struct argv_option slbt_stoolie_options[] = {
 			"compatibility, and is currently a no-op, thereby "
 			"deferring -lltdl to the system install library."},
 
+	{"jobs",	'j',TAG_STLE_JOBS,ARGV_OPTARG_REQUIRED,0,0,"<count>",
+			"set up at most %s target directories at a time; "
+			"the default is one directory at a time."},
+
 	{0,0,0,0,0,0,0,0}
 };
@@ -4,10 +4,13 @@
 /*  Released under the Standard MIT License; see COPYING.SLIBTOOL. */
 /*******************************************************************/
 
+#include <stdbool.h>
 #include <slibtool/slibtool.h>
 #include "slibtool_driver_impl.h"
 #include "slibtool_symlink_impl.h"
 #include "slibtool_errinfo_impl.h"
+#include "slibtool_ar_impl.h"
+#include "slibtool_visibility_impl.h"
 
 /* legacy fallback, no longer in use */
 extern int slbt_util_import_archive_mri(
@@ -20,7 +23,8 @@ static int slbt_util_import_archive_impl(
 	const struct slbt_driver_ctx *  dctx,
 	const struct slbt_exec_ctx *	ectx,
 	char *				dstarchive,
-	char *				srcarchive)
+	char *				srcarchive,
+	bool				fthin)
 {
 	int                             ret;
 	struct slbt_archive_ctx *       arctxv[3] = {0,0,0};
@@ -36,7 +40,11 @@ static int slbt_util_import_archive_impl(
 		return SLBT_NESTED_ERROR(dctx);
 	}
 
-	ret = slbt_ar_merge_archives(arctxv,&arctx);
+	/* a thin archive imports thin convenience libraries */
+	if (fthin)
+		ret = slbt_ar_merge_thin(arctxv,dstarchive,&arctx);
+	else
+		ret = slbt_ar_merge_archives(arctxv,&arctx);
 
 	slbt_ar_free_archive_ctx(arctxv[0]);
 	slbt_ar_free_archive_ctx(arctxv[1]);
@@ -50,10 +58,11 @@ static int slbt_util_import_archive_impl(
 }
 
 
-int slbt_util_import_archive(
+static int slbt_util_import_archive_common(
 	const struct slbt_exec_ctx *    ectx,
 	char *				dstarchive,
-	char *				srcarchive)
+	char *				srcarchive,
+	bool				fthin)
 {
 	const struct slbt_driver_ctx *	dctx;
 
@@ -67,5 +76,28 @@ int slbt_util_import_archive(
 	return slbt_util_import_archive_impl(
 		dctx,ectx,
 		dstarchive,
-		srcarchive);
+		srcarchive,
+		fthin);
+}
+
+
+int slbt_util_import_archive(
+	const struct slbt_exec_ctx *    ectx,
+	char *				dstarchive,
+	char *				srcarchive)
+{
+	return slbt_util_import_archive_common(
+		ectx,dstarchive,srcarchive,false);
+}
+
+
+/* the destination is thin by decision of the caller, rather than  */
+/* by its signature: ar -crsT with no objects creates an !<arch>.   */
+slbt_hidden int slbt_util_import_thin_archive(
+	const struct slbt_exec_ctx *    ectx,
+	char *				dstarchive,
+	char *				srcarchive)
+{
+	return slbt_util_import_archive_common(
+		ectx,dstarchive,srcarchive,true);
 }
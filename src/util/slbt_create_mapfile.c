@@ -22,7 +22,8 @@
 /*                                                  */
 /* Since the provided symbol list is host-neautral, */
 /* prepend symbol names with an underscore whenever */
-/* necessary.                                       */
+/* necessary. Symbols are emitted once each, and in */
+/* sorted order.                                    */
 /****************************************************/
 
 static int slbt_util_output_mapfile_impl(
@@ -52,7 +53,9 @@ static int slbt_util_output_mapfile_impl(
 			return SLBT_SYSTEM_ERROR(dctx,0);
 	}
 
-	symstrv = sctx->symstrv;
+	/* sorted order with --sort-symbols, otherwise file order */
+	if (!(symstrv = (slbt_get_symlist_ictx(sctx))->mapstrv))
+		symstrv = sctx->symstrv;
 
 	for (symv=symstrv; *symv; symv++) {
 		if (fcoff && slbt_is_strong_coff_symbol(*symv)) {